@@ -24,6 +24,7 @@
  *
  *******************************************************************************/
 #include "include_inliner.hpp"
+#include <miopen/lz4_block.hpp>
 #include <algorithm>
 #include <fstream>
 #include <iomanip>
@@ -37,7 +38,8 @@ void Bin2Hex(std::istream& source,
              const std::string& variable,
              bool nullTerminate,
              size_t bufferSize,
-             size_t lineSize)
+             size_t lineSize,
+             std::streamoff uncompressedSize = -1)
 {
     source.seekg(0, std::ios::end);
     std::unique_ptr<unsigned char[]> buffer(new unsigned char[bufferSize]);
@@ -46,8 +48,12 @@ void Bin2Hex(std::istream& source,
 
     if(variable.length() != 0)
     {
-        target << "const size_t " << variable << "_SIZE = " << std::setbase(10) << sourceSize << ";"
-               << std::endl;
+        // _COMPRESSED_SIZE is 0 for data stored as is.
+        const auto compressed = uncompressedSize >= 0;
+        target << "const size_t " << variable << "_SIZE = " << std::setbase(10)
+               << (compressed ? uncompressedSize : sourceSize) << ";" << std::endl;
+        target << "const size_t " << variable << "_COMPRESSED_SIZE = " << std::setbase(10)
+               << (compressed ? sourceSize : 0) << ";" << std::endl;
         target << "const unsigned char " << variable << "[] = {" << std::endl;
     }
 
@@ -101,6 +107,9 @@ void PrintHelp()
     std::cout << "           -g[uard] <string>: guard name. Default: no guard" << std::endl;
     std::cout << "           -n[o-recurse] : dont expand include files recursively. Default: off"
               << std::endl;
+    std::cout << "           -c[ompress] : store the files compressed (LZ4 block format). "
+                 "Default: off"
+              << std::endl;
 }
 
 [[gnu::noreturn]] void WrongUsage(const std::string& error)
@@ -122,7 +131,8 @@ void Process(const std::string& sourcePath,
              std::ostream& target,
              size_t bufferSize,
              size_t lineSize,
-             bool recurse)
+             bool recurse,
+             bool compress)
 {
     std::string fileName(sourcePath);
     std::string extension, root;
@@ -184,6 +194,17 @@ void Process(const std::string& sourcePath,
     }
 
     std::transform(variable.begin(), variable.end(), variable.begin(), ::toupper);
+
+    if(compress)
+    {
+        std::stringstream contents;
+        contents << source->rdbuf();
+        const auto data = contents.str();
+        std::stringstream compressed(miopen::Lz4Compress(data.data(), data.size()));
+        Bin2Hex(compressed, target, variable, false, bufferSize, lineSize, data.size());
+        return;
+    }
+
     Bin2Hex(*source, target, variable, true, bufferSize, lineSize);
 }
 
@@ -202,6 +223,7 @@ int main(int argsn, char** args)
     std::ofstream targetFile;
     std::ostream* target = &std::cout;
     bool recurse         = true;
+    bool compress        = false;
 
     int i = 0;
     while(++i < argsn && **args != '-')
@@ -220,7 +242,7 @@ int main(int argsn, char** args)
 
             while(++i < argsn)
             {
-                Process(args[i], *target, bufferSize, lineSize, recurse);
+                Process(args[i], *target, bufferSize, lineSize, recurse, compress);
             }
 
             if(guard.length() > 0)
@@ -243,6 +265,8 @@ int main(int argsn, char** args)
             guard = args[++i];
         else if(arg == "n" || arg == "no-recurse")
             recurse = false;
+        else if(arg == "c" || arg == "compress")
+            compress = true;
         else
             UnknownArgument(arg);
     }
@@ -0,0 +1,127 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2019 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_MIOPEN_CMD_LOG_HPP
+#define GUARD_MIOPEN_CMD_LOG_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// MIOpenDriver command split into the base argument followed by the input flags,
+// e.g. {"conv", "-n", "32", "-c", "64", ...}.
+using DriverCommand = std::vector<std::string>;
+
+// Reads MIOpenDriver commands, one per line. Lines printed with MIOPEN_ENABLE_LOGGING_CMD
+// are accepted as is: everything up to and including "MIOpenDriver " is dropped, so whole
+// application logs can be fed in. Other log lines, empty lines and '#' comments are skipped.
+inline std::vector<DriverCommand> ReadDriverCommands(std::istream& is)
+{
+    static const std::string marker = "MIOpenDriver ";
+    std::vector<DriverCommand> commands;
+    std::string line;
+
+    while(std::getline(is, line))
+    {
+        const auto pos = line.find(marker);
+        if(pos != std::string::npos)
+            line = line.substr(pos + marker.size());
+        else if(line.find("MIOpen(") != std::string::npos)
+            continue; // Other logging output.
+
+        std::istringstream ss(line);
+        DriverCommand command;
+        std::string token;
+        while(ss >> token)
+            command.push_back(token);
+
+        if(command.empty() || command.front()[0] == '#' || command.front()[0] == '-')
+            continue;
+        commands.push_back(command);
+    }
+    return commands;
+}
+
+inline std::vector<DriverCommand> ReadDriverCommands(const std::string& path)
+{
+    std::ifstream file(path);
+    if(!file)
+    {
+        std::cerr << "Unable to open " << path << std::endl;
+        return {};
+    }
+    return ReadDriverCommands(file);
+}
+
+inline std::string ToString(const DriverCommand& command)
+{
+    std::string result;
+    for(const auto& token : command)
+        result += (result.empty() ? "" : " ") + token;
+    return result;
+}
+
+// Removes the flag given by either its short or its long name together with its value.
+inline void RemoveDriverFlag(DriverCommand& command, char short_name, const std::string& long_name)
+{
+    const auto short_flag = std::string{'-', short_name};
+    const auto long_flag  = "--" + long_name;
+
+    for(std::size_t i = 1; i < command.size();)
+    {
+        if(command[i] == short_flag || command[i] == long_flag)
+            command.erase(command.begin() + i,
+                          command.begin() + std::min(i + 2, command.size()));
+        else
+            i += 2;
+    }
+}
+
+inline void SetDriverFlag(DriverCommand& command,
+                          char short_name,
+                          const std::string& long_name,
+                          const std::string& value)
+{
+    RemoveDriverFlag(command, short_name, long_name);
+    command.push_back(std::string{'-', short_name});
+    command.push_back(value);
+}
+
+// argv for Driver::ParseCmdLineArgs() and execv(). Valid while the command is alive.
+inline std::vector<char*> MakeDriverArgv(DriverCommand& command)
+{
+    static std::string program_name = "MIOpenDriver";
+    std::vector<char*> argv{&program_name[0]};
+    for(auto& token : command)
+        argv.push_back(&token[0]);
+    argv.push_back(nullptr);
+    return argv;
+}
+
+#endif // GUARD_MIOPEN_CMD_LOG_HPP
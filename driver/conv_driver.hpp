@@ -54,12 +54,15 @@
 #include <miopen/conv_algo_name.hpp>
 #include <miopen/logger.hpp>
 #include <miopen/convolution.hpp>
+#include <miopen/problem_description.hpp>
+#include <miopen/roofline.hpp>
 #include "random.hpp"
 #include <numeric>
 #include <sstream>
 #include <vector>
 #include <type_traits>
 #include <boost/range/adaptors.hpp>
+#include <../test/verification_cache.hpp>
 #include <../test/verify.hpp>
 #include <../test/serialize.hpp>
 #include <../test/tensor_holder.hpp>
@@ -158,6 +161,11 @@ class ConvDriver : public Driver
 
     std::vector<int> GetOutputTensorLengths();
 
+    // Perf-db/find-db keys of the problems enabled by -F, paired with
+    // the -F value of the direction. Valid after GetandSetData().
+    miopen::ProblemDescription GetProblem(int forw) const;
+    std::vector<std::pair<int, std::string>> GetProblemKeys();
+
     int AllocateBuffersAndCopy();
 
     int FindForward(int& ret_algo_count,
@@ -249,7 +257,8 @@ class ConvDriver : public Driver
     Timer2 bwd_auxiliary;
     Timer2 wrw_auxiliary;
 
-    void PrintForwardTime(float kernel_total_time, float kernel_first_time) const;
+    void PrintRoofline(int forw, float kernel_average_time) const;
+    void PrintForwardTime(float kernel_total_time, float kernel_first_time);
     int RunForwardGpuImmed(bool is_transform);
     int RunForwardGpuFind(bool is_transform);
     void PrintBackwardDataTime(float kernel_total_time, float kernel_first_time);
@@ -266,9 +275,9 @@ class ConvDriver : public Driver
     std::string GetVCacheBiasBwdDataBasename() const;
     bool IsInputTensorTransform() const;
 
-    bool TryReadVerificationCache(const std::string& file_name,
-                                  miopenTensorDescriptor_t& tensorDesc,
-                                  Tref* data) const;
+    std::string GetVerificationCachePath(const std::string& file_name) const;
+    template <class R>
+    bool TryVerifyWithCache(const std::string& file_name, const R& gpu, double& error) const;
     void TrySaveVerificationCache(const std::string& file_name, std::vector<Tref>& data) const;
 };
 
@@ -689,6 +698,57 @@ std::vector<int> ConvDriver<Tgpu, Tref>::GetOutputTensorLengths()
     return out_lens;
 }
 
+template <typename Tgpu, typename Tref>
+miopen::ProblemDescription ConvDriver<Tgpu, Tref>::GetProblem(int forw) const
+{
+    const auto& conv = miopen::deref(convDesc);
+    // Transposed convolutions are run as convolutions with swapped x and y,
+    // see convolution_api.cpp, so their problems are described the same way.
+    const bool is_trans = conv.mode == miopenTranspose;
+    const auto& x       = miopen::deref(is_trans ? outputTensor : inputTensor);
+    const auto& y       = miopen::deref(is_trans ? inputTensor : outputTensor);
+    const auto& w       = miopen::deref(weightTensor);
+
+    if(forw == 1)
+        return {x, w, y, conv, is_trans ? 0 : 1};
+    if(forw == 2)
+        return {x, w, y, conv, is_trans ? 1 : 0};
+    auto problem = miopen::ProblemDescription{x, w, y, conv, 0};
+    problem.direction.SetBackwardWrW();
+    return problem;
+}
+
+template <typename Tgpu, typename Tref>
+std::vector<std::pair<int, std::string>> ConvDriver<Tgpu, Tref>::GetProblemKeys()
+{
+    std::vector<std::pair<int, std::string>> keys;
+    const auto add_key = [&](int forw) {
+        std::ostringstream ss;
+        GetProblem(forw).Serialize(ss);
+        keys.emplace_back(forw, ss.str());
+    };
+
+    if(is_fwd)
+        add_key(1);
+    if(is_bwd)
+        add_key(2);
+    if(is_wrw)
+        add_key(4);
+    return keys;
+}
+
+template <typename Tgpu, typename Tref>
+void ConvDriver<Tgpu, Tref>::PrintRoofline(int forw, float kernel_average_time) const
+{
+    const auto problem = GetProblem(forw);
+    const auto peak    = miopen::GetPeakTflops(miopen::deref(handle), problem.in_data_type);
+    const auto metrics =
+        miopen::GetRooflineMetrics(miopen::GetConvolutionCost(problem), kernel_average_time, peak);
+    std::ostringstream ss;
+    ss << metrics;
+    printf("roofline: %s\n", ss.str().c_str());
+}
+
 namespace detail {
 
 template <typename T>
@@ -1042,12 +1102,14 @@ int ConvDriver<Tgpu, Tref>::FindForward(int& ret_algo_count,
 
 template <typename Tgpu, typename Tref>
 void ConvDriver<Tgpu, Tref>::PrintForwardTime(const float kernel_total_time,
-                                              const float kernel_first_time) const
+                                              const float kernel_first_time)
 {
     float kernel_average_time = num_iterations > 1
                                     ? (kernel_total_time - kernel_first_time) / (num_iterations - 1)
                                     : kernel_first_time;
+    AddKernelTime(kernel_average_time);
     printf("GPU Kernel Time Forward Conv. Elapsed: %f ms (average)\n", kernel_average_time);
+    PrintRoofline(1, kernel_average_time);
 
     const auto num_dim = miopen::deref(inputTensor).GetSize() - 2;
     if(num_dim != 2)
@@ -1632,8 +1694,10 @@ void ConvDriver<Tgpu, Tref>::PrintBackwardDataTime(float kernel_total_time, floa
     float kernel_average_time = num_iterations > 1
                                     ? (kernel_total_time - kernel_first_time) / (num_iterations - 1)
                                     : kernel_first_time;
+    AddKernelTime(kernel_average_time);
 
     printf("GPU Kernel Time Backward Data Conv. Elapsed: %f ms (average)\n", kernel_average_time);
+    PrintRoofline(2, kernel_average_time);
 
     const auto num_dim = miopen::deref(inputTensor).GetSize() - 2;
     if(num_dim != 2)
@@ -1767,9 +1831,11 @@ void ConvDriver<Tgpu, Tref>::PrintBackwardWrwTime(float kernel_total_time, float
     float kernel_average_time = num_iterations > 1
                                     ? (kernel_total_time - kernel_first_time) / (num_iterations - 1)
                                     : kernel_first_time;
+    AddKernelTime(kernel_average_time);
 
     printf("GPU Kernel Time Backward Weights Conv. Elapsed: %f ms (average)\n",
            kernel_average_time);
+    PrintRoofline(4, kernel_average_time);
 
     const auto num_dim = miopen::deref(inputTensor).GetSize() - 2;
     if(num_dim != 2)
@@ -2222,26 +2288,28 @@ std::string ConvDriver<Tgpu, Tref>::GetVerificationCacheFileName() const
 }
 
 template <typename Tgpu, typename Tref>
-bool ConvDriver<Tgpu, Tref>::TryReadVerificationCache(const std::string& file_name,
-                                                      miopenTensorDescriptor_t& tensorDesc,
-                                                      Tref* data) const
+std::string ConvDriver<Tgpu, Tref>::GetVerificationCachePath(const std::string& file_name) const
 {
     const auto verification_cache_path = inflags.GetValueStr("verification_cache");
+    if(verification_cache_path.empty())
+        return {};
+    return verification_cache_path + "/" + file_name + "_" + GetVerificationCacheFileName();
+}
 
-    if(!verification_cache_path.empty())
-    {
-        const auto file_path =
-            verification_cache_path + "/" + file_name + "_" + GetVerificationCacheFileName();
-
-        if(std::ifstream(file_path).good())
-        {
-            if(readBufferFromFile<Tref>(data, GetTensorSize(tensorDesc), file_path.c_str()))
-            {
-                return true;
-            }
-        }
-    }
-
+// Compares gpu with the cached reference block by block, without loading it whole.
+// Returns false if there is no valid cached reference, e.g. it is missing or corrupt.
+template <typename Tgpu, typename Tref>
+template <class R>
+bool ConvDriver<Tgpu, Tref>::TryVerifyWithCache(const std::string& file_name,
+                                                const R& gpu,
+                                                double& error) const
+{
+    const auto file_path = GetVerificationCachePath(file_name);
+    if(file_path.empty() || !std::ifstream(file_path).good())
+        return false;
+    if(miopen::CachedRmsRange<Tref>(file_path, gpu, error))
+        return true;
+    std::cout << "Warning: ignoring invalid verification cache file " << file_path << std::endl;
     return false;
 }
 
@@ -2249,13 +2317,9 @@ template <typename Tgpu, typename Tref>
 void ConvDriver<Tgpu, Tref>::TrySaveVerificationCache(const std::string& file_name,
                                                       std::vector<Tref>& data) const
 {
-    const auto verification_cache_path = inflags.GetValueStr("verification_cache");
-    if(!verification_cache_path.empty())
-    {
-        const auto file_path =
-            verification_cache_path + "/" + file_name + "_" + GetVerificationCacheFileName();
-        dumpBufferToFile<Tref>(file_path.c_str(), data.data(), data.size());
-    }
+    const auto file_path = GetVerificationCachePath(file_name);
+    if(!file_path.empty())
+        miopen::SaveVerificationCache(file_path, data);
 }
 
 template <typename Tgpu, typename Tref>
@@ -2288,18 +2352,26 @@ int ConvDriver<Tgpu, Tref>::VerifyForward()
     if(!is_fwd)
         return 0;
 
-    if(!TryReadVerificationCache(GetVCacheFwdOutBasename(), outputTensor, outhost.data.data()))
+    const bool is_int8 = data_type == miopenInt8 || data_type == miopenInt8x4;
+    double error       = 0;
+    const bool cached  = is_int8
+                            ? TryVerifyWithCache(GetVCacheFwdOutBasename(), out_int8, error)
+                            : TryVerifyWithCache(GetVCacheFwdOutBasename(), out.data, error);
+    if(!cached)
     {
         RunForwardCPU();
+        error = is_int8 ? miopen::rms_range(outhost.data, out_int8)
+                        : miopen::rms_range(outhost.data, out.data);
     }
 
-    auto error = miopen::rms_range(outhost.data, out.data);
-    if(data_type == miopenInt8 || data_type == miopenInt8x4)
-        error = miopen::rms_range(outhost.data, out_int8);
-
-    const Tref tolerance = ((sizeof(Tgpu) == 4 || sizeof(Tgpu) == 1) ? static_cast<Tref>(1e-6)
-                                                                     : static_cast<Tref>(7e-2));
-    if(!(error < tolerance))
+    // The host accumulates int8 in int32 and bfloat16 in fp32 like the device, so int8 results
+    // must match exactly and bfloat16 ones differ by the rounding of the output only.
+    const Tref tolerance = is_int8 ? static_cast<Tref>(0)
+                                   : sizeof(Tgpu) == 4 ? static_cast<Tref>(1e-6)
+                                                       : std::is_same<Tgpu, bfloat16>{}
+                                                             ? static_cast<Tref>(1e-2)
+                                                             : static_cast<Tref>(7e-2);
+    if(!(error <= tolerance))
     {
         std::cout << "Forward Convolution Failed: " << error << std::endl;
         return EC_VerifyFwd;
@@ -2325,13 +2397,13 @@ int ConvDriver<Tgpu, Tref>::VerifyBackward()
     int cumulative_rc = 0;
     if(is_bwd)
     {
-        if(!TryReadVerificationCache(GetVCacheBwdDataBasename(), inputTensor, din_host.data.data()))
+        double error_data = 0;
+        if(!TryVerifyWithCache(GetVCacheBwdDataBasename(), din, error_data))
         {
             RunBackwardDataCPU();
+            error_data = miopen::rms_range(din_host.data, din);
         }
 
-        auto error_data = miopen::rms_range(din_host.data, din);
-
         if(!(error_data < tolerance))
         {
             std::cout << "Backward Convolution Data Failed: " << error_data << std::endl;
@@ -2346,10 +2418,11 @@ int ConvDriver<Tgpu, Tref>::VerifyBackward()
 
     if(is_wrw)
     {
-        if(!TryReadVerificationCache(
-               GetVCacheBwdWeightBasename(), weightTensor, dwei_host.data.data()))
+        double error_weights = 0;
+        if(!TryVerifyWithCache(GetVCacheBwdWeightBasename(), dwei, error_weights))
         {
             RunBackwardWeightsCPU();
+            error_weights = miopen::rms_range(dwei_host.data, dwei);
         }
 
         // Winograd algorithm has worse precision than Direct and Gemm.
@@ -2359,7 +2432,6 @@ int ConvDriver<Tgpu, Tref>::VerifyBackward()
         if(is_wrw_winograd && std::is_same<Tgpu, float>::value)
             tolerance_wrw *= 16.0;
 
-        auto error_weights = miopen::rms_range(dwei_host.data, dwei);
         if(!(error_weights < tolerance_wrw))
         {
             std::cout << "Backward Convolution Weights Failed: " << error_weights << std::endl;
@@ -2374,13 +2446,12 @@ int ConvDriver<Tgpu, Tref>::VerifyBackward()
 
     if(inflags.GetValueInt("bias") != 0)
     {
-        if(!TryReadVerificationCache(
-               GetVCacheBiasBwdDataBasename(), biasTensor, db_host.data.data()))
+        double error_bias = 0;
+        if(!TryVerifyWithCache(GetVCacheBiasBwdDataBasename(), db, error_bias))
         {
             RunBackwardBiasCPU();
+            error_bias = miopen::rms_range(db_host.data, db);
         }
-
-        auto error_bias = miopen::rms_range(db_host.data, db);
         if(!(error_bias < tolerance))
         {
             std::cout << "Backward Convolution Bias Failed: " << error_bias << std::endl;
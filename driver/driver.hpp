@@ -129,7 +129,8 @@ void PadBufferSize(size_t& sz, int datatype_sz)
     printf("Usage: ./driver *base_arg* *other_args*\n");
     printf(
         "Supported Base Arguments: conv[fp16|int8|bfp16], CBAInfer[fp16], pool[fp16], lrn[fp16], "
-        "activ[fp16], softmax[fp16], bnorm[fp16], rnn[fp16], gemm, ctc, dropout[fp16]\n");
+        "activ[fp16], softmax[fp16], bnorm[fp16], rnn[fp16], gemm, ctc, dropout[fp16], tune, "
+        "replay, bundle\n");
     exit(0);
 }
 
@@ -148,7 +149,8 @@ std::string ParseBaseArg(int argc, char* argv[])
        arg != "lrn" && arg != "lrnfp16" && arg != "activ" && arg != "activfp16" &&
        arg != "softmax" && arg != "softmaxfp16" && arg != "bnorm" && arg != "bnormfp16" &&
        arg != "rnn" && arg != "rnnfp16" && arg != "gemm" /*&& arg != "gemmfp16"*/ && arg != "ctc" &&
-       arg != "dropout" && arg != "dropoutfp16")
+       arg != "dropout" && arg != "dropoutfp16" && arg != "tune" && arg != "replay" &&
+       arg != "bundle")
 
     {
         printf("Invalid Base Input Argument\n");
@@ -187,7 +189,12 @@ class Driver
 #endif
     virtual ~Driver() { miopenDestroy(handle); }
 
-    // TODO: add timing APIs
+    // Kernel time of one iteration of the library calls timed in the last RunForwardGPU() or
+    // RunBackwardGPU(), in ms, or a negative value if the driver has not measured it. Drivers
+    // measure kernel time only with --time 1.
+    float GetKernelTime() const { return kernel_time; }
+    void ResetKernelTime() { kernel_time = -1.0f; }
+
     virtual int AddCmdLineArgs() = 0;
     virtual int ParseCmdLineArgs(int argc, char* argv[]) = 0;
     virtual InputFlags& GetInputFlags()  = 0;
@@ -203,6 +210,9 @@ class Driver
     void InitDataType();
     miopenHandle_t handle;
     miopenDataType_t data_type;
+    float kernel_time = -1.0f;
+
+    void AddKernelTime(float time) { kernel_time = std::max(kernel_time, 0.0f) + time; }
 
 #if MIOPEN_BACKEND_OPENCL
     cl_command_queue q;
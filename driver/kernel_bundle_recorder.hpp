@@ -0,0 +1,187 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2019 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_MIOPEN_KERNEL_BUNDLE_RECORDER_HPP
+#define GUARD_MIOPEN_KERNEL_BUNDLE_RECORDER_HPP
+
+#include "InputFlags.hpp"
+#include "cmd_log.hpp"
+#include "driver.hpp"
+#include "log_replay.hpp"
+
+#include <miopen/miopen.h>
+
+#include <exception>
+#include <iostream>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+// Ahead-of-time compilation of the kernels of a fixed model.
+//
+// The input is a manifest of MIOpenDriver commands, normally an application log produced with
+// MIOPEN_ENABLE_LOGGING_CMD=1. Every unique command is run once forward and backward in this
+// process while the library records the code objects it builds or loads and the kernels the
+// solutions register. The result is a kernel bundle for the current device, which the
+// application loads with miopenLoadKernelBundle() to run the same problems without compilation.
+
+class KernelBundleRecorder
+{
+    public:
+    explicit KernelBundleRecorder(DriverFactory make_driver_) : make_driver(std::move(make_driver_))
+    {
+    }
+
+    void AddCmdLineArgs()
+    {
+        inflags.AddInputFlag("input",
+                             'f',
+                             "",
+                             "File with MIOpenDriver commands of the model, e.g. an application "
+                             "log produced with MIOPEN_ENABLE_LOGGING_CMD=1",
+                             "string");
+        inflags.AddInputFlag("output", 'o', "", "Kernel bundle file to write", "string");
+        inflags.AddInputFlag("immediate",
+                             'I',
+                             "1",
+                             "Record convolutions in immediate mode, i.e. the fastest solution "
+                             "only; 0 records all the solutions built by Find (Default=1)",
+                             "int");
+    }
+
+    int ParseCmdLineArgs(int argc, char* argv[])
+    {
+        inflags.Parse(argc, argv);
+        if(inflags.GetValueStr("input").empty())
+        {
+            std::cout << "Fatal: no input file (-f)" << std::endl;
+            return 1;
+        }
+        if(inflags.GetValueStr("output").empty())
+        {
+            std::cout << "Fatal: no output file (-o)" << std::endl;
+            return 1;
+        }
+        return 0;
+    }
+
+    int Run()
+    {
+        const auto commands = ReadDriverCommands(inflags.GetValueStr("input"));
+        const bool immediate = inflags.GetValueInt("immediate") != 0;
+
+        std::set<std::string> seen;
+        std::vector<DriverCommand> unique;
+        for(auto command : commands)
+        {
+            RemoveDriverFlag(command, 'w', "wall");
+            SetDriverFlag(command, 'V', "verify", "0");
+            SetDriverFlag(command, 't', "time", "0");
+            SetDriverFlag(command, 'i', "iter", "1");
+            if(immediate && command.front().compare(0, 4, "conv") == 0)
+                SetDriverFlag(command, 'S', "solution", "0");
+            if(seen.insert(ToString(command)).second)
+                unique.push_back(command);
+        }
+
+        std::cout << "Recording kernels of " << unique.size() << " unique commands out of "
+                  << commands.size() << std::endl;
+
+        if(miopenStartKernelBundleRecording() != miopenStatusSuccess)
+            return 1;
+        int rc = 0;
+        for(const auto& command : unique)
+            rc |= RunCommand(command);
+
+        const auto output = inflags.GetValueStr("output");
+        if(miopenWriteKernelBundle(output.c_str()) != miopenStatusSuccess)
+        {
+            std::cout << "Failed writing kernel bundle " << output << std::endl;
+            return 1;
+        }
+        std::cout << "Kernel bundle written to " << output << std::endl;
+        return rc;
+    }
+
+    private:
+    DriverFactory make_driver;
+    InputFlags inflags;
+
+    int RunCommand(DriverCommand command)
+    {
+        const auto& base_arg = command.front();
+        std::unique_ptr<Driver> drv(make_driver(base_arg));
+        if(drv == nullptr)
+        {
+            std::cout << "Skipping unknown base argument: " << base_arg << std::endl;
+            return 1;
+        }
+
+        try
+        {
+            drv->AddCmdLineArgs();
+            auto argv = MakeDriverArgv(command);
+            auto rc   = drv->ParseCmdLineArgs(static_cast<int>(argv.size()) - 1, argv.data());
+            if(rc != 0)
+                return rc;
+            drv->GetandSetData();
+            rc = drv->AllocateBuffersAndCopy();
+            if(rc != 0)
+                return rc;
+
+            // Same selection of directions as in main().
+            const int fargval = (base_arg != "CBAInfer" && base_arg != "CBAInferfp16")
+                                    ? drv->GetInputFlags().GetValueInt("forw")
+                                    : 1;
+            const bool bnFwdInVer = (fargval == 2 && (base_arg == "bnorm"));
+
+            if(fargval & 1 || fargval == 0 || bnFwdInVer)
+                rc |= drv->RunForwardGPU();
+            if(fargval != 1)
+                rc |= drv->RunBackwardGPU();
+            SyncDriverStream(*drv);
+            return rc;
+        }
+        catch(const std::exception& ex)
+        {
+            std::cout << "Recording of '" << ToString(command) << "' failed: " << ex.what()
+                      << std::endl;
+            return 1;
+        }
+    }
+};
+
+inline int RunKernelBundleRecorder(int argc, char* argv[], DriverFactory make_driver)
+{
+    KernelBundleRecorder recorder(std::move(make_driver));
+    recorder.AddCmdLineArgs();
+    const auto rc = recorder.ParseCmdLineArgs(argc, argv);
+    if(rc != 0)
+        return rc;
+    return recorder.Run();
+}
+
+#endif // GUARD_MIOPEN_KERNEL_BUNDLE_RECORDER_HPP
@@ -0,0 +1,317 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2019 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_MIOPEN_LOG_REPLAY_HPP
+#define GUARD_MIOPEN_LOG_REPLAY_HPP
+
+#include "InputFlags.hpp"
+#include "cmd_log.hpp"
+#include "driver.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <exception>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// Benchmark of the layer mix of a real application.
+//
+// The input is a list of MIOpenDriver commands, normally an application log produced with
+// MIOPEN_ENABLE_LOGGING_CMD=1. Identical commands are merged and weighted by the number of times
+// they were logged, then every unique command is replayed in this process through its Driver.
+// The report has a row per command and a weighted total, so the result of one library build can
+// be compared with another (--baseline) on the same log.
+//
+// The time of a layer is the kernel time the driver measures with --time 1 for one iteration
+// of its library calls, so it excludes Find, compilation and host transfers. Drivers that do not
+// report kernel time (see Driver::GetKernelTime()) are timed with the wall clock around
+// RunForwardGPU() and RunBackwardGPU() up to the completion of the stream instead. Either way
+// it is the median over --repeat runs after a warm-up run, which also does Find and compilation.
+
+using DriverFactory = std::function<Driver*(const std::string& base_arg)>;
+
+struct ReplayLayer
+{
+    DriverCommand command;
+    std::size_t count  = 0;
+    double forward_ms  = 0.0;
+    double backward_ms = 0.0;
+    int status         = 0;
+
+    double Time() const { return forward_ms + backward_ms; }
+    double WeightedTime() const { return count * Time(); }
+};
+
+inline void SyncDriverStream(Driver& drv)
+{
+#if MIOPEN_BACKEND_OPENCL
+    clFinish(drv.GetStream());
+#elif MIOPEN_BACKEND_HIP
+    hipStreamSynchronize(drv.GetStream());
+#endif
+}
+
+// Median of the times of repeat runs of the function after a warm-up run, in ms. A run is
+// timed with the kernel time reported by the driver if any, else with the wall clock.
+inline double MeasureDriverRun(Driver& drv, int repeat, const std::function<int()>& run, int& rc)
+{
+    rc = run();
+    SyncDriverStream(drv);
+
+    std::vector<double> times;
+    for(int i = 0; i < repeat && rc == 0; ++i)
+    {
+        drv.ResetKernelTime();
+        const auto start = std::chrono::steady_clock::now();
+        rc |= run();
+        SyncDriverStream(drv);
+        const auto end = std::chrono::steady_clock::now();
+        times.push_back(drv.GetKernelTime() >= 0
+                            ? drv.GetKernelTime()
+                            : std::chrono::duration<double, std::milli>(end - start).count());
+    }
+    if(times.empty())
+        return 0.0;
+    std::nth_element(times.begin(), times.begin() + times.size() / 2, times.end());
+    return times[times.size() / 2];
+}
+
+class LogReplay
+{
+    public:
+    explicit LogReplay(DriverFactory make_driver_) : make_driver(std::move(make_driver_)) {}
+
+    void AddCmdLineArgs()
+    {
+        inflags.AddInputFlag("input",
+                             'f',
+                             "",
+                             "File with MIOpenDriver commands, e.g. an application log "
+                             "produced with MIOPEN_ENABLE_LOGGING_CMD=1",
+                             "string");
+        inflags.AddInputFlag(
+            "repeat", 'r', "5", "Number of timed runs of each command (Default=5)", "int");
+        inflags.AddInputFlag("output", 'o', "", "Write the report into a CSV file", "string");
+        inflags.AddInputFlag("baseline",
+                             'B',
+                             "",
+                             "CSV report of another run of the same log to compare with",
+                             "string");
+    }
+
+    int ParseCmdLineArgs(int argc, char* argv[])
+    {
+        inflags.Parse(argc, argv);
+        if(inflags.GetValueStr("input").empty())
+        {
+            std::cout << "Fatal: no input file (-f)" << std::endl;
+            return 1;
+        }
+        return 0;
+    }
+
+    int Run()
+    {
+        const auto commands = ReadDriverCommands(inflags.GetValueStr("input"));
+        const auto repeat   = std::max(inflags.GetValueInt("repeat"), 1);
+
+        // Commands differing only in the driver's own options are the same layer.
+        std::map<std::string, std::size_t> index;
+        for(auto command : commands)
+        {
+            RemoveDriverFlag(command, 'w', "wall");
+            SetDriverFlag(command, 'V', "verify", "0");
+            SetDriverFlag(command, 't', "time", "1");
+            SetDriverFlag(command, 'i', "iter", "1");
+
+            const auto text = ToString(command);
+            if(index.count(text) == 0)
+            {
+                index[text] = layers.size();
+                layers.push_back({command});
+            }
+            layers[index[text]].count++;
+        }
+
+        std::cout << "Replaying " << layers.size() << " unique commands out of "
+                  << commands.size() << std::endl;
+
+        int rc = 0;
+        for(auto& layer : layers)
+        {
+            RunLayer(layer, repeat);
+            rc |= layer.status;
+        }
+
+        const auto output = inflags.GetValueStr("output");
+        if(!output.empty())
+        {
+            std::ofstream file(output);
+            WriteReport(file);
+        }
+        WriteReport(std::cout);
+
+        const auto baseline = inflags.GetValueStr("baseline");
+        if(!baseline.empty())
+            Compare(baseline);
+        return rc;
+    }
+
+    private:
+    DriverFactory make_driver;
+    InputFlags inflags;
+    std::vector<ReplayLayer> layers;
+
+    void RunLayer(ReplayLayer& layer, int repeat)
+    {
+        const auto& base_arg = layer.command.front();
+        std::unique_ptr<Driver> drv(make_driver(base_arg));
+        if(drv == nullptr)
+        {
+            std::cout << "Skipping unknown base argument: " << base_arg << std::endl;
+            layer.status = 1;
+            return;
+        }
+
+        try
+        {
+            drv->AddCmdLineArgs();
+            auto argv = MakeDriverArgv(layer.command);
+            layer.status = drv->ParseCmdLineArgs(static_cast<int>(argv.size()) - 1, argv.data());
+            if(layer.status != 0)
+                return;
+            drv->GetandSetData();
+            layer.status = drv->AllocateBuffersAndCopy();
+            if(layer.status != 0)
+                return;
+
+            // Same selection of directions as in main().
+            const int fargval = (base_arg != "CBAInfer" && base_arg != "CBAInferfp16")
+                                    ? drv->GetInputFlags().GetValueInt("forw")
+                                    : 1;
+            const bool bnFwdInVer = (fargval == 2 && (base_arg == "bnorm"));
+
+            int rc = 0;
+            if(fargval & 1 || fargval == 0 || bnFwdInVer)
+            {
+                layer.forward_ms = MeasureDriverRun(
+                    *drv, repeat, [&] { return drv->RunForwardGPU(); }, rc);
+                layer.status |= rc;
+            }
+            if(fargval != 1)
+            {
+                layer.backward_ms = MeasureDriverRun(
+                    *drv, repeat, [&] { return drv->RunBackwardGPU(); }, rc);
+                layer.status |= rc;
+            }
+        }
+        catch(const std::exception& ex)
+        {
+            std::cout << "Replay of '" << ToString(layer.command) << "' failed: " << ex.what()
+                      << std::endl;
+            layer.status = 1;
+        }
+    }
+
+    void WriteReport(std::ostream& os) const
+    {
+        double total      = 0.0;
+        std::size_t calls = 0;
+        os << "count,forward_ms,backward_ms,time_ms,weighted_ms,status,command\n";
+        os << std::fixed << std::setprecision(4);
+        for(const auto& layer : layers)
+        {
+            os << layer.count << ',' << layer.forward_ms << ',' << layer.backward_ms << ','
+               << layer.Time() << ',' << layer.WeightedTime() << ',' << layer.status << ','
+               << ToString(layer.command) << '\n';
+            total += layer.WeightedTime();
+            calls += layer.count;
+        }
+        os << calls << ",,,," << total << ",,TOTAL\n";
+        os.flush();
+    }
+
+    // Prints the ratio of the baseline time to the current time per command and for the
+    // weighted total. Commands are matched by their text.
+    void Compare(const std::string& baseline_path) const
+    {
+        std::ifstream file(baseline_path);
+        if(!file)
+        {
+            std::cout << "Unable to open " << baseline_path << std::endl;
+            return;
+        }
+
+        std::map<std::string, double> baseline;
+        std::string line;
+        std::getline(file, line); // Header.
+        while(std::getline(file, line))
+        {
+            std::vector<std::string> fields;
+            std::istringstream ss(line);
+            std::string field;
+            while(fields.size() < 6 && std::getline(ss, field, ','))
+                fields.push_back(field);
+            std::getline(ss, field);
+            if(fields.size() == 6 && fields[5] == "0")
+                baseline[field] = std::atof(fields[3].c_str());
+        }
+
+        double base_total = 0.0, total = 0.0;
+        std::cout << "speedup,baseline_ms,time_ms,command\n" << std::fixed << std::setprecision(4);
+        for(const auto& layer : layers)
+        {
+            const auto it = baseline.find(ToString(layer.command));
+            if(it == baseline.end() || layer.status != 0 || layer.Time() <= 0.0)
+                continue;
+            base_total += layer.count * it->second;
+            total += layer.WeightedTime();
+            std::cout << it->second / layer.Time() << ',' << it->second << ',' << layer.Time()
+                      << ',' << it->first << '\n';
+        }
+        if(total > 0.0)
+            std::cout << base_total / total << ',' << base_total << ',' << total
+                      << ",TOTAL (weighted, common commands)" << std::endl;
+    }
+};
+
+inline int RunLogReplay(int argc, char* argv[], DriverFactory make_driver)
+{
+    LogReplay replay(std::move(make_driver));
+    replay.AddCmdLineArgs();
+    const auto rc = replay.ParseCmdLineArgs(argc, argv);
+    if(rc != 0)
+        return rc;
+    return replay.Run();
+}
+
+#endif // GUARD_MIOPEN_LOG_REPLAY_HPP
@@ -38,115 +38,130 @@
 #include "rnn_driver.hpp"
 #include "ctc_driver.hpp"
 #include "dropout_driver.hpp"
+#include "kernel_bundle_recorder.hpp"
+#include "log_replay.hpp"
+#include "tuning_campaign.hpp"
 #include "miopen/config.h"
 
-int main(int argc, char* argv[])
+Driver* MakeDriver(const std::string& base_arg)
 {
-    // show command
-    std::cout << "MIOpenDriver:";
-    for(int i = 1; i < argc; i++)
-        std::cout << " " << argv[i];
-    std::cout << std::endl;
-
-    std::string base_arg = ParseBaseArg(argc, argv);
-
-    Driver* drv;
     if(base_arg == "conv")
     {
-        drv = new ConvDriver<float, float>();
+        return new ConvDriver<float, float>();
     }
-    else if(base_arg == "convfp16")
+    if(base_arg == "convfp16")
     {
-        drv = new ConvDriver<float16, float>();
+        return new ConvDriver<float16, float>();
     }
-    else if(base_arg == "convbfp16")
+    if(base_arg == "convbfp16")
     {
-        drv = new ConvDriver<bfloat16, float>();
+        return new ConvDriver<bfloat16, float>();
     }
-    else if(base_arg == "convint8")
+    if(base_arg == "convint8")
     {
-        drv = new ConvDriver<int8_t, float>();
+        return new ConvDriver<int8_t, float>();
     }
-    else if(base_arg == "CBAInfer")
+    if(base_arg == "CBAInfer")
     {
-        drv = new CBAInferFusionDriver<float, double>();
+        return new CBAInferFusionDriver<float, double>();
     }
-    else if(base_arg == "CBAInferfp16")
+    if(base_arg == "CBAInferfp16")
     {
-        drv = new CBAInferFusionDriver<float16, double>();
+        return new CBAInferFusionDriver<float16, double>();
     }
-    else if(base_arg == "pool")
+    if(base_arg == "pool")
     {
-        drv = new PoolDriver<float, double>();
+        return new PoolDriver<float, double>();
     }
-    else if(base_arg == "poolfp16")
+    if(base_arg == "poolfp16")
     {
-        drv = new PoolDriver<float16, double>();
+        return new PoolDriver<float16, double>();
     }
-    else if(base_arg == "lrn")
+    if(base_arg == "lrn")
     {
-        drv = new LRNDriver<float, double>();
+        return new LRNDriver<float, double>();
     }
-    else if(base_arg == "lrnfp16")
+    if(base_arg == "lrnfp16")
     {
-        drv = new LRNDriver<float16, double>();
+        return new LRNDriver<float16, double>();
     }
-    else if(base_arg == "activ")
+    if(base_arg == "activ")
     {
-        drv = new ActivationDriver<float, double>();
+        return new ActivationDriver<float, double>();
     }
-    else if(base_arg == "activfp16")
+    if(base_arg == "activfp16")
     {
-        drv = new ActivationDriver<float16, double>();
+        return new ActivationDriver<float16, double>();
     }
-    else if(base_arg == "softmax")
+    if(base_arg == "softmax")
     {
-        drv = new SoftmaxDriver<float, double>();
+        return new SoftmaxDriver<float, double>();
     }
-    else if(base_arg == "softmaxfp16")
+    if(base_arg == "softmaxfp16")
     {
-        drv = new SoftmaxDriver<float16, double>();
+        return new SoftmaxDriver<float16, double>();
     }
 #if MIOPEN_USE_GEMM
-    else if(base_arg == "gemm")
+    if(base_arg == "gemm")
     {
-        drv = new GemmDriver<float>();
+        return new GemmDriver<float>();
     }
 // TODO half is not supported in gemm
-//    else if(base_arg == "gemmfp16")
+//    if(base_arg == "gemmfp16")
 //    {
-//        drv = new GemmDriver<float16>();
+//        return new GemmDriver<float16>();
 //    }
 #endif
-    else if(base_arg == "bnorm")
+    if(base_arg == "bnorm")
     {
-        drv = new BatchNormDriver<float, double>();
+        return new BatchNormDriver<float, double>();
     }
-    else if(base_arg == "bnormfp16")
+    if(base_arg == "bnormfp16")
     {
-        drv = new BatchNormDriver<float16, double, float>();
+        return new BatchNormDriver<float16, double, float>();
     }
-    else if(base_arg == "rnn")
+    if(base_arg == "rnn")
     {
-        drv = new RNNDriver<float, double>();
+        return new RNNDriver<float, double>();
     }
-    else if(base_arg == "rnnfp16")
+    if(base_arg == "rnnfp16")
     {
-        drv = new RNNDriver<float16, double>();
+        return new RNNDriver<float16, double>();
     }
-    else if(base_arg == "ctc")
+    if(base_arg == "ctc")
     {
-        drv = new CTCDriver<float>();
+        return new CTCDriver<float>();
     }
-    else if(base_arg == "dropout")
+    if(base_arg == "dropout")
     {
-        drv = new DropoutDriver<float, float>();
+        return new DropoutDriver<float, float>();
     }
-    else if(base_arg == "dropoutfp16")
+    if(base_arg == "dropoutfp16")
     {
-        drv = new DropoutDriver<float16, float>();
+        return new DropoutDriver<float16, float>();
     }
-    else
+    return nullptr;
+}
+
+int main(int argc, char* argv[])
+{
+    // show command
+    std::cout << "MIOpenDriver:";
+    for(int i = 1; i < argc; i++)
+        std::cout << " " << argv[i];
+    std::cout << std::endl;
+
+    std::string base_arg = ParseBaseArg(argc, argv);
+
+    if(base_arg == "tune")
+        return RunTuningCampaign(argc, argv);
+    if(base_arg == "replay")
+        return RunLogReplay(argc, argv, MakeDriver);
+    if(base_arg == "bundle")
+        return RunKernelBundleRecorder(argc, argv, MakeDriver);
+
+    Driver* drv = MakeDriver(base_arg);
+    if(drv == nullptr)
     {
         printf("Incorrect BaseArg\n");
         exit(0);
@@ -0,0 +1,351 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2019 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_MIOPEN_TUNING_CAMPAIGN_HPP
+#define GUARD_MIOPEN_TUNING_CAMPAIGN_HPP
+
+#include "InputFlags.hpp"
+#include "cmd_log.hpp"
+#include "conv_driver.hpp"
+#include "driver.hpp"
+
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <set>
+#include <string>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <vector>
+
+// Offline tuning of the convolutions of a whole network.
+//
+// The layers come from a list of MIOpenDriver commands, e.g. an application log produced with
+// MIOPEN_ENABLE_LOGGING_CMD=1. The commands are split per direction and deduplicated by the
+// perf-db key of the problem, then every unique problem is searched by a separate MIOpenDriver
+// process (-s 1) with up to --jobs processes running at once. Workers write the results into the
+// user perf-db and find-db through the regular library code, which serializes concurrent updates
+// with file locks, so nothing needs to be merged afterwards.
+//
+// Finished problems are appended to the state file right away. A campaign that was interrupted
+// is resumed by running the same command again: problems recorded as done are skipped and
+// failed ones are retried.
+
+struct TuningJob
+{
+    std::string key;
+    DriverCommand command;
+    std::size_t occurrences = 0;
+};
+
+template <class TDriver>
+std::vector<std::pair<int, std::string>> GetConvProblemKeys(DriverCommand command)
+{
+    TDriver drv;
+    drv.AddCmdLineArgs();
+    auto argv = MakeDriverArgv(command);
+    if(drv.ParseCmdLineArgs(static_cast<int>(argv.size()) - 1, argv.data()) != 0)
+        return {};
+    drv.GetandSetData();
+    return drv.GetProblemKeys();
+}
+
+inline std::vector<std::pair<int, std::string>> GetConvProblemKeys(const DriverCommand& command)
+{
+    const auto& base_arg = command.front();
+    if(base_arg == "conv")
+        return GetConvProblemKeys<ConvDriver<float, float>>(command);
+    if(base_arg == "convfp16")
+        return GetConvProblemKeys<ConvDriver<float16, float>>(command);
+    if(base_arg == "convbfp16")
+        return GetConvProblemKeys<ConvDriver<bfloat16, float>>(command);
+    if(base_arg == "convint8")
+        return GetConvProblemKeys<ConvDriver<int8_t, float>>(command);
+    return {};
+}
+
+// Per-problem worker command: one direction, exhaustive search through the Find() API,
+// a single iteration and no verification.
+inline DriverCommand MakeTuningCommand(DriverCommand command, int forw)
+{
+    RemoveDriverFlag(command, 'S', "solution");
+    RemoveDriverFlag(command, 'w', "wall");
+    SetDriverFlag(command, 'F', "forw", std::to_string(forw));
+    SetDriverFlag(command, 's', "search", "1");
+    SetDriverFlag(command, 'V', "verify", "0");
+    SetDriverFlag(command, 'i', "iter", "1");
+    SetDriverFlag(command, 't', "time", "0");
+    return command;
+}
+
+// The state file has a line per finished problem: "done <key>" or "failed <key>".
+// Later lines override earlier ones. A torn last line left by a crash is ignored.
+inline std::set<std::string> ReadTuningState(const std::string& path)
+{
+    std::set<std::string> done;
+    std::ifstream file(path);
+    std::string status, key;
+    while(file >> status >> key)
+    {
+        if(status == "done")
+            done.insert(key);
+        else if(status == "failed")
+            done.erase(key);
+    }
+    return done;
+}
+
+class TuningCampaign
+{
+    public:
+    void AddCmdLineArgs()
+    {
+        inflags.AddInputFlag("input",
+                             'f',
+                             "",
+                             "File with MIOpenDriver commands, e.g. an application log "
+                             "produced with MIOPEN_ENABLE_LOGGING_CMD=1",
+                             "string");
+        inflags.AddInputFlag(
+            "state", 's', "tuning_campaign.txt", "Progress file used to resume", "string");
+        inflags.AddInputFlag("jobs", 'j', "1", "Number of worker processes (Default=1)", "int");
+        inflags.AddInputFlag("devices",
+                             'G',
+                             "",
+                             "Comma-separated device ids assigned to the workers round-robin."
+                             "\nBy default all workers use the default device",
+                             "string");
+        inflags.AddInputFlag("update",
+                             'u',
+                             "0",
+                             "Search again the problems that are already in the perf-db"
+                             "\n(MIOPEN_FIND_ENFORCE=SEARCH_DB_UPDATE) (Default=0)",
+                             "int");
+        inflags.AddInputFlag("dry_run",
+                             'd',
+                             "0",
+                             "Only print the unique problems and the worker commands (Default=0)",
+                             "int");
+    }
+
+    int ParseCmdLineArgs(int argc, char* argv[])
+    {
+        inflags.Parse(argc, argv);
+        input_path = inflags.GetValueStr("input");
+        state_path = inflags.GetValueStr("state");
+        jobs_num   = std::max(inflags.GetValueInt("jobs"), 1);
+        dry_run    = inflags.GetValueInt("dry_run") != 0;
+
+        std::istringstream devices_ss(inflags.GetValueStr("devices"));
+        std::string device;
+        while(std::getline(devices_ss, device, ','))
+            if(!device.empty())
+                devices.push_back(device);
+
+        if(input_path.empty())
+        {
+            std::cout << "Fatal: no input file (-f)" << std::endl;
+            return 1;
+        }
+        return 0;
+    }
+
+    int Run()
+    {
+        const auto commands = ReadDriverCommands(input_path);
+        std::size_t skipped = 0;
+        // Logs repeat the same commands a lot, and each key lookup creates a handle.
+        std::map<std::string, std::vector<std::pair<int, std::string>>> keys_cache;
+
+        for(const auto& command : commands)
+        {
+            const auto text = ToString(command);
+            if(keys_cache.count(text) == 0)
+                keys_cache[text] = GetConvProblemKeys(command);
+            const auto& keys = keys_cache[text];
+            if(keys.empty())
+            {
+                ++skipped;
+                continue;
+            }
+            for(const auto& key : keys)
+            {
+                auto& job = jobs[key.second];
+                if(job.occurrences++ == 0)
+                {
+                    job.key     = key.second;
+                    job.command = MakeTuningCommand(command, key.first);
+                }
+            }
+        }
+
+        const auto done = ReadTuningState(state_path);
+        std::vector<TuningJob*> pending;
+        for(auto& job : jobs)
+            if(done.count(job.first) == 0)
+                pending.push_back(&job.second);
+
+        std::cout << "Tuning campaign: " << commands.size() << " commands, " << skipped
+                  << " not tunable, " << jobs.size() << " unique problems, "
+                  << jobs.size() - pending.size() << " done before, " << pending.size()
+                  << " to search" << std::endl;
+
+        if(dry_run)
+        {
+            for(const auto job : pending)
+                std::cout << job->key << " (x" << job->occurrences
+                          << "): " << ToString(job->command) << std::endl;
+            return 0;
+        }
+
+        return RunWorkers(pending);
+    }
+
+    private:
+    InputFlags inflags;
+    std::string input_path;
+    std::string state_path;
+    int jobs_num = 1;
+    bool dry_run = false;
+    std::vector<std::string> devices;
+    std::map<std::string, TuningJob> jobs;
+
+    pid_t Spawn(TuningJob& job, int slot) const
+    {
+        const auto pid = fork();
+        if(pid != 0)
+            return pid;
+
+        // Worker.
+        const auto log_path = state_path + ".worker" + std::to_string(slot) + ".log";
+        const auto log_fd   = open(log_path.c_str(), O_WRONLY | O_CREAT | O_APPEND, 0644);
+        if(log_fd >= 0)
+        {
+            dup2(log_fd, STDOUT_FILENO);
+            dup2(log_fd, STDERR_FILENO);
+            close(log_fd);
+        }
+
+        if(!devices.empty())
+        {
+            const auto& device = devices[slot % devices.size()];
+            setenv("HIP_VISIBLE_DEVICES", device.c_str(), 1);
+            setenv("GPU_DEVICE_ORDINAL", device.c_str(), 1);
+        }
+        if(inflags.GetValueInt("update") != 0)
+            setenv("MIOPEN_FIND_ENFORCE", "SEARCH_DB_UPDATE", 1);
+        else
+            setenv("MIOPEN_FIND_ENFORCE", "SEARCH", 0);
+
+        auto argv = MakeDriverArgv(job.command);
+        execv("/proc/self/exe", argv.data());
+        std::cerr << "Unable to start worker: " << std::strerror(errno) << std::endl;
+        _exit(127);
+    }
+
+    int RunWorkers(const std::vector<TuningJob*>& pending) const
+    {
+        std::ofstream state(state_path, std::ios::app);
+        if(!state)
+        {
+            std::cout << "Fatal: unable to write " << state_path << std::endl;
+            return 1;
+        }
+
+        struct Running
+        {
+            TuningJob* job;
+            int slot;
+        };
+        std::map<pid_t, Running> running;
+        std::vector<int> free_slots;
+        for(int slot = jobs_num - 1; slot >= 0; --slot)
+            free_slots.push_back(slot);
+
+        std::size_t next = 0, finished = 0, failed = 0;
+        while(next < pending.size() || !running.empty())
+        {
+            while(next < pending.size() && !free_slots.empty())
+            {
+                const auto slot = free_slots.back();
+                const auto pid  = Spawn(*pending[next], slot);
+                if(pid < 0)
+                {
+                    std::cout << "Fatal: fork() failed: " << std::strerror(errno) << std::endl;
+                    break;
+                }
+                free_slots.pop_back();
+                running[pid] = {pending[next++], slot};
+            }
+
+            if(running.empty())
+                return 1;
+
+            int status     = 0;
+            const auto pid = waitpid(-1, &status, 0);
+            if(pid < 0)
+            {
+                if(errno == EINTR)
+                    continue;
+                std::cout << "Fatal: waitpid() failed: " << std::strerror(errno) << std::endl;
+                return 1;
+            }
+            const auto it = running.find(pid);
+            if(it == running.end())
+                continue;
+
+            const bool ok = WIFEXITED(status) && WEXITSTATUS(status) == 0;
+            state << (ok ? "done " : "failed ") << it->second.job->key << std::endl;
+            ++finished;
+            if(!ok)
+                ++failed;
+            std::cout << "[" << finished << "/" << pending.size() << "] "
+                      << (ok ? "done " : "FAILED ") << it->second.job->key << std::endl;
+
+            free_slots.push_back(it->second.slot);
+            running.erase(it);
+        }
+
+        std::cout << "Tuning campaign finished: " << finished - failed << " done, " << failed
+                  << " failed" << std::endl;
+        return failed == 0 ? 0 : 1;
+    }
+};
+
+inline int RunTuningCampaign(int argc, char* argv[])
+{
+    TuningCampaign campaign;
+    campaign.AddCmdLineArgs();
+    const auto rc = campaign.ParseCmdLineArgs(argc, argv);
+    if(rc != 0)
+        return rc;
+    return campaign.Run();
+}
+
+#endif // GUARD_MIOPEN_TUNING_CAMPAIGN_HPP
@@ -227,6 +227,89 @@ MIOPEN_EXPORT miopenStatus_t miopenGetKernelTime(miopenHandle_t handle, float* t
  * @return           miopenStatus_t
 */
 MIOPEN_EXPORT miopenStatus_t miopenEnableProfiling(miopenHandle_t handle, bool enable);
+
+/*! @brief Cancels background compilation of solutions
+ *
+ * Drops the solutions queued by miopenConvolution*CompileSolutionAsync which have not started
+ * compiling yet. Compilations in progress are completed.
+ * @param handle     MIOpen handle (input)
+ * @return           miopenStatus_t
+*/
+MIOPEN_EXPORT miopenStatus_t miopenCancelAsyncCompilation(miopenHandle_t handle);
+
+/*! @brief Loads an ahead-of-time kernel bundle into the handle
+ *
+ * Registers the precompiled kernels of the bundle, so the problems the bundle has been recorded
+ * for run without kernel compilation, the kernel binary cache or a temporary directory.
+ * The bundle must be recorded on the same device, see miopenStartKernelBundleRecording.
+ * @param handle     MIOpen handle (input)
+ * @param path       Path to the kernel bundle file (input)
+ * @return           miopenStatus_t
+*/
+MIOPEN_EXPORT miopenStatus_t miopenLoadKernelBundle(miopenHandle_t handle, const char* path);
+
+/*! @brief Starts recording a kernel bundle
+ *
+ * From now on the kernels built or loaded by all the handles of the process are recorded,
+ * together with their binaries, until miopenWriteKernelBundle is called.
+ * @return           miopenStatus_t
+*/
+MIOPEN_EXPORT miopenStatus_t miopenStartKernelBundleRecording(void);
+
+/*! @brief Stops recording a kernel bundle and writes it to a file
+ *
+ * @param path       Path to the kernel bundle file (input)
+ * @return           miopenStatus_t
+*/
+MIOPEN_EXPORT miopenStatus_t miopenWriteKernelBundle(const char* path);
+
+/*! @brief Sets the workspace budget of the handle
+ *
+ * The budget is the memory the application spends on the workspaces of all the convolutions it
+ * runs on the handle. The workspace size queries never return more than the budget, the immediate
+ * mode solution queries skip solutions that need more, and
+ * miopenPlanConvolutionWorkspace distributes the budget over the layers of a network.
+ * The budget is not limited by default.
+ * @param handle     MIOpen handle (input)
+ * @param budget     Workspace budget in bytes (input)
+ * @return           miopenStatus_t
+*/
+MIOPEN_EXPORT miopenStatus_t miopenSetWorkspaceBudget(miopenHandle_t handle, size_t budget);
+
+/*! @brief Gets the workspace budget of the handle
+ *
+ * @param handle     MIOpen handle (input)
+ * @param budget     Pointer to the workspace budget in bytes (output)
+ * @return           miopenStatus_t
+*/
+MIOPEN_EXPORT miopenStatus_t miopenGetWorkspaceBudget(miopenHandle_t handle, size_t* budget);
+
+/*! @brief Enables or disables the workspace arena of the handle
+ *
+ * When the arena is enabled, the convolution, RNN inference and CTC loss calls that are passed a
+ * null workspace use a buffer owned by the handle instead. If the workspace size passed is zero
+ * as well, the call uses the size returned by the matching workspace size query. The buffer is
+ * reused by the consecutive calls on the handle and grows geometrically, within the workspace
+ * budget of the handle when possible. Disabling the arena releases the buffer.
+ * @param handle     MIOpen handle (input)
+ * @param enable     Boolean to toggle the arena (input)
+ * @return           miopenStatus_t
+*/
+MIOPEN_EXPORT miopenStatus_t miopenEnableWorkspaceArena(miopenHandle_t handle, bool enable);
+
+/*! @brief Gets the statistics of the workspace arena of the handle
+ *
+ * All values are zero if the arena is disabled.
+ * @param handle          MIOpen handle (input)
+ * @param capacity        Size of the buffer of the arena, in bytes (output)
+ * @param highWaterMark   Largest workspace requested from the arena, in bytes (output)
+ * @param allocations     Number of times the buffer has been allocated (output)
+ * @return                miopenStatus_t
+*/
+MIOPEN_EXPORT miopenStatus_t miopenGetWorkspaceArenaStats(miopenHandle_t handle,
+                                                          size_t* capacity,
+                                                          size_t* highWaterMark,
+                                                          size_t* allocations);
 /** @} */
 // CLOSEOUT HANDLE DOXYGEN GROUP
 
@@ -1019,6 +1102,37 @@ miopenConvolutionForwardCompileSolution(miopenHandle_t handle,
                                         const miopenTensorDescriptor_t yDesc,
                                         const uint64_t solution_id);
 
+/*! @brief Compiles the solution in the background
+ *
+ * Same as miopenConvolutionForwardCompileSolution, but does not block. The first call queues the
+ * solution on a pool of compiler threads of the handle and returns. Subsequent calls with the same
+ * arguments report whether the solution is ready, so the application may keep using another
+ * solution, e.g. GEMM, until then. Queued solutions of higher priority are compiled first; calling
+ * again with a higher priority raises the priority of a queued solution. A failed compilation is
+ * reported by the status of the call which finds it finished, and is queued again by the next call.
+ *
+ * The number of compiler threads is set by the MIOPEN_COMPILE_THREADS environment variable.
+ *
+ * @param handle         MIOpen handle (input)
+ * @param wDesc          Tensor descriptor for weight tensor w (input)
+ * @param xDesc          Tensor descriptor for input data tensor x (input)
+ * @param convDesc       Convolution layer descriptor (input)
+ * @param yDesc          Tensor descriptor for output data tensor y (input)
+ * @param solution_id    ID of the solution to be compiled, as chosen by the user
+ * @param priority       Priority of the compilation (input)
+ * @param ready          Set to true once the solution is compiled (output)
+ * @return               miopenStatus_t
+ */
+MIOPEN_EXPORT miopenStatus_t
+miopenConvolutionForwardCompileSolutionAsync(miopenHandle_t handle,
+                                             const miopenTensorDescriptor_t wDesc,
+                                             const miopenTensorDescriptor_t xDesc,
+                                             const miopenConvolutionDescriptor_t convDesc,
+                                             const miopenTensorDescriptor_t yDesc,
+                                             const uint64_t solution_id,
+                                             const int priority,
+                                             bool* ready);
+
 /*! @brief Executes the Forward convolution operation based on the provided solution ID.
  *
  * Supported datatypes are fp32, fp16, bfp16, and int8
@@ -1160,6 +1274,37 @@ miopenConvolutionBackwardDataCompileSolution(miopenHandle_t handle,
                                              const miopenTensorDescriptor_t dxDesc,
                                              const uint64_t solution_id);
 
+/*! @brief Compiles the solution in the background
+ *
+ * Same as miopenConvolutionBackwardDataCompileSolution, but does not block. The first call queues
+ * the solution on a pool of compiler threads of the handle and returns. Subsequent calls with the
+ * same arguments report whether the solution is ready, so the application may keep using another
+ * solution, e.g. GEMM, until then. Queued solutions of higher priority are compiled first; calling
+ * again with a higher priority raises the priority of a queued solution. A failed compilation is
+ * reported by the status of the call which finds it finished, and is queued again by the next call.
+ *
+ * The number of compiler threads is set by the MIOPEN_COMPILE_THREADS environment variable.
+ *
+ * @param handle         MIOpen handle (input)
+ * @param dyDesc         Tensor descriptor for output data tensor dy (input)
+ * @param wDesc          Tensor descriptor for weight tensor w (input)
+ * @param convDesc       Convolution layer descriptor (input)
+ * @param dxDesc         Tensor descriptor for input data tensor dx (input)
+ * @param solution_id    ID of the solution to be compiled, as chosen by the user
+ * @param priority       Priority of the compilation (input)
+ * @param ready          Set to true once the solution is compiled (output)
+ * @return               miopenStatus_t
+ */
+MIOPEN_EXPORT miopenStatus_t
+miopenConvolutionBackwardDataCompileSolutionAsync(miopenHandle_t handle,
+                                                  const miopenTensorDescriptor_t dyDesc,
+                                                  const miopenTensorDescriptor_t wDesc,
+                                                  const miopenConvolutionDescriptor_t convDesc,
+                                                  const miopenTensorDescriptor_t dxDesc,
+                                                  const uint64_t solution_id,
+                                                  const int priority,
+                                                  bool* ready);
+
 /*! @brief Executes the Backward convolution w-r-t data  operation based on the provided solution
  * ID.
  *
@@ -1299,6 +1444,38 @@ miopenConvolutionBackwardWeightsCompileSolution(miopenHandle_t handle,
                                                 const miopenTensorDescriptor_t dwDesc,
                                                 const uint64_t solution_id);
 
+/*! @brief Compiles the solution in the background
+ *
+ * Same as miopenConvolutionBackwardWeightsCompileSolution, but does not block. The first call
+ * queues the solution on a pool of compiler threads of the handle and returns. Subsequent calls
+ * with the same arguments report whether the solution is ready, so the application may keep using
+ * another solution, e.g. GEMM, until then. Queued solutions of higher priority are compiled first;
+ * calling again with a higher priority raises the priority of a queued solution. A failed
+ * compilation is reported by the status of the call which finds it finished, and is queued again by
+ * the next call.
+ *
+ * The number of compiler threads is set by the MIOPEN_COMPILE_THREADS environment variable.
+ *
+ * @param handle         MIOpen handle (input)
+ * @param dyDesc         Tensor descriptor for output data tensor dy (input)
+ * @param xDesc          Tensor descriptor for input data tensor x (input)
+ * @param convDesc       Convolution layer descriptor (input)
+ * @param dwDesc         Tensor descriptor for weight tensor dw (input)
+ * @param solution_id    ID of the solution to be compiled, as chosen by the user
+ * @param priority       Priority of the compilation (input)
+ * @param ready          Set to true once the solution is compiled (output)
+ * @return               miopenStatus_t
+ */
+MIOPEN_EXPORT miopenStatus_t
+miopenConvolutionBackwardWeightsCompileSolutionAsync(miopenHandle_t handle,
+                                                     const miopenTensorDescriptor_t dyDesc,
+                                                     const miopenTensorDescriptor_t xDesc,
+                                                     const miopenConvolutionDescriptor_t convDesc,
+                                                     const miopenTensorDescriptor_t dwDesc,
+                                                     const uint64_t solution_id,
+                                                     const int priority,
+                                                     bool* ready);
+
 /*! @brief Executes the Backward convolution w-r-t weights  operation based on the provided solution
  * ID.
  *
@@ -1330,6 +1507,35 @@ miopenConvolutionBackwardWeightsImmediate(miopenHandle_t handle,
                                           size_t workSpaceSize,
                                           const uint64_t solution_id);
 
+/*! @brief Chooses the solutions of the layers of a network under the workspace budget
+ *
+ * Every layer is given the applicable solutions returned by the immediate mode queries, such as
+ * miopenConvolutionForwardGetSolution. The call picks one solution per layer so that the total
+ * time of the layers is minimal and the sum of their workspaces does not exceed the workspace
+ * budget of the handle, see miopenSetWorkspaceBudget. Solutions with an unknown (negative) time
+ * are counted as taking no time.
+ *
+ * @param handle          MIOpen handle (input)
+ * @param layerCount      Number of layers (input)
+ * @param solutionCounts  Number of solutions of each layer (input)
+ * @param solutions       Solutions of all the layers, one layer after another (input)
+ * @param choices         Index of the chosen solution within the solutions of each layer (output)
+ * @param totalTime       Total time of the chosen solutions, in milliseconds (output)
+ * @param totalWorkspace  Total workspace of the chosen solutions, in bytes (output)
+ * @param timePerMB       Time that one more MB (1048576 bytes) of budget would save, in
+ *                        milliseconds (output)
+ * @return                miopenStatus_t
+ */
+MIOPEN_EXPORT miopenStatus_t
+miopenPlanConvolutionWorkspace(miopenHandle_t handle,
+                               size_t layerCount,
+                               const size_t* solutionCounts,
+                               const miopenConvSolution_t* solutions,
+                               size_t* choices,
+                               float* totalTime,
+                               size_t* totalWorkspace,
+                               float* timePerMB);
+
 /*! @brief Query the workspace size required for a forward convolution layer
  *
  * This call is required and must be executed once before running
@@ -29,6 +29,7 @@
 #include <miopen/errors.hpp>
 #include <miopen/env.hpp>
 #include <miopen/stringutils.hpp>
+#include <miopen/trace.hpp>
 #include <miopen/expanduser.hpp>
 #include <miopen/miopen.h>
 #include <miopen/version.h>
@@ -87,6 +88,7 @@ std::string LoadBinary(const std::string& device,
                        const std::string& args,
                        bool is_kernel_str)
 {
+    MIOPEN_TRACE_SCOPE("binary_cache", "LoadBinary " + name);
     if(miopen::IsCacheDisabled())
         return {};
     auto f = GetCacheFile(device, name, args, is_kernel_str);
@@ -105,6 +107,7 @@ void SaveBinary(const boost::filesystem::path& binary_path,
                 const std::string& args,
                 bool is_kernel_str)
 {
+    MIOPEN_TRACE_SCOPE("binary_cache", "SaveBinary " + name);
     if(miopen::IsCacheDisabled())
     {
         boost::filesystem::remove(binary_path);
@@ -28,32 +28,27 @@
 #include <miopen/env.hpp>
 #include <miopen/handle.hpp>
 #include <miopen/logger.hpp>
+#include <miopen/make_unique.hpp>
 #include <miopen/tensor.hpp>
 
+#include <exception>
+
 namespace miopen {
 
 MIOPEN_DECLARE_ENV_VAR(MIOPEN_CHECK_NUMERICS)
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_CHECK_NUMERICS_RING_SIZE)
 
 bool CheckNumericsEnabled(const int bitMask)
 {
     return (miopen::Value(MIOPEN_CHECK_NUMERICS{}) & bitMask) != 0;
 }
 
-// Must keep this structure synchronized with one in MIOpenCheckNumerics
-struct CheckNumericsResult
-{
-    float sum    = 0.0f;
-    float absSum = 0.0f;
-    float min    = 0.0f;
-    float max    = 0.0f;
-
-    int hasZero = 0;
-    int hasNan  = 0;
-    int hasInf  = 0;
-};
-
-bool checkNumericsImpl(
-    Handle& handle, int mode, const TensorDescriptor& dDesc, ConstData_t data, bool isInput)
+static void LaunchCheckNumerics(Handle& handle,
+                                int mode,
+                                const TensorDescriptor& dDesc,
+                                ConstData_t data,
+                                Data_t results,
+                                int resultIndex)
 {
     int numElements = dDesc.GetElementSize();
 
@@ -64,27 +59,31 @@ bool checkNumericsImpl(
 
     const int computeStats = (mode & CheckNumerics::ComputeStats);
 
-    CheckNumericsResult abnormal_h;
-
-    auto abnormal_d =
-        handle.Create(sizeof(CheckNumericsResult)); // TODO - someday avoid slow malloc/free here
-    handle.WriteTo(&abnormal_h, abnormal_d, sizeof(CheckNumericsResult));
-
     std::string program_name      = "MIOpenCheckNumerics.cl";
     std::string kernel_name       = "MIOpenCheckNumerics";
     const std::vector<size_t> vld = {size_t{blockSize}, size_t{1}, size_t{1}};
     const std::vector<size_t> vgd = {numGlobalWorkItems, size_t{1}, size_t{1}};
     handle.AddKernel("MIOpenCheckNumerics", "", program_name, kernel_name, vld, vgd, "")(
-        data, numElements, abnormal_d.get(), computeStats);
-
-    handle.ReadTo(&abnormal_h, abnormal_d, sizeof(CheckNumericsResult));
+        data, numElements, results, computeStats, resultIndex);
+}
 
-    bool isAbnormal = (abnormal_h.hasNan != 0) || (abnormal_h.hasInf != 0);
+// Logs the result according to the mode, returns true if it is abnormal.
+static bool ReportCheckNumerics(int mode,
+                                const CheckNumericsResult& abnormal_h,
+                                const TensorDescriptor& dDesc,
+                                ConstData_t data,
+                                bool isInput,
+                                const char* call)
+{
+    const int numElements = dDesc.GetElementSize();
+    bool isAbnormal       = (abnormal_h.hasNan != 0) || (abnormal_h.hasInf != 0);
 
     if(((mode & CheckNumerics::Info) != 0) || (((mode & CheckNumerics::Warn) != 0) && isAbnormal))
     {
         MIOPEN_LOG((isAbnormal ? miopen::LoggingLevel::Warning : miopen::LoggingLevel::Info),
-                   (isInput ? "INPUT " : "OUTPUT") << " ptr=" << data << " zeros="
+                   (isInput ? "INPUT " : "OUTPUT") << " ptr=" << data << " call="
+                                                   << (call != nullptr ? call : "?")
+                                                   << " zeros="
                                                    << abnormal_h.hasZero
                                                    << " nans="
                                                    << abnormal_h.hasNan
@@ -93,7 +92,7 @@ bool checkNumericsImpl(
                                                    << "  {"
                                                    << dDesc
                                                    << "}");
-        if(computeStats != 0)
+        if((mode & CheckNumerics::ComputeStats) != 0)
         {
             assert(numElements != 0);
             MIOPEN_LOG((isAbnormal ? miopen::LoggingLevel::Warning : miopen::LoggingLevel::Info),
@@ -105,34 +104,148 @@ bool checkNumericsImpl(
                                       << abnormal_h.max);
         }
     }
+    return isAbnormal;
+}
 
-    if(isAbnormal)
+static void FailCheckNumerics(int mode, bool isInput, const char* call)
+{
+    if((mode & CheckNumerics::Throw) != 0)
     {
+        const std::string where = call != nullptr ? std::string(" in ") + call : "";
+        if(isInput)
+        {
+            MIOPEN_THROW(miopenStatusInternalError,
+                         "abnormal checkNumerics result detected on INPUT" + where);
+        }
+        else
+        {
+            MIOPEN_THROW(miopenStatusInternalError,
+                         "abnormal checkNumerics result detected on OUTPUT" + where);
+        }
+    }
+    if((mode & CheckNumerics::Abort) != 0)
+    {
+        abort();
+    }
+}
 
-        if((mode & CheckNumerics::Throw) != 0)
+CheckNumericsRing::CheckNumericsRing(Handle& handle, std::size_t size)
+    : results(handle.Create(size * sizeof(CheckNumericsResult))), host_results(size)
+{
+    queued.reserve(size);
+    handle.WriteTo(host_results.data(), results, size * sizeof(CheckNumericsResult));
+}
+
+void CheckNumericsRing::Queue(
+    Handle& handle, int mode, const TensorDescriptor& dDesc, ConstData_t data, bool isInput)
+{
+    // The check is queued even when draining the full ring fails on an earlier one, so the
+    // abnormal values of this call are still reported.
+    auto drain_error = std::exception_ptr{};
+    if(queued.size() == host_results.size())
+    {
+        try
         {
-            if(isInput)
-            {
-                MIOPEN_THROW(miopenStatusInternalError,
-                             "abnormal checkNumerics result detected on INPUT");
-            }
-            else
-            {
-                MIOPEN_THROW(miopenStatusInternalError,
-                             "abnormal checkNumerics result detected on OUTPUT");
-            }
+            Drain(handle, mode);
         }
-        if((mode & CheckNumerics::Abort) != 0)
+        catch(...)
         {
-            abort();
+            if(queued.size() == host_results.size())
+                throw;
+            drain_error = std::current_exception();
         }
     }
 
+    const auto index = queued.size();
+    queued.push_back({GetCurrentApiCall(), isInput, data, dDesc});
+    LaunchCheckNumerics(handle, mode, dDesc, data, results.get(), static_cast<int>(index));
+    if(drain_error)
+        std::rethrow_exception(drain_error);
+}
+
+bool CheckNumericsRing::Drain(Handle& handle, int mode)
+{
+    if(queued.empty())
+        return false;
+
+    const auto size = queued.size() * sizeof(CheckNumericsResult);
+    handle.ReadTo(host_results.data(), results, size);
+
+    // Report everything first, then fail on the first abnormal check.
+    const Check* first_abnormal = nullptr;
+    for(std::size_t i = 0; i < queued.size(); ++i)
+    {
+        const auto& check = queued[i];
+        if(ReportCheckNumerics(
+               mode, host_results[i], check.desc, check.data, check.isInput, check.call) &&
+           first_abnormal == nullptr)
+            first_abnormal = &check;
+    }
+
+    std::fill(host_results.begin(), host_results.end(), CheckNumericsResult{});
+    handle.WriteTo(host_results.data(), results, size);
+
+    if(first_abnormal == nullptr)
+    {
+        queued.clear();
+        return false;
+    }
+    const auto isInput = first_abnormal->isInput;
+    const auto call    = first_abnormal->call;
+    queued.clear();
+    FailCheckNumerics(mode, isInput, call);
+    return true;
+}
+
+static CheckNumericsRing& GetCheckNumericsRing(Handle& handle)
+{
+    if(handle.check_numerics_ring == nullptr)
+    {
+        const auto size = miopen::Value(MIOPEN_CHECK_NUMERICS_RING_SIZE{});
+        handle.check_numerics_ring =
+            make_unique<CheckNumericsRing>(handle, size != 0 ? size : 256);
+    }
+    return *handle.check_numerics_ring;
+}
+
+bool flushCheckNumerics(Handle& handle)
+{
+    if(handle.check_numerics_ring == nullptr)
+        return false;
+    return handle.check_numerics_ring->Drain(
+        handle, static_cast<int>(miopen::Value(MIOPEN_CHECK_NUMERICS{})));
+}
+
+bool checkNumericsImpl(
+    Handle& handle, int mode, const TensorDescriptor& dDesc, ConstData_t data, bool isInput)
+{
+    if((mode & CheckNumerics::Deferred) != 0)
+    {
+        GetCheckNumericsRing(handle).Queue(handle, mode, dDesc, data, isInput);
+        return false;
+    }
+
+    CheckNumericsResult abnormal_h;
+
+    auto abnormal_d =
+        handle.Create(sizeof(CheckNumericsResult)); // TODO - someday avoid slow malloc/free here
+    handle.WriteTo(&abnormal_h, abnormal_d, sizeof(CheckNumericsResult));
+
+    LaunchCheckNumerics(handle, mode, dDesc, data, abnormal_d.get(), 0);
+
+    handle.ReadTo(&abnormal_h, abnormal_d, sizeof(CheckNumericsResult));
+
+    const auto call       = GetCurrentApiCall();
+    const bool isAbnormal = ReportCheckNumerics(mode, abnormal_h, dDesc, data, isInput, call);
+    if(isAbnormal)
+        FailCheckNumerics(mode, isInput, call);
+
     return isAbnormal;
 };
 
 // Checks data for input
-// Returns: 1 if abnormal value (inf or nan) detected in specified data, 0 otherwise
+// Returns: 1 if abnormal value (inf or nan) detected in specified data, 0 otherwise.
+// Deferred checks always return 0, abnormal values are reported later.
 bool checkNumericsInput(Handle& handle, const TensorDescriptor& dDesc, ConstData_t data)
 {
     return checkNumericsImpl(
@@ -141,12 +254,14 @@ bool checkNumericsInput(Handle& handle, const TensorDescriptor& dDesc, ConstData
 
 // Synchronizes to wait for kernel to finish, then checks data for output:
 // Returns: 1 if abnormal value (inf or nan) detected in specified data, 0 otherwise
+// Deferred checks are queued after the kernel on the same stream, so these do not synchronize.
 bool checkNumericsOutput(Handle& handle, const TensorDescriptor& dDesc, ConstData_t data)
 {
-    handle.Finish();
+    const auto mode = static_cast<int>(miopen::Value(MIOPEN_CHECK_NUMERICS{}));
+    if((mode & CheckNumerics::Deferred) == 0)
+        handle.Finish();
 
-    return checkNumericsImpl(
-        handle, static_cast<int>(miopen::Value(MIOPEN_CHECK_NUMERICS{})), dDesc, data, false);
+    return checkNumericsImpl(handle, mode, dDesc, data, false);
 }
 
 } // namespace miopen
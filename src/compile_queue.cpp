@@ -0,0 +1,161 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2019 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/compile_queue.hpp>
+#include <miopen/env.hpp>
+#include <miopen/errors.hpp>
+#include <miopen/handle.hpp>
+#include <miopen/logger.hpp>
+#include <miopen/make_unique.hpp>
+
+#include <algorithm>
+
+namespace miopen {
+
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_COMPILE_THREADS)
+
+CompileQueue::CompileQueue(std::size_t threads_num)
+{
+    threads.reserve(threads_num);
+    for(std::size_t i = 0; i < threads_num; ++i)
+        threads.emplace_back([this] { Work(); });
+}
+
+CompileQueue::~CompileQueue()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+        CancelPendingUnsafe();
+    }
+    queued.notify_all();
+    for(auto& thread : threads)
+        thread.join();
+}
+
+std::shared_future<void> CompileQueue::Enqueue(const std::string& key, int priority, Job job)
+{
+    std::unique_lock<std::mutex> lock(mutex);
+
+    const auto found = results.find(key);
+    if(found != results.end())
+    {
+        auto result = found->second;
+        if(result.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
+        {
+            try
+            {
+                result.get();
+            }
+            catch(...)
+            {
+                results.erase(found);
+            }
+            return result;
+        }
+
+        const auto task = std::find_if(
+            pending.begin(), pending.end(), [&](const auto& t) { return t->key == key; });
+        if(task != pending.end())
+            (*task)->priority = std::max((*task)->priority, priority);
+        return result;
+    }
+
+    auto task      = make_unique<Task>();
+    task->key      = key;
+    task->priority = priority;
+    task->order    = enqueued++;
+    task->job      = std::move(job);
+    auto result    = task->promise.get_future().share();
+    results.emplace(key, result);
+    pending.push_back(std::move(task));
+    lock.unlock();
+    queued.notify_one();
+    return result;
+}
+
+void CompileQueue::CancelPending()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    CancelPendingUnsafe();
+}
+
+void CompileQueue::CancelPendingUnsafe()
+{
+    for(auto& task : pending)
+    {
+        MIOPEN_LOG_I2("Cancelled: " << task->key);
+        task->promise.set_exception(std::make_exception_ptr(
+            Exception(miopenStatusUnknownError, "Compilation cancelled: " + task->key)));
+    }
+    pending.clear();
+}
+
+void CompileQueue::Work()
+{
+    for(;;)
+    {
+        std::unique_ptr<Task> task;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            queued.wait(lock, [&] { return stopping || !pending.empty(); });
+            if(stopping)
+                return;
+            const auto next = std::max_element(
+                pending.begin(), pending.end(), [](const auto& left, const auto& right) {
+                    return left->priority < right->priority ||
+                           (left->priority == right->priority && left->order > right->order);
+                });
+            task = std::move(*next);
+            pending.erase(next);
+        }
+
+        MIOPEN_LOG_I2("Compiling: " << task->key);
+        try
+        {
+            task->job();
+            task->promise.set_value();
+        }
+        catch(...)
+        {
+            task->promise.set_exception(std::current_exception());
+        }
+    }
+}
+
+CompileQueue& GetCompileQueue(Handle& handle)
+{
+    if(handle.compile_queue == nullptr)
+    {
+        const auto threads_num = Value(MIOPEN_COMPILE_THREADS{});
+        handle.compile_queue   = make_unique<CompileQueue>(
+            threads_num != 0 ? threads_num
+                             : std::max<std::size_t>(1, std::thread::hardware_concurrency() / 2));
+    }
+    return *handle.compile_queue;
+}
+
+} // namespace miopen
@@ -40,6 +40,7 @@
 #include <cstddef>
 #include <algorithm>
 #include <cmath>
+#include <limits>
 #include <ostream>
 
 #include <boost/range/combine.hpp>
@@ -48,6 +49,7 @@
 MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_CONV_DIRECT)
 MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_CONV_IMPLICIT_GEMM)
 MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_CONV_SCGEMM)
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_CONV_GEMM_CHUNKED)
 
 // Workaround for issue 1430.
 // Vega20 fails to access GPU memory larger than the return value of GetMaxMemoryAllocSize() of
@@ -292,6 +294,98 @@ std::size_t ConvolutionDescriptor::ForwardGetWorkSpaceSizeGEMM(const TensorDescr
     return (wDesc.GetType() == miopenInt8 ? 2 * workspace_size : workspace_size);
 }
 
+std::size_t
+ConvolutionDescriptor::ForwardGetWorkSpaceSizeGEMMChunk(const TensorDescriptor& wDesc,
+                                                        const TensorDescriptor& yDesc) const
+{
+    // Columns of a chunk are im2col'ed into sub-buffers, whose origins have to be aligned to
+    // CL_DEVICE_MEM_BASE_ADDR_ALIGN under OpenCL. A page is enough for all supported devices.
+    const std::size_t alignment = 4096;
+    const std::size_t column    = ForwardGetWorkSpaceSizeGEMM(wDesc, yDesc);
+    return (column + alignment - 1) / alignment * alignment;
+}
+
+std::size_t
+ConvolutionDescriptor::ForwardGetWorkSpaceSizeGEMMIm2Col(Handle& handle,
+                                                         const TensorDescriptor& wDesc,
+                                                         const TensorDescriptor& xDesc,
+                                                         const TensorDescriptor& yDesc) const
+{
+    std::size_t workspace_size = ForwardGetWorkSpaceSizeGEMM(wDesc, yDesc) * group_count;
+    // Under a workspace budget, ask for as many im2col columns as the budget holds, so that
+    // the non-1x1 path multiplies a chunk of images per GEMM call. The chunk is capped by what
+    // can be allocated, so a large budget does not end in no GEMM workspace at all.
+    if(handle.workspace_budget != std::numeric_limits<std::size_t>::max())
+    {
+        const std::size_t column = ForwardGetWorkSpaceSizeGEMMChunk(wDesc, yDesc);
+        const auto chunk =
+            std::min(ForwardGetGEMMChunkSize(wDesc, xDesc, yDesc, handle.workspace_budget),
+                     column != 0 ? MAX_MEM_ALLOC_SZ / column : std::size_t{1});
+        if(chunk > 1)
+            workspace_size = chunk * column;
+    }
+    /// \todo WORKAROUND for issue 1430
+    if(workspace_size > MAX_MEM_ALLOC_SZ /* handle.GetMaxMemoryAllocSize() */)
+        workspace_size = 0;
+    return workspace_size;
+}
+
+std::size_t ConvolutionDescriptor::ForwardGetGEMMChunkSize(const TensorDescriptor& wDesc,
+                                                           const TensorDescriptor& xDesc,
+                                                           const TensorDescriptor& yDesc,
+                                                           std::size_t workSpaceSize) const
+{
+    // Int8 transposes every column in place, grouped convolutions already batch over groups.
+    if(miopen::IsDisabled(MIOPEN_DEBUG_CONV_GEMM_CHUNKED{}) || group_count > 1 ||
+       wDesc.GetType() == miopenInt8 || wDesc.GetType() == miopenInt8x4)
+        return 1;
+
+    const std::size_t column = ForwardGetWorkSpaceSizeGEMMChunk(wDesc, yDesc);
+    if(column == 0)
+        return 1;
+
+    return std::max<std::size_t>(1, std::min(xDesc.GetLengths()[0], workSpaceSize / column));
+}
+
+bool ConvolutionDescriptor::IsGemmNHWCFwd(const TensorDescriptor& xDesc,
+                                          const TensorDescriptor& wDesc,
+                                          const TensorDescriptor& yDesc) const
+{
+    const std::size_t spatial_dim = GetSpatialDimension();
+    const std::string labels      = spatial_dim == 3 ? "NCDHW" : "NCHW";
+    const std::string layout      = spatial_dim == 3 ? "NDHWC" : "NHWC";
+
+    if(group_count != 1 || wDesc.GetType() == miopenInt8 || wDesc.GetType() == miopenInt8x4 ||
+       !xDesc.IsPacked() || !wDesc.IsPacked() || !yDesc.IsPacked() ||
+       !xDesc.FitsLayout(labels, layout) || !wDesc.FitsLayout(labels, layout) ||
+       !yDesc.FitsLayout(labels, layout))
+        return false;
+
+    // y[NHW x K] = x[NHW x C] * transpose(w[K x C])
+    const auto wei_spatial = boost::adaptors::slice(wDesc.GetLengths(), 2, 2 + spatial_dim);
+    return miopen::all_of(wei_spatial, [](auto v) { return v == 1; }) &&
+           miopen::all_of(GetConvPads(), [](auto v) { return v == 0; }) &&
+           miopen::all_of(GetConvStrides(), [](auto v) { return v == 1; });
+}
+
+bool ConvolutionDescriptor::IsGemmTransposeFwd(const TensorDescriptor& xDesc,
+                                               const TensorDescriptor& wDesc) const
+{
+    if(GetSpatialDimension() != 2)
+        return false;
+
+    const auto wei_spatial = boost::adaptors::slice(wDesc.GetLengths(), 2, 4);
+    const auto in_spatial  = boost::adaptors::slice(xDesc.GetLengths(), 2, 4);
+
+    // Use transpose path if input ht and width <= 14 for 1x1_stride=1 convolutions OR for
+    // 1x1_stride=2
+    return miopen::all_of(wei_spatial, [](auto v) { return v == 1; }) &&
+           miopen::all_of(GetConvPads(), [](auto v) { return v == 0; }) &&
+           ((miopen::all_of(in_spatial, [](auto v) { return v <= 14; }) &&
+             miopen::all_of(GetConvStrides(), [](auto v) { return v == 1; })) ||
+            miopen::all_of(GetConvStrides(), [](auto v) { return v == 2; }));
+}
+
 std::size_t
 ConvolutionDescriptor::ForwardGetWorkSpaceSizeGEMMTranspose(const TensorDescriptor& xDesc,
                                                             const TensorDescriptor& yDesc) const
@@ -340,18 +434,11 @@ ConvolutionDescriptor::ForwardGetValidWorkSpaceSizeGemm(Handle& handle,
 {
 
 #if MIOPEN_USE_GEMM
-    const std::size_t spatial_dim = GetSpatialDimension();
-    auto wei_spatial              = boost::adaptors::slice(wDesc.GetLengths(), 2, 2 + spatial_dim);
-    auto in_spatial               = boost::adaptors::slice(xDesc.GetLengths(), 2, 2 + spatial_dim);
+    // Channels-last 1x1 convolutions are a single GEMM over the tensors themselves.
+    if(!xDesc.IsDefaultLayout() && IsGemmNHWCFwd(xDesc, wDesc, yDesc))
+        return 0;
 
-    // Use transpose path if input ht and width <= 14 for 1x1_stride=1 convolutions OR for
-    // 1x1_stride=2
-    if(GetSpatialDimension() == 2 &&
-       (miopen::all_of(wei_spatial, [](auto v) { return v == 1; }) &&
-        miopen::all_of(GetConvPads(), [](auto v) { return v == 0; })) &&
-       ((miopen::all_of(in_spatial, [](auto v) { return v <= 14; }) &&
-         miopen::all_of(GetConvStrides(), [](auto v) { return v == 1; })) ||
-        miopen::all_of(GetConvStrides(), [](auto v) { return v == 2; })))
+    if(IsGemmTransposeFwd(xDesc, wDesc))
     {
         size_t gemm_trans = ForwardGetWorkSpaceSizeGEMMTranspose(xDesc, yDesc);
         /// \todo WORKAROUND for issue 1430
@@ -360,12 +447,7 @@ ConvolutionDescriptor::ForwardGetValidWorkSpaceSizeGemm(Handle& handle,
         return gemm_trans;
     }
 
-    size_t workspace_size_gemm = ForwardGetWorkSpaceSizeGEMM(wDesc, yDesc) * group_count;
-    /// \todo WORKAROUND for issue 1430
-    if(workspace_size_gemm > MAX_MEM_ALLOC_SZ /* handle.GetMaxMemoryAllocSize() */)
-        workspace_size_gemm = 0;
-
-    return workspace_size_gemm;
+    return ForwardGetWorkSpaceSizeGEMMIm2Col(handle, wDesc, xDesc, yDesc);
 #else
     (void)handle;
     (void)wDesc;
@@ -428,23 +510,12 @@ std::size_t ConvolutionDescriptor::ForwardGetWorkSpaceSize(Handle& handle,
     const size_t workspace_size_scgemm = ForwardBackwardDataGetWorkSpaceSizeSCGemm(handle, ctx);
 
 #if MIOPEN_USE_GEMM
-    const std::size_t spatial_dim = GetSpatialDimension();
-    const auto wei_spatial        = boost::adaptors::slice(wDesc.GetLengths(), 2, 2 + spatial_dim);
-    const auto in_spatial         = boost::adaptors::slice(xDesc.GetLengths(), 2, 2 + spatial_dim);
+    if(!xDesc.IsDefaultLayout() && IsGemmNHWCFwd(xDesc, wDesc, yDesc))
+        return std::max({direct_workspace, implicit_gemm_workspace, workspace_size_scgemm});
 
-    size_t workspace_size_gemm = ForwardGetWorkSpaceSizeGEMM(wDesc, yDesc) * group_count;
-    /// \todo WORKAROUND for issue 1430
-    if(workspace_size_gemm > MAX_MEM_ALLOC_SZ /* handle.GetMaxMemoryAllocSize() */)
-        workspace_size_gemm = 0;
+    size_t workspace_size_gemm = ForwardGetWorkSpaceSizeGEMMIm2Col(handle, wDesc, xDesc, yDesc);
 
-    // Use transpose path if input ht and width <= 14 for 1x1_stride=1 convolutions OR for
-    // 1x1_stride=2
-    if(GetSpatialDimension() == 2 &&
-       (miopen::all_of(wei_spatial, [](auto v) { return v == 1; }) &&
-        miopen::all_of(GetConvPads(), [](auto v) { return v == 0; })) &&
-       ((miopen::all_of(in_spatial, [](auto v) { return v <= 14; }) &&
-         miopen::all_of(GetConvStrides(), [](auto v) { return v == 1; })) ||
-        miopen::all_of(GetConvStrides(), [](auto v) { return v == 2; })))
+    if(IsGemmTransposeFwd(xDesc, wDesc))
     {
         size_t gemm_trans = ForwardGetWorkSpaceSizeGEMMTranspose(xDesc, yDesc);
         /// \todo WORKAROUND for issue 1430
@@ -791,6 +862,16 @@ ConvolutionDescriptor::BackwardWeightsGetWorkSpaceSize(Handle& handle,
     return workspace_size;
 }
 
+std::ostream& operator<<(std::ostream& stream, ConvLayout layout)
+{
+    switch(layout)
+    {
+    case ConvLayout::NCHW: return stream << "NCHW";
+    case ConvLayout::CNHW: return stream << "CNHW";
+    }
+    return stream;
+}
+
 std::ostream& operator<<(std::ostream& stream, const ConvolutionDescriptor& c)
 {
     stream << "conv" << c.spatialDim << "d, ";
@@ -28,6 +28,8 @@
 #include <miopen/handle.hpp>
 #include <miopen/logger.hpp>
 #include <miopen/tensor_ops.hpp>
+#include <miopen/workspace_arena.hpp>
+#include <miopen/workspace_planner.hpp>
 #include <algorithm>
 
 // TODO: Make miopenConvAlgoPerf_t loggable
@@ -224,6 +226,13 @@ extern "C" miopenStatus_t miopenDestroyConvolutionDescriptor(miopenConvolutionDe
     return miopen::try_([&] { miopen_destroy_object(convDesc); });
 }
 
+/// Find picks the fastest solution that fits into the workspace it is given, so Find keeps to the
+/// budget when the application allocates the workspace it is told.
+static void ApplyWorkspaceBudget(miopenHandle_t handle, size_t* workSpaceSize)
+{
+    *workSpaceSize = std::min(*workSpaceSize, miopen::deref(handle).workspace_budget);
+}
+
 extern "C" miopenStatus_t
 miopenConvolutionForwardGetWorkSpaceSize(miopenHandle_t handle,
                                          const miopenTensorDescriptor_t wDesc,
@@ -245,6 +254,7 @@ miopenConvolutionForwardGetWorkSpaceSize(miopenHandle_t handle,
                                                                   miopen::deref(wDesc),
                                                                   miopen::deref(xDesc),
                                                                   miopen::deref(yDesc));
+        ApplyWorkspaceBudget(handle, workSpaceSize);
     });
 
     return (miopenStatusSuccess);
@@ -308,6 +318,23 @@ static void LogCmdConvolution(const miopenTensorDescriptor_t xDesc,
     }
 }
 
+/// Lets the workspace arena of the handle provide the workspace of a call, see
+/// miopenEnableWorkspaceArena(). query is the workspace size query of the call.
+template <class F>
+static miopenStatus_t
+UseWorkspaceArena(miopenHandle_t handle, void*& workSpace, size_t& workSpaceSize, F query)
+{
+    return miopen::try_([&] {
+        miopen::UseWorkspaceArena(miopen::deref(handle), workSpace, workSpaceSize, [&] {
+            size_t size       = 0;
+            const auto status = query(&size);
+            if(status != miopenStatusSuccess)
+                MIOPEN_THROW(status, "Unable to query the workspace size");
+            return size;
+        });
+    });
+}
+
 extern "C" miopenStatus_t
 miopenFindConvolutionForwardAlgorithm(miopenHandle_t handle,
                                       const miopenTensorDescriptor_t xDesc,
@@ -340,6 +367,13 @@ miopenFindConvolutionForwardAlgorithm(miopenHandle_t handle,
                         workSpaceSize,
                         exhaustiveSearch);
 
+    const auto status = UseWorkspaceArena(handle, workSpace, workSpaceSize, [&](size_t* size) {
+        return miopenConvolutionForwardGetWorkSpaceSize(
+            handle, wDesc, xDesc, convDesc, yDesc, size);
+    });
+    if(status != miopenStatusSuccess)
+        return status;
+
     /// workaround for previous trans conv logic
     if(miopen::deref(convDesc).mode == miopenTranspose)
         return miopen::try_([&] {
@@ -412,6 +446,13 @@ extern "C" miopenStatus_t miopenConvolutionForward(miopenHandle_t handle,
                         workSpaceSize);
     LogCmdConvolution(xDesc, wDesc, convDesc, ConvDirection::Fwd, false);
 
+    const auto status = UseWorkspaceArena(handle, workSpace, workSpaceSize, [&](size_t* size) {
+        return miopenConvolutionForwardGetWorkSpaceSize(
+            handle, wDesc, xDesc, convDesc, yDesc, size);
+    });
+    if(status != miopenStatusSuccess)
+        return status;
+
     /// workaround for previous trans conv logic
     if(miopen::deref(convDesc).mode == miopenTranspose)
         return miopen::try_([&] {
@@ -587,6 +628,36 @@ miopenConvolutionForwardCompileSolution(miopenHandle_t handle,
     });
 }
 
+extern "C" miopenStatus_t
+miopenConvolutionForwardCompileSolutionAsync(miopenHandle_t handle,
+                                             const miopenTensorDescriptor_t wDesc,
+                                             const miopenTensorDescriptor_t xDesc,
+                                             const miopenConvolutionDescriptor_t convDesc,
+                                             const miopenTensorDescriptor_t yDesc,
+                                             const uint64_t solution_id,
+                                             const int priority,
+                                             bool* ready)
+{
+    MIOPEN_LOG_FUNCTION(handle, wDesc, xDesc, convDesc, yDesc, solution_id, priority);
+    return miopen::try_([&] {
+        auto& ready_ = miopen::deref(ready);
+        if(miopen::deref(convDesc).mode == miopenTranspose)
+            ready_ = miopen::deref(convDesc).CompileBackwardSolutionAsync(miopen::deref(handle),
+                                                                          miopen::deref(xDesc),
+                                                                          miopen::deref(wDesc),
+                                                                          miopen::deref(yDesc),
+                                                                          solution_id,
+                                                                          priority);
+        else
+            ready_ = miopen::deref(convDesc).CompileForwardSolutionAsync(miopen::deref(handle),
+                                                                         miopen::deref(wDesc),
+                                                                         miopen::deref(xDesc),
+                                                                         miopen::deref(yDesc),
+                                                                         solution_id,
+                                                                         priority);
+    });
+}
+
 extern "C" miopenStatus_t
 miopenConvolutionForwardImmediate(miopenHandle_t handle,
                                   const miopenTensorDescriptor_t wDesc,
@@ -604,6 +675,13 @@ miopenConvolutionForwardImmediate(miopenHandle_t handle,
         handle, wDesc, w, xDesc, x, convDesc, yDesc, y, workSpace, workSpaceSize, solution_id);
     LogCmdConvolution(xDesc, wDesc, convDesc, ConvDirection::Fwd, true);
 
+    const auto status = UseWorkspaceArena(handle, workSpace, workSpaceSize, [&](size_t* size) {
+        return miopenConvolutionForwardGetSolutionWorkspaceSize(
+            handle, wDesc, xDesc, convDesc, yDesc, solution_id, size);
+    });
+    if(status != miopenStatusSuccess)
+        return status;
+
     return miopen::try_([&] {
         if(miopen::deref(convDesc).mode == miopenTranspose)
             miopen::deref(convDesc).ConvolutionBackwardImmediate(miopen::deref(handle),
@@ -739,6 +817,36 @@ miopenConvolutionBackwardDataCompileSolution(miopenHandle_t handle,
     });
 }
 
+extern "C" miopenStatus_t
+miopenConvolutionBackwardDataCompileSolutionAsync(miopenHandle_t handle,
+                                                  const miopenTensorDescriptor_t dyDesc,
+                                                  const miopenTensorDescriptor_t wDesc,
+                                                  const miopenConvolutionDescriptor_t convDesc,
+                                                  const miopenTensorDescriptor_t dxDesc,
+                                                  const uint64_t solution_id,
+                                                  const int priority,
+                                                  bool* ready)
+{
+    MIOPEN_LOG_FUNCTION(handle, dyDesc, wDesc, convDesc, dxDesc, solution_id, priority);
+    return miopen::try_([&] {
+        auto& ready_ = miopen::deref(ready);
+        if(miopen::deref(convDesc).mode == miopenTranspose)
+            ready_ = miopen::deref(convDesc).CompileForwardSolutionAsync(miopen::deref(handle),
+                                                                         miopen::deref(wDesc),
+                                                                         miopen::deref(dyDesc),
+                                                                         miopen::deref(dxDesc),
+                                                                         solution_id,
+                                                                         priority);
+        else
+            ready_ = miopen::deref(convDesc).CompileBackwardSolutionAsync(miopen::deref(handle),
+                                                                          miopen::deref(dyDesc),
+                                                                          miopen::deref(wDesc),
+                                                                          miopen::deref(dxDesc),
+                                                                          solution_id,
+                                                                          priority);
+    });
+}
+
 extern "C" miopenStatus_t
 miopenConvolutionBackwardDataImmediate(miopenHandle_t handle,
                                        const miopenTensorDescriptor_t dyDesc,
@@ -755,6 +863,13 @@ miopenConvolutionBackwardDataImmediate(miopenHandle_t handle,
     MIOPEN_LOG_FUNCTION(
         handle, dyDesc, wDesc, convDesc, dxDesc, workSpace, workSpaceSize, solution_id);
     LogCmdConvolution(dxDesc, wDesc, convDesc, ConvDirection::Bwd, true);
+
+    const auto status = UseWorkspaceArena(handle, workSpace, workSpaceSize, [&](size_t* size) {
+        return miopenConvolutionBackwardDataGetSolutionWorkspaceSize(
+            handle, dyDesc, wDesc, convDesc, dxDesc, solution_id, size);
+    });
+    if(status != miopenStatusSuccess)
+        return status;
     return miopen::try_([&] {
         if(miopen::deref(convDesc).mode == miopenTranspose)
             miopen::deref(convDesc).ConvolutionForwardImmediate(miopen::deref(handle),
@@ -887,6 +1002,36 @@ miopenConvolutionBackwardWeightsCompileSolution(miopenHandle_t handle,
     });
 }
 
+extern "C" miopenStatus_t
+miopenConvolutionBackwardWeightsCompileSolutionAsync(miopenHandle_t handle,
+                                                     const miopenTensorDescriptor_t dyDesc,
+                                                     const miopenTensorDescriptor_t xDesc,
+                                                     const miopenConvolutionDescriptor_t convDesc,
+                                                     const miopenTensorDescriptor_t dwDesc,
+                                                     const uint64_t solution_id,
+                                                     const int priority,
+                                                     bool* ready)
+{
+    MIOPEN_LOG_FUNCTION(handle, dyDesc, xDesc, convDesc, dwDesc, solution_id, priority);
+    return miopen::try_([&] {
+        auto& ready_ = miopen::deref(ready);
+        if(miopen::deref(convDesc).mode == miopenTranspose)
+            ready_ = miopen::deref(convDesc).CompileWrwSolutionAsync(miopen::deref(handle),
+                                                                     miopen::deref(xDesc),
+                                                                     miopen::deref(dyDesc),
+                                                                     miopen::deref(dwDesc),
+                                                                     solution_id,
+                                                                     priority);
+        else
+            ready_ = miopen::deref(convDesc).CompileWrwSolutionAsync(miopen::deref(handle),
+                                                                     miopen::deref(dyDesc),
+                                                                     miopen::deref(xDesc),
+                                                                     miopen::deref(dwDesc),
+                                                                     solution_id,
+                                                                     priority);
+    });
+}
+
 extern "C" miopenStatus_t
 miopenConvolutionBackwardWeightsImmediate(miopenHandle_t handle,
                                           const miopenTensorDescriptor_t dyDesc,
@@ -903,6 +1048,13 @@ miopenConvolutionBackwardWeightsImmediate(miopenHandle_t handle,
     MIOPEN_LOG_FUNCTION(
         handle, dyDesc, dy, xDesc, x, convDesc, dwDesc, dw, workSpace, workSpaceSize, solution_id);
     LogCmdConvolution(xDesc, dwDesc, convDesc, ConvDirection::WrW, true);
+
+    const auto status = UseWorkspaceArena(handle, workSpace, workSpaceSize, [&](size_t* size) {
+        return miopenConvolutionBackwardWeightsGetSolutionWorkspaceSize(
+            handle, dyDesc, xDesc, convDesc, dwDesc, solution_id, size);
+    });
+    if(status != miopenStatusSuccess)
+        return status;
     return miopen::try_([&] {
         if(miopen::deref(convDesc).mode == miopenTranspose)
             miopen::deref(convDesc).ConvolutionWrwImmediate(miopen::deref(handle),
@@ -929,6 +1081,38 @@ miopenConvolutionBackwardWeightsImmediate(miopenHandle_t handle,
     });
 }
 
+extern "C" miopenStatus_t
+miopenPlanConvolutionWorkspace(miopenHandle_t handle,
+                               size_t layerCount,
+                               const size_t* solutionCounts,
+                               const miopenConvSolution_t* solutions,
+                               size_t* choices,
+                               float* totalTime,
+                               size_t* totalWorkspace,
+                               float* timePerMB)
+{
+    MIOPEN_LOG_FUNCTION(handle, layerCount);
+    return miopen::try_([&] {
+        if(layerCount != 0 && (solutionCounts == nullptr || choices == nullptr))
+            MIOPEN_THROW(miopenStatusBadParm, "solutionCounts and choices cannot be nullptr");
+
+        std::vector<std::vector<miopenConvSolution_t>> layers(layerCount);
+        for(std::size_t i = 0; i < layerCount; ++i)
+        {
+            if(solutionCounts[i] != 0 && solutions == nullptr)
+                MIOPEN_THROW(miopenStatusBadParm, "solutions cannot be nullptr");
+            layers[i].assign(solutions, solutions + solutionCounts[i]);
+            solutions += solutionCounts[i];
+        }
+
+        const auto plan = miopen::PlanWorkspace(layers, miopen::deref(handle).workspace_budget);
+        std::copy(plan.choices.begin(), plan.choices.end(), choices);
+        miopen::deref(totalTime)      = plan.time;
+        miopen::deref(totalWorkspace) = plan.workspace;
+        miopen::deref(timePerMB)      = plan.time_per_mb;
+    });
+}
+
 extern "C" miopenStatus_t
 miopenFindConvolutionBackwardDataAlgorithm(miopenHandle_t handle,
                                            const miopenTensorDescriptor_t dyDesc,
@@ -961,6 +1145,13 @@ miopenFindConvolutionBackwardDataAlgorithm(miopenHandle_t handle,
                         workSpaceSize,
                         exhaustiveSearch);
 
+    const auto status = UseWorkspaceArena(handle, workSpace, workSpaceSize, [&](size_t* size) {
+        return miopenConvolutionBackwardDataGetWorkSpaceSize(
+            handle, dyDesc, wDesc, convDesc, dxDesc, size);
+    });
+    if(status != miopenStatusSuccess)
+        return status;
+
     /// workaround for previous trans conv logic
     if(miopen::deref(convDesc).mode == miopenTranspose)
         return miopen::try_([&] {
@@ -1034,6 +1225,13 @@ miopenConvolutionBackwardData(miopenHandle_t handle,
                         workSpaceSize);
     LogCmdConvolution(dxDesc, wDesc, convDesc, ConvDirection::Bwd, false);
 
+    const auto status = UseWorkspaceArena(handle, workSpace, workSpaceSize, [&](size_t* size) {
+        return miopenConvolutionBackwardDataGetWorkSpaceSize(
+            handle, dyDesc, wDesc, convDesc, dxDesc, size);
+    });
+    if(status != miopenStatusSuccess)
+        return status;
+
     /// workaround for previous trans conv logic
     if(miopen::deref(convDesc).mode == miopenTranspose)
         return miopen::try_([&] {
@@ -1090,6 +1288,7 @@ miopenConvolutionBackwardDataGetWorkSpaceSize(miopenHandle_t handle,
                                                                        miopen::deref(wDesc),
                                                                        miopen::deref(dyDesc),
                                                                        miopen::deref(dxDesc));
+        ApplyWorkspaceBudget(handle, workSpaceSize);
     });
 }
 
@@ -1111,6 +1310,7 @@ miopenConvolutionBackwardWeightsGetWorkSpaceSize(miopenHandle_t handle,
             miopen::deref(convDesc).mode == miopenTranspose ? miopen::deref(dyDesc)
                                                             : miopen::deref(xDesc),
             miopen::deref(dwDesc));
+        ApplyWorkspaceBudget(handle, workSpaceSize);
     });
 }
 
@@ -1147,6 +1347,13 @@ miopenFindConvolutionBackwardWeightsAlgorithm(miopenHandle_t handle,
                         exhaustiveSearch);
     LogCmdConvolution(xDesc, dwDesc, convDesc, ConvDirection::WrW, false);
 
+    const auto status = UseWorkspaceArena(handle, workSpace, workSpaceSize, [&](size_t* size) {
+        return miopenConvolutionBackwardWeightsGetWorkSpaceSize(
+            handle, dyDesc, xDesc, convDesc, dwDesc, size);
+    });
+    if(status != miopenStatusSuccess)
+        return status;
+
     return miopen::try_([&] {
         miopen::deref(convDesc).FindConvBwdWeightsAlgorithm(
             miopen::deref(handle),
@@ -1197,6 +1404,13 @@ miopenConvolutionBackwardWeights(miopenHandle_t handle,
                         dw,
                         workSpace,
                         workSpaceSize);
+
+    const auto status = UseWorkspaceArena(handle, workSpace, workSpaceSize, [&](size_t* size) {
+        return miopenConvolutionBackwardWeightsGetWorkSpaceSize(
+            handle, dyDesc, xDesc, convDesc, dwDesc, size);
+    });
+    if(status != miopenStatusSuccess)
+        return status;
     return miopen::try_([&] {
         miopen::deref(convDesc).ConvolutionBackwardWeights(
             miopen::deref(handle),
@@ -28,6 +28,7 @@
 #include <miopen/errors.hpp>
 #include <miopen/logger.hpp>
 #include <miopen/tensor_ops.hpp>
+#include <miopen/workspace_arena.hpp>
 #include <vector>
 
 extern "C" miopenStatus_t miopenCreateCTCLossDescriptor(miopenCTCLossDescriptor_t* ctcLossDesc)
@@ -137,6 +138,16 @@ extern "C" miopenStatus_t miopenCTCLoss(miopenHandle_t handle,
     }
 
     return miopen::try_([&] {
+        miopen::UseWorkspaceArena(miopen::deref(handle), workSpace, workSpaceSize, [&] {
+            return miopen::deref(ctcLossDesc)
+                .GetCTCLossWorkspaceSize(miopen::deref(handle),
+                                         miopen::deref(probsDesc),
+                                         miopen::deref(gradientsDesc),
+                                         labels,
+                                         labelLengths,
+                                         inputLengths,
+                                         algo);
+        });
         miopen::deref(ctcLossDesc)
             .CTCLoss(miopen::deref(handle),
                      miopen::deref(probsDesc),
@@ -43,7 +43,7 @@
 #include <fstream>
 #include <ios>
 #include <mutex>
-#include <shared_mutex>
+#include <sstream>
 #include <string>
 
 namespace miopen {
@@ -99,12 +99,18 @@ Db::Db(const std::string& filename_, bool is_system)
 static std::chrono::seconds GetLockTimeout() { return std::chrono::seconds{60}; }
 
 using exclusive_lock = std::unique_lock<LockFile>;
-using shared_lock    = std::shared_lock<LockFile>;
 
+// Readers take no lock. Writers are serialized by the lock and follow this write policy
+// (see FlushUnsafe):
+// - A new record is appended to the published file with a single write of a complete line.
+//   Readers ignore a last line without its newline, so they never see a partial record.
+//   This costs O(record size), which keeps tuning runs storing many records cheap.
+// - Replacing or removing an existing record writes a new file which then atomically replaces
+//   the published one. That is O(file size) per store. A reader keeps the version it has opened
+//   even if it is replaced (and unlinked) meanwhile; replaced versions are reclaimed by the
+//   filesystem when the last reader closes them.
 boost::optional<DbRecord> Db::FindRecord(const std::string& key)
 {
-    const auto lock = shared_lock(lock_file, GetLockTimeout());
-    MIOPEN_VALIDATE_LOCK(lock);
     return FindRecordUnsafe(key, nullptr);
 }
 
@@ -171,6 +177,9 @@ boost::optional<DbRecord> Db::FindRecordUnsafe(const std::string& key, RecordPos
         const auto line_begin = file.tellg();
         if(!std::getline(file, line))
             break;
+        // The last line is being appended by a writer if it has no newline yet.
+        if(file.eof())
+            break;
         ++n_line;
         const auto next_line_begin = file.tellg();
 
@@ -247,6 +256,16 @@ bool Db::FlushUnsafe(const DbRecord& record, const RecordPositions* pos)
 
     if(pos->begin < 0 || pos->end < 0)
     {
+        std::ostringstream line;
+        // Terminate a line left incomplete by an interrupted writer, so the record stays intact.
+        {
+            std::ifstream from(filename, std::ios::ate);
+            if(from && from.tellg() > 0 && from.seekg(-1, std::ios::end) && from.get() != '\n')
+                line << '\n';
+        }
+        record.WriteContents(line);
+        const auto contents = line.str();
+
         {
             std::ofstream file(filename, std::ios::app);
 
@@ -256,46 +275,61 @@ bool Db::FlushUnsafe(const DbRecord& record, const RecordPositions* pos)
                 return false;
             }
 
-            (void)file.tellp();
-            record.WriteContents(file);
+            if(!file.write(contents.data(), contents.size()).flush())
+            {
+                MIOPEN_LOG_E("Unable to append a record to " << filename);
+                return false;
+            }
         }
 
         boost::filesystem::permissions(filename, boost::filesystem::all_all);
+        return true;
     }
-    else
+
+    const auto temp_name = filename + ".temp";
     {
+        std::ofstream to(temp_name);
+
+        if(!to)
+        {
+            MIOPEN_LOG_E("Temp file is unwritable: " << temp_name);
+            return false;
+        }
+
         std::ifstream from(filename, std::ios::ate);
 
-        if(!from)
+        if(from)
+        {
+            const auto from_size = from.tellg();
+            from.seekg(std::ios::beg);
+
+            Copy(from, to, pos->begin);
+            record.WriteContents(to);
+            from.seekg(pos->end);
+            Copy(from, to, from_size - pos->end);
+        }
+        else
         {
             MIOPEN_LOG_E("File is unreadable: " << filename);
             return false;
         }
 
-        const auto temp_name = filename + ".temp";
-        std::ofstream to(temp_name);
-
-        if(!to)
+        if(!to.flush())
         {
             MIOPEN_LOG_E("Temp file is unwritable: " << temp_name);
             return false;
         }
+    }
 
-        const auto from_size = from.tellg();
-        from.seekg(std::ios::beg);
-
-        Copy(from, to, pos->begin);
-        record.WriteContents(to);
-        from.seekg(pos->end);
-        Copy(from, to, from_size - pos->end);
-
-        from.close();
-        to.close();
+    boost::filesystem::permissions(temp_name, boost::filesystem::all_all);
 
-        std::remove(filename.c_str());
-        std::rename(temp_name.c_str(), filename.c_str());
-        /// \todo What if rename fails? Thou shalt not loose the original file.
-        boost::filesystem::permissions(filename, boost::filesystem::all_all);
+    // Publish the new snapshot. rename() replaces the target atomically, so readers always find
+    // either the old or the new complete file.
+    if(std::rename(temp_name.c_str(), filename.c_str()) != 0)
+    {
+        MIOPEN_LOG_E("Unable to replace " << filename << " with " << temp_name);
+        std::remove(temp_name.c_str());
+        return false;
     }
     return true;
 }
@@ -0,0 +1,55 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2019 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/embedded_source.hpp>
+#include <miopen/errors.hpp>
+#include <miopen/lz4_block.hpp>
+
+#include <map>
+#include <mutex>
+
+namespace miopen {
+
+std::string LoadEmbeddedSource(const EmbeddedSource& source)
+{
+    if(source.compressed_size == 0)
+        return {reinterpret_cast<const char*>(source.data), source.size};
+
+    static std::mutex mutex;
+    static std::map<const unsigned char*, std::string> decompressed;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    const auto it = decompressed.find(source.data);
+    if(it != decompressed.end())
+        return it->second;
+
+    std::string result(source.size, '\0');
+    if(!Lz4Decompress(source.data, source.compressed_size, &result[0], result.size()))
+        MIOPEN_THROW("Embedded kernel source is corrupted");
+    decompressed.emplace(source.data, result);
+    return result;
+}
+
+} // namespace miopen
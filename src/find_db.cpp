@@ -27,16 +27,89 @@
 #include <miopen/find_db.hpp>
 
 #include <miopen/handle.hpp>
+#include <miopen/any_solver.hpp>
 #include <miopen/finddb_kernel_cache_key.hpp>
 #include <miopen/logger.hpp>
 #include <miopen/perf_field.hpp>
+#include <miopen/roofline.hpp>
+#include <miopen/solver_id.hpp>
 
+#include <sys/stat.h>
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <sstream>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 namespace miopen {
 
 bool FindDbRecord::enabled = true;
+constexpr std::chrono::milliseconds FindDbRecord::version_poll_interval;
+
+static std::atomic<std::size_t>& StoredRecordsCount()
+{
+    static std::atomic<std::size_t> count{0};
+    return count;
+}
+
+FindDbRecord::~FindDbRecord()
+{
+    if(!db.is_initialized() || !content.is_initialized() || in_sync)
+        return;
+    if(!db->StoreRecord(content.get()))
+    {
+        MIOPEN_LOG_E("Failed to store record to find-db at <" << path << ">");
+        return;
+    }
+    ++StoredRecordsCount();
+}
+
+// Inode, size and write time with nanoseconds: the db replaces the file by renaming a new one
+// over it and appends to it otherwise, so any change is seen even within the same second.
+static std::string GetFileVersion(const std::string& path)
+{
+    struct stat st;
+    if(stat(path.c_str(), &st) != 0)
+        return "none";
+    std::ostringstream ss;
+    ss << st.st_ino << ':' << st.st_size << ':' << st.st_mtim.tv_sec << '.' << st.st_mtim.tv_nsec;
+    return ss.str();
+}
+
+std::string FindDbRecord::GetVersion(Handle& handle)
+{
+    if(!enabled || IsEnabled(MIOPEN_DEBUG_DISABLE_FIND_DB{}))
+        return "disabled";
+
+    struct FileVersion
+    {
+        std::chrono::steady_clock::time_point checked;
+        std::string version;
+    };
+    static std::mutex mutex;
+    static std::unordered_map<std::string, FileVersion> file_versions;
+
+    const auto user_path = path_override() ? *path_override() : GetUserPath(handle);
+    const auto now       = std::chrono::steady_clock::now();
+    std::string file_version;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto& cached = file_versions[user_path];
+        if(cached.version.empty() || now - cached.checked >= version_poll_interval)
+        {
+            cached.version = GetFileVersion(user_path);
+            cached.checked = now;
+        }
+        file_version = cached.version;
+    }
+
+    std::ostringstream ss;
+    ss << StoredRecordsCount() << ':' << user_path << ':' << file_version;
+    return ss.str();
+}
 
 boost::optional<std::string>& FindDbRecord::path_override()
 {
@@ -55,6 +128,86 @@ std::string FindDbRecord::GetUserPath(Handle& handle)
     return GetUserDbPath() + "/" + handle.GetDbBasename() + "." + GetUserDbSuffix() + ".ufdb.txt";
 }
 
+void FindDbRecord::LookupBucket(const ProblemDescription& problem)
+{
+    const auto representative = GetBucketRepresentative(problem);
+    if(in_sync)
+    {
+        RecordBucketLookup(representative, BucketLookup::Exact);
+        return;
+    }
+
+    const auto bucket = db->FindRecord(ProblemBucket{representative});
+    if(!bucket)
+    {
+        RecordBucketLookup(representative, BucketLookup::Miss);
+        return;
+    }
+
+    // Kernels are built for the exact problem, so the items are rekeyed to its network config.
+    // GEMM and FFT items are dropped, as their applicability and workspace can not be checked
+    // without the descriptors.
+    std::string network_config;
+    problem.mloBuildConf_Key(network_config);
+    content.emplace(problem);
+    for(const auto& pair : bucket->As<FindDbData>())
+    {
+        const auto solver_id = solver::Id{pair.second.solver_id};
+        if(solver_id == solver::Id::gemm() || solver_id == solver::Id::fft())
+            continue;
+        auto item = pair.second;
+        if(!item.kcache_key.IsUnused())
+            item.kcache_key.network_config = network_config;
+        content->SetValues(pair.first, item);
+    }
+
+    if(content->GetSize() == 0)
+    {
+        content = boost::none;
+        RecordBucketLookup(representative, BucketLookup::Miss);
+        return;
+    }
+
+    // Never stored: the record of the problem is written by Find only.
+    in_sync     = true;
+    from_bucket = true;
+    RecordBucketLookup(representative, BucketLookup::Bucket);
+}
+
+void FindDbRecord::StoreToBucket(const ProblemDescription& problem)
+{
+    auto bucket = DbRecord{ProblemBucket{GetBucketRepresentative(problem)}};
+    for(const auto& pair : content->As<FindDbData>())
+        bucket.SetValues(pair.first, pair.second);
+    if(!db->StoreRecord(bucket))
+        MIOPEN_LOG_E("Failed to store record to find-db at <" << path << ">");
+}
+
+void FindDbRecord::AddRooflineMetrics(Handle& handle, const ProblemDescription& problem)
+{
+    auto ctx = ConvolutionContext{problem};
+    ctx.SetStream(&handle);
+    const auto peak_tflops = GetPeakTflops(handle, problem.in_data_type);
+
+    std::vector<std::pair<std::string, FindDbData>> items;
+    for(const auto& pair : content->As<FindDbData>())
+        items.push_back(pair);
+
+    for(auto& item : items)
+    {
+        // GEMM and FFT are not solvers yet, so they are rated as direct convolutions.
+        const auto solver_id = solver::Id{item.second.solver_id};
+        const auto cost      = solver_id.IsValid() && solver_id != solver::Id::gemm() &&
+                                  solver_id != solver::Id::fft()
+                              ? solver_id.GetSolver().GetCost(ctx)
+                              : GetConvolutionCost(problem);
+        item.second.roofline = GetRooflineMetrics(cost, item.second.time, peak_tflops);
+        content->SetValues(item.first, item.second);
+        MIOPEN_LOG_I2(item.first << ": " << item.second.solver_id << ", "
+                                 << item.second.roofline);
+    }
+}
+
 bool FindDbRecord::CopyValidating(Handle& handle, std::vector<PerfField>& to) const
 {
     auto unbuilt = false;
@@ -75,7 +228,11 @@ bool FindDbRecord::CopyValidating(Handle& handle, std::vector<PerfField>& to) co
 
             any = true;
         }
-        to.push_back({pair.first, pair.second.solver_id, pair.second.time, pair.second.workspace});
+        to.push_back({pair.first,
+                      pair.second.solver_id,
+                      pair.second.time,
+                      pair.second.workspace,
+                      pair.second.roofline});
     }
 
     return !any || unbuilt;
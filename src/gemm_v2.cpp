@@ -1382,6 +1382,57 @@ GemmDescriptor CreateGemmDescriptorConvBwdWeight(const TensorDescriptor& dyDesc,
                           xDesc.GetType()};
 }
 
+// y = x * transpose(w), x and y are NHWC, w is KYXC
+GemmDescriptor CreateGemmDescriptorConvNHWCFwd(const TensorDescriptor& wDesc,
+                                               const TensorDescriptor& xDesc,
+                                               const TensorDescriptor& yDesc)
+{
+#ifndef NDEBUG
+    assert(wDesc.GetType() == xDesc.GetType());
+    assert(wDesc.GetType() == yDesc.GetType());
+#endif
+
+    int in_n  = xDesc.GetLengths()[0];
+    int in_c  = xDesc.GetLengths()[1];
+    int wei_k = wDesc.GetLengths()[0];
+
+    auto out_spatial = boost::adaptors::slice(yDesc.GetLengths(), 2, yDesc.GetLengths().size());
+
+    bool isColMajor = false;
+    bool transA     = false;
+    bool transB     = true;
+    int m =
+        in_n * std::accumulate(out_spatial.begin(), out_spatial.end(), 1, std::multiplies<int>());
+    int n                 = wei_k;
+    int k                 = in_c;
+    int lda               = k;
+    int ldb               = k;
+    int ldc               = n;
+    int batch_count       = 1;
+    long long int strideA = 0;
+    long long int strideB = 0;
+    long long int strideC = 0;
+    float alpha           = 1.;
+    float beta            = 0.;
+
+    return GemmDescriptor{isColMajor,
+                          transA,
+                          transB,
+                          m,
+                          n,
+                          k,
+                          lda,
+                          ldb,
+                          ldc,
+                          batch_count,
+                          strideA,
+                          strideB,
+                          strideC,
+                          alpha,
+                          beta,
+                          xDesc.GetType()};
+}
+
 // y = CNHW2NCHW(w * NCHW2CNHW(x))
 GemmDescriptor CreateGemmDescriptorConvCNHWFwd(const TensorDescriptor& wDesc,
                                                const TensorDescriptor& xDesc,
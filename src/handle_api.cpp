@@ -24,8 +24,12 @@
  *
  *******************************************************************************/
 #include <cstdio>
+#include <miopen/compile_queue.hpp>
 #include <miopen/errors.hpp>
 #include <miopen/handle.hpp>
+#include <miopen/kernel_bundle.hpp>
+#include <miopen/make_unique.hpp>
+#include <miopen/workspace_arena.hpp>
 
 extern "C" const char* miopenGetErrorString(miopenStatus_t error)
 {
@@ -97,3 +101,69 @@ extern "C" miopenStatus_t miopenEnableProfiling(miopenHandle_t handle, bool enab
 {
     return miopen::try_([&] { miopen::deref(handle).EnableProfiling(enable); });
 }
+
+extern "C" miopenStatus_t miopenCancelAsyncCompilation(miopenHandle_t handle)
+{
+    return miopen::try_([&] {
+        auto& h = miopen::deref(handle);
+        if(h.compile_queue != nullptr)
+            h.compile_queue->CancelPending();
+    });
+}
+
+extern "C" miopenStatus_t miopenLoadKernelBundle(miopenHandle_t handle, const char* path)
+{
+    return miopen::try_([&] {
+        if(path == nullptr)
+            MIOPEN_THROW(miopenStatusBadParm, "Kernel bundle path is null");
+        miopen::deref(handle).LoadKernelBundle(path);
+    });
+}
+
+extern "C" miopenStatus_t miopenSetWorkspaceBudget(miopenHandle_t handle, size_t budget)
+{
+    return miopen::try_([&] { miopen::deref(handle).workspace_budget = budget; });
+}
+
+extern "C" miopenStatus_t miopenGetWorkspaceBudget(miopenHandle_t handle, size_t* budget)
+{
+    return miopen::try_([&] { miopen::deref(budget) = miopen::deref(handle).workspace_budget; });
+}
+
+extern "C" miopenStatus_t miopenEnableWorkspaceArena(miopenHandle_t handle, bool enable)
+{
+    return miopen::try_([&] {
+        auto& h = miopen::deref(handle);
+        if(!enable)
+            h.workspace_arena = nullptr;
+        else if(h.workspace_arena == nullptr)
+            h.workspace_arena = miopen::make_unique<miopen::WorkspaceArena>();
+    });
+}
+
+extern "C" miopenStatus_t miopenGetWorkspaceArenaStats(miopenHandle_t handle,
+                                                       size_t* capacity,
+                                                       size_t* highWaterMark,
+                                                       size_t* allocations)
+{
+    return miopen::try_([&] {
+        const auto& arena            = miopen::deref(handle).workspace_arena;
+        miopen::deref(capacity)      = arena != nullptr ? arena->GetCapacity() : 0;
+        miopen::deref(highWaterMark) = arena != nullptr ? arena->GetHighWaterMark() : 0;
+        miopen::deref(allocations)   = arena != nullptr ? arena->GetAllocationCount() : 0;
+    });
+}
+
+extern "C" miopenStatus_t miopenStartKernelBundleRecording(void)
+{
+    return miopen::try_([&] { miopen::StartKernelBundleRecording(); });
+}
+
+extern "C" miopenStatus_t miopenWriteKernelBundle(const char* path)
+{
+    return miopen::try_([&] {
+        if(path == nullptr)
+            MIOPEN_THROW(miopenStatusBadParm, "Kernel bundle path is null");
+        miopen::StopKernelBundleRecording().Save(path);
+    });
+}
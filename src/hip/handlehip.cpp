@@ -25,13 +25,19 @@
  *******************************************************************************/
 #include <algorithm>
 #include <miopen/logger.hpp>
+#include <miopen/check_numerics.hpp>
+#include <miopen/compile_queue.hpp>
 #include <miopen/device_name.hpp>
 #include <miopen/errors.hpp>
 #include <miopen/handle.hpp>
+#include <miopen/kernel_bundle.hpp>
 #include <miopen/kernel_cache.hpp>
+#include <miopen/load_file.hpp>
 #include <miopen/binary_cache.hpp>
 #include <boost/filesystem.hpp>
 #include <miopen/handle_lock.hpp>
+#include <miopen/trace.hpp>
+#include <miopen/workspace_arena.hpp>
 #include <miopen/gemm_geometry.hpp>
 
 #ifndef _WIN32
@@ -204,7 +210,21 @@ Handle::Handle() : impl(new HandleImpl())
     MIOPEN_LOG_I(*this);
 }
 
-Handle::~Handle() {}
+Handle::~Handle()
+{
+    // The running compile jobs use the handle.
+    compile_queue.reset();
+    if(check_numerics_ring == nullptr)
+        return;
+    try
+    {
+        miopen::flushCheckNumerics(*this);
+    }
+    catch(const Exception& ex)
+    {
+        MIOPEN_LOG_E(ex.what());
+    }
+}
 
 void Handle::SetStream(miopenAcceleratorQueue_t streamID) const
 {
@@ -323,7 +343,19 @@ Program Handle::LoadProgram(const std::string& program_name,
                             bool is_kernel_str,
                             const std::string& kernel_src)
 {
+    MIOPEN_TRACE_SCOPE("compile", program_name);
     this->impl->set_ctx();
+    // May run on the compile queue while the bundle is loaded.
+    const auto bundle = std::atomic_load(&this->kernel_bundle);
+    if(bundle != nullptr)
+    {
+        const auto binary = bundle->FindProgram(program_name, params, is_kernel_str);
+        if(binary != nullptr)
+            return HIPOCProgram{program_name, std::vector<char>(binary->begin(), binary->end())};
+    }
+
+    // The bundle is keyed by the arguments of the kernel cache.
+    const auto bundle_params = miopen::IsRecordingKernelBundle() ? params : std::string{};
     params += " -mcpu=" + this->GetDeviceName();
     auto cache_file =
         miopen::LoadBinary(this->GetDeviceName(), program_name, params, is_kernel_str);
@@ -332,6 +364,13 @@ Program Handle::LoadProgram(const std::string& program_name,
         auto p =
             HIPOCProgram{program_name, params, is_kernel_str, this->GetDeviceName(), kernel_src};
 
+        if(miopen::IsRecordingKernelBundle())
+            miopen::RecordBundleProgram(this->GetDeviceName(),
+                                        program_name,
+                                        bundle_params,
+                                        is_kernel_str,
+                                        miopen::LoadFile(p.GetBinary().string()));
+
         // Save to cache
         auto path = miopen::GetCachePath() / boost::filesystem::unique_path();
         boost::filesystem::copy_file(p.GetBinary(), path);
@@ -341,6 +380,12 @@ Program Handle::LoadProgram(const std::string& program_name,
     }
     else
     {
+        if(miopen::IsRecordingKernelBundle())
+            miopen::RecordBundleProgram(this->GetDeviceName(),
+                                        program_name,
+                                        bundle_params,
+                                        is_kernel_str,
+                                        miopen::LoadFile(cache_file));
         return HIPOCProgram{program_name, cache_file};
     }
 }
@@ -410,6 +455,16 @@ std::size_t Handle::GetMaxComputeUnits()
     return result;
 }
 
+std::size_t Handle::GetMaxClockFrequency()
+{
+    int result;
+    auto status = hipDeviceGetAttribute(&result, hipDeviceAttributeClockRate, this->impl->device);
+    if(status != hipSuccess)
+        MIOPEN_THROW_HIP_STATUS(status);
+
+    return result / 1000; // kHz to MHz
+}
+
 std::size_t Handle::GetImage3dMaxWidth()
 {
     int result;
@@ -28,6 +28,7 @@
 #include <miopen/errors.hpp>
 #include <miopen/hipoc_kernel.hpp>
 #include <miopen/handle_lock.hpp>
+#include <miopen/trace.hpp>
 #include <thread>
 #include <hip/hip_hcc.h>
 #include <hip/hip_runtime.h>
@@ -58,6 +59,7 @@ void HIPOCKernelInvoke::run(void* args, std::size_t size) const
 
     // std::cerr << "Launch kernel: " << name << std::endl;
 
+    MIOPEN_TRACE_SCOPE("kernel", name);
     MIOPEN_HANDLE_LOCK
 
     auto status = hipHccModuleLaunchKernel(fun,
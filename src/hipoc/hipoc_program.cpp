@@ -49,8 +49,23 @@ hipModulePtr CreateModule(const boost::filesystem::path& hsaco_file)
     return m;
 }
 
+hipModulePtr CreateModule(const std::vector<char>& code_object)
+{
+    hipModule_t raw_m;
+    auto status = hipModuleLoadData(&raw_m, code_object.data());
+    hipModulePtr m{raw_m};
+    if(status != hipSuccess)
+        MIOPEN_THROW_HIP_STATUS(status, "Failed creating module from memory");
+    return m;
+}
+
 struct HIPOCProgramImpl
 {
+    HIPOCProgramImpl(const std::string& program_name, const std::vector<char>& code_object)
+        : name(program_name)
+    {
+        this->module = CreateModule(code_object);
+    }
     HIPOCProgramImpl(const std::string& program_name, const boost::filesystem::path& hsaco)
         : name(program_name), hsaco_file(hsaco)
     {
@@ -137,6 +152,11 @@ HIPOCProgram::HIPOCProgram(const std::string& program_name, const boost::filesys
 {
 }
 
+HIPOCProgram::HIPOCProgram(const std::string& program_name, const std::vector<char>& code_object)
+    : impl(std::make_shared<HIPOCProgramImpl>(program_name, code_object))
+{
+}
+
 hipModule_t HIPOCProgram::GetModule() const { return this->impl->module.get(); }
 
 boost::filesystem::path HIPOCProgram::GetBinary() const { return this->impl->hsaco_file; }
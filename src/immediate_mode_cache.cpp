@@ -0,0 +1,65 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2019 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/immediate_mode_cache.hpp>
+
+#include <utility>
+
+namespace miopen {
+
+ImmediateModeCache& ImmediateModeCache::Get()
+{
+    static ImmediateModeCache cache;
+    return cache;
+}
+
+std::shared_ptr<const ImmediateSolutions> ImmediateModeCache::Find(const std::string& key,
+                                                                   const std::string& version)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    const auto it = entries.find(key);
+    if(it == entries.end() || it->second.version != version)
+        return nullptr;
+    return it->second.solutions;
+}
+
+void ImmediateModeCache::Insert(const std::string& key,
+                                const std::string& version,
+                                std::shared_ptr<const ImmediateSolutions> solutions)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    if(entries.size() >= max_entries && entries.count(key) == 0)
+        entries.clear();
+    entries[key] = {version, std::move(solutions)};
+}
+
+void ImmediateModeCache::Clear()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    entries.clear();
+}
+
+} // namespace miopen
@@ -30,6 +30,7 @@
 #include <miopen/conv_solution.hpp>
 #include <miopen/find_solution.hpp>
 #include <miopen/mlo_internal.hpp>
+#include <miopen/roofline.hpp>
 
 #include <cassert>
 #include <memory>
@@ -62,9 +63,14 @@ struct AnySolver
         return ptr_value->IsFast(ctx);
     };
     ConvSolution FindSolution(const ConvolutionContext& ctx, Db& db) const
+    {
+        return FindSolution(ctx, db, GetSolverPolicy(ctx));
+    };
+    ConvSolution
+    FindSolution(const ConvolutionContext& ctx, Db& db, const SolverPolicy& policy) const
     {
         assert(ptr_value != nullptr);
-        return ptr_value->FindSolution(ctx, db);
+        return ptr_value->FindSolution(ctx, db, policy);
     };
     std::string GetSolverDbId() const
     {
@@ -78,6 +84,12 @@ struct AnySolver
         return ptr_value->GetWorkspaceSize(ctx);
     }
 
+    OperationCost GetCost(const ConvolutionContext& ctx) const
+    {
+        assert(ptr_value != nullptr);
+        return ptr_value->GetCost(ctx);
+    }
+
     // virtual base class
     struct AnySolver_base
     {
@@ -88,8 +100,10 @@ struct AnySolver
         virtual bool IsFast(const ConvolutionContext& ctx) const       = 0;
         virtual const std::type_info& Type() const                     = 0;
         virtual std::string GetSolverDbId() const                      = 0;
-        virtual ConvSolution FindSolution(const ConvolutionContext& ctx, Db& db) const = 0;
+        virtual ConvSolution
+        FindSolution(const ConvolutionContext& ctx, Db& db, const SolverPolicy& policy) const = 0;
         virtual size_t GetWorkspaceSize(const ConvolutionContext& ctx) const = 0;
+        virtual OperationCost GetCost(const ConvolutionContext& ctx) const   = 0;
     };
 
     // templated derived class
@@ -102,14 +116,20 @@ struct AnySolver
             return value.IsApplicable(ctx);
         }
         bool IsFast(const ConvolutionContext& ctx) const override { return value.IsFast(ctx); }
-        ConvSolution FindSolution(const ConvolutionContext& ctx, Db& db) const override
+        ConvSolution FindSolution(const ConvolutionContext& ctx,
+                                  Db& db,
+                                  const SolverPolicy& policy) const override
         {
-            return miopen::solver::FindSolution(value, ctx, db);
+            return miopen::solver::FindSolution(value, ctx, db, policy);
         };
         size_t GetWorkspaceSize(const ConvolutionContext& ctx) const override
         {
             return value.GetWorkspaceSize(ctx);
         }
+        OperationCost GetCost(const ConvolutionContext& ctx) const override
+        {
+            return value.GetCost(ctx);
+        }
         const std::type_info& Type() const override { return typeid(T); };
         std::string GetSolverDbId() const override { return ComputeSolverDbId(value); }
 
@@ -0,0 +1,155 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2019 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#ifndef GUARD_MIOPEN_BATCH_NORM_SOLVER_HPP_
+#define GUARD_MIOPEN_BATCH_NORM_SOLVER_HPP_
+
+#include <miopen/miopen.h>
+#include <miopen/primitive_context.hpp>
+#include <miopen/serializable.hpp>
+#include <miopen/solver.hpp>
+
+#include <cstddef>
+#include <functional>
+#include <ostream>
+#include <string>
+
+namespace miopen {
+
+struct TensorDescriptor;
+
+namespace solver {
+struct BnSpatialSolution;
+} // namespace solver
+
+/// Problem config of the spatial batch normalization training kernels.
+/// Serialize() provides the Perf Db key.
+struct BatchNormContext : PrimitiveContext
+{
+    bool forward = true; // Forward training or backward.
+    int n        = 0;
+    int c        = 0;
+    int h        = 0;
+    int w        = 0;
+    miopenDataType_t in_data_type    = miopenFloat;
+    miopenDataType_t param_data_type = miopenFloat;
+    /// Forward: the mean and inverse variance are saved. Backward: the saved ones are used.
+    bool saved_mean_variance = false;
+    /// Forward: the running mean and variance are updated.
+    bool running_mean_variance = false;
+    /// The kernels reduce with gcn_reduce2(), which handles any multiple of a wave.
+    /// Otherwise they use the LDS tree of lds_reduce2(), which needs a power of 2.
+    bool gcn_reduce = true;
+
+    std::function<void(const solver::BnSpatialSolution&)> run;
+
+    BatchNormContext() = default;
+    BatchNormContext(bool forward_,
+                     const TensorDescriptor& xDesc,
+                     const TensorDescriptor& bnScaleBiasDesc);
+
+    unsigned int GetHW() const { return h * w; }
+    unsigned int GetNHW() const { return n * GetHW(); }
+
+    void Serialize(std::ostream& stream) const;
+
+    friend std::ostream& operator<<(std::ostream& os, const BatchNormContext& obj)
+    {
+        obj.Serialize(os);
+        return os;
+    }
+};
+
+namespace solver {
+
+/// Launch parameters of the spatial batch normalization kernels.
+/// Variant 2 is the only multi-kernel one, it reduces over the y dimension of the grid.
+struct BnSpatialSolution
+{
+    int variant           = 0;
+    bool single           = true;
+    size_t xlocalsize     = 1;
+    size_t ylocalsize     = 1;
+    size_t xgridsize      = 1;
+    size_t ygridsize      = 1;
+    unsigned int ldsgcn   = 0;
+    unsigned int ldsnogcn = 0;
+};
+
+struct PerformanceConfigBnSpatial : Serializable<PerformanceConfigBnSpatial>
+{
+    int variant; // [0..3]
+    int wg_size; // [64..1024], multiple of 64. The size of the reducing dimension of work-groups.
+
+    PerformanceConfigBnSpatial(int variant_, int wg_size_) : variant(variant_), wg_size(wg_size_)
+    {
+    }
+    PerformanceConfigBnSpatial() : PerformanceConfigBnSpatial(-1, -1) {}
+    PerformanceConfigBnSpatial(bool) : PerformanceConfigBnSpatial(0, 64) {}
+
+    template <class Self, class F>
+    static void Visit(Self&& self, F f)
+    {
+        f(self.variant, "variant");
+        f(self.wg_size, "wg_size");
+    }
+
+    void EuristicInit(const BatchNormContext& context);
+    bool IsValidValue() const;
+    bool SetNextValue();
+    bool IsValid(const BatchNormContext& context) const;
+    bool operator==(const PerformanceConfigBnSpatial& other) const;
+};
+
+struct BnFwdTrainingSpatial : SolverBase<BatchNormContext>
+{
+    bool IsApplicable(const BatchNormContext& context) const { return context.forward; }
+    PerformanceConfigBnSpatial GetPerformanceConfig(const BatchNormContext& context) const;
+    bool IsValidPerformanceConfig(const BatchNormContext& context,
+                                  const PerformanceConfigBnSpatial& config) const;
+    PerformanceConfigBnSpatial Search(const BatchNormContext& context) const;
+    BnSpatialSolution GetSolution(const BatchNormContext& context,
+                                  const PerformanceConfigBnSpatial& config) const;
+};
+
+struct BnBwdTrainingSpatial : SolverBase<BatchNormContext>
+{
+    bool IsApplicable(const BatchNormContext& context) const { return !context.forward; }
+    PerformanceConfigBnSpatial GetPerformanceConfig(const BatchNormContext& context) const;
+    bool IsValidPerformanceConfig(const BatchNormContext& context,
+                                  const PerformanceConfigBnSpatial& config) const;
+    PerformanceConfigBnSpatial Search(const BatchNormContext& context) const;
+    BnSpatialSolution GetSolution(const BatchNormContext& context,
+                                  const PerformanceConfigBnSpatial& config) const;
+};
+
+/// Returns the launch parameters for the problem, see FindPrimitiveSolution().
+BnSpatialSolution FindBnSpatialSolution(const BatchNormContext& context);
+
+} // namespace solver
+} // namespace miopen
+
+#endif // GUARD_MIOPEN_BATCH_NORM_SOLVER_HPP_
@@ -1,12 +1,16 @@
 #ifndef GUARD_MIOPEN_CHECK_NUMERICS_HPP
 #define GUARD_MIOPEN_CHECK_NUMERICS_HPP
 
+#include <miopen/allocator.hpp>
 #include <miopen/common.hpp>
+#include <miopen/tensor.hpp>
+
+#include <cstddef>
+#include <vector>
 
 namespace miopen {
 
 struct Handle;
-struct TensorDescriptor;
 
 struct CheckNumerics
 {
@@ -15,6 +19,7 @@ struct CheckNumerics
     static const int Throw        = 0x04; // MIOPEN_THROW on abnormal result
     static const int Abort        = 0x08; // abort on abnormal result (to drop into debugger)
     static const int ComputeStats = 0x10; // Print mean/absmean/min/max (slow)
+    static const int Deferred     = 0x20; // Queue the checks, report them later (see below)
 };
 bool CheckNumericsEnabled(int bitMask = -1);
 
@@ -22,6 +27,50 @@ bool checkNumericsInput(Handle& handle, const TensorDescriptor& dDesc, ConstData
 bool checkNumericsOutput(Handle& handle, const TensorDescriptor& dDesc, ConstData_t data);
 bool checkNumericsImpl(
     Handle& handle, int mode, const TensorDescriptor& dDesc, ConstData_t data, bool isInput);
+
+// Must keep this structure synchronized with one in MIOpenCheckNumerics
+struct CheckNumericsResult
+{
+    float sum    = 0.0f;
+    float absSum = 0.0f;
+    float min    = 0.0f;
+    float max    = 0.0f;
+
+    int hasZero = 0;
+    int hasNan  = 0;
+    int hasInf  = 0;
+};
+
+// Deferred checks neither allocate nor wait for the device. The check kernels write into the
+// slots of a device buffer owned by the handle, and the results are read back in one go when all
+// the slots are used (MIOPEN_CHECK_NUMERICS_RING_SIZE, 256 by default) and when the handle is
+// destroyed. Abnormal tensors are reported with the API call which has checked them.
+class CheckNumericsRing
+{
+    public:
+    CheckNumericsRing(Handle& handle, std::size_t size);
+
+    void Queue(
+        Handle& handle, int mode, const TensorDescriptor& dDesc, ConstData_t data, bool isInput);
+    /// Reports the queued checks. Returns true if an abnormal value has been detected.
+    bool Drain(Handle& handle, int mode);
+
+    private:
+    struct Check
+    {
+        const char* call;
+        bool isInput;
+        ConstData_t data;
+        TensorDescriptor desc;
+    };
+
+    Allocator::ManageDataPtr results;
+    std::vector<CheckNumericsResult> host_results;
+    std::vector<Check> queued;
+};
+
+/// Reports the deferred checks queued in the handle so far.
+bool flushCheckNumerics(Handle& handle);
 } // namespace miopen
 
 #endif // GUARD_MIOPEN_CHECK_NUMERICS_HPP
@@ -0,0 +1,97 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2019 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#ifndef GUARD_MIOPEN_COMPILE_QUEUE_HPP_
+#define GUARD_MIOPEN_COMPILE_QUEUE_HPP_
+
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace miopen {
+
+struct Handle;
+
+/// Pool of threads building kernels in the background, see Compile*SolutionAsync()
+/// of ConvolutionDescriptor. Jobs are named, so requesting the same job again returns its
+/// state instead of building it twice.
+class CompileQueue
+{
+    public:
+    using Job = std::function<void()>;
+
+    explicit CompileQueue(std::size_t threads_num);
+    ~CompileQueue();
+
+    CompileQueue(const CompileQueue&) = delete;
+    CompileQueue& operator=(const CompileQueue&) = delete;
+
+    /// Returns the future of the job named key, queueing job if there is none.
+    /// Queued jobs of higher priority start first, jobs of the same priority in queueing order.
+    /// Requesting a queued job again with a higher priority raises its priority.
+    /// A failed or cancelled job is forgotten once its future is returned here,
+    /// so the next request queues it again.
+    std::shared_future<void> Enqueue(const std::string& key, int priority, Job job);
+
+    /// Drops the queued jobs. Their futures throw. Running jobs are not interrupted.
+    void CancelPending();
+
+    private:
+    struct Task
+    {
+        std::string key;
+        int priority;
+        std::size_t order;
+        Job job;
+        std::promise<void> promise;
+    };
+
+    void Work();
+    void CancelPendingUnsafe();
+
+    std::mutex mutex;
+    std::condition_variable queued;
+    std::vector<std::unique_ptr<Task>> pending;
+    std::unordered_map<std::string, std::shared_future<void>> results;
+    std::size_t enqueued = 0;
+    bool stopping        = false;
+    std::vector<std::thread> threads;
+};
+
+/// Returns the compile queue of the handle, starting it on first use.
+/// The number of threads is MIOPEN_COMPILE_THREADS, or half of the hardware threads by default.
+CompileQueue& GetCompileQueue(Handle& handle);
+
+} // namespace miopen
+
+#endif // GUARD_MIOPEN_COMPILE_QUEUE_HPP_
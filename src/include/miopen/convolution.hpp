@@ -57,6 +57,15 @@ using ExtraKernelArgs = std::tuple<int /*N*/,
 struct ConvFwdTensors;
 struct ConvWrwTensors;
 
+/// Memory order of a 4D activation tensor whose descriptor has the NCHW lengths.
+enum class ConvLayout
+{
+    NCHW,
+    CNHW,
+};
+
+std::ostream& operator<<(std::ostream& stream, ConvLayout layout);
+
 struct ConvolutionDescriptor : miopenConvolutionDescriptor
 {
     ConvolutionDescriptor(std::size_t spatial_dim,
@@ -95,9 +104,38 @@ struct ConvolutionDescriptor : miopenConvolutionDescriptor
     std::size_t ForwardGetWorkSpaceSizeGEMM(const TensorDescriptor& wDesc,
                                             const TensorDescriptor& yDesc) const;
 
+    /// A 1x1 convolution of packed channels-last tensors (NHWC or NDHWC, weights KYXC or KZYXC)
+    /// runs as a single GEMM. It is the only GEMM path for tensors not in the default layout.
+    bool IsGemmNHWCFwd(const TensorDescriptor& xDesc,
+                       const TensorDescriptor& wDesc,
+                       const TensorDescriptor& yDesc) const;
+
+    /// The forward GEMM path transposes x from NCHW to CNHW, runs a single GEMM and transposes
+    /// y back, instead of im2col'ing x. See the layout planner for chaining such layers.
+    bool IsGemmTransposeFwd(const TensorDescriptor& xDesc, const TensorDescriptor& wDesc) const;
+
     std::size_t ForwardGetWorkSpaceSizeGEMMTranspose(const TensorDescriptor& xDesc,
                                                      const TensorDescriptor& yDesc) const;
 
+    /// Bytes taken by the im2col column of one image in the chunked GEMM forward path,
+    /// rounded up so that every column starts at a sub-buffer aligned offset.
+    std::size_t ForwardGetWorkSpaceSizeGEMMChunk(const TensorDescriptor& wDesc,
+                                                 const TensorDescriptor& yDesc) const;
+
+    /// Workspace the im2col GEMM forward path asks for: the column of one image, or of as many
+    /// images as the workspace budget of the handle holds. 0 if it can not be allocated.
+    std::size_t ForwardGetWorkSpaceSizeGEMMIm2Col(Handle& handle,
+                                                  const TensorDescriptor& wDesc,
+                                                  const TensorDescriptor& xDesc,
+                                                  const TensorDescriptor& yDesc) const;
+
+    /// Number of images the non-1x1 GEMM forward path im2cols into workSpaceSize bytes and
+    /// multiplies with a single strided batched GEMM. 1 means the per-image path is used.
+    std::size_t ForwardGetGEMMChunkSize(const TensorDescriptor& wDesc,
+                                        const TensorDescriptor& xDesc,
+                                        const TensorDescriptor& yDesc,
+                                        std::size_t workSpaceSize) const;
+
     std::size_t ForwardGetWorkSpaceSizeGEMMStridedBatched(Handle& handle,
                                                           const TensorDescriptor& xDesc,
                                                           const TensorDescriptor& wDesc,
@@ -234,6 +272,20 @@ struct ConvolutionDescriptor : miopenConvolutionDescriptor
                             Data_t workSpace,
                             std::size_t workSpaceSize) const;
 
+    /// Forward GEMM convolution whose x and y buffers may hold CNHW tensors, so that a chain
+    /// of layers on the transpose path skips the transposes between them. See PlanConvLayouts().
+    void ConvolutionForwardGemm(Handle& handle,
+                                const TensorDescriptor& xDesc,
+                                ConstData_t x,
+                                const TensorDescriptor& wDesc,
+                                ConstData_t w,
+                                const TensorDescriptor& yDesc,
+                                Data_t y,
+                                Data_t workSpace,
+                                std::size_t workSpaceSize,
+                                ConvLayout x_layout,
+                                ConvLayout y_layout) const;
+
     std::size_t GetForwardSolutionCount(Handle& handle,
                                         const TensorDescriptor& wDesc,
                                         const TensorDescriptor& xDesc,
@@ -253,6 +305,15 @@ struct ConvolutionDescriptor : miopenConvolutionDescriptor
                                 const TensorDescriptor& yDesc,
                                 solver::Id solver_id) const;
 
+    /// Queues compilation of the solution on the compile queue of the handle, or raises
+    /// its priority if it is already queued. Returns true once the solution is compiled.
+    bool CompileForwardSolutionAsync(Handle& handle,
+                                     const TensorDescriptor& wDesc,
+                                     const TensorDescriptor& xDesc,
+                                     const TensorDescriptor& yDesc,
+                                     solver::Id solver_id,
+                                     int priority) const;
+
     std::size_t GetForwardSolutionWorkspaceSize(Handle& handle,
                                                 const TensorDescriptor& wDesc,
                                                 const TensorDescriptor& xDesc,
@@ -331,6 +392,13 @@ struct ConvolutionDescriptor : miopenConvolutionDescriptor
                                  const TensorDescriptor& dxDesc,
                                  solver::Id solver_id) const;
 
+    bool CompileBackwardSolutionAsync(Handle& handle,
+                                      const TensorDescriptor& dyDesc,
+                                      const TensorDescriptor& wDesc,
+                                      const TensorDescriptor& dxDesc,
+                                      solver::Id solver_id,
+                                      int priority) const;
+
     std::size_t GetBackwardSolutionWorkspaceSize(Handle& handle,
                                                  const TensorDescriptor& dyDesc,
                                                  const TensorDescriptor& wDesc,
@@ -367,6 +435,13 @@ struct ConvolutionDescriptor : miopenConvolutionDescriptor
                             const TensorDescriptor& dwDesc,
                             solver::Id solver_id) const;
 
+    bool CompileWrwSolutionAsync(Handle& handle,
+                                 const TensorDescriptor& dyDesc,
+                                 const TensorDescriptor& xDesc,
+                                 const TensorDescriptor& dwDesc,
+                                 solver::Id solver_id,
+                                 int priority) const;
+
     std::size_t GetWrwSolutionWorkspaceSize(Handle& handle,
                                             const TensorDescriptor& dyDesc,
                                             const TensorDescriptor& xDesc,
@@ -442,7 +517,9 @@ struct ConvolutionDescriptor : miopenConvolutionDescriptor
     void ConvFwdGemm(Handle& handle,
                      const ConvFwdTensors& tensors,
                      Data_t workSpace,
-                     std::size_t workSpaceSize) const;
+                     std::size_t workSpaceSize,
+                     ConvLayout x_layout = ConvLayout::NCHW,
+                     ConvLayout y_layout = ConvLayout::NCHW) const;
     void ConvFwdFFT(Handle& handle,
                     const ConvFwdTensors& tensors,
                     Data_t workSpace,
@@ -519,15 +596,18 @@ struct ConvolutionDescriptor : miopenConvolutionDescriptor
                              const TensorDescriptor& xDesc,
                              const TensorDescriptor& dwDesc) const;
 
-    std::size_t GetFwdSolutionCountFallback(const TensorDescriptor& wDesc,
+    std::size_t GetFwdSolutionCountFallback(Handle& handle,
+                                            const TensorDescriptor& wDesc,
                                             const TensorDescriptor& xDesc,
                                             const TensorDescriptor& yDesc) const;
 
-    std::size_t GetBwdSolutionCountFallback(const TensorDescriptor& dyDesc,
+    std::size_t GetBwdSolutionCountFallback(Handle& handle,
+                                            const TensorDescriptor& dyDesc,
                                             const TensorDescriptor& wDesc,
                                             const TensorDescriptor& dxDesc) const;
 
-    std::size_t GetWrwSolutionCountFallback(const TensorDescriptor& dyDesc,
+    std::size_t GetWrwSolutionCountFallback(Handle& handle,
+                                            const TensorDescriptor& dyDesc,
                                             const TensorDescriptor& xDesc,
                                             const TensorDescriptor& dwDesc) const;
 
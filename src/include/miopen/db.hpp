@@ -28,6 +28,7 @@
 
 #include <miopen/db_record.hpp>
 #include <miopen/rank.hpp>
+#include <miopen/trace.hpp>
 
 #include <boost/core/explicit_operator_bool.hpp>
 #include <boost/none.hpp>
@@ -301,6 +302,7 @@ class DbTimer
     template <class TFunc>
     static auto Measure(const std::string& funcName, TFunc&& func)
     {
+        MIOPEN_TRACE_SCOPE("db", "Db::" + funcName);
         if(!miopen::IsLogging(LoggingLevel::Info))
             return func();
 
@@ -0,0 +1,49 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2019 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#ifndef GUARD_MIOPEN_EMBEDDED_SOURCE_HPP_
+#define GUARD_MIOPEN_EMBEDDED_SOURCE_HPP_
+
+#include <cstddef>
+#include <string>
+
+namespace miopen {
+
+/// Kernel source file embedded into the library by addkernels.
+struct EmbeddedSource
+{
+    const unsigned char* data;
+    std::size_t size;
+    /// Size of data if the file is stored compressed, 0 if it is stored as is.
+    std::size_t compressed_size;
+};
+
+/// Compressed files are decompressed on first use, and the result is kept for later calls.
+std::string LoadEmbeddedSource(const EmbeddedSource& source);
+
+} // namespace miopen
+
+#endif // GUARD_MIOPEN_EMBEDDED_SOURCE_HPP_
@@ -32,10 +32,12 @@
 #include <miopen/db_record.hpp>
 #include <miopen/env.hpp>
 #include <miopen/perf_field.hpp>
+#include <miopen/problem_buckets.hpp>
 #include <miopen/readonlyramdb.hpp>
 
 #include <boost/optional.hpp>
 
+#include <chrono>
 #include <functional>
 #include <vector>
 
@@ -67,21 +69,28 @@ class FindDbRecord
 
         content = db->FindRecord(problem);
         in_sync = content.is_initialized();
+        if(IsProblemBucketingEnabled())
+            LookupBucket(problem);
     }
 
-    ~FindDbRecord()
-    {
-        if(!db.is_initialized() || !content.is_initialized() || in_sync)
-            return;
-        if(!db->StoreRecord(content.get()))
-            MIOPEN_LOG_E("Failed to store record to find-db at <" << path << ">");
-    }
+    ~FindDbRecord();
+
+    /// Changes whenever the find-db used with the handle may have changed: a record has been
+    /// stored by this process, the user find-db file has been written by another one, or the
+    /// find-db has been disabled or overridden. Writes of other processes are seen within
+    /// version_poll_interval, as the file is checked at most that often.
+    static std::string GetVersion(Handle& handle);
+    static constexpr std::chrono::milliseconds version_poll_interval{100};
 
     auto begin() const { return content->As<FindDbData>().begin(); }
     auto begin() { return content->As<FindDbData>().begin(); }
     auto end() const { return content->As<FindDbData>().end(); }
     auto end() { return content->As<FindDbData>().end(); }
     bool empty() const { return !content.is_initialized(); }
+    /// True if the items were found for the bucket representative of the problem, not for the
+    /// problem itself, see problem_buckets.hpp. Callers shall check the solvers are applicable
+    /// and recompute workspace sizes.
+    bool IsFromBucket() const { return from_bucket; }
 
     template <class TProblemDescription>
     static std::vector<PerfField> TryLoad(Handle& handle,
@@ -91,19 +100,27 @@ class FindDbRecord
         auto ret = std::vector<PerfField>{};
         FindDbRecord record{handle, problem};
 
-        if(record.in_sync && !record.CopyValidating(handle, ret))
+        // Find is asked to measure the problem, so items of its bucket are not reused here.
+        if(record.in_sync && !record.from_bucket && !record.CopyValidating(handle, ret))
             return ret;
 
         MIOPEN_LOG_I("Find-db regenerating.");
         ret.clear();
-        record.in_sync = false;
+        record.in_sync     = false;
+        record.from_bucket = false;
         record.content.emplace(problem);
         regenerator(*record.content);
+        if(IsProblemBucketingEnabled())
+            record.StoreToBucket(problem);
+        record.AddRooflineMetrics(handle, problem);
 
         for(const auto& pair : record)
             // cppcheck-suppress useStlAlgorithm
-            ret.push_back(
-                {pair.first, pair.second.solver_id, pair.second.time, pair.second.workspace});
+            ret.push_back({pair.first,
+                           pair.second.solver_id,
+                           pair.second.time,
+                           pair.second.workspace,
+                           pair.second.roofline});
 
         return ret;
     }
@@ -118,13 +135,19 @@ class FindDbRecord
     std::string path;
     boost::optional<DbClass> db;
     boost::optional<DbRecord> content{boost::none};
-    bool in_sync = false;
+    bool in_sync     = false;
+    bool from_bucket = false;
 
     static bool HasKernel(Handle& handle, const FindDbKCacheKey& key);
 
     static std::string GetInstalledPath(Handle& handle);
     static std::string GetUserPath(Handle& handle);
 
+    void LookupBucket(const ProblemDescription& problem);
+    void StoreToBucket(const ProblemDescription& problem);
+    /// Sets the rates achieved by the measured items, see roofline.hpp.
+    void AddRooflineMetrics(Handle& handle, const ProblemDescription& problem);
+
     // Returns true if rebuild is required
     bool CopyValidating(Handle& handle, std::vector<PerfField>& to) const;
 
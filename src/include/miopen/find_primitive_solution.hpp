@@ -0,0 +1,143 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2019 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#ifndef GUARD_MIOPEN_FIND_PRIMITIVE_SOLUTION_HPP_
+#define GUARD_MIOPEN_FIND_PRIMITIVE_SOLUTION_HPP_
+
+#include <miopen/db.hpp>
+#include <miopen/each_args.hpp>
+#include <miopen/errors.hpp>
+#include <miopen/find_solution.hpp>
+#include <miopen/generic_search.hpp>
+#include <miopen/handle.hpp>
+#include <miopen/logger.hpp>
+#include <miopen/mlo_internal.hpp>
+#include <miopen/primitive_context.hpp>
+#include <miopen/solver_policy.hpp>
+#include <miopen/trace.hpp>
+
+#include <limits>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <string>
+
+namespace miopen {
+namespace solver {
+
+template <class Context, class Solution>
+int RunAndMeasurePrimitive(const Context& context, const Solution& solution, float& elapsed_time)
+{
+#ifdef NDEBUG
+    try
+#endif
+    {
+        elapsed_time = std::numeric_limits<float>::max();
+        context.run(solution);
+        elapsed_time = context.GetStream().GetKernelTime();
+    }
+#ifdef NDEBUG
+    catch(miopen::Exception&)
+    {
+        return -1;
+    }
+#endif
+    return 0;
+}
+
+/// Search() of the solvers of the primitives. Times every valid performance config
+/// by launching the primitive through context.run, see PrimitiveContext.
+/// The primitives are expected to consist of a single kernel or the kernel time
+/// of the handle to cover all of them.
+template <class Solver, class Context>
+auto SearchPrimitive(const Solver s, const Context& context)
+    -> decltype(s.GetPerformanceConfig(context))
+{
+    if(!context.run)
+        MIOPEN_THROW("Search of " + SolverDbId(s) + " requires a run function.");
+
+    using PerformanceConfig = decltype(s.GetPerformanceConfig(context));
+    return SearchPerformanceConfig(
+        s, context, context.GetStream(), [&](const PerformanceConfig& config) {
+            const auto solution = s.GetSolution(context, config);
+            return [&, solution](float& elapsed_time) {
+                return RunAndMeasurePrimitive(context, solution, elapsed_time);
+            };
+        });
+}
+
+/// Returns the solution of the first applicable solver: tuned (from the Perf Db) or,
+/// if there is none, chosen by the heuristic of the solver. Searches when MIOPEN_FIND_ENFORCE
+/// requires that. The solvers of a primitive exclude each other, e.g. by direction, so there is
+/// nothing to rank in the Find Db. Unlike convolutions, the primitives have no Find step, so the
+/// result is cached per device, problem and search controls for the lifetime of the process,
+/// and the Perf Db is read only once per problem.
+template <class Solution, class Context, class... Solvers>
+Solution FindPrimitiveSolution(const Context& context, Solvers... solvers)
+{
+    static std::mutex mutex;
+    static std::map<std::string, Solution> found;
+
+    std::ostringstream ss;
+    ss << context.GetStream().GetDbBasename() << ':' << context << ':'
+       << context.disable_search_enforce << context.disable_perfdb_access << context.do_search;
+    const auto key = ss.str();
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        const auto it = found.find(key);
+        if(it != found.end())
+            return it->second;
+    }
+
+    PerfDb db{{context.GetPerfDbPath(), context.GetUserPerfDbPath()}};
+    const auto& policy = GetSolverPolicy(context);
+    Solution solution{};
+    bool applicable = false;
+    each_args(
+        [&](auto solver) {
+            if(applicable || !solver.IsApplicable(context))
+                return;
+            MIOPEN_TRACE_SCOPE("solver", SolverDbId(solver));
+            solution   = FindSolutionImpl(rank<1>{}, solver, context, db, policy);
+            applicable = true;
+        },
+        solvers...);
+
+    if(!applicable)
+    {
+        MIOPEN_THROW(miopenStatusNotImplemented,
+                     "No applicable solvers for the problem: " + ss.str());
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+    found[key] = solution;
+    return solution;
+}
+
+} // namespace solver
+} // namespace miopen
+
+#endif // GUARD_MIOPEN_FIND_PRIMITIVE_SOLUTION_HPP_
@@ -30,7 +30,11 @@
 #include <miopen/env.hpp>
 #include <miopen/conv_solution.hpp>
 #include <miopen/find_controls.hpp>
+#include <miopen/measurement_policy.hpp>
+#include <miopen/solver_policy.hpp>
+#include <miopen/trace.hpp>
 
+#include <sstream>
 #include <vector>
 
 /// Allows to explicitly disable performance filtering heuristics
@@ -40,11 +44,27 @@ MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_AMD_ASM_KERNELS_PERF_FILTERING)
 namespace miopen {
 namespace solver {
 
+/// The policy is the one of the problem, see GetSolverPolicy(). Callers trying several solvers
+/// look it up once for all of them.
 template <class Solver, class Context, class Db>
-auto FindSolutionImpl(rank<1>, Solver s, const Context& context, Db& db)
+auto FindSolutionImpl(
+    rank<1>, Solver s, const Context& context, Db& db, const SolverPolicy& policy)
     -> decltype(s.GetSolution(context, s.Search(context)))
 {
     const FindEnforce enforce;
+    using PerformanceConfig  = decltype(s.GetPerformanceConfig(context));
+    const auto policy_config = policy.FindConfig(SolverDbId(s));
+    if(policy_config != nullptr)
+    {
+        PerformanceConfig config{};
+        if(config.Deserialize(*policy_config) && s.IsValidPerformanceConfig(context, config))
+        {
+            MIOPEN_LOG_I(SolverDbId(s) << " (config from solver policy)");
+            return s.GetSolution(context, config);
+        }
+        MIOPEN_LOG_W("Invalid config in solver policy: " << SolverDbId(s) << ": "
+                                                         << *policy_config);
+    }
     if(context.disable_perfdb_access)
     {
         MIOPEN_LOG_I(SolverDbId(s) << " (db access disabled)");
@@ -55,6 +75,7 @@ auto FindSolutionImpl(rank<1>, Solver s, const Context& context, Db& db)
     {
         if(db.Remove(context, SolverDbId(s)))
             MIOPEN_LOG_W("Perf Db: record removed: " << SolverDbId(s) << ", enforce: " << enforce);
+        db.Remove(context, PerfDbTimingId(SolverDbId(s)));
     }
     else
     {
@@ -64,7 +85,6 @@ auto FindSolutionImpl(rank<1>, Solver s, const Context& context, Db& db)
         }
         else
         {
-            using PerformanceConfig = decltype(s.GetPerformanceConfig(context));
             PerformanceConfig config{};
             if(db.Load(context, SolverDbId(s), config))
             {
@@ -89,8 +109,16 @@ auto FindSolutionImpl(rank<1>, Solver s, const Context& context, Db& db)
             MIOPEN_LOG_I("Starting search: " << SolverDbId(s) << ", enforce: " << enforce);
             try
             {
+                LastSearchTiming() = {};
                 auto c = s.Search(context);
                 db.Update(context, SolverDbId(s), c);
+                const auto& timing = LastSearchTiming();
+                if(timing.samples != 0)
+                {
+                    std::ostringstream ss;
+                    ss << timing.time << ',' << timing.variance << ',' << timing.samples;
+                    db.Update(context, PerfDbTimingId(SolverDbId(s)), ss.str());
+                }
                 return s.GetSolution(context, c);
             }
             catch(const miopen::Exception& ex)
@@ -104,7 +132,7 @@ auto FindSolutionImpl(rank<1>, Solver s, const Context& context, Db& db)
 }
 
 template <class Solver, class Context, class Db>
-auto FindSolutionImpl(rank<0>, Solver s, const Context& context, Db&)
+auto FindSolutionImpl(rank<0>, Solver s, const Context& context, Db&, const SolverPolicy&)
     -> decltype(s.GetSolution(context))
 {
     MIOPEN_LOG_I(SolverDbId(s) << " (not searchable)");
@@ -118,16 +146,23 @@ auto FindSolutionImpl(rank<0>, Solver s, const Context& context, Db&)
 /// Could take long if an exhaustive search is requested/performed.
 /// May read/write perfDb.
 template <class Solver, class Context, class Db>
-ConvSolution FindSolution(Solver s, const Context& context, Db& db)
+ConvSolution FindSolution(Solver s, const Context& context, Db& db, const SolverPolicy& policy)
 {
     static_assert(std::is_empty<Solver>{} && std::is_trivially_constructible<Solver>{},
                   "Solver must be stateless");
+    MIOPEN_TRACE_SCOPE("solver", SolverDbId(s));
     // TODO: This assumes all solutions are ConvSolution
-    auto solution      = FindSolutionImpl(rank<1>{}, s, context, db);
+    auto solution      = FindSolutionImpl(rank<1>{}, s, context, db, policy);
     solution.solver_id = SolverDbId(s);
     return solution;
 }
 
+template <class Solver, class Context, class Db>
+ConvSolution FindSolution(Solver s, const Context& context, Db& db)
+{
+    return FindSolution(s, context, db, GetSolverPolicy(context));
+}
+
 template <class... Solvers>
 struct SolverContainer
 {
@@ -135,7 +170,7 @@ struct SolverContainer
     auto SearchForSolution(const Context& search_params, Db&& db) const
     {
         using Solution = typename std::common_type<decltype(
-            FindSolution(Solvers{}, search_params, db))...>::type;
+            FindSolution(Solvers{}, search_params, db, SolverPolicy{}))...>::type;
         Solution solution{miopenStatusUnknownError};
 
 // Using const here causes gcc to ICE
@@ -144,16 +179,28 @@ struct SolverContainer
 #endif
             auto no_perf_filtering =
                 miopen::IsDisabled(MIOPEN_DEBUG_AMD_ASM_KERNELS_PERF_FILTERING{});
+        const auto& policy = GetSolverPolicy(search_params);
 
         miopen::each_args(
             [&](auto solver) {
+                if(!policy.IsAllowed(SolverDbId(solver)))
+                {
+                    MIOPEN_LOG_I2(SolverDbId(solver) << ": Disabled by solver policy");
+                    return;
+                }
                 if(solver.IsApplicable(search_params) &&
                    (no_perf_filtering || solver.IsFast(search_params)))
                 {
                     if(!solution.Succeeded())
                     {
-                        solution = FindSolution(solver, search_params, db);
-                        if(solution.Succeeded())
+                        solution = FindSolution(solver, search_params, db, policy);
+                        if(solution.Succeeded() && !policy.FitsWorkspace(solution.workspce_sz))
+                        {
+                            MIOPEN_LOG_I2(SolverDbId(solver)
+                                          << ": Workspace exceeds solver policy limit");
+                            solution = Solution{miopenStatusUnknownError};
+                        }
+                        else if(solution.Succeeded())
                         {
                             MIOPEN_LOG_I2(SolverDbId(solver) << ": Success.");
                             if(solution.construction_params.empty())
@@ -179,12 +226,22 @@ struct SolverContainer
     std::vector<Solution> SearchForAllSolutions(const Context& search_params, Db&& db) const
     {
         std::vector<Solution> ss;
+        const auto& policy = GetSolverPolicy(search_params);
         miopen::each_args(
             [&](auto solver) {
-                if(solver.IsApplicable(search_params))
+                if(!policy.IsAllowed(SolverDbId(solver)))
                 {
-                    const Solution s = FindSolution(solver, search_params, db);
-                    if(s.Succeeded())
+                    MIOPEN_LOG_I2(SolverDbId(solver) << ": Disabled by solver policy");
+                }
+                else if(solver.IsApplicable(search_params))
+                {
+                    const Solution s = FindSolution(solver, search_params, db, policy);
+                    if(s.Succeeded() && !policy.FitsWorkspace(s.workspce_sz))
+                    {
+                        MIOPEN_LOG_I2(SolverDbId(solver)
+                                      << ": Workspace exceeds solver policy limit");
+                    }
+                    else if(s.Succeeded())
                     {
                         ss.push_back(s);
                         MIOPEN_LOG_I2(SolverDbId(solver) << ": Success.");
@@ -212,12 +269,18 @@ struct SolverContainer
     std::vector<std::pair<std::string, size_t>> GetWorkspaceSize(const Context& search_params) const
     {
         std::vector<std::pair<std::string, size_t>> res;
+        const auto& policy = GetSolverPolicy(search_params);
         miopen::each_args(
             [&](auto solver) {
-                if(solver.IsApplicable(search_params))
+                if(!policy.IsAllowed(SolverDbId(solver)))
+                {
+                    MIOPEN_LOG_I2(SolverDbId(solver) << ": Disabled by solver policy");
+                }
+                else if(solver.IsApplicable(search_params))
                 {
                     auto sz = solver.GetWorkspaceSize(search_params);
-                    res.push_back(std::make_pair(SolverDbId(solver), sz));
+                    if(policy.FitsWorkspace(sz))
+                        res.push_back(std::make_pair(SolverDbId(solver), sz));
                 }
                 else
                 {
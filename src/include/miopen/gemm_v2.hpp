@@ -145,6 +145,12 @@ GemmDescriptor CreateGemmDescriptorConvBwdWeight(const TensorDescriptor& dyDesc,
                                                  const TensorDescriptor& xDesc,
                                                  const TensorDescriptor& dwDesc);
 
+// GEMM parameters for 1x1 Convolution of channels-last tensors Fwd
+// y = x * transpose(w)
+GemmDescriptor CreateGemmDescriptorConvNHWCFwd(const TensorDescriptor& wDesc,
+                                               const TensorDescriptor& xDesc,
+                                               const TensorDescriptor& yDesc);
+
 // GEMM parameters for 1x1 Convolution (using CNHW) Fwd
 // y = CNHW2NCHW(w * NCHW2CNHW(x))
 GemmDescriptor CreateGemmDescriptorConvCNHWFwd(const TensorDescriptor& wDesc,
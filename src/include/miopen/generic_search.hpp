@@ -37,6 +37,7 @@
 
 #include <miopen/logger.hpp>
 #include <miopen/handle.hpp>
+#include <miopen/measurement_policy.hpp>
 
 namespace miopen {
 namespace solver {
@@ -267,6 +268,124 @@ enum class SearchTweak
     WorkspaceInsteadOfWeightsBuffer,
 };
 
+/// Runs all the performance configs of the solver for the problem and returns the fastest one.
+/// MakeRunner(const PerformanceConfig&) shall return a callable which runs the config once,
+/// writes the time into its float& argument and returns non-zero on failure.
+/// The default config of the solver is measured last to show the score of the search.
+template <class Solver, class Context, class MakeRunner>
+auto SearchPerformanceConfig(const Solver s,
+                             const Context& context,
+                             Handle& profile_h,
+                             MakeRunner make_runner)
+    -> decltype(s.GetPerformanceConfig(context))
+{
+    using PerformanceConfig = decltype(s.GetPerformanceConfig(context));
+    PerformanceConfig best_config;
+    AutoEnableProfiling enableProfiling{profile_h};
+
+    const ComputedContainer<PerformanceConfig, Context> main(context);
+    const int main_size = std::distance(main.begin(), main.end());
+    const ComputedContainer<PerformanceConfig, Context> spare(context, true);
+    const int spare_size = std::distance(spare.begin(), spare.end());
+    const bool useSpare  = (main_size == 0);
+
+    const ComputedContainer<PerformanceConfig, Context> all_configs = useSpare ? spare : main;
+    const int n_runs_total = useSpare ? spare_size : main_size;
+    MIOPEN_LOG_W(SolverDbId(s) << ": Searching the best solution among " << n_runs_total
+                               << (useSpare ? " (spare)" : "")
+                               << "...");
+
+    const auto policy = MeasurementPolicy::FromEnv();
+    MeasurementResult best_timing;
+    bool is_passed   = false; // left false only if all iterations failed.
+    float best_time  = std::numeric_limits<float>::max();
+    size_t n_failed  = 0;
+    size_t n_current = 0;
+    size_t n_best    = 0;
+    HeartBeat<PerformanceConfig> heartbeat;
+    heartbeat.Start();
+
+    profile_h.EnableProfiling(true);
+    for(const auto& current_config : all_configs)
+    {
+        MIOPEN_LOG_I2('#' << n_current << '/' << n_failed << '/' << n_runs_total << ' '
+                          << current_config);
+
+        // Smooth the jitter of measurements: configs which look promising after
+        // the first probe are re-run until their time is known well enough.
+        const auto timing        = policy.Measure(make_runner(current_config), best_time);
+        const int ret            = timing.ret;
+        const float elapsed_time = timing.time;
+        MIOPEN_LOG_T("##"
+                     << "(n_current, n_failed, n_runs_total):  "
+                     << n_current
+                     << '/'
+                     << n_failed
+                     << '/'
+                     << n_runs_total
+                     << " elapsed_time: "
+                     << elapsed_time
+                     << ", best_time: "
+                     << best_time
+                     << ", "
+                     << current_config);
+
+        if(ret == 0)
+        {
+            is_passed = true;
+            if(!timing.probe_only && elapsed_time < best_time)
+            {
+                MIOPEN_LOG_I('#' << n_current << '/' << n_failed << '/' << n_runs_total << ' '
+                                 << timing
+                                 << " < "
+                                 << best_time
+                                 << ' '
+                                 << current_config);
+                best_config = current_config;
+                best_time   = elapsed_time;
+                best_timing = timing;
+                n_best      = n_current;
+            }
+            else
+            {
+                MIOPEN_LOG_I2("Not better: " << timing << " >= " << best_time);
+            }
+        }
+
+        if(ret != 0)
+        {
+            MIOPEN_LOG_E('#' << n_current << " (" << n_runs_total << ") "
+                             << " Failed rc="
+                             << ret);
+            ++n_failed;
+        }
+        heartbeat.Monitor(
+            ret != 0, elapsed_time, n_current, best_time, n_failed, n_runs_total, current_config);
+        ++n_current;
+    }
+
+    profile_h.EnableProfiling(false);
+    MIOPEN_LOG_W("Done: " << n_runs_total << '/' << n_failed << '/' << n_runs_total << ", best #"
+                          << n_best
+                          << ' '
+                          << best_time
+                          << ' '
+                          << best_config);
+    if(!is_passed)
+        MIOPEN_THROW("Search failed");
+    LastSearchTiming() = best_timing;
+    // Measure the default config the same way and show score.
+    profile_h.EnableProfiling(true);
+    const auto default_timing = policy.Measure(make_runner(s.GetPerformanceConfig(context)));
+    if(default_timing.ret == 0)
+    {
+        const float score = (best_time > 0.0f) ? default_timing.time / best_time : 0.0f;
+        MIOPEN_LOG_W("...Score: " << score << " (default time " << default_timing << ')');
+    }
+    profile_h.EnableProfiling(false);
+    return best_config;
+}
+
 /// Solver member function requirements:
 /// * GetPerformanceConfig shall be implemented.
 ///   - Its return type shall be suitable for instantiation of the ComputedContainer.
@@ -367,8 +486,7 @@ auto GenericSearch(const Solver s,
 #endif
     -> decltype(s.GetPerformanceConfig(context))
 {
-    using PerformanceConfig = decltype(s.GetPerformanceConfig(context));
-    PerformanceConfig best_config;
+    using PerformanceConfig     = decltype(s.GetPerformanceConfig(context));
     const auto default_solution = s.GetSolution(context, s.GetPerformanceConfig(context));
 
 #if MIOPEN_ALLOC_BUFFERS
@@ -446,165 +564,30 @@ auto GenericSearch(const Solver s,
     default: MIOPEN_THROW("GenericSearch: Unsupported SearchTweak value.");
     }
 #endif
-    AutoEnableProfiling enableProfiling{profile_h};
-
-    const ComputedContainer<PerformanceConfig, Context> main(context);
-    const int main_size = std::distance(main.begin(), main.end());
-    const ComputedContainer<PerformanceConfig, Context> spare(context, true);
-    const int spare_size = std::distance(spare.begin(), spare.end());
-    const bool useSpare  = (main_size == 0);
-
-    const ComputedContainer<PerformanceConfig, Context> all_configs = useSpare ? spare : main;
-    const int n_runs_total = useSpare ? spare_size : main_size;
-    MIOPEN_LOG_W(SolverDbId(s) << ": Searching the best solution among " << n_runs_total
-                               << (useSpare ? " (spare)" : "")
-                               << "...");
-
-    bool is_passed   = false; // left false only if all iterations failed.
-    float best_time  = std::numeric_limits<float>::max();
-    size_t n_failed  = 0;
-    size_t n_current = 0;
-    size_t n_best    = 0;
-    HeartBeat<PerformanceConfig> heartbeat;
-    heartbeat.Start();
-
-    profile_h.EnableProfiling(true);
-    for(const auto& current_config : all_configs)
-    {
-        float elapsed_time = 0.0f;
-        int ret            = 0;
-        MIOPEN_LOG_I2('#' << n_current << '/' << n_failed << '/' << n_runs_total << ' '
-                          << current_config);
-
-        const auto current_solution = s.GetSolution(context, current_config, true);
-        if((tweak == SearchTweak::WorkspaceInsteadOfXBuffer ||
-            tweak == SearchTweak::WorkspaceInsteadOfWeightsBuffer) &&
-           default_solution.workspce_sz != current_solution.workspce_sz)
-        {
-            ret = -2;
-            MIOPEN_LOG_E('#' << n_current << " (" << n_runs_total << ") "
-                             << "Workspace size should not depend on PerformanceConfig: "
-                             << default_solution.workspce_sz
-                             << " != "
-                             << current_solution.workspce_sz);
-        }
-
-        if(ret == 0)
-        {
-            ret = s.RunAndMeasureSolution(profile_h,
-                                          bot_ocl_ptr,
-                                          top_ocl_ptr,
-                                          wei_ocl_ptr,
-                                          bias_ocl_ptr,
-                                          context,
-                                          current_solution,
-                                          elapsed_time);
-        }
-        MIOPEN_LOG_T("##"
-                     << "(n_current, n_failed, n_runs_total):  "
-                     << n_current
-                     << '/'
-                     << n_failed
-                     << '/'
-                     << n_runs_total
-                     << " elapsed_time: "
-                     << elapsed_time
-                     << ", best_time: "
-                     << best_time
-                     << ", "
-                     << current_config);
-
-        if(ret == 0)
-        {
-            // Smooth the jitter of measurements:
-            // If the 1st probe is NOT too bad (measured time <= 1.05 * best known time),
-            // then re-run it 4 times more and compute average time,
-            // and decide using average of all 5 attempts vs. the best.
-            if(elapsed_time / best_time < 1.05f)
-            {
-                MIOPEN_LOG_I2("Finding average for: " << elapsed_time << " / " << best_time << " = "
-                                                      << (elapsed_time / best_time));
-                float temp;
-                for(int i = 0; i < 4; ++i)
-                {
-                    ret = s.RunAndMeasureSolution(profile_h,
-                                                  bot_ocl_ptr,
-                                                  top_ocl_ptr,
-                                                  wei_ocl_ptr,
-                                                  bias_ocl_ptr,
-                                                  context,
-                                                  current_solution,
-                                                  temp);
-                    if(ret != 0)
-                    {
-                        break;
-                    }
-                    elapsed_time += temp;
-                }
-                if(ret == 0)
-                {
-                    is_passed = true;
-                    elapsed_time /= 5;
-                    if(elapsed_time < best_time)
-                    {
-                        MIOPEN_LOG_I('#' << n_current << '/' << n_failed << '/' << n_runs_total
-                                         << ' '
-                                         << elapsed_time
-                                         << " < "
-                                         << best_time
-                                         << ' '
-                                         << current_config);
-                        best_config = current_config;
-                        best_time   = elapsed_time;
-                        n_best      = n_current;
-                    }
-                    else
-                    {
-                        MIOPEN_LOG_I2(
-                            "Average is not better: " << elapsed_time << " >= " << best_time);
-                    }
-                }
-            }
-        }
-
-        if(ret != 0)
-        {
-            MIOPEN_LOG_E('#' << n_current << " (" << n_runs_total << ") "
-                             << " Failed rc="
-                             << ret);
-            ++n_failed;
-        }
-        heartbeat.Monitor(
-            ret != 0, elapsed_time, n_current, best_time, n_failed, n_runs_total, current_config);
-        ++n_current;
-    }
-
-    profile_h.EnableProfiling(false);
-    MIOPEN_LOG_W("Done: " << n_runs_total << '/' << n_failed << '/' << n_runs_total << ", best #"
-                          << n_best
-                          << ' '
-                          << best_time
-                          << ' '
-                          << best_config);
-    if(!is_passed)
-        MIOPEN_THROW("Search failed");
-    // Run once with the default config and show score.
-    float default_time = 0.0f;
-    profile_h.EnableProfiling(true);
-    if(s.RunAndMeasureSolution(profile_h,
-                               bot_ocl_ptr,
-                               top_ocl_ptr,
-                               wei_ocl_ptr,
-                               bias_ocl_ptr,
-                               context,
-                               default_solution,
-                               default_time) == 0)
-    {
-        const float score = (best_time > 0.0f) ? default_time / best_time : 0.0f;
-        MIOPEN_LOG_W("...Score: " << score << " (default time " << default_time << ')');
-    }
-    profile_h.EnableProfiling(false);
-    return best_config;
+    return SearchPerformanceConfig(s, context, profile_h, [&](const PerformanceConfig& config) {
+        const auto solution = s.GetSolution(context, config, true);
+        const bool workspace_mismatch =
+            (tweak == SearchTweak::WorkspaceInsteadOfXBuffer ||
+             tweak == SearchTweak::WorkspaceInsteadOfWeightsBuffer) &&
+            default_solution.workspce_sz != solution.workspce_sz;
+        if(workspace_mismatch)
+            MIOPEN_LOG_E("Workspace size should not depend on PerformanceConfig: "
+                         << default_solution.workspce_sz
+                         << " != "
+                         << solution.workspce_sz);
+        return [&, solution, workspace_mismatch](float& elapsed_time) {
+            if(workspace_mismatch)
+                return -2;
+            return s.RunAndMeasureSolution(profile_h,
+                                           bot_ocl_ptr,
+                                           top_ocl_ptr,
+                                           wei_ocl_ptr,
+                                           bias_ocl_ptr,
+                                           context,
+                                           solution,
+                                           elapsed_time);
+        };
+    });
 }
 
 } // namespace solver
@@ -28,6 +28,7 @@
 
 #include <cstdio>
 #include <cstring>
+#include <limits>
 #include <memory>
 #include <miopen/config.h>
 #include <miopen/common.hpp>
@@ -48,6 +49,10 @@
 namespace miopen {
 
 struct HandleImpl;
+class CompileQueue;
+class KernelBundle;
+class CheckNumericsRing;
+class WorkspaceArena;
 #if MIOPEN_USE_MIOPENGEMM
 struct GemmGeometry;
 using GemmKey = std::pair<std::string, std::string>;
@@ -120,12 +125,18 @@ struct Handle : miopenHandle
                         bool is_kernel_str,
                         const std::string& kernel_src);
 
+    /// Registers the kernels of the bundle in the kernel cache. The programs of the bundle are
+    /// never compiled or looked up in the binary cache by this handle afterwards.
+    void LoadKernelBundle(const std::string& path);
+
     void Finish() const;
     void Flush() const;
 
     std::size_t GetLocalMemorySize();
     std::size_t GetGlobalMemorySize();
     std::size_t GetMaxComputeUnits();
+    /// In MHz.
+    std::size_t GetMaxClockFrequency();
     std::size_t GetImage3dMaxWidth();
 
     std::size_t m_MaxMemoryAllocSizeCached = 0;
@@ -182,6 +193,18 @@ struct Handle : miopenHandle
 #if MIOPEN_USE_MIOPENGEMM
     std::unordered_map<GemmKey, std::unique_ptr<GemmGeometry>, SimpleHash> geo_map;
 #endif
+    /// Accessed with std::atomic_load() and std::atomic_store(), as the compile jobs read it.
+    std::shared_ptr<const KernelBundle> kernel_bundle;
+    /// Background compilation, see GetCompileQueue(). Declared after impl and kernel_bundle,
+    /// and stopped first by ~Handle(), so that running jobs finish before what they use is
+    /// released.
+    std::unique_ptr<CompileQueue> compile_queue;
+    /// Results of the deferred numerics checks, see CheckNumerics::Deferred.
+    std::unique_ptr<CheckNumericsRing> check_numerics_ring;
+    /// Memory the application spends on convolution workspaces, see miopenSetWorkspaceBudget().
+    std::size_t workspace_budget = std::numeric_limits<std::size_t>::max();
+    /// Provides the workspace of the calls passed none, see miopenEnableWorkspaceArena().
+    std::unique_ptr<WorkspaceArena> workspace_arena;
 
 #if MIOPEN_USE_ROCBLAS
     rocblas_handle_ptr& rhandle() { return rhandle_; }
@@ -30,6 +30,7 @@
 #include <miopen/manage_ptr.hpp>
 #include <boost/filesystem/path.hpp>
 #include <string>
+#include <vector>
 
 namespace miopen {
 
@@ -44,6 +45,8 @@ struct HIPOCProgram
                  std::string dev_name,
                  const std::string& kernel_src);
     HIPOCProgram(const std::string& program_name, const boost::filesystem::path& hsaco);
+    /// Loads the code object from memory, no file is involved.
+    HIPOCProgram(const std::string& program_name, const std::vector<char>& code_object);
     std::shared_ptr<const HIPOCProgramImpl> impl;
     hipModule_t GetModule() const;
     boost::filesystem::path GetBinary() const;
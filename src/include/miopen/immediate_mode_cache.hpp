@@ -0,0 +1,85 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2019 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#ifndef GUARD_MIOPEN_IMMEDIATE_MODE_CACHE_HPP_
+#define GUARD_MIOPEN_IMMEDIATE_MODE_CACHE_HPP_
+
+#include <miopen/miopen.h>
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace miopen {
+
+/// Answer to the immediate mode queries of a problem.
+struct ImmediateSolutions
+{
+    /// Enabled and applicable solutions, fastest first. Get*SolutionCount() and
+    /// Get*Solution() return the ones within the workspace budget of the handle.
+    std::vector<miopenConvSolution_t> solutions;
+};
+
+/// Process-wide cache of the immediate mode queries, so frameworks that query every layer on
+/// each shape change do not parse the find-db and check applicability of solvers every time.
+/// Entries are keyed by the problem and the device, and each remembers the version of the
+/// find-db it was computed from (see FindDbRecord::GetVersion()). An entry is recomputed as
+/// soon as the find-db changes.
+class ImmediateModeCache
+{
+    public:
+    /// The cache is dropped when it grows beyond that.
+    static constexpr std::size_t max_entries = 4096;
+
+    static ImmediateModeCache& Get();
+
+    /// Returns nullptr if there is no entry of key computed from the given find-db version.
+    std::shared_ptr<const ImmediateSolutions> Find(const std::string& key,
+                                                   const std::string& version);
+
+    void Insert(const std::string& key,
+                const std::string& version,
+                std::shared_ptr<const ImmediateSolutions> solutions);
+
+    void Clear();
+
+    private:
+    struct Entry
+    {
+        std::string version;
+        std::shared_ptr<const ImmediateSolutions> solutions;
+    };
+
+    std::mutex mutex;
+    std::unordered_map<std::string, Entry> entries;
+};
+
+} // namespace miopen
+
+#endif // GUARD_MIOPEN_IMMEDIATE_MODE_CACHE_HPP_
@@ -0,0 +1,110 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2019 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#ifndef GUARD_MIOPEN_KERNEL_BUNDLE_HPP_
+#define GUARD_MIOPEN_KERNEL_BUNDLE_HPP_
+
+#include <cstddef>
+#include <istream>
+#include <map>
+#include <ostream>
+#include <string>
+#include <tuple>
+#include <vector>
+
+namespace miopen {
+
+struct Handle;
+
+/// Kernel registered in the kernel cache under (algorithm, network_config), with the arguments
+/// of Handle::AddKernel() it was built from.
+struct BundleKernel
+{
+    std::string algorithm;
+    std::string network_config;
+    std::size_t cache_index = 0;
+    std::string program_name;
+    std::string params;
+    bool is_kernel_str = false;
+    std::string kernel_name;
+    std::vector<std::size_t> vld;
+    std::vector<std::size_t> vgd;
+};
+
+bool operator==(const BundleKernel& left, const BundleKernel& right);
+
+/// Precompiled code objects of a fixed set of problems and the kernels the solutions of these
+/// problems register in the kernel cache. Loading a bundle into a handle makes these kernels
+/// available without compilation, the binary cache or a temporary directory.
+///
+/// Bundles are produced by recording a run of the problems on the target device, see
+/// StartKernelBundleRecording(), and are valid for the device they were recorded on only.
+class KernelBundle
+{
+    public:
+    /// Same arguments as given to Handle::LoadProgram().
+    using ProgramKey = std::tuple<std::string, std::string, bool>;
+
+    std::string device;
+    std::map<ProgramKey, std::string> programs;
+    std::vector<BundleKernel> kernels;
+
+    /// \return nullptr if the bundle has no binary for the program.
+    const std::string* FindProgram(const std::string& program_name,
+                                   const std::string& params,
+                                   bool is_kernel_str) const;
+
+    void AddProgram(const std::string& program_name,
+                    const std::string& params,
+                    bool is_kernel_str,
+                    std::string binary);
+    /// Kernels already in the bundle are ignored.
+    void AddKernel(const BundleKernel& kernel);
+
+    /// Binary format: magic, version, then the contents followed by their md5.
+    void Write(std::ostream& stream) const;
+    static KernelBundle Read(std::istream& stream);
+
+    void Save(const std::string& path) const;
+    static KernelBundle Load(const std::string& path);
+};
+
+/// Starts recording the programs loaded and the kernels added by all handles of the process.
+void StartKernelBundleRecording();
+bool IsRecordingKernelBundle();
+void RecordBundleProgram(const std::string& device,
+                         const std::string& program_name,
+                         const std::string& params,
+                         bool is_kernel_str,
+                         std::string binary);
+void RecordBundleKernel(const BundleKernel& kernel);
+/// Stops the recording and returns what has been recorded. Throws if the recorded programs were
+/// built for different devices.
+KernelBundle StopKernelBundleRecording();
+
+} // namespace miopen
+
+#endif // GUARD_MIOPEN_KERNEL_BUNDLE_HPP_
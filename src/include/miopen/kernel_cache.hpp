@@ -46,6 +46,7 @@
 #include <miopen/kernel.hpp>
 #include <miopen/simple_hash.hpp>
 #include <miopen/miopen.h>
+#include <mutex>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -88,6 +89,9 @@ class KernelCache
     KernelCache();
 
     private:
+    /// Guards the maps, so programs can be built by background compilation (see
+    /// CompileQueue) while the handle is in use. Programs are built without holding it.
+    mutable std::mutex mutex;
     KernelMap kernel_map;
     ProgramMap program_map;
 };
@@ -0,0 +1,79 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2019 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#ifndef GUARD_MIOPEN_LAYOUT_PLANNER_HPP_
+#define GUARD_MIOPEN_LAYOUT_PLANNER_HPP_
+
+#include <miopen/convolution.hpp>
+#include <miopen/tensor.hpp>
+
+#include <cstddef>
+#include <vector>
+
+namespace miopen {
+
+/// A forward convolution of a chain. The output of a layer is the input of the next one.
+struct LayoutPlanLayer
+{
+    ConvolutionDescriptor conv;
+    TensorDescriptor xDesc;
+    TensorDescriptor wDesc;
+};
+
+struct LayoutPlanStep
+{
+    /// Layouts of x and y to pass to ConvolutionDescriptor::ConvolutionForwardGemm().
+    ConvLayout input  = ConvLayout::NCHW;
+    ConvLayout output = ConvLayout::NCHW;
+    /// Transpose kernels the layer launches, including the subsampling of a strided CNHW input.
+    std::size_t transposes = 0;
+};
+
+/// Layouts of the layers of a chain run with the GEMM algorithm, see PlanConvLayouts().
+struct LayoutPlan
+{
+    std::vector<LayoutPlanStep> steps;
+    std::size_t transposes = 0;
+    /// Transposes launched when every layer reads and writes NCHW tensors.
+    std::size_t baseline_transposes = 0;
+};
+
+/// Plans the layouts of the activations of a chain of convolutions run with the GEMM algorithm.
+/// A layer on the transpose path (ConvolutionDescriptor::IsGemmTransposeFwd()) transposes its
+/// input to CNHW and its output back to NCHW. When two such layers follow each other, the
+/// intermediate tensor stays in CNHW, so the output transpose of the first layer is skipped, and
+/// so is the input transpose of the second one unless it has to subsample a strided input.
+/// The input and the output of the chain are NCHW. Int8 layers always use NCHW.
+/// Throws if the input of a layer does not match the output of the previous one.
+///
+/// This is a library-internal utility: the public API has no CNHW tensors and runs every layer
+/// on NCHW, so nothing calls it on the regular forward path. A caller owning the buffers of a
+/// whole chain runs its steps with ConvolutionForwardGemm().
+LayoutPlan PlanConvLayouts(const std::vector<LayoutPlanLayer>& layers);
+
+} // namespace miopen
+
+#endif // GUARD_MIOPEN_LAYOUT_PLANNER_HPP_
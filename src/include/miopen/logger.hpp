@@ -34,6 +34,7 @@
 
 #include <miopen/each_args.hpp>
 #include <miopen/object.hpp>
+#include <miopen/trace.hpp>
 
 // See https://github.com/pfultz2/Cloak/wiki/C-Preprocessor-tricks,-tips,-and-idioms
 #define MIOPEN_PP_CAT(x, y) MIOPEN_PP_PRIMITIVE_CAT(x, y)
@@ -203,6 +204,22 @@ inline void* LogObjImpl(void* x) { return x; }
 
 inline const void* LogObjImpl(const void* x) { return x; }
 
+/// Name of the outermost function logged with MIOPEN_LOG_FUNCTION which the calling thread is
+/// executing, i.e. the API call in progress, or nullptr.
+const char* GetCurrentApiCall();
+
+class ApiCallScope
+{
+    public:
+    explicit ApiCallScope(const char* name);
+    ApiCallScope(const ApiCallScope&) = delete;
+    ApiCallScope& operator=(const ApiCallScope&) = delete;
+    ~ApiCallScope();
+
+    private:
+    bool outermost;
+};
+
 #ifndef _MSC_VER
 template <class T, typename std::enable_if<(std::is_pointer<T>{}), int>::type = 0>
 std::ostream& LogParam(std::ostream& os, std::string name, const T& x)
@@ -235,6 +252,11 @@ std::ostream& LogParam(std::ostream& os, std::string name, const T& x)
     } while(false);
 
 #define MIOPEN_LOG_FUNCTION(...)                                                        \
+    const miopen::ApiCallScope MIOPEN_TRACE_PP_CAT(miopen_api_call_scope_, __LINE__)(   \
+        __func__); /* NOLINT */                                                         \
+    MIOPEN_TRACE_SCOPE("call",                                                          \
+                       miopen::LoggingParseFunction(__func__,            /* NOLINT */   \
+                                                    __PRETTY_FUNCTION__) /* NOLINT */); \
     do                                                                                  \
         if(miopen::IsLoggingFunctionCalls())                                            \
         {                                                                               \
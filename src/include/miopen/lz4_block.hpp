@@ -0,0 +1,180 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2019 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#ifndef GUARD_MIOPEN_LZ4_BLOCK_HPP_
+#define GUARD_MIOPEN_LZ4_BLOCK_HPP_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+// Self-contained codec of the LZ4 block format, used for the embedded kernel sources. Only the
+// standard library is used, so the header is shared by addkernels (compression at build time)
+// and the library (decompression at run time) without a new dependency.
+
+namespace miopen {
+namespace lz4 {
+
+constexpr std::size_t min_match     = 4;
+constexpr std::size_t last_literals = 5;  // The last bytes of a block are always literals.
+constexpr std::size_t mf_limit      = 12; // A match never starts closer to the end.
+constexpr std::size_t max_offset    = 65535;
+constexpr unsigned int hash_log     = 16;
+
+inline std::uint32_t Read32(const char* p)
+{
+    std::uint32_t value;
+    std::memcpy(&value, p, sizeof(value));
+    return value;
+}
+
+inline std::size_t Hash(std::uint32_t sequence)
+{
+    return (sequence * 2654435761U) >> (32 - hash_log);
+}
+
+inline void WriteLength(std::string& out, std::size_t length)
+{
+    for(; length >= 255; length -= 255)
+        out.push_back(static_cast<char>(255));
+    out.push_back(static_cast<char>(length));
+}
+
+} // namespace lz4
+
+/// Greedy single-pass compression into an LZ4 block.
+inline std::string Lz4Compress(const char* src, std::size_t size)
+{
+    using namespace lz4;
+    std::string out;
+    out.reserve(size / 2 + 16);
+    // Position + 1 of the last occurrence of a hashed 4-byte sequence, 0 if none.
+    std::vector<std::size_t> table(std::size_t(1) << hash_log, 0);
+    std::size_t anchor = 0;
+    std::size_t pos    = 0;
+
+    while(size >= mf_limit && pos <= size - mf_limit)
+    {
+        const auto sequence = Read32(src + pos);
+        auto& entry         = table[Hash(sequence)];
+        const auto previous = entry;
+        entry               = pos + 1;
+        if(previous == 0 || pos - (previous - 1) > max_offset ||
+           Read32(src + previous - 1) != sequence)
+        {
+            ++pos;
+            continue;
+        }
+
+        const std::size_t ref = previous - 1;
+        std::size_t length    = min_match;
+        while(pos + length < size - last_literals && src[ref + length] == src[pos + length])
+            ++length;
+
+        const std::size_t literals = pos - anchor;
+        const std::size_t extra    = length - min_match;
+        out.push_back(static_cast<char>((std::min<std::size_t>(literals, 15) << 4) |
+                                        std::min<std::size_t>(extra, 15)));
+        if(literals >= 15)
+            WriteLength(out, literals - 15);
+        out.append(src + anchor, literals);
+        const std::size_t offset = pos - ref;
+        out.push_back(static_cast<char>(offset & 0xff));
+        out.push_back(static_cast<char>(offset >> 8));
+        if(extra >= 15)
+            WriteLength(out, extra - 15);
+
+        pos += length;
+        anchor = pos;
+    }
+
+    const std::size_t literals = size - anchor;
+    out.push_back(static_cast<char>(std::min<std::size_t>(literals, 15) << 4));
+    if(literals >= 15)
+        WriteLength(out, literals - 15);
+    out.append(src + anchor, literals);
+    return out;
+}
+
+/// Decompresses an LZ4 block into exactly dst_size bytes.
+/// \return false if the block is malformed or does not decompress into dst_size bytes.
+inline bool
+Lz4Decompress(const unsigned char* src, std::size_t src_size, char* dst, std::size_t dst_size)
+{
+    std::size_t ip = 0;
+    std::size_t op = 0;
+
+    const auto read_length = [&](std::size_t& length) {
+        unsigned char byte;
+        do
+        {
+            if(ip >= src_size)
+                return false;
+            byte = src[ip++];
+            length += byte;
+        } while(byte == 255);
+        return true;
+    };
+
+    while(ip < src_size)
+    {
+        const unsigned int token = src[ip++];
+        std::size_t literals     = token >> 4;
+        if(literals == 15 && !read_length(literals))
+            return false;
+        if(literals > src_size - ip || literals > dst_size - op)
+            return false;
+        std::memcpy(dst + op, src + ip, literals);
+        ip += literals;
+        op += literals;
+        if(ip == src_size)
+            break; // The last sequence has no match.
+
+        if(src_size - ip < 2)
+            return false;
+        const std::size_t offset = src[ip] | (static_cast<std::size_t>(src[ip + 1]) << 8);
+        ip += 2;
+        if(offset == 0 || offset > op)
+            return false;
+        std::size_t length = token & 15;
+        if(length == 15 && !read_length(length))
+            return false;
+        length += lz4::min_match;
+        if(length > dst_size - op)
+            return false;
+        // Byte by byte, as the match may overlap the output.
+        for(const auto end = op + length; op < end; ++op)
+            dst[op] = dst[op - offset];
+    }
+    return op == dst_size;
+}
+
+} // namespace miopen
+
+#endif // GUARD_MIOPEN_LZ4_BLOCK_HPP_
@@ -0,0 +1,161 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2019 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#ifndef GUARD_MIOPEN_MEASUREMENT_POLICY_HPP_
+#define GUARD_MIOPEN_MEASUREMENT_POLICY_HPP_
+
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace miopen {
+namespace solver {
+
+struct MeasurementResult
+{
+    /// Non-zero code returned by the first failed run, zero if all runs succeeded.
+    int ret = 0;
+    /// Estimated time of the solution, ms.
+    float time = 0.0f;
+    /// Variance of the samples used for the estimate, ms^2.
+    float variance = 0.0f;
+    /// Half-width of the 95% confidence interval of the mean, ms.
+    float ci_half_width = 0.0f;
+    /// Number of samples the estimate is based on, after outlier rejection.
+    std::size_t samples  = 0;
+    std::size_t outliers = 0;
+    /// The solution was rejected after the first probe, so the time is a single sample.
+    bool probe_only = false;
+
+    friend std::ostream& operator<<(std::ostream& os, const MeasurementResult& r)
+    {
+        return os << r.time << " ms (var " << r.variance << ", n " << r.samples << ", outliers "
+                  << r.outliers << (r.probe_only ? ", probe only)" : ")");
+    }
+};
+
+/// Decides how many times a solution is run during the search, and how its time
+/// is estimated from the samples.
+///
+/// The first run is a probe. If it is slower than probe_ratio * best known time, the solution
+/// is not promising and the probe is returned as is. Otherwise the solution is run warmup_runs
+/// times (the probe counts as the first warm-up run), and then sampled until either
+/// the 95% confidence interval of the time is narrow enough, or it lies entirely above the best
+/// known time, or max_runs samples are taken. Samples too far from the median (in terms of the
+/// median absolute deviation) are dropped before estimating the time by the median or
+/// the trimmed mean of the rest.
+///
+/// The defaults can be overridden with the MIOPEN_SEARCH_* environment variables,
+/// see FromEnv().
+struct MeasurementPolicy
+{
+    enum class Estimator
+    {
+        Median,
+        TrimmedMean,
+    };
+
+    std::size_t warmup_runs = 1;
+    std::size_t min_runs    = 3;
+    std::size_t max_runs    = 10;
+    Estimator estimator     = Estimator::Median;
+    /// Fraction of samples dropped from each end by the trimmed mean.
+    float trim_fraction = 0.2f;
+    /// Samples with |x - median| > outlier_threshold * 1.4826 * MAD are outliers.
+    float outlier_threshold = 3.5f;
+    /// Sampling stops when the CI half-width is below this fraction of the estimate.
+    float ci_relative_width = 0.01f;
+    float probe_ratio       = 1.1f;
+
+    /// Default policy adjusted by MIOPEN_SEARCH_WARMUP_RUNS, MIOPEN_SEARCH_MIN_RUNS,
+    /// MIOPEN_SEARCH_MAX_RUNS and MIOPEN_SEARCH_ESTIMATOR ("median" or "trimmed_mean").
+    static MeasurementPolicy FromEnv();
+
+    /// Estimate from the samples taken so far.
+    MeasurementResult Estimate(std::vector<float> samples) const;
+
+    /// Runs the solution according to the policy.
+    /// run(float& elapsed) runs the solution once, stores its time and returns 0 on success.
+    template <class Run>
+    MeasurementResult Measure(Run run, float best_time = std::numeric_limits<float>::max()) const
+    {
+        MeasurementResult result;
+        float elapsed = 0.0f;
+
+        result.ret = run(elapsed);
+        if(result.ret != 0)
+            return result;
+        if(best_time < std::numeric_limits<float>::max() && elapsed > best_time * probe_ratio)
+        {
+            result.time       = elapsed;
+            result.samples    = 1;
+            result.probe_only = true;
+            return result;
+        }
+
+        std::vector<float> samples;
+        if(warmup_runs == 0)
+            samples.push_back(elapsed);
+        for(std::size_t i = 1; i < warmup_runs; ++i)
+        {
+            result.ret = run(elapsed);
+            if(result.ret != 0)
+                return result;
+        }
+
+        while(samples.size() < std::max<std::size_t>(max_runs, 1))
+        {
+            result.ret = run(elapsed);
+            if(result.ret != 0)
+                return result;
+            samples.push_back(elapsed);
+
+            if(samples.size() < min_runs)
+                continue;
+            result = Estimate(samples);
+            if(result.ci_half_width <= ci_relative_width * result.time ||
+               result.time - result.ci_half_width > best_time)
+                return result;
+        }
+        return Estimate(samples);
+    }
+};
+
+/// Perf-db id under which the timing of the config found by the search is stored,
+/// next to the config itself.
+inline std::string PerfDbTimingId(const std::string& solver_id) { return solver_id + ".timing"; }
+
+/// Timing of the best config found by the last search on the calling thread.
+/// Set by GenericSearch(), used by FindSolution() to record it in the perf-db.
+MeasurementResult& LastSearchTiming();
+
+} // namespace solver
+} // namespace miopen
+
+#endif // GUARD_MIOPEN_MEASUREMENT_POLICY_HPP_
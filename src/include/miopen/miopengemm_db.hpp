@@ -0,0 +1,87 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2019 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#ifndef GUARD_MIOPEN_MIOPENGEMM_DB_HPP_
+#define GUARD_MIOPEN_MIOPENGEMM_DB_HPP_
+
+#include <boost/optional.hpp>
+
+#include <cstddef>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace miopen {
+
+struct Handle;
+
+/// Kernel of a MIOpenGEMM solution, as passed to Handle::AddKernel().
+struct MiopengemmKernel
+{
+    std::string name;
+    std::string source;
+    std::size_t local_work_size  = 0;
+    std::size_t global_work_size = 0;
+};
+
+/// Kernels chosen by MIOpenGEMM for a GEMM geometry, in the order of the solution: the main kernel
+/// is the last one. Kernel sources are escaped, so they fit into a single db line.
+struct MiopengemmKernels
+{
+    std::vector<MiopengemmKernel> kernels;
+
+    void Serialize(std::ostream& stream) const;
+    bool Deserialize(const std::string& s);
+};
+
+/// Key of a GEMM geometry in the db: the network config of the MIOpenGEMM kernels, which holds
+/// the transposes, leading dimensions and sizes.
+struct MiopengemmDbKey
+{
+    std::string network_config;
+    bool enforce_determinism = false;
+
+    void Serialize(std::ostream& stream) const;
+};
+
+/// MIOpenGEMM searches its kernels for every new GEMM geometry, and the search is slow. The found
+/// kernels are stored in the user MIOpenGEMM db next to the user find-db, so other processes skip
+/// the search for the known geometries. Disabled by MIOPEN_DEBUG_DISABLE_MIOPENGEMM_DB.
+class MiopengemmDb
+{
+    public:
+    static std::string GetUserPath(Handle& handle);
+
+    /// Returns none if the db is disabled or has no kernels for the key.
+    static boost::optional<MiopengemmKernels> Load(const std::string& path,
+                                                   const MiopengemmDbKey& key);
+    static void
+    Store(const std::string& path, const MiopengemmDbKey& key, const MiopengemmKernels& kernels);
+};
+
+} // namespace miopen
+
+#endif // GUARD_MIOPEN_MIOPENGEMM_DB_HPP_
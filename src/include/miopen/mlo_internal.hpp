@@ -645,7 +645,7 @@ struct mlo_construct_activ_lrn_pooling_common : mlo_construct_base
                                      w_stride);
 
         int data_len = miopen::GetTypeSize(data_type);
-        size_t size  = (layout == "NCHW")
+        size_t size  = miopen::IsDenseLayout(layout)
                           ? batch * channels * depth * height * width * data_len
                           : batch * batch_stride * channel_stride * stride * w_stride * data_len;
 
@@ -687,7 +687,7 @@ struct mlo_construct_activ_lrn_pooling_common : mlo_construct_base
                                      w_stride);
 
         int data_len = miopen::GetTypeSize(data_type);
-        size_t size  = (layout == "NCHW")
+        size_t size  = miopen::IsDenseLayout(layout)
                           ? batch * channels * depth * height * width * data_len
                           : batch * batch_stride * channel_stride * stride * w_stride * data_len;
 
@@ -806,12 +806,22 @@ struct mlo_construct_pooling2D : mlo_construct_activ_lrn_pooling_common
     }
 
     inline int getPoolingMethod() const { return (_pooling_method); }
+
+    /// Forward: output pixels per work-item to use instead of the ones chosen by mloConstruct().
+    inline void setOutPixTile(int out_pix_tile0, int out_pix_tile1)
+    {
+        _tuned_out_pix_tile0 = out_pix_tile0;
+        _tuned_out_pix_tile1 = out_pix_tile1;
+    }
+
     int mloConstruct();
 
     protected:
     int _pooling_method;
     miopenIndexType_t _index_type;
     int _NAN_option;
+    int _tuned_out_pix_tile0 = 0;
+    int _tuned_out_pix_tile1 = 0;
     int mloConstructFwd();
     int mloConstructBwd();
 };
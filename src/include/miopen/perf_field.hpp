@@ -28,9 +28,11 @@
 
 #include <miopen/errors.hpp>
 #include <miopen/finddb_kernel_cache_key.hpp>
+#include <miopen/roofline.hpp>
 #include <miopen/serializable.hpp>
 
 #include <cstddef>
+#include <sstream>
 #include <string>
 
 namespace miopen {
@@ -41,6 +43,7 @@ struct PerfField
     std::string solver_id;
     float time;
     std::size_t workspace;
+    RooflineMetrics roofline;
 
     bool operator<(const PerfField& p) const { return (time < p.time); }
 };
@@ -53,6 +56,8 @@ struct FindDbData : solver::Serializable<FindDbData>
     /// kcache_key may have a special value <unused> in network_config. It means that the particular
     /// solver doesn't use kernel cache and doesn't require a validation of built kernel existence.
     FindDbKCacheKey kcache_key;
+    /// Not a part of Visit(): records written without it remain valid.
+    RooflineMetrics roofline;
 
     FindDbData() : solver_id("<invalid>"), time(-1), workspace(-1) {}
 
@@ -76,6 +81,32 @@ struct FindDbData : solver::Serializable<FindDbData>
         f(self.kcache_key.algorithm_name, "kcache_key::algorithm_name");
         f(self.kcache_key.network_config, "kcache_key::network_confing");
     }
+
+    void Serialize(std::ostream& stream) const
+    {
+        Serializable::Serialize(stream);
+        if(roofline.IsValid())
+            stream << ',' << roofline.tflops << ',' << roofline.gbps << ','
+                   << roofline.peak_percent;
+    }
+
+    bool Deserialize(const std::string& s)
+    {
+        if(!Serializable::Deserialize(s))
+            return false;
+
+        // The optional roofline metrics follow the five fields of Visit().
+        roofline = {};
+        std::istringstream ss(s);
+        std::string part;
+        for(auto i = 0; i < 5; ++i)
+            std::getline(ss, part, ',');
+        auto metrics = RooflineMetrics{};
+        if(ss >> metrics.tflops && ss.get() == ',' && ss >> metrics.gbps && ss.get() == ',' &&
+           ss >> metrics.peak_percent)
+            roofline = metrics;
+        return true;
+    }
 };
 
 } // namespace miopen
@@ -0,0 +1,131 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2019 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#ifndef GUARD_MIOPEN_POOLING_SOLVER_HPP_
+#define GUARD_MIOPEN_POOLING_SOLVER_HPP_
+
+#include <miopen/miopen.h>
+#include <miopen/primitive_context.hpp>
+#include <miopen/serializable.hpp>
+#include <miopen/solver.hpp>
+
+#include <functional>
+#include <ostream>
+
+namespace miopen {
+
+struct TensorDescriptor;
+
+namespace solver {
+struct PoolingFwdSolution;
+} // namespace solver
+
+/// Problem config of the 2D pooling forward kernel. Serialize() provides the Perf Db key.
+struct PoolingContext : PrimitiveContext
+{
+    int n                      = 0;
+    int c                      = 0;
+    int in_h                   = 0;
+    int in_w                   = 0;
+    int out_h                  = 0;
+    int out_w                  = 0;
+    int win_h                  = 0;
+    int win_w                  = 0;
+    int pad_h                  = 0;
+    int pad_w                  = 0;
+    int stride_h               = 1;
+    int stride_w               = 1;
+    int pooling_method         = 0; // MLO_POOLING_OP_*
+    bool save_index            = false;
+    miopenDataType_t data_type = miopenFloat;
+
+    std::function<void(const solver::PoolingFwdSolution&)> run;
+
+    PoolingContext() = default;
+    PoolingContext(const TensorDescriptor& xDesc, const TensorDescriptor& yDesc);
+
+    void Serialize(std::ostream& stream) const;
+
+    friend std::ostream& operator<<(std::ostream& os, const PoolingContext& obj)
+    {
+        obj.Serialize(os);
+        return os;
+    }
+};
+
+namespace solver {
+
+/// Output pixels computed by each work-item of the 8x8 work-groups.
+struct PoolingFwdSolution
+{
+    int out_pix_tile0 = 1;
+    int out_pix_tile1 = 1;
+};
+
+struct PerformanceConfigPoolingFwd : Serializable<PerformanceConfigPoolingFwd>
+{
+    int out_pix_tile0; // 1, 2, 4, 8
+    int out_pix_tile1; // 1, 2, 4, 8
+
+    PerformanceConfigPoolingFwd(int out_pix_tile0_, int out_pix_tile1_)
+        : out_pix_tile0(out_pix_tile0_), out_pix_tile1(out_pix_tile1_)
+    {
+    }
+    PerformanceConfigPoolingFwd() : PerformanceConfigPoolingFwd(-1, -1) {}
+    PerformanceConfigPoolingFwd(bool) : PerformanceConfigPoolingFwd(1, 1) {}
+
+    template <class Self, class F>
+    static void Visit(Self&& self, F f)
+    {
+        f(self.out_pix_tile0, "out_pix_tile0");
+        f(self.out_pix_tile1, "out_pix_tile1");
+    }
+
+    void EuristicInit(const PoolingContext& context);
+    bool IsValidValue() const;
+    bool SetNextValue();
+    bool IsValid(const PoolingContext& context) const;
+    bool operator==(const PerformanceConfigPoolingFwd& other) const;
+};
+
+struct PoolingFwd2d : SolverBase<PoolingContext>
+{
+    bool IsApplicable(const PoolingContext&) const { return true; }
+    PerformanceConfigPoolingFwd GetPerformanceConfig(const PoolingContext& context) const;
+    bool IsValidPerformanceConfig(const PoolingContext& context,
+                                  const PerformanceConfigPoolingFwd& config) const;
+    PerformanceConfigPoolingFwd Search(const PoolingContext& context) const;
+    PoolingFwdSolution GetSolution(const PoolingContext& context,
+                                   const PerformanceConfigPoolingFwd& config) const;
+};
+
+/// Returns the launch parameters for the problem, see FindPrimitiveSolution().
+PoolingFwdSolution FindPoolingFwdSolution(const PoolingContext& context);
+
+} // namespace solver
+} // namespace miopen
+
+#endif // GUARD_MIOPEN_POOLING_SOLVER_HPP_
@@ -0,0 +1,69 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2019 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#ifndef GUARD_MIOPEN_PRIMITIVE_CONTEXT_HPP_
+#define GUARD_MIOPEN_PRIMITIVE_CONTEXT_HPP_
+
+#include <miopen/problem_description.hpp>
+
+#include <string>
+
+namespace miopen {
+
+struct Handle;
+
+/// The part of the problem config which is common to the non-convolution primitives
+/// that have solvers (batch normalization, softmax). Carries what FindSolutionImpl()
+/// needs besides the problem itself. The derived contexts provide Serialize(),
+/// which is the Perf Db key, and a run function which is required by the searches:
+///
+///     std::function<void(const Solution&)> run;
+///
+/// It shall launch the primitive on the user's buffers, so the kernels are timed
+/// on the actual data.
+struct PrimitiveContext
+{
+    /// Unknown direction: the primitives are out of the convolution scopes
+    /// of MIOPEN_FIND_ENFORCE_SCOPE, only the "all" scope applies to them.
+    ProblemDescription::Direction direction;
+    bool disable_search_enforce = false;
+    bool disable_perfdb_access  = false;
+    bool do_search              = false;
+
+    Handle& GetStream() const { return *_stream; }
+    void SetStream(Handle* stream) { _stream = stream; }
+
+    /// The same databases as the ones of the convolutions.
+    std::string GetPerfDbPath() const;
+    std::string GetUserPerfDbPath() const;
+
+    private:
+    Handle* _stream = nullptr;
+};
+
+} // namespace miopen
+
+#endif // GUARD_MIOPEN_PRIMITIVE_CONTEXT_HPP_
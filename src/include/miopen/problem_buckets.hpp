@@ -0,0 +1,81 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2019 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#ifndef GUARD_MIOPEN_PROBLEM_BUCKETS_HPP_
+#define GUARD_MIOPEN_PROBLEM_BUCKETS_HPP_
+
+#include <miopen/problem_description.hpp>
+
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace miopen {
+
+// Opt-in bucketing of problem shapes in the find-db, for applications running the same layers
+// with many batch (or image) sizes. Bucket upper bounds are set by MIOPEN_FIND_DB_BATCH_BUCKETS
+// and MIOPEN_FIND_DB_SPATIAL_BUCKETS as comma separated ascending lists, e.g. "1,2,4,8,16,32".
+// A size belongs to the bucket of the smallest bound not below it, sizes above the last bound
+// are not bucketed. When the find-db has no record of a problem, the record of its bucket
+// representative is used instead, see FindDbRecord.
+
+/// Parses a comma separated list of bucket bounds. Returns an empty list if it is malformed
+/// or not ascending.
+std::vector<int> ParseBucketBounds(const std::string& s);
+
+/// Bound of the bucket of size, or size itself if it is above all bounds.
+int GetBucketBound(const std::vector<int>& bounds, int size);
+
+bool IsProblemBucketingEnabled();
+
+/// The problem with the batch size and, if spatial buckets are set, the image sizes replaced
+/// by the bounds of their buckets. Only meant to be used as a find-db key.
+ProblemDescription GetBucketRepresentative(const ProblemDescription& problem);
+
+/// Find-db key of the items found for a bucket. It differs from the keys of all the problems,
+/// the representative included, so storing a bucket never replaces the record of a problem.
+struct ProblemBucket
+{
+    ProblemDescription representative;
+
+    void Serialize(std::ostream& stream) const;
+};
+
+enum class BucketLookup
+{
+    Exact,  // The problem has its own record.
+    Bucket, // The record of the bucket is used.
+    Miss,
+};
+
+/// Counts find-db lookups per bucket. The counts are logged at exit.
+void RecordBucketLookup(const ProblemDescription& representative, BucketLookup lookup);
+
+void WriteBucketStats(std::ostream& os);
+
+} // namespace miopen
+
+#endif // GUARD_MIOPEN_PROBLEM_BUCKETS_HPP_
@@ -50,7 +50,13 @@ SetDescFromMLDesc(int spatial_dims, TTo& to, const TensorDescriptor& tensor, con
 
     std::tie(ns, cs, hs, ws) = miopen::tien<4>(tensor.GetStrides(), 0);
 
-    (to.*method)("NCHW", tensor.GetType(), n, c, d, h, w, ns, cs, hs, ws);
+    // The default layout of 3D tensors is named NCHW as well, as the databases key it so.
+    const std::string labels = spatial_dims == 3 ? "NCDHW" : "NCHW";
+    auto layout = tensor.GetLengths().size() == labels.size() ? tensor.GetLayout(labels) : labels;
+    if(layout == "NCDHW")
+        layout = "NCHW";
+
+    (to.*method)(layout, tensor.GetType(), n, c, d, h, w, ns, cs, hs, ws);
 
     return tensor.GetElementSpace();
 }
@@ -72,6 +78,12 @@ inline std::string GetDataTypeName(miopenDataType_t data_type)
     return "Unknown(" + std::to_string(data_type) + ")";
 }
 
+/// Packed tensors of these layouts take batch * channels * spatial elements.
+inline bool IsDenseLayout(const std::string& layout)
+{
+    return layout == "NCHW" || layout == "NHWC" || layout == "NDHWC";
+}
+
 struct ProblemDescription
 {
     int spatial_dims      = 2;
@@ -197,7 +209,7 @@ struct ProblemDescription
     {
         batch_sz     = batch;
         int data_len = GetTypeSize(data_type);
-        size_t size  = (layout == "NCHW")
+        size_t size  = IsDenseLayout(layout)
                           ? batch * channels * depth * height * width * data_len
                           : batch * batch_stride * channel_stride * stride * w_stride * data_len;
 
@@ -232,7 +244,7 @@ struct ProblemDescription
     {
         batch_sz     = batch;
         int data_len = GetTypeSize(data_type);
-        size_t size  = (layout == "NCHW")
+        size_t size  = IsDenseLayout(layout)
                           ? batch * channels * depth * height * width * data_len
                           : batch * batch_stride * channel_stride * stride * w_stride * data_len;
 
@@ -290,6 +302,20 @@ struct ProblemDescription
 
     int mloBuildConf_Key(std::string& conf_key) const;
 
+    /// The kernels of the solvers assume the NCHW (NCDHW) layout of all the tensors, so their
+    /// IsApplicable() reject other layouts.
+    bool IsLayoutDefault() const
+    {
+        return in_layout == "NCHW" && out_layout == "NCHW" && weights_layout.empty();
+    }
+
+    /// Channels-last NHWC (NDHWC) input, weights (KYXC) and output.
+    bool IsLayoutNHWC() const
+    {
+        const auto layout = spatial_dims == 3 ? "NDHWC" : "NHWC";
+        return in_layout == layout && out_layout == layout && weights_layout == layout;
+    }
+
     private:
     /*
      * set convolutional parameters
@@ -316,10 +342,13 @@ struct ProblemDescription
         kernel_size_d     = depth;
         weights_data_type = data_type;
         int data_len      = GetTypeSize(data_type);
-        size_t size       = (layout == "NCHW")
+        size_t size       = IsDenseLayout(layout)
                           ? batch * channels * depth * height * width * data_len
                           : batch * batch_stride * channel_stride * stride * w_stride * data_len;
         weights_sz = size;
+        // Empty for the default layout, which the solvers assume.
+        if(layout != "NCHW")
+            weights_layout = layout;
     }
 
     /*
@@ -339,7 +368,7 @@ struct ProblemDescription
     {
         batch_sz     = batch;
         int data_len = GetTypeSize(data_type);
-        size_t size  = (layout == "NCHW")
+        size_t size  = IsDenseLayout(layout)
                           ? batch * channels * depth * height * width * data_len
                           : batch * batch_stride * channel_stride * stride * w_stride * data_len;
         if(direction.IsForward())
@@ -391,7 +420,7 @@ struct ProblemDescription
     {
         batch_sz     = batch;
         int data_len = GetTypeSize(data_type);
-        size_t size  = (layout == "NCHW")
+        size_t size  = IsDenseLayout(layout)
                           ? batch * channels * depth * height * width * data_len
                           : batch * batch_stride * channel_stride * stride * w_stride * data_len;
         if(direction.IsForward())
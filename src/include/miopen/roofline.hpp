@@ -0,0 +1,77 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2019 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#ifndef GUARD_MIOPEN_ROOFLINE_HPP_
+#define GUARD_MIOPEN_ROOFLINE_HPP_
+
+#include <miopen/miopen.h>
+
+#include <cstddef>
+#include <ostream>
+
+namespace miopen {
+
+struct Handle;
+struct ProblemDescription;
+
+/// Analytical amount of work done by a solution, see SolverBase::GetCost().
+struct OperationCost
+{
+    double flops         = 0;
+    double bytes_read    = 0;
+    double bytes_written = 0;
+
+    double GetBytes() const { return bytes_read + bytes_written; }
+};
+
+/// Cost of a direct convolution of the problem: 2 FLOPs per multiply-accumulate, each tensor
+/// read or written once. Algorithms doing less arithmetic (e.g. Winograd or FFT) are thus rated
+/// by the direct convolution equivalent FLOP rate, which makes them comparable to each other.
+OperationCost GetConvolutionCost(const ProblemDescription& problem);
+
+/// Estimate of the peak arithmetic throughput of a GCN device: each CU retires 64 FMA per clock
+/// for fp32, packed math doubles that for fp16 and dot products quadruple it for int8.
+double GetPeakTflops(std::size_t compute_units, std::size_t clock_mhz, miopenDataType_t type);
+double GetPeakTflops(Handle& handle, miopenDataType_t type);
+
+struct RooflineMetrics
+{
+    float tflops       = -1;
+    float gbps         = -1;
+    float peak_percent = -1;
+
+    bool IsValid() const { return tflops >= 0; }
+};
+
+/// Achieved rates of a solution which took time_ms to run. The percent of peak is unknown (-1)
+/// if peak_tflops is not positive.
+RooflineMetrics GetRooflineMetrics(const OperationCost& cost, float time_ms, double peak_tflops);
+
+std::ostream& operator<<(std::ostream& os, const RooflineMetrics& metrics);
+
+} // namespace miopen
+
+#endif // GUARD_MIOPEN_ROOFLINE_HPP_
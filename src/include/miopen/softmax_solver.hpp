@@ -0,0 +1,142 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2019 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#ifndef GUARD_MIOPEN_SOFTMAX_SOLVER_HPP_
+#define GUARD_MIOPEN_SOFTMAX_SOLVER_HPP_
+
+#include <miopen/miopen.h>
+#include <miopen/primitive_context.hpp>
+#include <miopen/serializable.hpp>
+#include <miopen/solver.hpp>
+
+#include <cstddef>
+#include <functional>
+#include <ostream>
+
+namespace miopen {
+
+struct TensorDescriptor;
+
+namespace solver {
+struct SoftmaxSolution;
+} // namespace solver
+
+/// Problem config of the softmax kernels. Serialize() provides the Perf Db key.
+struct SoftmaxContext : PrimitiveContext
+{
+    bool forward = true;
+    int n        = 0;
+    int c        = 0;
+    int h        = 0;
+    int w        = 0;
+    miopenDataType_t data_type         = miopenFloat;
+    miopenSoftmaxAlgorithm_t algorithm = MIOPEN_SOFTMAX_ACCURATE;
+    miopenSoftmaxMode_t mode           = MIOPEN_SOFTMAX_MODE_CHANNEL;
+
+    std::function<void(const solver::SoftmaxSolution&)> run;
+
+    SoftmaxContext() = default;
+    SoftmaxContext(bool forward_,
+                   const TensorDescriptor& desc,
+                   miopenSoftmaxAlgorithm_t algorithm_,
+                   miopenSoftmaxMode_t mode_);
+
+    /// Number of the vectors softmax is computed over.
+    int GetGridSize() const { return mode == MIOPEN_SOFTMAX_MODE_INSTANCE ? n : n * h * w; }
+    int GetSpatialDim() const { return mode == MIOPEN_SOFTMAX_MODE_INSTANCE ? 1 : h * w; }
+    int GetVectorSize() const { return mode == MIOPEN_SOFTMAX_MODE_INSTANCE ? c * h * w : c; }
+
+    void Serialize(std::ostream& stream) const;
+
+    friend std::ostream& operator<<(std::ostream& os, const SoftmaxContext& obj)
+    {
+        obj.Serialize(os);
+        return os;
+    }
+};
+
+namespace solver {
+
+/// Launch parameters of the softmax kernels, which use work-groups of 256.
+/// See MIOpenSoftmax.cl for the description of the CSR-Vector and CSR-Stream approaches.
+struct SoftmaxSolution
+{
+    int num_batch     = 1;   // Vectors per work-group, 1 selects the CSR-Vector approach.
+    int batch_size    = 256; // Work-items per vector.
+    int u_batch_size  = 1;   // Values kept per work-item.
+    size_t workgroups = 1;
+};
+
+struct PerformanceConfigSoftmax : Serializable<PerformanceConfigSoftmax>
+{
+    int num_batch; // [1..256], power of 2
+
+    PerformanceConfigSoftmax(int num_batch_) : num_batch(num_batch_) {}
+    PerformanceConfigSoftmax() : PerformanceConfigSoftmax(-1) {}
+    PerformanceConfigSoftmax(bool) : PerformanceConfigSoftmax(1) {}
+
+    template <class Self, class F>
+    static void Visit(Self&& self, F f)
+    {
+        f(self.num_batch, "num_batch");
+    }
+
+    void EuristicInit(const SoftmaxContext& context);
+    bool IsValidValue() const;
+    bool SetNextValue();
+    bool IsValid(const SoftmaxContext& context) const;
+    bool operator==(const PerformanceConfigSoftmax& other) const;
+};
+
+struct SoftmaxFwd : SolverBase<SoftmaxContext>
+{
+    bool IsApplicable(const SoftmaxContext& context) const { return context.forward; }
+    PerformanceConfigSoftmax GetPerformanceConfig(const SoftmaxContext& context) const;
+    bool IsValidPerformanceConfig(const SoftmaxContext& context,
+                                  const PerformanceConfigSoftmax& config) const;
+    PerformanceConfigSoftmax Search(const SoftmaxContext& context) const;
+    SoftmaxSolution GetSolution(const SoftmaxContext& context,
+                                const PerformanceConfigSoftmax& config) const;
+};
+
+struct SoftmaxBwd : SolverBase<SoftmaxContext>
+{
+    bool IsApplicable(const SoftmaxContext& context) const { return !context.forward; }
+    PerformanceConfigSoftmax GetPerformanceConfig(const SoftmaxContext& context) const;
+    bool IsValidPerformanceConfig(const SoftmaxContext& context,
+                                  const PerformanceConfigSoftmax& config) const;
+    PerformanceConfigSoftmax Search(const SoftmaxContext& context) const;
+    SoftmaxSolution GetSolution(const SoftmaxContext& context,
+                                const PerformanceConfigSoftmax& config) const;
+};
+
+/// Returns the launch parameters for the problem, see FindPrimitiveSolution().
+SoftmaxSolution FindSoftmaxSolution(const SoftmaxContext& context);
+
+} // namespace solver
+} // namespace miopen
+
+#endif // GUARD_MIOPEN_SOFTMAX_SOLVER_HPP_
@@ -36,6 +36,7 @@
 #include <miopen/type_name.hpp>
 #include <miopen/miopen.h>
 #include <miopen/buffer_info.hpp>
+#include <miopen/roofline.hpp>
 #include <miopen/scgemm_param.hpp>
 
 #include <memory>
@@ -116,6 +117,10 @@ struct SolverBase
     bool IsFast(const Context&) const { return true; }
     // Returns the workspace size required by the solver for a given ConvolutionContext
     size_t GetWorkspaceSize(const Context&) const { return 0; };
+    /// Returns analytical FLOP and byte counts of the solution, used to report the achieved
+    /// rates (see roofline.hpp). Solvers which do extra memory traffic, e.g. through the
+    /// workspace, shall add it.
+    OperationCost GetCost(const Context& ctx) const { return GetConvolutionCost(ctx); }
 
     /// Takes problem config, optimization parameters and other info
     /// and computes information required to build and run the kernel(s).
@@ -846,6 +851,7 @@ struct ConvOclBwdWrW2 : SolverBase<ConvolutionContext>
     PerformanceConfigConvOclBwdWrw2<N_BATCH_LOOPS> Search(const ConvolutionContext&) const;
     bool IsApplicable(const ConvolutionContext& params) const;
     size_t GetWorkspaceSize(const ConvolutionContext& params) const;
+    OperationCost GetCost(const ConvolutionContext& params) const;
     ConvSolution GetSolution(const ConvolutionContext& params,
                              const PerformanceConfigConvOclBwdWrw2<N_BATCH_LOOPS>& config,
                              bool disableConfigOverrideFromEnv = false) const;
@@ -901,6 +907,7 @@ struct ConvOclBwdWrW53 : SolverBase<ConvolutionContext>
 {
     bool IsApplicable(const ConvolutionContext& params) const;
     size_t GetWorkspaceSize(const ConvolutionContext& params) const;
+    OperationCost GetCost(const ConvolutionContext& params) const;
     ConvSolution GetSolution(const ConvolutionContext& params) const;
 };
 
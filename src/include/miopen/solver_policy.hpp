@@ -0,0 +1,121 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2019 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#ifndef GUARD_MIOPEN_SOLVER_POLICY_HPP_
+#define GUARD_MIOPEN_SOLVER_POLICY_HPP_
+
+#include <cstddef>
+#include <istream>
+#include <limits>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace miopen {
+
+/// Restrictions a policy file puts on the solvers of a problem, see SolverPolicyFile.
+struct SolverPolicy
+{
+    /// If not empty, only these solvers are used.
+    std::vector<std::string> pinned;
+    std::vector<std::string> disabled;
+    /// Performance configs to use instead of the perf-db ones, by solver.
+    std::map<std::string, std::string> configs;
+    std::size_t workspace_limit = std::numeric_limits<std::size_t>::max();
+
+    bool IsAllowed(const std::string& solver) const;
+    bool FitsWorkspace(std::size_t workspace) const { return workspace <= workspace_limit; }
+    /// Returns nullptr if the policy has no config for the solver.
+    const std::string* FindConfig(const std::string& solver) const;
+    bool IsEmpty() const;
+};
+
+/// Policy file set by MIOPEN_SOLVER_POLICY_FILE. Each line is a rule
+///
+///     <problem key pattern> <action> [arguments]
+///
+/// where the pattern is matched against the find-db key of the problem (see
+/// ProblemDescription::Serialize()) and may contain the '*' and '?' wildcards. Actions are:
+///
+///     solver <solver>             use only the pinned solvers for the problem
+///     disable <solver>            never use the solver for the problem
+///     config <solver> <config>    use the performance config instead of the perf-db one
+///     workspace <bytes>           skip solutions that need more workspace
+///
+/// Pinned and disabled solvers of all matching rules are combined. For the config of a solver and
+/// for the workspace limit the first matching rule wins. Empty lines and lines starting with '#'
+/// are ignored, and so are malformed rules (with an error message).
+class SolverPolicyFile
+{
+    public:
+    SolverPolicyFile() = default;
+    SolverPolicyFile(std::istream& stream, const std::string& source);
+
+    /// Policy of the problem with the given key.
+    SolverPolicy Match(const std::string& key) const;
+    bool IsEmpty() const { return rules.empty(); }
+
+    private:
+    struct Rule
+    {
+        std::string pattern;
+        std::string action;
+        std::vector<std::string> args;
+        /// Of the workspace action, converted when the file is read.
+        std::size_t workspace_limit = 0;
+    };
+
+    std::vector<Rule> rules;
+};
+
+/// Matches the whole text against a pattern with the '*' and '?' wildcards.
+bool MatchKeyPattern(const std::string& pattern, const std::string& text);
+
+/// True if MIOPEN_SOLVER_POLICY_FILE sets any rules. The file is read once per process.
+bool HasSolverPolicy();
+
+/// Policy of the problem with the given key. The match is computed once per key.
+const SolverPolicy& GetSolverPolicy(const std::string& key);
+
+/// Policy of the problem: a ProblemDescription or a context of the primitives, whose keys are
+/// the ones of the perf-db. Without a policy file returns an empty policy without building the
+/// key. Each call builds the key and looks up the match, so the callers trying several solvers
+/// look the policy up once for all of them.
+template <class Problem>
+const SolverPolicy& GetSolverPolicy(const Problem& problem)
+{
+    static const SolverPolicy empty;
+    if(!HasSolverPolicy())
+        return empty;
+    std::ostringstream ss;
+    problem.Serialize(ss);
+    return GetSolverPolicy(ss.str());
+}
+
+} // namespace miopen
+
+#endif // GUARD_MIOPEN_SOLVER_POLICY_HPP_
@@ -166,6 +166,18 @@ struct TensorDescriptor : miopenTensorDescriptor
 
     bool IsPacked() const;
 
+    /// Labels of the dimensions ordered from the largest stride to the smallest one, e.g. "NHWC"
+    /// for the labels "NCHW" of a channels-last tensor. As dimensions of length 1 fit anywhere,
+    /// the order of the labels and then the channels-last order are preferred when they fit.
+    std::string GetLayout(std::string labels) const;
+
+    /// True if every dimension of the layout steps over all the dimensions following it,
+    /// ignoring dimensions of length 1. The labels name the dimensions in their order.
+    bool FitsLayout(const std::string& labels, const std::string& layout) const;
+
+    /// True unless a 4D or 5D tensor is laid out in other than the NCHW or NCDHW order.
+    bool IsDefaultLayout() const;
+
     bool operator==(const TensorDescriptor& rhs) const;
     bool operator!=(const TensorDescriptor& rhs) const;
     bool operator<(const TensorDescriptor& rhs) const;
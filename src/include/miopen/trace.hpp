@@ -0,0 +1,92 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2019 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#ifndef GUARD_MIOPEN_TRACE_HPP_
+#define GUARD_MIOPEN_TRACE_HPP_
+
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <utility>
+
+#define MIOPEN_TRACE_PP_CAT(x, y) MIOPEN_TRACE_PP_PRIMITIVE_CAT(x, y)
+#define MIOPEN_TRACE_PP_PRIMITIVE_CAT(x, y) x##y
+
+namespace miopen {
+
+/// \return true if tracing is enabled, i.e. MIOPEN_TRACE_FILE is set.
+bool IsTracing();
+
+/// Nanoseconds elapsed since the first use of tracing in the process.
+std::uint64_t TraceNow();
+
+/// Appends a complete span to the trace buffer of the calling thread.
+/// Each thread owns a ring buffer, so the oldest spans are overwritten
+/// when more than MIOPEN_TRACE_BUFFER_SIZE spans are recorded by a thread.
+void TraceSpan(const char* category, std::string name, std::uint64_t start, std::uint64_t end);
+
+/// Writes the spans recorded so far by all threads in the Chrome trace JSON format,
+/// which can be loaded into chrome://tracing or Perfetto.
+/// The same output is written into MIOPEN_TRACE_FILE at process exit.
+void WriteTrace(std::ostream& os);
+
+/// Records the lifetime of the object as a span. Does nothing when tracing is disabled.
+class TraceScope
+{
+    public:
+    TraceScope(const char* category_, std::string name_)
+        : category(category_),
+          name(std::move(name_)),
+          active(IsTracing()),
+          start(active ? TraceNow() : 0)
+    {
+    }
+
+    TraceScope(const TraceScope&) = delete;
+    TraceScope& operator=(const TraceScope&) = delete;
+
+    ~TraceScope()
+    {
+        if(active)
+            TraceSpan(category, std::move(name), start, TraceNow());
+    }
+
+    private:
+    const char* category;
+    std::string name;
+    bool active;
+    std::uint64_t start;
+};
+
+} // namespace miopen
+
+/// Records a span from here to the end of the enclosing scope.
+/// The name expression is evaluated only when tracing is enabled.
+#define MIOPEN_TRACE_SCOPE(category, ...)                                    \
+    const miopen::TraceScope MIOPEN_TRACE_PP_CAT(miopen_trace_scope_, __LINE__)( \
+        category, miopen::IsTracing() ? std::string(__VA_ARGS__) : std::string{})
+
+#endif // GUARD_MIOPEN_TRACE_HPP_
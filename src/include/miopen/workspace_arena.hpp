@@ -0,0 +1,73 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2019 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#ifndef GUARD_MIOPEN_WORKSPACE_ARENA_HPP_
+#define GUARD_MIOPEN_WORKSPACE_ARENA_HPP_
+
+#include <miopen/allocator.hpp>
+#include <miopen/common.hpp>
+
+#include <cstddef>
+#include <functional>
+
+namespace miopen {
+
+struct Handle;
+
+/// Workspace owned by a handle, used by the calls that are passed no workspace, see
+/// miopenEnableWorkspaceArena(). All the calls of a handle run in order on its stream, so a call
+/// may reuse the buffer as soon as the previous one is enqueued. The buffer grows geometrically,
+/// up to the workspace budget of the handle, so a network settles on a single allocation after
+/// the first few layers.
+class WorkspaceArena
+{
+    public:
+    /// Returns a buffer of at least size bytes. A smaller buffer is released first; the runtime
+    /// keeps it alive until the kernels using it complete.
+    Data_t Get(Handle& handle, std::size_t size);
+
+    std::size_t GetCapacity() const { return capacity; }
+    /// The largest workspace requested so far.
+    std::size_t GetHighWaterMark() const { return high_water_mark; }
+    std::size_t GetAllocationCount() const { return allocations; }
+
+    private:
+    Allocator::ManageDataPtr buffer;
+    std::size_t capacity        = 0;
+    std::size_t high_water_mark = 0;
+    std::size_t allocations     = 0;
+};
+
+/// Makes the arena of the handle provide the workspace when the caller passes none and the arena
+/// is enabled. If the caller passes no size either, get_size() tells how much the call needs.
+void UseWorkspaceArena(Handle& handle,
+                       void*& workspace,
+                       std::size_t& size,
+                       const std::function<std::size_t()>& get_size);
+
+} // namespace miopen
+
+#endif // GUARD_MIOPEN_WORKSPACE_ARENA_HPP_
@@ -0,0 +1,61 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2019 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#ifndef GUARD_MIOPEN_WORKSPACE_PLANNER_HPP_
+#define GUARD_MIOPEN_WORKSPACE_PLANNER_HPP_
+
+#include <miopen/miopen.h>
+
+#include <cstddef>
+#include <vector>
+
+namespace miopen {
+
+/// Solutions chosen for the layers of a network, see PlanWorkspace().
+struct WorkspacePlan
+{
+    /// Index of the chosen solution of each layer.
+    std::vector<std::size_t> choices;
+    float time            = 0.0f;
+    std::size_t workspace = 0;
+    /// Time that one more MB of budget would save.
+    float time_per_mb = 0.0f;
+};
+
+/// Chooses one solution per layer so that the total time is minimal and the sum of workspaces
+/// does not exceed the budget (multiple-choice knapsack). The candidates are combined layer by
+/// layer, keeping only the (workspace, time) pairs not dominated by another pair. The result is
+/// exact unless the number of such pairs exceeds max_plan_points, in which case pairs closer than
+/// 1/max_plan_points of the budget are merged. Negative (unknown) times count as zero.
+/// Throws if a layer has no solutions or no combination fits into the budget.
+WorkspacePlan PlanWorkspace(const std::vector<std::vector<miopenConvSolution_t>>& layers,
+                            std::size_t budget);
+
+constexpr std::size_t max_plan_points = 1 << 16;
+
+} // namespace miopen
+
+#endif // GUARD_MIOPEN_WORKSPACE_PLANNER_HPP_
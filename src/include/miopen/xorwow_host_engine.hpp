@@ -0,0 +1,226 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2019 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#ifndef GUARD_MIOPEN_XORWOW_HOST_ENGINE_HPP_
+#define GUARD_MIOPEN_XORWOW_HOST_ENGINE_HPP_
+
+#include <miopen/dropout.hpp>
+#include <miopen/precalc_xorwow_skipahead_matrices.hpp>
+#include <miopen/precalc_xorwow_skipahead_sequence_matrices.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace miopen {
+
+// Host-side generator of the PRNG states written by the InitKernelState kernel
+// (DropoutDescriptor::InitPRNGState). The state of subsequence gid is the seed state advanced by
+// gid jumps of 2^67 steps, and every jump is the same 160x160 GF(2) matrix. So instead of doing a
+// full skipahead per state, the engine walks the subsequences with one table-driven matrix-vector
+// product per state, starting from cached per-(seed, block) states.
+
+// GF(2) product of a xorwow transition matrix with the 160-bit xorwow vector, table-driven.
+// The vector is consumed a byte at a time: each byte selects one of 256 precombined XOR sums of
+// the matching 8 matrix rows, so a product costs 20 lookups instead of 160 conditional row XORs.
+class XorwowMatrixTable
+{
+    static constexpr unsigned int chunk_bits = 8;
+    static constexpr unsigned int chunk_vals = 1U << chunk_bits;
+    static constexpr unsigned int chunk_num  = XORWOW_DIM * XORWOW_BITS / chunk_bits;
+    static constexpr unsigned int chunks_per_word = XORWOW_BITS / chunk_bits;
+
+    std::vector<unsigned int> table;
+
+    public:
+    explicit XorwowMatrixTable(const unsigned int* matrix)
+        : table(static_cast<std::size_t>(chunk_num) * chunk_vals * XORWOW_DIM, 0)
+    {
+        for(unsigned int c = 0; c < chunk_num; c++)
+        {
+            unsigned int* entries = &table[c * chunk_vals * XORWOW_DIM];
+            for(unsigned int e = 1; e < chunk_vals; e++)
+            {
+                unsigned int low = 0;
+                while(!bool(e & (1U << low)))
+                    low++;
+                // Row of input bit (c * chunk_bits + low), see mat_vec().
+                const unsigned int* row  = matrix + XORWOW_DIM * (c * chunk_bits + low);
+                const unsigned int* rest = entries + XORWOW_DIM * (e & (e - 1));
+                for(unsigned int k = 0; k < XORWOW_DIM; k++)
+                    entries[e * XORWOW_DIM + k] = rest[k] ^ row[k];
+            }
+        }
+    }
+
+    // multiply vector by the matrix, store result in vector
+    void Apply(unsigned int* vector) const
+    {
+        unsigned int result[XORWOW_DIM] = {0};
+        for(unsigned int c = 0; c < chunk_num; c++)
+        {
+            const unsigned int byte =
+                (vector[c / chunks_per_word] >> (chunk_bits * (c % chunks_per_word))) &
+                (chunk_vals - 1);
+            const unsigned int* entry = &table[(c * chunk_vals + byte) * XORWOW_DIM];
+            for(unsigned int k = 0; k < XORWOW_DIM; k++)
+                result[k] ^= entry[k];
+        }
+        std::copy(std::begin(result), std::end(result), vector);
+    }
+};
+
+// State of subsequence 0 at offset 0 for the given seed, same as xorwow_lite_init() in
+// MIOpenDropout.cl.
+inline prngStates XorwowSeedState(unsigned long long seed)
+{
+    prngStates state;
+    state.x = 123456789;
+    state.y = 362436069;
+    state.z = 521288629;
+    state.w = 88675123;
+    state.v = 5783321;
+
+    state.d = 6615241;
+
+    // Adopt constants choice of rocRAND (https://github.com/ROCmSoftwarePlatform/rocRAND)
+    const unsigned int s0 = static_cast<unsigned int>(seed) ^ 0x2c7f967fU;
+    const unsigned int s1 = static_cast<unsigned int>(seed >> 32) ^ 0xa03697cbU;
+    const unsigned int t0 = 1228688033 * s0;
+    const unsigned int t1 = 2073658381 * s1;
+    state.x += t0;
+    state.y ^= t0;
+    state.z += t1;
+    state.w ^= t1;
+    state.v += t0;
+    state.d += t1 + t0;
+    return state;
+}
+
+class XorwowStateEngine
+{
+    public:
+    // precalc_xorwow_skipahead_matrices[i] jumps over 4^i subsequences.
+    static constexpr unsigned int block_matrix_idx = 4;
+    // Number of consecutive subsequences generated from one cached block state.
+    static constexpr std::size_t block_size = std::size_t(1)
+                                              << (block_matrix_idx * XORWOW_JUMP_LOG2);
+    // Minimal number of blocks worth a separate thread.
+    static constexpr std::size_t min_blocks_per_thread = 16;
+    // Seeds whose block states are kept; the cache is dropped when it grows beyond that.
+    static constexpr std::size_t max_cached_seeds = 64;
+
+    XorwowStateEngine()
+        : step(precalc_xorwow_skipahead_matrices[0]),
+          block_step(precalc_xorwow_skipahead_matrices[block_matrix_idx])
+    {
+    }
+
+    // Fills states[gid] with the state of subsequence gid, gid in [0, states_num).
+    void Generate(unsigned long long seed, prngStates* states, std::size_t states_num)
+    {
+        const std::size_t blocks_num = (states_num + block_size - 1) / block_size;
+        const auto block_states      = GetBlockStates(seed, blocks_num);
+
+        const auto fill_blocks = [&](std::size_t first, std::size_t last) {
+            for(std::size_t b = first; b < last; b++)
+            {
+                auto state              = block_states[b];
+                const std::size_t begin = b * block_size;
+                const std::size_t end   = std::min(states_num, begin + block_size);
+                for(std::size_t gid = begin; gid < end; gid++)
+                {
+                    states[gid] = state;
+                    step.Apply(&state.x);
+                }
+            }
+        };
+
+        const std::size_t threads_num =
+            std::max<std::size_t>(1,
+                                  std::min<std::size_t>(std::thread::hardware_concurrency(),
+                                                        blocks_num / min_blocks_per_thread));
+        if(threads_num == 1)
+        {
+            fill_blocks(0, blocks_num);
+            return;
+        }
+
+        const std::size_t grain = (blocks_num + threads_num - 1) / threads_num;
+        std::vector<std::thread> threads;
+        threads.reserve(threads_num);
+        for(std::size_t first = 0; first < blocks_num; first += grain)
+            threads.emplace_back(fill_blocks, first, std::min(blocks_num, first + grain));
+        for(auto& thread : threads)
+            thread.join();
+    }
+
+    std::vector<prngStates> Generate(unsigned long long seed, std::size_t states_num)
+    {
+        std::vector<prngStates> states(states_num);
+        Generate(seed, states.data(), states_num);
+        return states;
+    }
+
+    private:
+    XorwowMatrixTable step;
+    XorwowMatrixTable block_step;
+    std::mutex mutex;
+    std::map<unsigned long long, std::vector<prngStates>> cache;
+
+    std::vector<prngStates> GetBlockStates(unsigned long long seed, std::size_t blocks_num)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if(cache.size() >= max_cached_seeds && cache.count(seed) == 0)
+            cache.clear();
+
+        auto& block_states = cache[seed];
+        if(block_states.empty())
+            block_states.push_back(XorwowSeedState(seed));
+        while(block_states.size() < blocks_num)
+        {
+            auto state = block_states.back();
+            block_step.Apply(&state.x);
+            block_states.push_back(state);
+        }
+        return {block_states.begin(),
+                block_states.begin() + std::min(blocks_num, block_states.size())};
+    }
+};
+
+inline XorwowStateEngine& GetXorwowStateEngine()
+{
+    static XorwowStateEngine engine;
+    return engine;
+}
+
+} // namespace miopen
+
+#endif // GUARD_MIOPEN_XORWOW_HOST_ENGINE_HPP_
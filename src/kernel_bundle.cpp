@@ -0,0 +1,357 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2019 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/kernel_bundle.hpp>
+#include <miopen/errors.hpp>
+#include <miopen/handle.hpp>
+#include <miopen/logger.hpp>
+#include <miopen/md5.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <fstream>
+#include <iterator>
+#include <mutex>
+#include <sstream>
+
+namespace miopen {
+
+namespace {
+
+const char bundle_magic[]          = "MIOPENKB";
+const std::uint64_t bundle_version = 1;
+
+void WriteU64(std::ostream& stream, std::uint64_t value)
+{
+    // Little endian regardless of the host.
+    char bytes[8];
+    for(auto& byte : bytes)
+    {
+        byte = static_cast<char>(value & 0xff);
+        value >>= 8;
+    }
+    stream.write(bytes, sizeof(bytes));
+}
+
+void WriteString(std::ostream& stream, const std::string& s)
+{
+    WriteU64(stream, s.size());
+    stream.write(s.data(), s.size());
+}
+
+void WriteSizes(std::ostream& stream, const std::vector<std::size_t>& sizes)
+{
+    WriteU64(stream, sizes.size());
+    for(const auto size : sizes)
+        WriteU64(stream, size);
+}
+
+class BundleReader
+{
+    public:
+    BundleReader(const std::string& data_) : data(data_) {}
+
+    std::uint64_t ReadU64()
+    {
+        Require(8);
+        std::uint64_t value = 0;
+        for(std::size_t i = 8; i > 0; --i)
+            value = (value << 8) | static_cast<unsigned char>(data[pos + i - 1]);
+        pos += 8;
+        return value;
+    }
+
+    std::string ReadString()
+    {
+        const auto size = ReadU64();
+        Require(size);
+        auto s = data.substr(pos, size);
+        pos += size;
+        return s;
+    }
+
+    std::vector<std::size_t> ReadSizes()
+    {
+        const auto count = ReadU64();
+        Require(count * 8);
+        std::vector<std::size_t> sizes;
+        sizes.reserve(count);
+        for(std::uint64_t i = 0; i < count; ++i)
+            sizes.push_back(ReadU64());
+        return sizes;
+    }
+
+    std::size_t Remaining() const { return data.size() - pos; }
+
+    private:
+    const std::string& data;
+    std::size_t pos = 0;
+
+    void Require(std::uint64_t size) const
+    {
+        if(size > Remaining())
+            MIOPEN_THROW("Kernel bundle is truncated");
+    }
+};
+
+struct BundleRecorder
+{
+    std::mutex mutex;
+    std::atomic<bool> recording{false};
+    bool mixed_devices = false;
+    KernelBundle bundle;
+
+    static BundleRecorder& Get()
+    {
+        static BundleRecorder recorder;
+        return recorder;
+    }
+};
+
+} // namespace
+
+bool operator==(const BundleKernel& left, const BundleKernel& right)
+{
+    return left.algorithm == right.algorithm && left.network_config == right.network_config &&
+           left.cache_index == right.cache_index && left.program_name == right.program_name &&
+           left.params == right.params && left.is_kernel_str == right.is_kernel_str &&
+           left.kernel_name == right.kernel_name && left.vld == right.vld && left.vgd == right.vgd;
+}
+
+const std::string* KernelBundle::FindProgram(const std::string& program_name,
+                                             const std::string& params,
+                                             bool is_kernel_str) const
+{
+    const auto it = programs.find(std::make_tuple(program_name, params, is_kernel_str));
+    return it == programs.end() ? nullptr : &it->second;
+}
+
+void KernelBundle::AddProgram(const std::string& program_name,
+                              const std::string& params,
+                              bool is_kernel_str,
+                              std::string binary)
+{
+    programs[std::make_tuple(program_name, params, is_kernel_str)] = std::move(binary);
+}
+
+void KernelBundle::AddKernel(const BundleKernel& kernel)
+{
+    const auto same_slot = [&](const BundleKernel& k) {
+        return k.algorithm == kernel.algorithm && k.network_config == kernel.network_config &&
+               k.cache_index == kernel.cache_index;
+    };
+    const auto it = std::find_if(kernels.begin(), kernels.end(), same_slot);
+    if(it == kernels.end())
+        kernels.push_back(kernel);
+    else
+        *it = kernel; // The kernel cache keeps the last kernel added to a slot as well.
+}
+
+void KernelBundle::Write(std::ostream& stream) const
+{
+    std::ostringstream contents;
+    WriteString(contents, device);
+    WriteU64(contents, programs.size());
+    for(const auto& program : programs)
+    {
+        WriteString(contents, std::get<0>(program.first));
+        WriteString(contents, std::get<1>(program.first));
+        WriteU64(contents, std::get<2>(program.first) ? 1 : 0);
+        WriteString(contents, program.second);
+    }
+    WriteU64(contents, kernels.size());
+    for(const auto& kernel : kernels)
+    {
+        WriteString(contents, kernel.algorithm);
+        WriteString(contents, kernel.network_config);
+        WriteU64(contents, kernel.cache_index);
+        WriteString(contents, kernel.program_name);
+        WriteString(contents, kernel.params);
+        WriteU64(contents, kernel.is_kernel_str ? 1 : 0);
+        WriteString(contents, kernel.kernel_name);
+        WriteSizes(contents, kernel.vld);
+        WriteSizes(contents, kernel.vgd);
+    }
+
+    const auto data = contents.str();
+    stream.write(bundle_magic, sizeof(bundle_magic) - 1);
+    WriteU64(stream, bundle_version);
+    WriteString(stream, data);
+    WriteString(stream, md5(data));
+}
+
+KernelBundle KernelBundle::Read(std::istream& stream)
+{
+    const std::string file{std::istreambuf_iterator<char>{stream},
+                           std::istreambuf_iterator<char>{}};
+    const std::size_t magic_size = sizeof(bundle_magic) - 1;
+    if(file.compare(0, magic_size, bundle_magic) != 0)
+        MIOPEN_THROW("Not a kernel bundle");
+
+    const auto header = file.substr(magic_size);
+    BundleReader header_reader{header};
+    const auto version = header_reader.ReadU64();
+    if(version != bundle_version)
+        MIOPEN_THROW("Unsupported kernel bundle version: " + std::to_string(version));
+    const auto data     = header_reader.ReadString();
+    const auto checksum = header_reader.ReadString();
+    if(checksum != md5(data))
+        MIOPEN_THROW("Kernel bundle is corrupted: checksum mismatch");
+
+    KernelBundle bundle;
+    BundleReader reader{data};
+    bundle.device         = reader.ReadString();
+    const auto prog_count = reader.ReadU64();
+    for(std::uint64_t i = 0; i < prog_count; ++i)
+    {
+        auto name          = reader.ReadString();
+        auto params        = reader.ReadString();
+        const auto kstr    = reader.ReadU64() != 0;
+        bundle.programs[std::make_tuple(std::move(name), std::move(params), kstr)] =
+            reader.ReadString();
+    }
+    const auto kernel_count = reader.ReadU64();
+    for(std::uint64_t i = 0; i < kernel_count; ++i)
+    {
+        BundleKernel kernel;
+        kernel.algorithm      = reader.ReadString();
+        kernel.network_config = reader.ReadString();
+        kernel.cache_index    = reader.ReadU64();
+        kernel.program_name   = reader.ReadString();
+        kernel.params         = reader.ReadString();
+        kernel.is_kernel_str  = reader.ReadU64() != 0;
+        kernel.kernel_name    = reader.ReadString();
+        kernel.vld            = reader.ReadSizes();
+        kernel.vgd            = reader.ReadSizes();
+        bundle.kernels.push_back(std::move(kernel));
+    }
+    if(reader.Remaining() != 0)
+        MIOPEN_THROW("Kernel bundle has trailing data");
+    return bundle;
+}
+
+void KernelBundle::Save(const std::string& path) const
+{
+    std::ofstream file(path, std::ios::binary);
+    if(!file)
+        MIOPEN_THROW("Unable to write kernel bundle: " + path);
+    Write(file);
+    if(!file)
+        MIOPEN_THROW("Failed writing kernel bundle: " + path);
+}
+
+KernelBundle KernelBundle::Load(const std::string& path)
+{
+    std::ifstream file(path, std::ios::binary);
+    if(!file)
+        MIOPEN_THROW(miopenStatusBadParm, "Unable to read kernel bundle: " + path);
+    return Read(file);
+}
+
+void StartKernelBundleRecording()
+{
+    auto& recorder = BundleRecorder::Get();
+    std::lock_guard<std::mutex> lock(recorder.mutex);
+    recorder.bundle        = {};
+    recorder.mixed_devices = false;
+    recorder.recording     = true;
+}
+
+bool IsRecordingKernelBundle() { return BundleRecorder::Get().recording; }
+
+void RecordBundleProgram(const std::string& device,
+                         const std::string& program_name,
+                         const std::string& params,
+                         bool is_kernel_str,
+                         std::string binary)
+{
+    auto& recorder = BundleRecorder::Get();
+    std::lock_guard<std::mutex> lock(recorder.mutex);
+    if(!recorder.recording)
+        return;
+    if(recorder.bundle.device.empty())
+        recorder.bundle.device = device;
+    else if(recorder.bundle.device != device)
+        recorder.mixed_devices = true;
+    recorder.bundle.AddProgram(program_name, params, is_kernel_str, std::move(binary));
+}
+
+void RecordBundleKernel(const BundleKernel& kernel)
+{
+    auto& recorder = BundleRecorder::Get();
+    std::lock_guard<std::mutex> lock(recorder.mutex);
+    if(recorder.recording)
+        recorder.bundle.AddKernel(kernel);
+}
+
+KernelBundle StopKernelBundleRecording()
+{
+    auto& recorder = BundleRecorder::Get();
+    std::lock_guard<std::mutex> lock(recorder.mutex);
+    if(!recorder.recording)
+        MIOPEN_THROW("Kernel bundle recording has not been started");
+    recorder.recording = false;
+    if(recorder.mixed_devices)
+        MIOPEN_THROW("Kernels for different devices have been recorded");
+    auto bundle = std::move(recorder.bundle);
+    recorder.bundle = {};
+    return bundle;
+}
+
+void Handle::LoadKernelBundle(const std::string& path)
+{
+    auto bundle       = std::make_shared<KernelBundle>(KernelBundle::Load(path));
+    const auto device = this->GetDeviceName();
+    if(bundle->device != device)
+        MIOPEN_THROW(miopenStatusBadParm,
+                     "Kernel bundle " + path + " is built for " + bundle->device + ", not for " +
+                         device);
+    for(const auto& kernel : bundle->kernels)
+    {
+        if(bundle->FindProgram(kernel.program_name, kernel.params, kernel.is_kernel_str) ==
+           nullptr)
+            MIOPEN_THROW("Kernel bundle " + path + " has no binary for " + kernel.program_name);
+    }
+
+    // LoadProgram() takes the binaries from the bundle from now on.
+    std::atomic_store(&this->kernel_bundle, std::shared_ptr<const KernelBundle>{bundle});
+    for(const auto& kernel : bundle->kernels)
+    {
+        this->AddKernel(kernel.algorithm,
+                        kernel.network_config,
+                        kernel.program_name,
+                        kernel.kernel_name,
+                        kernel.vld,
+                        kernel.vgd,
+                        kernel.params,
+                        kernel.cache_index,
+                        kernel.is_kernel_str);
+    }
+    MIOPEN_LOG_I("Loaded " << bundle->kernels.size() << " kernels of " << bundle->programs.size()
+                           << " programs from " << path);
+}
+
+} // namespace miopen
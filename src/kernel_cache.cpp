@@ -40,6 +40,7 @@
  * ************************************************************************ */
 
 #include <miopen/errors.hpp>
+#include <miopen/kernel_bundle.hpp>
 #include <miopen/kernel_cache.hpp>
 #include <miopen/logger.hpp>
 
@@ -114,6 +115,7 @@ const std::vector<Kernel>& KernelCache::GetKernels(const std::string& algorithm,
 
     std::pair<std::string, std::string> key = std::make_pair(algorithm, network_config);
 
+    std::lock_guard<std::mutex> lock(mutex);
     const auto it = kernel_map.find(key);
     if(it != kernel_map.end())
     {
@@ -133,6 +135,7 @@ bool KernelCache::HasKernels(const std::string& algorithm, const std::string& ne
 #ifndef NDEBUG
     MIOPEN_LOG_I("Key: " << key.first << " \"" << key.second << '\"');
 #endif
+    std::lock_guard<std::mutex> lock(mutex);
     const auto it = kernel_map.find(key);
     if(it == kernel_map.end())
         return false;
@@ -172,19 +175,23 @@ Kernel KernelCache::AddKernel(Handle& h,
         MIOPEN_LOG_I2("Key: " << key.first << " \"" << key.second << '\"');
 
     Program program;
+    bool found = false;
 
-    auto program_it = program_map.find(std::make_pair(program_name, params));
-    if(program_it != program_map.end())
     {
-        program = program_it->second;
+        std::lock_guard<std::mutex> lock(mutex);
+        auto program_it = program_map.find(std::make_pair(program_name, params));
+        found           = program_it != program_map.end();
+        if(found)
+            program = program_it->second;
     }
-    else
-    {
-        if(!is_kernel_miopengemm_str) // default value
-            is_kernel_miopengemm_str = algorithm.find("ImplicitGEMM") == std::string::npos &&
-                                       algorithm.find("GEMM") != std::string::npos &&
-                                       algorithm.find("StaticCompiledGEMM") == std::string::npos;
 
+    if(!is_kernel_miopengemm_str) // default value
+        is_kernel_miopengemm_str = algorithm.find("ImplicitGEMM") == std::string::npos &&
+                                   algorithm.find("GEMM") != std::string::npos &&
+                                   algorithm.find("StaticCompiledGEMM") == std::string::npos;
+
+    if(!found)
+    {
         if(miopen::IsLogging(miopen::LoggingLevel::Info2))
         {
             AddKernelDumpKernelParams(is_kernel_miopengemm_str
@@ -196,18 +203,30 @@ Kernel KernelCache::AddKernel(Handle& h,
                                       params);
         }
         program = h.LoadProgram(program_name, params, is_kernel_miopengemm_str, kernel_src);
+        std::lock_guard<std::mutex> lock(mutex);
         program_map[std::make_pair(program_name, params)] = program;
     }
     Kernel kernel{program, kernel_name, vld, vgd};
     if(!network_config.empty() && !algorithm.empty())
     {
         this->AddKernel(key, kernel, cache_index);
+        if(IsRecordingKernelBundle())
+            RecordBundleKernel({algorithm,
+                                network_config,
+                                cache_index,
+                                program_name,
+                                params,
+                                is_kernel_miopengemm_str,
+                                kernel_name,
+                                vld,
+                                vgd});
     }
     return kernel;
 }
 
 void KernelCache::AddKernel(Key key, Kernel k, std::size_t cache_index)
 {
+    std::lock_guard<std::mutex> lock(mutex);
     auto&& v = kernel_map[key];
     if(cache_index >= v.size())
     {
@@ -223,6 +242,7 @@ void KernelCache::ClearKernels(const std::string& algorithm, const std::string&
         MIOPEN_THROW("Network config or algorithm empty.");
     }
     const std::pair<std::string, std::string> key = std::make_pair(algorithm, network_config);
+    std::lock_guard<std::mutex> lock(mutex);
     auto&& v = this->kernel_map[key];
     if(!v.empty())
     {
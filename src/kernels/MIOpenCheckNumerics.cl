@@ -77,12 +77,16 @@ void cl_atomic_max_float(volatile __global float* addr, float val)
         barrier(CLK_LOCAL_MEM_FENCE);                                             \
     }
 
-// Checks a block of data for abnormal numeric values :
+// Checks a block of data for abnormal numeric values, the result is accumulated
+// into abnormal[resultIndex] :
 __kernel void MIOpenCheckNumerics(const __global DTYPE* data,
                                   int size,
                                   __global struct CheckNumericsResult* abnormal,
-                                  int computeStats)
+                                  int computeStats,
+                                  int resultIndex)
 {
+    abnormal += resultIndex;
+
     const int lid           = get_local_id(0);
     const int gid           = get_global_id(0);
     const int total_wi_size = get_global_size(0);
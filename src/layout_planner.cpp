@@ -0,0 +1,76 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2019 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/layout_planner.hpp>
+#include <miopen/algorithm.hpp>
+#include <miopen/errors.hpp>
+
+#include <string>
+
+namespace miopen {
+
+static bool IsTransposedLayer(const LayoutPlanLayer& layer)
+{
+    return layer.conv.IsGemmTransposeFwd(layer.xDesc, layer.wDesc) &&
+           layer.wDesc.GetType() != miopenInt8 && layer.wDesc.GetType() != miopenInt8x4;
+}
+
+LayoutPlan PlanConvLayouts(const std::vector<LayoutPlanLayer>& layers)
+{
+    for(std::size_t i = 1; i < layers.size(); ++i)
+    {
+        const auto& prev = layers[i - 1];
+        if(prev.conv.GetForwardOutputTensor(prev.xDesc, prev.wDesc).GetLengths() !=
+           layers[i].xDesc.GetLengths())
+            MIOPEN_THROW(miopenStatusBadParm,
+                         "Input of layer " + std::to_string(i) +
+                             " does not match the output of the previous layer");
+    }
+
+    LayoutPlan plan;
+    plan.steps.resize(layers.size());
+    for(std::size_t i = 0; i < layers.size(); ++i)
+    {
+        if(!IsTransposedLayer(layers[i]))
+            continue;
+
+        auto& step = plan.steps[i];
+        if(i > 0 && IsTransposedLayer(layers[i - 1]))
+            step.input = ConvLayout::CNHW;
+        if(i + 1 < layers.size() && IsTransposedLayer(layers[i + 1]))
+            step.output = ConvLayout::CNHW;
+
+        const bool in_place =
+            step.input == ConvLayout::CNHW &&
+            miopen::all_of(layers[i].conv.GetConvStrides(), [](auto v) { return v == 1; });
+
+        step.transposes = (in_place ? 0 : 1) + (step.output == ConvLayout::CNHW ? 0 : 1);
+        plan.transposes += step.transposes;
+        plan.baseline_transposes += 2;
+    }
+    return plan;
+}
+
+} // namespace miopen
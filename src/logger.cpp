@@ -155,6 +155,24 @@ std::string LoggingPrefix()
     return ss.str();
 }
 
+namespace {
+thread_local const char* current_api_call = nullptr;
+} // namespace
+
+const char* GetCurrentApiCall() { return current_api_call; }
+
+ApiCallScope::ApiCallScope(const char* name) : outermost(current_api_call == nullptr)
+{
+    if(outermost)
+        current_api_call = name;
+}
+
+ApiCallScope::~ApiCallScope()
+{
+    if(outermost)
+        current_api_call = nullptr;
+}
+
 /// Expected to be invoked with __func__ and __PRETTY_FUNCTION__.
 std::string LoggingParseFunction(const char* func, const char* pretty_func)
 {
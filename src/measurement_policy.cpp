@@ -0,0 +1,162 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2019 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/measurement_policy.hpp>
+#include <miopen/env.hpp>
+#include <miopen/errors.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <numeric>
+
+namespace miopen {
+namespace solver {
+
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_SEARCH_WARMUP_RUNS)
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_SEARCH_MIN_RUNS)
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_SEARCH_MAX_RUNS)
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_SEARCH_ESTIMATOR)
+
+namespace {
+
+template <class T>
+void SetFromEnv(T, std::size_t& value)
+{
+    const auto str = GetStringEnv(T{});
+    if(str != nullptr)
+        value = std::strtoul(str, nullptr, 10);
+}
+
+float Median(std::vector<float> v)
+{
+    std::sort(v.begin(), v.end());
+    const auto n = v.size();
+    return n % 2 != 0 ? v[n / 2] : (v[n / 2 - 1] + v[n / 2]) / 2;
+}
+
+/// Two-sided 95% quantiles of Student's t-distribution for 1..10 degrees of freedom.
+float TQuantile95(std::size_t dof)
+{
+    static const float table[] = {
+        12.706f, 4.303f, 3.182f, 2.776f, 2.571f, 2.447f, 2.365f, 2.306f, 2.262f, 2.228f};
+    if(dof == 0)
+        return std::numeric_limits<float>::infinity();
+    if(dof <= sizeof(table) / sizeof(table[0]))
+        return table[dof - 1];
+    return 1.96f;
+}
+
+} // namespace
+
+MeasurementPolicy MeasurementPolicy::FromEnv()
+{
+    MeasurementPolicy policy;
+    SetFromEnv(MIOPEN_SEARCH_WARMUP_RUNS{}, policy.warmup_runs);
+    SetFromEnv(MIOPEN_SEARCH_MIN_RUNS{}, policy.min_runs);
+    SetFromEnv(MIOPEN_SEARCH_MAX_RUNS{}, policy.max_runs);
+    policy.max_runs = std::max<std::size_t>(policy.max_runs, 1);
+    policy.min_runs = std::min(std::max<std::size_t>(policy.min_runs, 1), policy.max_runs);
+
+    const auto estimator = GetStringEnv(MIOPEN_SEARCH_ESTIMATOR{});
+    if(estimator != nullptr)
+    {
+        const std::string str = estimator;
+        if(str == "median")
+            policy.estimator = Estimator::Median;
+        else if(str == "trimmed_mean")
+            policy.estimator = Estimator::TrimmedMean;
+        else
+            MIOPEN_THROW("Invalid MIOPEN_SEARCH_ESTIMATOR: " + str);
+    }
+    return policy;
+}
+
+MeasurementResult MeasurementPolicy::Estimate(std::vector<float> samples) const
+{
+    MeasurementResult result;
+    if(samples.empty())
+        return result;
+
+    if(samples.size() >= 3)
+    {
+        const auto median = Median(samples);
+        std::vector<float> deviations(samples.size());
+        std::transform(samples.begin(), samples.end(), deviations.begin(), [&](auto x) {
+            return std::fabs(x - median);
+        });
+        const auto limit = outlier_threshold * 1.4826f * Median(deviations);
+        // Zero MAD means most samples are equal; nothing to measure the spread by.
+        if(limit > 0.0f)
+        {
+            const auto size = samples.size();
+            samples.erase(std::remove_if(samples.begin(),
+                                         samples.end(),
+                                         [&](auto x) { return std::fabs(x - median) > limit; }),
+                          samples.end());
+            result.outliers = size - samples.size();
+        }
+    }
+
+    std::sort(samples.begin(), samples.end());
+    const auto n = samples.size();
+
+    if(estimator == Estimator::Median)
+    {
+        result.time = Median(samples);
+    }
+    else
+    {
+        const auto trim = std::min(static_cast<std::size_t>(n * trim_fraction), (n - 1) / 2);
+        const auto sum  = std::accumulate(samples.begin() + trim, samples.end() - trim, 0.0f);
+        result.time     = sum / static_cast<float>(n - 2 * trim);
+    }
+
+    result.samples = n;
+    if(n > 1)
+    {
+        const auto mean = std::accumulate(samples.begin(), samples.end(), 0.0f) / n;
+        float ss        = 0.0f;
+        for(const auto x : samples)
+            ss += (x - mean) * (x - mean);
+        result.variance      = ss / (n - 1);
+        result.ci_half_width = TQuantile95(n - 1) * std::sqrt(result.variance / n);
+    }
+    else
+    {
+        result.ci_half_width = std::numeric_limits<float>::infinity();
+    }
+    return result;
+}
+
+MeasurementResult& LastSearchTiming()
+{
+    thread_local MeasurementResult result;
+    return result;
+}
+
+} // namespace solver
+} // namespace miopen
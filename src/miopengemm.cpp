@@ -26,6 +26,7 @@
 
 #include <miopen/handle.hpp>
 #include <miopen/miopengemm.hpp>
+#include <miopen/miopengemm_db.hpp>
 #include <miopen/float_equal.hpp>
 
 #if MIOPEN_USE_MIOPENGEMM
@@ -69,41 +70,52 @@ void AddMiopengemmSolution(Handle& handle,
                            float time,
                            bool enforce_determinism)
 {
+    const auto db_path = MiopengemmDb::GetUserPath(handle);
+    const auto db_key  = MiopengemmDbKey{network_config, enforce_determinism};
+    auto found         = MiopengemmDb::Load(db_path, db_key);
+
+    if(!found)
+    {
 #if MIOPEN_BACKEND_OPENCL
-    // jn : print search results to terminal
-    bool miopengemm_verbose = false;
-
-    // jn : print warning messages when the returned kernel(s) might be sub-optimal
-    bool miopengemm_warnings = false;
-
-    // jn : find with no workspace
-    MIOpenGEMM::Solution soln = MIOpenGEMM::find(time,
-                                                 handle.GetStream(),
-                                                 A,
-                                                 B,
-                                                 C,
-                                                 enforce_determinism,
-                                                 mgg,
-                                                 miopengemm_verbose,
-                                                 miopengemm_warnings);
+        // jn : print search results to terminal
+        bool miopengemm_verbose = false;
+
+        // jn : print warning messages when the returned kernel(s) might be sub-optimal
+        bool miopengemm_warnings = false;
+
+        // jn : find with no workspace
+        MIOpenGEMM::Solution soln = MIOpenGEMM::find(time,
+                                                     handle.GetStream(),
+                                                     A,
+                                                     B,
+                                                     C,
+                                                     enforce_determinism,
+                                                     mgg,
+                                                     miopengemm_verbose,
+                                                     miopengemm_warnings);
 #else
-    (void)A;
-    (void)B;
-    (void)C;
-    (void)time;
-    (void)enforce_determinism;
-    MIOpenGEMM::Solution soln = MIOpenGEMM::get_default(mgg);
+        (void)A;
+        (void)B;
+        (void)C;
+        (void)time;
+        MIOpenGEMM::Solution soln = MIOpenGEMM::get_default(mgg);
 #endif
-    // jn : the main kernel is at the back of the solution vector
-    std::string kernel_clstring = soln.v_tgks.back().kernstr;
-    tempfix_v2::set_offsets_to_uint(kernel_clstring);
+        found.emplace();
+        for(const auto& tgk : soln.v_tgks)
+        {
+            auto kernel = MiopengemmKernel{
+                tgk.fname, tgk.kernstr, tgk.local_work_size, tgk.global_work_size};
+            tempfix_v2::set_offsets_to_uint(kernel.source);
+            found->kernels.push_back(kernel);
+        }
+        MiopengemmDb::Store(db_path, db_key, *found);
+    }
 
-    std::string kernel_name = soln.v_tgks.back().fname;
-    size_t local_work_size  = soln.v_tgks.back().local_work_size;
-    size_t global_work_size = soln.v_tgks.back().global_work_size;
+    // jn : the main kernel is at the back of the solution vector
+    const auto& main_kernel = found->kernels.back();
 
-    std::vector<size_t> vld{local_work_size, 1, 1};
-    std::vector<size_t> vgd{global_work_size, 1, 1};
+    std::vector<size_t> vld{main_kernel.local_work_size, 1, 1};
+    std::vector<size_t> vgd{main_kernel.global_work_size, 1, 1};
 
     // chao : there are 2 possible kernel paths for C = alpha * A * B + beta * C in MIOpenGEMM
     // library
@@ -112,23 +124,19 @@ void AddMiopengemmSolution(Handle& handle,
     //      kernel_2 : C += alpha * A * B
 
     // this kernel could be kernel_0, kernel_1
-    handle.AddKernel(algorithm_name, network_config, kernel_clstring, kernel_name, vld, vgd, "", 0);
+    handle.AddKernel(
+        algorithm_name, network_config, main_kernel.source, main_kernel.name, vld, vgd, "", 0);
 
-    if(soln.v_tgks.size() == 2)
+    if(found->kernels.size() == 2)
     {
-        std::string beta_program_name = soln.v_tgks[0].kernstr;
-        tempfix_v2::set_offsets_to_uint(beta_program_name);
-
-        std::string beta_kernel_name = soln.v_tgks[0].fname;
-        local_work_size              = soln.v_tgks[0].local_work_size;
-        global_work_size             = soln.v_tgks[0].global_work_size;
+        const auto& beta_kernel = found->kernels[0];
 
-        vld[0] = local_work_size;
-        vgd[0] = global_work_size;
+        vld[0] = beta_kernel.local_work_size;
+        vgd[0] = beta_kernel.global_work_size;
 
         // chao : this is kernel_2: C += alpha * A * B (needs to work with kernel_1)
         handle.AddKernel(
-            algorithm_name, network_config, beta_program_name, beta_kernel_name, vld, vgd, "", 1);
+            algorithm_name, network_config, beta_kernel.source, beta_kernel.name, vld, vgd, "", 1);
     }
 
 #if MIOPENGEMM_CPP_DEBUG
@@ -0,0 +1,185 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2019 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/miopengemm_db.hpp>
+#include <miopen/db.hpp>
+#include <miopen/db_path.hpp>
+#include <miopen/env.hpp>
+#include <miopen/handle.hpp>
+#include <miopen/logger.hpp>
+
+#include <cstdio>
+#include <cstdlib>
+#include <sstream>
+
+namespace miopen {
+
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_DISABLE_MIOPENGEMM_DB)
+
+namespace {
+
+// Characters with a meaning in the db line format, and the escape character itself.
+bool IsEscaped(char c)
+{
+    switch(c)
+    {
+    case '%':
+    case '\n':
+    case '\r':
+    case '=':
+    case ';':
+    case ':':
+    case ',': return true;
+    default: return false;
+    }
+}
+
+void WriteEscaped(std::ostream& stream, const std::string& s)
+{
+    for(const auto c : s)
+    {
+        if(IsEscaped(c))
+        {
+            char buf[4];
+            std::snprintf(buf, sizeof(buf), "%%%02X", static_cast<unsigned int>(c));
+            stream << buf;
+        }
+        else
+        {
+            stream << c;
+        }
+    }
+}
+
+bool ReadEscaped(const std::string& s, std::string& result)
+{
+    result.clear();
+    result.reserve(s.size());
+    for(std::size_t i = 0; i < s.size(); ++i)
+    {
+        if(s[i] != '%')
+        {
+            result += s[i];
+            continue;
+        }
+        if(i + 2 >= s.size())
+            return false;
+        char* end       = nullptr;
+        const auto code = s.substr(i + 1, 2);
+        const auto c    = std::strtoul(code.c_str(), &end, 16);
+        if(end != code.c_str() + 2)
+            return false;
+        result += static_cast<char>(c);
+        i += 2;
+    }
+    return true;
+}
+
+bool ReadSize(const std::string& s, std::size_t& result)
+{
+    char* end = nullptr;
+    result    = std::strtoull(s.c_str(), &end, 10);
+    return !s.empty() && end == s.c_str() + s.size();
+}
+
+} // namespace
+
+void MiopengemmKernels::Serialize(std::ostream& stream) const
+{
+    stream << kernels.size();
+    for(const auto& kernel : kernels)
+    {
+        stream << ',' << kernel.name << ',' << kernel.local_work_size << ','
+               << kernel.global_work_size << ',';
+        WriteEscaped(stream, kernel.source);
+    }
+}
+
+bool MiopengemmKernels::Deserialize(const std::string& s)
+{
+    std::vector<std::string> fields;
+    std::istringstream ss(s);
+    std::string field;
+    while(std::getline(ss, field, ','))
+        fields.push_back(field);
+
+    std::size_t count = 0;
+    if(fields.empty() || !ReadSize(fields[0], count) || count == 0 ||
+       fields.size() != 1 + 4 * count)
+        return false;
+
+    std::vector<MiopengemmKernel> read(count);
+    for(std::size_t i = 0; i < count; ++i)
+    {
+        const auto* kernel_fields = &fields[1 + 4 * i];
+        read[i].name              = kernel_fields[0];
+        if(read[i].name.empty() || !ReadSize(kernel_fields[1], read[i].local_work_size) ||
+           !ReadSize(kernel_fields[2], read[i].global_work_size) ||
+           !ReadEscaped(kernel_fields[3], read[i].source) || read[i].source.empty())
+            return false;
+    }
+
+    kernels = std::move(read);
+    return true;
+}
+
+void MiopengemmDbKey::Serialize(std::ostream& stream) const
+{
+    stream << network_config;
+    if(enforce_determinism)
+        stream << "_deterministic";
+}
+
+std::string MiopengemmDb::GetUserPath(Handle& handle)
+{
+    return GetUserDbPath() + "/" + handle.GetDbBasename() + "." + GetUserDbSuffix() +
+           ".ugemmdb.txt";
+}
+
+boost::optional<MiopengemmKernels> MiopengemmDb::Load(const std::string& path,
+                                                      const MiopengemmDbKey& key)
+{
+    if(IsEnabled(MIOPEN_DEBUG_DISABLE_MIOPENGEMM_DB{}))
+        return boost::none;
+
+    auto kernels = MiopengemmKernels{};
+    if(!Db{path, false}.Load(key, "MIOpenGEMM", kernels))
+        return boost::none;
+    MIOPEN_LOG_I2("MIOpenGEMM kernels loaded from <" << path << ">: " << key.network_config);
+    return kernels;
+}
+
+void MiopengemmDb::Store(const std::string& path,
+                         const MiopengemmDbKey& key,
+                         const MiopengemmKernels& kernels)
+{
+    if(IsEnabled(MIOPEN_DEBUG_DISABLE_MIOPENGEMM_DB{}))
+        return;
+
+    if(!Db{path, false}.Update(key, "MIOpenGEMM", kernels))
+        MIOPEN_LOG_E("Failed to store MIOpenGEMM kernels to <" << path << ">");
+}
+
+} // namespace miopen
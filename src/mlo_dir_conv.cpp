@@ -34,6 +34,7 @@
 #include <miopen/mlo_internal.hpp>
 #include <miopen/mlo_utils.hpp>
 #include <miopen/solver.hpp>
+#include <miopen/solver_policy.hpp>
 #include <miopen/readonlyramdb.hpp>
 #include <miopen/datatype.hpp>
 #include <miopen/version.h>
@@ -64,10 +65,11 @@ mlo_construct_direct2D_fusion::FindSolution(const std::vector<miopen::solver::An
 {
     miopen::solver::ConvSolution solution{miopenStatusUnknownError};
     std::string solver_id;
-    auto db = this->GetDb();
+    auto db            = this->GetDb();
+    const auto& policy = miopen::GetSolverPolicy(_search_params);
     for(auto& solver : solvers)
     {
-        solution = solver.FindSolution(_search_params, db);
+        solution = solver.FindSolution(_search_params, db, policy);
         if(solution.Succeeded() && solver.IsApplicable(_search_params) &&
            solver.IsFast(_search_params))
         {
@@ -25,11 +25,13 @@
  *******************************************************************************/
 #include <miopen/batch_norm.hpp>
 
+#include <miopen/batch_norm_solver.hpp>
 #include <miopen/check_numerics.hpp>
 #include <miopen/errors.hpp>
 #include <miopen/handle.hpp>
 #include <miopen/float_equal.hpp>
 #include <miopen/logger.hpp>
+#include <miopen/stringutils.hpp>
 #include <miopen/tensor.hpp>
 #include <miopen/util.hpp>
 #include <miopen/visit_float.hpp>
@@ -138,221 +140,49 @@ void BatchNormForwardTraining(Handle& handle,
 
     if(bn_mode == miopenBNSpatial)
     {
-        bool single           = true;
-        unsigned int variant  = 1;
-        unsigned int ldsgcn   = xlocalsize / 64;
-        unsigned int ldsnogcn = xlocalsize;
-        std::string algo_name = "miopenBatchNormForwardTrainingSpatial";
-        if(in_nhw < 33554432 && in_cstride > 1024)
-        {
-            //
-        }
-        else if(in_nhw < 33554432 && in_cstride > 512)
-        {
-            variant    = 3;
-            xlocalsize = 64 * ((in_cstride + 63) / 64);
-            ldsgcn     = xlocalsize / 64;
-            ldsnogcn   = xlocalsize;
-            xgridsize  = c * xlocalsize;
-            algo_name  = "gcnAsmBNFwdTrainSpatial";
-        }
-        else if(in_cstride <= 512)
-        {
-            variant = 0;
-        }
-        else
-        {
-            variant      = 2;
-            xlocalsize   = 1;
-            ylocalsize   = 1024;
-            auto segment = int(std::ceil(double(in_cstride) / double(ylocalsize)));
-            xgridsize    = c;
-            ygridsize    = segment * ylocalsize;
-            single       = false;
-            ldsgcn       = ylocalsize / 64;
-            ldsnogcn     = ylocalsize;
-        }
-
-        std::string network_config =
-            "variant" + std::to_string(variant) + "gx" + std::to_string(xgridsize) + "gy" +
-            std::to_string(ygridsize) + "xl" + std::to_string(xlocalsize) + "yl" +
-            std::to_string(ylocalsize) + "ldsgcn" + std::to_string(ldsgcn) + "rs" +
-            std::to_string(static_cast<int>(resultsave)) + "rr" +
-            std::to_string(static_cast<int>(resultrunning)) + "fp16" +
-            std::to_string(static_cast<int>(bfp16parm)) + "fp32" +
-            std::to_string(static_cast<int>(bfp32parm)) + "single" +
-            std::to_string(static_cast<int>(single)) + "n" + std::to_string(n) + "c" +
-            std::to_string(c) + "hw" + std::to_string(in_cstride);
-
-        auto&& kernels = handle.GetKernels(algo_name, network_config);
-
-        if(single)
-        {
-            if(!kernels.empty())
+        const auto run_spatial = [&](const solver::BnSpatialSolution& solution, bool running) {
+            const bool single           = solution.single;
+            const unsigned int variant  = solution.variant;
+            const unsigned int ldsgcn   = solution.ldsgcn;
+            const unsigned int ldsnogcn = solution.ldsnogcn;
+
+            std::string algo_name = "miopenBatchNormForwardTrainingSpatial";
+            if(variant == 3)
+                algo_name = "gcnAsmBNFwdTrainSpatial";
+
+            xlocalsize = solution.xlocalsize;
+            ylocalsize = solution.ylocalsize;
+            xgridsize  = solution.xgridsize;
+            ygridsize  = solution.ygridsize;
+            vld.clear();
+            vgd.clear();
+
+            std::string network_config =
+                "variant" + std::to_string(variant) + "gx" + std::to_string(xgridsize) + "gy" +
+                std::to_string(ygridsize) + "xl" + std::to_string(xlocalsize) + "yl" +
+                std::to_string(ylocalsize) + "ldsgcn" + std::to_string(ldsgcn) + "rs" +
+                std::to_string(static_cast<int>(resultsave)) + "rr" +
+                std::to_string(static_cast<int>(running)) + "fp16" +
+                std::to_string(static_cast<int>(bfp16parm)) + "fp32" +
+                std::to_string(static_cast<int>(bfp32parm)) + "single" +
+                std::to_string(static_cast<int>(single)) + "n" + std::to_string(n) + "c" +
+                std::to_string(c) + "hw" + std::to_string(in_cstride);
+
+            auto&& kernels = handle.GetKernels(algo_name, network_config);
+
+            if(single)
             {
-                auto kernel = kernels.front();
-                visit_float(bnScaleBiasMeanVarDesc.GetType(), [&](auto as_float) {
-                    if(resultsave && resultrunning)
-                    {
-
-                        kernel(x,
-                               y,
-                               bnScale,
-                               bnBias,
-                               as_float(inhw),
-                               expAvgFactor,
-                               resultRunningMean,
-                               resultRunningVariance,
-                               epsilon,
-                               resultSaveMean,
-                               resultSaveInvVariance);
-                    }
-                    else if(resultsave)
-                    {
-                        kernel(x,
-                               y,
-                               bnScale,
-                               bnBias,
-                               as_float(inhw),
-                               epsilon,
-                               resultSaveMean,
-                               resultSaveInvVariance);
-                    }
-                    else if(resultrunning)
-                    {
-                        kernel(x,
-                               y,
-                               bnScale,
-                               bnBias,
-                               as_float(inhw),
-                               expAvgFactor,
-                               resultRunningMean,
-                               resultRunningVariance,
-                               epsilon);
-                    }
-                    else
-                    {
-                        kernel(x, y, bnScale, bnBias, as_float(inhw), epsilon);
-                    }
-                });
-            }
-            else
-            {
-                std::string kernel_name;
-                std::string program_name;
-                std::string parms;
-
-                if((variant == 3) && (bfpmixparm) && (n <= 64) && (n % 2 == 0))
+                if(!kernels.empty())
                 {
-                    kernel_name  = "gcnAsmBNFwdTrainSpatial";
-                    program_name = "gcnAsmBNFwdTrainSpatial.s";
-
-                    union nhw_val
-                    {
-                        unsigned u32;
-                        float f32;
-                        nhw_val()
+                    auto kernel = kernels.front();
+                    visit_float(bnScaleBiasMeanVarDesc.GetType(), [&](auto as_float) {
+                        if(resultsave && running)
                         {
-                            u32 = 0;
-                            f32 = 0;
-                        }
-                    } NHW_value;
-                    NHW_value.f32 = static_cast<float>(in_nhw / (in_nhw - 1.0));
-
-                    parms = "-Wa,-defsym,MIOPEN_USE_FP16=" +
-                            std::to_string(static_cast<int>(bfp16parm)) +
-                            " -Wa,-defsym,MIOPEN_USE_FP32=" +
-                            std::to_string(static_cast<int>(bfp32parm)) +
-                            " -Wa,-defsym,MIOPEN_USE_FPMIX=" +
-                            std::to_string(static_cast<int>(bfpmixparm)) +
-                            " -Wa,-defsym,MIO_SAVE_MEAN_VARIANCE=" +
-                            std::to_string(static_cast<int>(resultsave)) +
-                            " -Wa,-defsym,MIO_RUNNING_RESULT=" +
-                            std::to_string(static_cast<int>(resultrunning)) +
-                            " -Wa,-defsym,MIO_BN_N=" + std::to_string(n) +
-                            " -Wa,-defsym,MIO_BN_C=" + std::to_string(c) +
-                            " -Wa,-defsym,MIO_BN_HW=" + std::to_string(in_cstride) +
-                            " -Wa,-defsym,MIO_BN_NHW=" + std::to_string(in_nhw) +
-                            " -Wa,-defsym,MIO_BN_NHW_DIV=" + std::to_string(NHW_value.u32) +
-                            " -Wa,-defsym,MIO_BN_CHW=" + std::to_string(in_nstride) +
-                            " -Wa,-defsym,MIO_BN_NCHW=" + std::to_string(in_nchw) +
-                            " -Wa,-defsym,MIO_BN_LDS_SIZE=" + std::to_string(ldsnogcn) +
-                            " -Wa,-defsym,MIO_BN_LDSGCN_SIZE=" + std::to_string(ldsgcn) +
-                            " -Wa,-defsym,MIO_BN_VARIANT=" + std::to_string(variant) +
-                            " -Wa,-defsym,MIO_BN_GRP0=" + std::to_string(xlocalsize) +
-                            " -Wa,-defsym,MIO_BN_GRP1=" + std::to_string(ylocalsize) +
-                            " -Wa,-defsym,MIO_BN_GRP2=" + std::to_string(zlocalsize);
-                }
-                else
-                {
-                    kernel_name  = "MIOpenBatchNormFwdTrainSpatial";
-                    program_name = "MIOpenBatchNormFwdTrainSpatial.cl";
-
-                    parms =
-                        " -DMIOPEN_USE_FP16=" + std::to_string(static_cast<int>(bfp16parm)) +
-                        " -DMIOPEN_USE_FP32=" + std::to_string(static_cast<int>(bfp32parm)) +
-                        " -DMIOPEN_USE_FPMIX=" + std::to_string(static_cast<int>(bfpmixparm)) +
-                        " -DMIO_SAVE_MEAN_VARIANCE=" +
-                        std::to_string(static_cast<int>(resultsave)) + " -DMIO_RUNNING_RESULT=" +
-                        std::to_string(static_cast<int>(resultrunning)) + " -DMIO_BN_N=" +
-                        std::to_string(n) + " -DMIO_BN_C=" + std::to_string(c) + " -DMIO_BN_HW=" +
-                        std::to_string(in_cstride) + " -DMIO_BN_NHW=" + std::to_string(in_nhw) +
-                        " -DMIO_BN_CHW=" + std::to_string(in_nstride) + " -DMIO_BN_NCHW=" +
-                        std::to_string(in_nchw) + " -DMIO_BN_LDS_SIZE=" + std::to_string(ldsnogcn) +
-                        " -DMIO_BN_LDSGCN_SIZE=" + std::to_string(ldsgcn) + " -DMIO_BN_VARIANT=" +
-                        std::to_string(variant) + " -DMIO_BN_GRP0=" + std::to_string(xlocalsize) +
-                        " -DMIO_BN_GRP1=" + std::to_string(ylocalsize) + " -DMIO_BN_GRP2=" +
-                        std::to_string(zlocalsize);
-
-                    MIOPEN_LOG_I2(kernel_name << ":: " << algo_name);
-                    MIOPEN_LOG_I2("..." << parms);
-                    MIOPEN_LOG_I2("..." << network_config);
-                }
 
-                vld.push_back(xlocalsize);
-                vld.push_back(ylocalsize);
-                vld.push_back(zlocalsize);
-
-                vgd.push_back(xgridsize);
-                vgd.push_back(ygridsize);
-                vgd.push_back(zgridsize);
-
-                bnFwdTrainSelectSingle(handle,
-                                       bnScaleBiasMeanVarDesc.GetType(),
-                                       program_name,
-                                       algo_name,
-                                       kernel_name,
-                                       network_config,
-                                       parms,
-                                       vld,
-                                       vgd,
-                                       x,
-                                       y,
-                                       bnScale,
-                                       bnBias,
-                                       resultsave,
-                                       resultrunning,
-                                       expAvgFactor,
-                                       resultRunningMean,
-                                       resultRunningVariance,
-                                       epsilon,
-                                       resultSaveMean,
-                                       resultSaveInvVariance,
-                                       inhw);
-            }
-        }
-        else
-        {
-            if(!kernels.empty())
-            {
-                float ctime = 0.;
-                visit_float(bnScaleBiasMeanVarDesc.GetType(), [&](auto as_float) {
-                    if(resultsave && resultrunning)
-                    {
-                        kernels[0](x, y);
-                        profileSequence(handle, 0, &ctime);
-
-                        kernels[1](y,
+                            kernel(x,
+                                   y,
+                                   bnScale,
+                                   bnBias,
                                    as_float(inhw),
                                    expAvgFactor,
                                    resultRunningMean,
@@ -360,158 +190,334 @@ void BatchNormForwardTraining(Handle& handle,
                                    epsilon,
                                    resultSaveMean,
                                    resultSaveInvVariance);
-                        profileSequence(handle, 1, &ctime);
-
-                        kernels[2](x, y, bnScale, bnBias);
-                        profileSequence(handle, 2, &ctime);
-                    }
-                    else if(resultsave)
-                    {
-                        kernels[0](x, y);
-                        profileSequence(handle, 0, &ctime);
-
-                        kernels[1](
-                            y, as_float(inhw), epsilon, resultSaveMean, resultSaveInvVariance);
-                        profileSequence(handle, 1, &ctime);
-
-                        kernels[2](x, y, bnScale, bnBias);
-                        profileSequence(handle, 2, &ctime);
-                    }
-                    else if(resultrunning)
-                    {
-
-                        kernels[0](x, y);
-                        profileSequence(handle, 0, &ctime);
-
-                        kernels[1](y,
+                        }
+                        else if(resultsave)
+                        {
+                            kernel(x,
+                                   y,
+                                   bnScale,
+                                   bnBias,
+                                   as_float(inhw),
+                                   epsilon,
+                                   resultSaveMean,
+                                   resultSaveInvVariance);
+                        }
+                        else if(running)
+                        {
+                            kernel(x,
+                                   y,
+                                   bnScale,
+                                   bnBias,
                                    as_float(inhw),
                                    expAvgFactor,
                                    resultRunningMean,
                                    resultRunningVariance,
                                    epsilon);
-                        profileSequence(handle, 1, &ctime);
+                        }
+                        else
+                        {
+                            kernel(x, y, bnScale, bnBias, as_float(inhw), epsilon);
+                        }
+                    });
+                }
+                else
+                {
+                    std::string kernel_name;
+                    std::string program_name;
+                    std::string parms;
+
+                    if((variant == 3) && (bfpmixparm) && (n <= 64) && (n % 2 == 0) &&
+                       (in_cstride > 512))
+                    {
+                        kernel_name  = "gcnAsmBNFwdTrainSpatial";
+                        program_name = "gcnAsmBNFwdTrainSpatial.s";
 
-                        kernels[2](x, y, bnScale, bnBias);
-                        profileSequence(handle, 2, &ctime);
+                        union nhw_val
+                        {
+                            unsigned u32;
+                            float f32;
+                            nhw_val()
+                            {
+                                u32 = 0;
+                                f32 = 0;
+                            }
+                        } NHW_value;
+                        NHW_value.f32 = static_cast<float>(in_nhw / (in_nhw - 1.0));
+
+                        parms = "-Wa,-defsym,MIOPEN_USE_FP16=" +
+                                std::to_string(static_cast<int>(bfp16parm)) +
+                                " -Wa,-defsym,MIOPEN_USE_FP32=" +
+                                std::to_string(static_cast<int>(bfp32parm)) +
+                                " -Wa,-defsym,MIOPEN_USE_FPMIX=" +
+                                std::to_string(static_cast<int>(bfpmixparm)) +
+                                " -Wa,-defsym,MIO_SAVE_MEAN_VARIANCE=" +
+                                std::to_string(static_cast<int>(resultsave)) +
+                                " -Wa,-defsym,MIO_RUNNING_RESULT=" +
+                                std::to_string(static_cast<int>(running)) +
+                                " -Wa,-defsym,MIO_BN_N=" + std::to_string(n) +
+                                " -Wa,-defsym,MIO_BN_C=" + std::to_string(c) +
+                                " -Wa,-defsym,MIO_BN_HW=" + std::to_string(in_cstride) +
+                                " -Wa,-defsym,MIO_BN_NHW=" + std::to_string(in_nhw) +
+                                " -Wa,-defsym,MIO_BN_NHW_DIV=" + std::to_string(NHW_value.u32) +
+                                " -Wa,-defsym,MIO_BN_CHW=" + std::to_string(in_nstride) +
+                                " -Wa,-defsym,MIO_BN_NCHW=" + std::to_string(in_nchw) +
+                                " -Wa,-defsym,MIO_BN_LDS_SIZE=" + std::to_string(ldsnogcn) +
+                                " -Wa,-defsym,MIO_BN_LDSGCN_SIZE=" + std::to_string(ldsgcn) +
+                                " -Wa,-defsym,MIO_BN_VARIANT=" + std::to_string(variant) +
+                                " -Wa,-defsym,MIO_BN_GRP0=" + std::to_string(xlocalsize) +
+                                " -Wa,-defsym,MIO_BN_GRP1=" + std::to_string(ylocalsize) +
+                                " -Wa,-defsym,MIO_BN_GRP2=" + std::to_string(zlocalsize);
                     }
                     else
                     {
-                        kernels[0](x, y);
-                        profileSequence(handle, 0, &ctime);
-
-                        kernels[1](y, as_float(inhw), epsilon);
-                        profileSequence(handle, 1, &ctime);
-
-                        kernels[2](x, y, bnScale, bnBias);
-                        profileSequence(handle, 2, &ctime);
+                        kernel_name  = "MIOpenBatchNormFwdTrainSpatial";
+                        program_name = "MIOpenBatchNormFwdTrainSpatial.cl";
+
+                        parms =
+                            " -DMIOPEN_USE_FP16=" + std::to_string(static_cast<int>(bfp16parm)) +
+                            " -DMIOPEN_USE_FP32=" + std::to_string(static_cast<int>(bfp32parm)) +
+                            " -DMIOPEN_USE_FPMIX=" + std::to_string(static_cast<int>(bfpmixparm)) +
+                            " -DMIO_SAVE_MEAN_VARIANCE=" +
+                            std::to_string(static_cast<int>(resultsave)) +
+                            " -DMIO_RUNNING_RESULT=" + std::to_string(static_cast<int>(running)) +
+                            " -DMIO_BN_N=" + std::to_string(n) + " -DMIO_BN_C=" +
+                            std::to_string(c) + " -DMIO_BN_HW=" + std::to_string(in_cstride) +
+                            " -DMIO_BN_NHW=" + std::to_string(in_nhw) + " -DMIO_BN_CHW=" +
+                            std::to_string(in_nstride) + " -DMIO_BN_NCHW=" +
+                            std::to_string(in_nchw) + " -DMIO_BN_LDS_SIZE=" +
+                            std::to_string(ldsnogcn) + " -DMIO_BN_LDSGCN_SIZE=" +
+                            std::to_string(ldsgcn) + " -DMIO_BN_VARIANT=" +
+                            std::to_string(variant) + " -DMIO_BN_GRP0=" +
+                            std::to_string(xlocalsize) + " -DMIO_BN_GRP1=" +
+                            std::to_string(ylocalsize) + " -DMIO_BN_GRP2=" +
+                            std::to_string(zlocalsize);
+
+                        MIOPEN_LOG_I2(kernel_name << ":: " << algo_name);
+                        MIOPEN_LOG_I2("..." << parms);
+                        MIOPEN_LOG_I2("..." << network_config);
                     }
-                });
+
+                    vld.push_back(xlocalsize);
+                    vld.push_back(ylocalsize);
+                    vld.push_back(zlocalsize);
+
+                    vgd.push_back(xgridsize);
+                    vgd.push_back(ygridsize);
+                    vgd.push_back(zgridsize);
+
+                    bnFwdTrainSelectSingle(handle,
+                                           bnScaleBiasMeanVarDesc.GetType(),
+                                           program_name,
+                                           algo_name,
+                                           kernel_name,
+                                           network_config,
+                                           parms,
+                                           vld,
+                                           vgd,
+                                           x,
+                                           y,
+                                           bnScale,
+                                           bnBias,
+                                           resultsave,
+                                           running,
+                                           expAvgFactor,
+                                           resultRunningMean,
+                                           resultRunningVariance,
+                                           epsilon,
+                                           resultSaveMean,
+                                           resultSaveInvVariance,
+                                           inhw);
+                }
             }
             else
             {
+                if(!kernels.empty())
+                {
+                    float ctime = 0.;
+                    visit_float(bnScaleBiasMeanVarDesc.GetType(), [&](auto as_float) {
+                        if(resultsave && running)
+                        {
+                            kernels[0](x, y);
+                            profileSequence(handle, 0, &ctime);
 
-                vld.push_back(xlocalsize);
-                vld.push_back(ylocalsize);
-                vld.push_back(zlocalsize);
+                            kernels[1](y,
+                                       as_float(inhw),
+                                       expAvgFactor,
+                                       resultRunningMean,
+                                       resultRunningVariance,
+                                       epsilon,
+                                       resultSaveMean,
+                                       resultSaveInvVariance);
+                            profileSequence(handle, 1, &ctime);
 
-                vgd.push_back(xgridsize);
-                vgd.push_back(ygridsize);
-                vgd.push_back(zgridsize);
+                            kernels[2](x, y, bnScale, bnBias);
+                            profileSequence(handle, 2, &ctime);
+                        }
+                        else if(resultsave)
+                        {
+                            kernels[0](x, y);
+                            profileSequence(handle, 0, &ctime);
 
-                std::string kernel_name;
-                std::string program_name;
-                std::string parms;
-                if((variant == 3) && (bfpmixparm) && (n <= 64) && (n % 2 == 0))
-                {
-                    kernel_name  = "gcnAsmBNFwdTrainSpatial";
-                    program_name = "gcnAsmBNFwdTrainSpatial.s";
+                            kernels[1](
+                                y, as_float(inhw), epsilon, resultSaveMean, resultSaveInvVariance);
+                            profileSequence(handle, 1, &ctime);
 
-                    union nhw_val
-                    {
-                        unsigned u32;
-                        float f32;
-                        nhw_val()
+                            kernels[2](x, y, bnScale, bnBias);
+                            profileSequence(handle, 2, &ctime);
+                        }
+                        else if(running)
                         {
-                            u32 = 0;
-                            f32 = 0;
+
+                            kernels[0](x, y);
+                            profileSequence(handle, 0, &ctime);
+
+                            kernels[1](y,
+                                       as_float(inhw),
+                                       expAvgFactor,
+                                       resultRunningMean,
+                                       resultRunningVariance,
+                                       epsilon);
+                            profileSequence(handle, 1, &ctime);
+
+                            kernels[2](x, y, bnScale, bnBias);
+                            profileSequence(handle, 2, &ctime);
                         }
-                    } NHW_value;
+                        else
+                        {
+                            kernels[0](x, y);
+                            profileSequence(handle, 0, &ctime);
 
-                    NHW_value.f32 = static_cast<float>(in_nhw / (in_nhw - 1.0));
+                            kernels[1](y, as_float(inhw), epsilon);
+                            profileSequence(handle, 1, &ctime);
 
-                    parms = "-Wa,-defsym,MIOPEN_USE_FP16=" +
-                            std::to_string(static_cast<int>(bfp16parm)) +
-                            " -Wa,-defsym,MIOPEN_USE_FP32=" +
-                            std::to_string(static_cast<int>(bfp32parm)) +
-                            " -Wa,-defsym,MIOPEN_USE_FPMIX=" +
-                            std::to_string(static_cast<int>(bfpmixparm)) +
-                            " -Wa,-defsym,MIO_SAVE_MEAN_VARIANCE=" +
-                            std::to_string(static_cast<int>(resultsave)) +
-                            " -Wa,-defsym,MIO_RUNNING_RESULT=" +
-                            std::to_string(static_cast<int>(resultrunning)) +
-                            " -Wa,-defsym,MIO_BN_N=" + std::to_string(n) +
-                            " -Wa,-defsym,MIO_BN_C=" + std::to_string(c) +
-                            " -Wa,-defsym,MIO_BN_HW=" + std::to_string(in_cstride) +
-                            " -Wa,-defsym,MIO_BN_NHW=" + std::to_string(in_nhw) +
-                            " -Wa,-defsym,MIO_BN_NHW_DIV=" + std::to_string(NHW_value.u32) +
-                            " -Wa,-defsym,MIO_BN_CHW=" + std::to_string(in_nstride) +
-                            " -Wa,-defsym,MIO_BN_NCHW=" + std::to_string(in_nchw) +
-                            " -Wa,-defsym,MIO_BN_LDS_SIZE=" + std::to_string(ldsnogcn) +
-                            " -Wa,-defsym,MIO_BN_LDSGCN_SIZE=" + std::to_string(ldsgcn) +
-                            " -Wa,-defsym,MIO_BN_VARIANT=" + std::to_string(variant) +
-                            " -Wa,-defsym,MIO_BN_GRP0=" + std::to_string(xlocalsize) +
-                            " -Wa,-defsym,MIO_BN_GRP1=" + std::to_string(ylocalsize) +
-                            " -Wa,-defsym,MIO_BN_GRP2=" + std::to_string(zlocalsize);
+                            kernels[2](x, y, bnScale, bnBias);
+                            profileSequence(handle, 2, &ctime);
+                        }
+                    });
                 }
                 else
                 {
-                    kernel_name  = "MIOpenBatchNormFwdTrainSpatial";
-                    program_name = "MIOpenBatchNormFwdTrainSpatial.cl";
-                    parms =
-                        " -DMIOPEN_USE_FP16=" + std::to_string(static_cast<int>(bfp16parm)) +
-                        " -DMIOPEN_USE_FP32=" + std::to_string(static_cast<int>(bfp32parm)) +
-                        " -DMIOPEN_USE_FPMIX=" + std::to_string(static_cast<int>(bfpmixparm)) +
-                        " -DMIO_SAVE_MEAN_VARIANCE=" +
-                        std::to_string(static_cast<int>(resultsave)) + " -DMIO_RUNNING_RESULT=" +
-                        std::to_string(static_cast<int>(resultrunning)) + " -DMIO_BN_N=" +
-                        std::to_string(n) + " -DMIO_BN_C=" + std::to_string(c) + " -DMIO_BN_HW=" +
-                        std::to_string(in_cstride) + " -DMIO_BN_NHW=" + std::to_string(in_nhw) +
-                        " -DMIO_BN_CHW=" + std::to_string(in_nstride) + " -DMIO_BN_NCHW=" +
-                        std::to_string(in_nchw) + " -DMIO_BN_NGRPS=" +
-                        std::to_string(int(std::ceil(float(ygridsize) / ylocalsize))) +
-                        " -DMIO_BN_LDS_SIZE=" + std::to_string(ldsnogcn) +
-                        " -DMIO_BN_LDSGCN_SIZE=" + std::to_string(ldsgcn) + " -DMIO_BN_VARIANT=" +
-                        std::to_string(variant) + " -DMIO_BN_GRP0=" + std::to_string(xlocalsize) +
-                        " -DMIO_BN_GRP1=" + std::to_string(ylocalsize) + " -DMIO_BN_GRP2=" +
-                        std::to_string(zlocalsize);
 
-                    MIOPEN_LOG_I2(kernel_name << ":: " << parms);
-                }
+                    vld.push_back(xlocalsize);
+                    vld.push_back(ylocalsize);
+                    vld.push_back(zlocalsize);
+
+                    vgd.push_back(xgridsize);
+                    vgd.push_back(ygridsize);
+                    vgd.push_back(zgridsize);
+
+                    std::string kernel_name;
+                    std::string program_name;
+                    std::string parms;
+                    if((variant == 3) && (bfpmixparm) && (n <= 64) && (n % 2 == 0) &&
+                       (in_cstride > 512))
+                    {
+                        kernel_name  = "gcnAsmBNFwdTrainSpatial";
+                        program_name = "gcnAsmBNFwdTrainSpatial.s";
 
-                bnFwdTrainSelectMulti(handle,
-                                      bnScaleBiasMeanVarDesc.GetType(),
-                                      program_name,
-                                      algo_name,
-                                      kernel_name,
-                                      network_config,
-                                      parms,
-                                      vld,
-                                      vgd,
-                                      x,
-                                      y,
-                                      bnScale,
-                                      bnBias,
-                                      resultsave,
-                                      resultrunning,
-                                      expAvgFactor,
-                                      resultRunningMean,
-                                      resultRunningVariance,
-                                      epsilon,
-                                      resultSaveMean,
-                                      resultSaveInvVariance,
-                                      inhw);
+                        union nhw_val
+                        {
+                            unsigned u32;
+                            float f32;
+                            nhw_val()
+                            {
+                                u32 = 0;
+                                f32 = 0;
+                            }
+                        } NHW_value;
+
+                        NHW_value.f32 = static_cast<float>(in_nhw / (in_nhw - 1.0));
+
+                        parms = "-Wa,-defsym,MIOPEN_USE_FP16=" +
+                                std::to_string(static_cast<int>(bfp16parm)) +
+                                " -Wa,-defsym,MIOPEN_USE_FP32=" +
+                                std::to_string(static_cast<int>(bfp32parm)) +
+                                " -Wa,-defsym,MIOPEN_USE_FPMIX=" +
+                                std::to_string(static_cast<int>(bfpmixparm)) +
+                                " -Wa,-defsym,MIO_SAVE_MEAN_VARIANCE=" +
+                                std::to_string(static_cast<int>(resultsave)) +
+                                " -Wa,-defsym,MIO_RUNNING_RESULT=" +
+                                std::to_string(static_cast<int>(running)) +
+                                " -Wa,-defsym,MIO_BN_N=" + std::to_string(n) +
+                                " -Wa,-defsym,MIO_BN_C=" + std::to_string(c) +
+                                " -Wa,-defsym,MIO_BN_HW=" + std::to_string(in_cstride) +
+                                " -Wa,-defsym,MIO_BN_NHW=" + std::to_string(in_nhw) +
+                                " -Wa,-defsym,MIO_BN_NHW_DIV=" + std::to_string(NHW_value.u32) +
+                                " -Wa,-defsym,MIO_BN_CHW=" + std::to_string(in_nstride) +
+                                " -Wa,-defsym,MIO_BN_NCHW=" + std::to_string(in_nchw) +
+                                " -Wa,-defsym,MIO_BN_LDS_SIZE=" + std::to_string(ldsnogcn) +
+                                " -Wa,-defsym,MIO_BN_LDSGCN_SIZE=" + std::to_string(ldsgcn) +
+                                " -Wa,-defsym,MIO_BN_VARIANT=" + std::to_string(variant) +
+                                " -Wa,-defsym,MIO_BN_GRP0=" + std::to_string(xlocalsize) +
+                                " -Wa,-defsym,MIO_BN_GRP1=" + std::to_string(ylocalsize) +
+                                " -Wa,-defsym,MIO_BN_GRP2=" + std::to_string(zlocalsize);
+                    }
+                    else
+                    {
+                        kernel_name  = "MIOpenBatchNormFwdTrainSpatial";
+                        program_name = "MIOpenBatchNormFwdTrainSpatial.cl";
+                        parms =
+                            " -DMIOPEN_USE_FP16=" + std::to_string(static_cast<int>(bfp16parm)) +
+                            " -DMIOPEN_USE_FP32=" + std::to_string(static_cast<int>(bfp32parm)) +
+                            " -DMIOPEN_USE_FPMIX=" + std::to_string(static_cast<int>(bfpmixparm)) +
+                            " -DMIO_SAVE_MEAN_VARIANCE=" +
+                            std::to_string(static_cast<int>(resultsave)) +
+                            " -DMIO_RUNNING_RESULT=" + std::to_string(static_cast<int>(running)) +
+                            " -DMIO_BN_N=" + std::to_string(n) + " -DMIO_BN_C=" +
+                            std::to_string(c) + " -DMIO_BN_HW=" + std::to_string(in_cstride) +
+                            " -DMIO_BN_NHW=" + std::to_string(in_nhw) + " -DMIO_BN_CHW=" +
+                            std::to_string(in_nstride) + " -DMIO_BN_NCHW=" +
+                            std::to_string(in_nchw) + " -DMIO_BN_NGRPS=" +
+                            std::to_string(int(std::ceil(float(ygridsize) / ylocalsize))) +
+                            " -DMIO_BN_LDS_SIZE=" + std::to_string(ldsnogcn) +
+                            " -DMIO_BN_LDSGCN_SIZE=" + std::to_string(ldsgcn) +
+                            " -DMIO_BN_VARIANT=" + std::to_string(variant) + " -DMIO_BN_GRP0=" +
+                            std::to_string(xlocalsize) + " -DMIO_BN_GRP1=" +
+                            std::to_string(ylocalsize) + " -DMIO_BN_GRP2=" +
+                            std::to_string(zlocalsize);
+
+                        MIOPEN_LOG_I2(kernel_name << ":: " << parms);
+                    }
+
+                    bnFwdTrainSelectMulti(handle,
+                                          bnScaleBiasMeanVarDesc.GetType(),
+                                          program_name,
+                                          algo_name,
+                                          kernel_name,
+                                          network_config,
+                                          parms,
+                                          vld,
+                                          vgd,
+                                          x,
+                                          y,
+                                          bnScale,
+                                          bnBias,
+                                          resultsave,
+                                          running,
+                                          expAvgFactor,
+                                          resultRunningMean,
+                                          resultRunningVariance,
+                                          epsilon,
+                                          resultSaveMean,
+                                          resultSaveInvVariance,
+                                          inhw);
+                }
             }
-        }
+        };
+
+        BatchNormContext context(true, xDesc, bnScaleBiasMeanVarDesc);
+        context.saved_mean_variance   = resultsave;
+        context.running_mean_variance = resultrunning;
+        context.gcn_reduce = StartsWith(handle.GetDeviceName(), "gfx");
+        context.SetStream(&handle);
+        // Searching runs the kernels several times, so it is not allowed in place.
+        if(x == y)
+            context.disable_search_enforce = true;
+        // The running averages are accumulated, so the runs of the search do not update them.
+        context.run = [&](const solver::BnSpatialSolution& solution) {
+            run_spatial(solution, false);
+        };
+        run_spatial(solver::FindBnSpatialSolution(context), resultrunning);
     }
     else // else run per activation
     {
@@ -951,314 +957,282 @@ void BatchNormBackward(Handle& handle,
     if(bn_mode == miopenBNSpatial)
     { // SPATIAL kernels
 
-        unsigned int ldsgcn   = 0;
-        unsigned int ldsnogcn = 0;
-        bool single           = true;
-        unsigned int variant  = 1;
-
-        //*************************************************************************************************
-        // N*H*W < 32M and H*W > 1024, use batchnorm variant#1 implementation which parallelize
-        // work groups over channels and loop through NHW.
-        //*************************************************************************************************
-        if(in_nhw < (32 * 1024 * 1024) && in_cstride > 1024)
-        {
-            variant    = 1;
-            xlocalsize = 1024;
-            xgridsize  = c * xlocalsize;
-            ldsgcn     = xlocalsize / 64;
-            ldsnogcn   = xlocalsize;
-        }
-        //*************************************************************************************************
-        // N*H*W < 32M and H*W > 512  use batchnorm variant#1 or variant#3 implementation which
-        // parallelize
-        // work groups over channels and loop through N.
-        //*************************************************************************************************
-        else if(in_nhw < (32 * 1024 * 1024) && in_cstride > 512)
-        {
-            variant    = (n >= 32) ? 1 : 3;
-            xlocalsize = std::min(64 * ((in_cstride + 63) / 64), static_cast<unsigned int>(1024));
-            xgridsize  = c * xlocalsize;
-            ldsgcn     = xlocalsize / 64;
-            ldsnogcn   = xlocalsize;
-        }
-        //*************************************************************************************************
-        // H*W < 512  use batchnorm variant#0 or variant#3 implementation based on batch size and
-        // H*W
-        //*************************************************************************************************
-        else if(in_cstride <= 512)
-        {
-            if((n > 64) && (in_cstride > 160))
+        const auto run_spatial = [&](const solver::BnSpatialSolution& solution) {
+            const bool single           = solution.single;
+            const unsigned int variant  = solution.variant;
+            const unsigned int ldsgcn   = solution.ldsgcn;
+            const unsigned int ldsnogcn = solution.ldsnogcn;
+            std::string algo_name       = "miopenBatchNormBackwardPropSpatial";
+
+            xlocalsize = solution.xlocalsize;
+            ylocalsize = solution.ylocalsize;
+            xgridsize  = solution.xgridsize;
+            ygridsize  = solution.ygridsize;
+            vld.clear();
+            vgd.clear();
+
+            std::string network_config =
+                "variant" + std::to_string(variant) + "gx" + std::to_string(xgridsize) + "n" +
+                std::to_string(n) + "c" + std::to_string(c) + "hw" + std::to_string(in_cstride) +
+                "gy" + std::to_string(ygridsize) + "lx" + std::to_string(xlocalsize) + "ly" +
+                std::to_string(ylocalsize) + "us" + std::to_string(static_cast<int>(useSaved)) +
+                "fp16" + std::to_string(static_cast<int>(bfp16parm)) + "fp32" +
+                std::to_string(static_cast<int>(bfp32parm)) + "single" +
+                std::to_string(static_cast<int>(single)) + "gcn" + std::to_string(ldsgcn);
+
+            auto&& kernels = handle.GetKernels(algo_name, network_config);
+
+            if(single)
             {
-                variant = 3;
-                xlocalsize =
-                    std::min(64 * ((in_cstride + 63) / 64), static_cast<unsigned int>(1024));
-                xgridsize = c * xlocalsize;
-                ldsgcn    = xlocalsize / 64;
-                ldsnogcn  = xlocalsize;
-            }
-            else
-            {
-                variant    = 0;
-                xlocalsize = 1024;
-                xgridsize  = 1024 * c;
-                ldsgcn     = xlocalsize / 64;
-                ldsnogcn   = xlocalsize;
-            }
-        }
-        //*************************************************************************************************
-        // N*H*W > 32M, use batchnorm variant#2 implementation which parallelize
-        // work groups over channels and data segments.
-        //*************************************************************************************************
-        else
-        {
-            variant      = 2;
-            ylocalsize   = 1024;
-            auto segment = int(std::ceil(double(in_cstride) / double(ylocalsize)));
-            xgridsize    = c;
-            ygridsize    = segment * ylocalsize;
-            single       = false;
-            ldsgcn       = ylocalsize / 64;
-            ldsnogcn     = ylocalsize;
-        }
-        std::string algo_name = "miopenBatchNormBackwardPropSpatial";
-        std::string network_config =
-            "variant" + std::to_string(variant) + "gx" + std::to_string(xgridsize) + "n" +
-            std::to_string(n) + "c" + std::to_string(c) + "hw" + std::to_string(in_cstride) + "gy" +
-            std::to_string(ygridsize) + "lx" + std::to_string(xlocalsize) + "ly" +
-            std::to_string(ylocalsize) + "us" + std::to_string(static_cast<int>(useSaved)) +
-            "fp16" + std::to_string(static_cast<int>(bfp16parm)) + "fp32" +
-            std::to_string(static_cast<int>(bfp32parm)) + "single" +
-            std::to_string(static_cast<int>(single)) + "gcn" + std::to_string(ldsgcn);
+                if(!kernels.empty())
+                {
+                    auto kernel = kernels.front();
+                    visit_float(bnScaleBiasDiffDesc.GetType(), [&](auto as_float) {
+                        if(useSaved)
+                        {
+                            kernel(x,
+                                   dy,
+                                   dx,
+                                   bnScale,
+                                   resultBnScaleDiff,
+                                   resultBnBiasDiff,
+                                   savedMean,
+                                   savedInvVariance,
+                                   as_float(inhw));
+                        }
+                        else
+                        {
+                            kernel(x,
+                                   dy,
+                                   dx,
+                                   bnScale,
+                                   resultBnScaleDiff,
+                                   resultBnBiasDiff,
+                                   epsilon,
+                                   inhw);
+                        }
+                    });
+                }
+                else
+                {
 
-        auto&& kernels = handle.GetKernels(algo_name, network_config);
+                    std::string kernel_name;
+                    std::string program_name;
+                    std::string parms;
 
-        if(single)
-        {
-            if(!kernels.empty())
-            {
-                auto kernel = kernels.front();
-                visit_float(bnScaleBiasDiffDesc.GetType(), [&](auto as_float) {
-                    if(useSaved)
+                    if((n > 64) && (n % 2 == 0) && (variant == 3) && (bfpmixparm) && (useSaved) &&
+                       (in_cstride > 160))
                     {
-                        kernel(x,
-                               dy,
-                               dx,
-                               bnScale,
-                               resultBnScaleDiff,
-                               resultBnBiasDiff,
-                               savedMean,
-                               savedInvVariance,
-                               as_float(inhw));
+                        kernel_name  = "gcnAsmBNBwdTrainSpatial";
+                        program_name = "gcnAsmBNBwdTrainSpatial.s";
+
+                        union nhw_val
+                        {
+                            unsigned u32;
+                            float f32;
+                            nhw_val()
+                            {
+                                u32 = 0;
+                                f32 = 0;
+                            }
+                        } NHW_value;
+                        NHW_value.f32 = static_cast<float>(in_nhw);
+
+                        parms = "-Wa,-defsym,MIOPEN_USE_FP16=" +
+                                std::to_string(static_cast<int>(bfp16parm)) +
+                                " -Wa,-defsym,MIOPEN_USE_FP32=" +
+                                std::to_string(static_cast<int>(bfp32parm)) +
+                                " -Wa,-defsym,MIOPEN_USE_FPMIX=" +
+                                std::to_string(static_cast<int>(bfpmixparm)) +
+                                " -Wa,-defsym,MIO_BN_USESAVED=" +
+                                std::to_string(static_cast<int>(useSaved)) +
+                                " -Wa,-defsym,MIO_BN_N=" + std::to_string(n) +
+                                " -Wa,-defsym,MIO_BN_C=" + std::to_string(c) +
+                                " -Wa,-defsym,MIO_BN_HW=" + std::to_string(in_cstride) +
+                                " -Wa,-defsym,MIO_BN_NHW=" + std::to_string(in_nhw) +
+                                " -Wa,-defsym,MIO_BN_NHW_FLOAT=" + std::to_string(NHW_value.u32) +
+                                " -Wa,-defsym,MIO_BN_CHW=" + std::to_string(in_nstride) +
+                                " -Wa,-defsym,MIO_BN_NCHW=" + std::to_string(in_nchw) +
+                                " -Wa,-defsym,MIO_BN_LDS_SIZE=" + std::to_string(ldsnogcn) +
+                                " -Wa,-defsym,MIO_BN_LDSGCN_SIZE=" + std::to_string(ldsgcn) +
+                                " -Wa,-defsym,MIO_BN_VARIANT=" + std::to_string(variant) +
+                                " -Wa,-defsym,MIO_BN_GRP0=" + std::to_string(xlocalsize) +
+                                " -Wa,-defsym,MIO_BN_GRP1=" + std::to_string(ylocalsize) +
+                                " -Wa,-defsym,MIO_BN_GRP2=" + std::to_string(zlocalsize);
                     }
                     else
                     {
-                        kernel(
-                            x, dy, dx, bnScale, resultBnScaleDiff, resultBnBiasDiff, epsilon, inhw);
+                        program_name = "MIOpenBatchNormBwdSpatial.cl";
+                        kernel_name  = "MIOpenBatchNormBwdSpatial";
+
+                        parms =
+                            " -DMIOPEN_USE_FP16=" + std::to_string(static_cast<int>(bfp16parm)) +
+                            " -DMIOPEN_USE_FP32=" + std::to_string(static_cast<int>(bfp32parm)) +
+                            " -DMIOPEN_USE_FPMIX=" + std::to_string(static_cast<int>(bfpmixparm)) +
+                            " -DMIO_BN_USESAVED=" + std::to_string(static_cast<int>(useSaved)) +
+                            " -DMIO_BN_N=" + std::to_string(n) + " -DMIO_BN_C=" +
+                            std::to_string(c) + " -DMIO_BN_HW=" + std::to_string(in_cstride) +
+                            " -DMIO_BN_NHW=" + std::to_string(in_nhw) + " -DMIO_BN_CHW=" +
+                            std::to_string(in_nstride) + " -DMIO_BN_NCHW=" +
+                            std::to_string(in_nchw) + " -DMIO_BN_LDS_SIZE=" +
+                            std::to_string(ldsnogcn) + " -DMIO_BN_LDSGCN_SIZE=" +
+                            std::to_string(ldsgcn) + " -DMIO_BN_VARIANT=" +
+                            std::to_string(variant) + " -DMIO_BN_GRP0=" +
+                            std::to_string(xlocalsize) + " -DMIO_BN_GRP1=" +
+                            std::to_string(ylocalsize) + " -DMIO_BN_GRP2=" +
+                            std::to_string(zlocalsize);
                     }
-                });
-            }
-            else
-            {
 
-                std::string kernel_name;
-                std::string program_name;
-                std::string parms;
+                    MIOPEN_LOG_I2(kernel_name << ":: " << algo_name);
+                    MIOPEN_LOG_I2("..." << parms);
+                    MIOPEN_LOG_I2("..." << network_config);
+                    vld.push_back(xlocalsize);
+                    vld.push_back(ylocalsize);
+                    vld.push_back(zlocalsize);
+
+                    vgd.push_back(xgridsize);
+                    vgd.push_back(ygridsize);
+                    vgd.push_back(zgridsize);
 
-                if((n > 64) && (n % 2 == 0) && (variant == 3) && (bfpmixparm) && (useSaved))
-                {
-                    kernel_name  = "gcnAsmBNBwdTrainSpatial";
-                    program_name = "gcnAsmBNBwdTrainSpatial.s";
+                    MIOPEN_LOG_I2(kernel_name << ":: " << parms);
 
-                    union nhw_val
-                    {
-                        unsigned u32;
-                        float f32;
-                        nhw_val()
-                        {
-                            u32 = 0;
-                            f32 = 0;
-                        }
-                    } NHW_value;
-                    NHW_value.f32 = static_cast<float>(in_nhw);
-
-                    parms = "-Wa,-defsym,MIOPEN_USE_FP16=" +
-                            std::to_string(static_cast<int>(bfp16parm)) +
-                            " -Wa,-defsym,MIOPEN_USE_FP32=" +
-                            std::to_string(static_cast<int>(bfp32parm)) +
-                            " -Wa,-defsym,MIOPEN_USE_FPMIX=" +
-                            std::to_string(static_cast<int>(bfpmixparm)) +
-                            " -Wa,-defsym,MIO_BN_USESAVED=" +
-                            std::to_string(static_cast<int>(useSaved)) + " -Wa,-defsym,MIO_BN_N=" +
-                            std::to_string(n) + " -Wa,-defsym,MIO_BN_C=" + std::to_string(c) +
-                            " -Wa,-defsym,MIO_BN_HW=" + std::to_string(in_cstride) +
-                            " -Wa,-defsym,MIO_BN_NHW=" + std::to_string(in_nhw) +
-                            " -Wa,-defsym,MIO_BN_NHW_FLOAT=" + std::to_string(NHW_value.u32) +
-                            " -Wa,-defsym,MIO_BN_CHW=" + std::to_string(in_nstride) +
-                            " -Wa,-defsym,MIO_BN_NCHW=" + std::to_string(in_nchw) +
-                            " -Wa,-defsym,MIO_BN_LDS_SIZE=" + std::to_string(ldsnogcn) +
-                            " -Wa,-defsym,MIO_BN_LDSGCN_SIZE=" + std::to_string(ldsgcn) +
-                            " -Wa,-defsym,MIO_BN_VARIANT=" + std::to_string(variant) +
-                            " -Wa,-defsym,MIO_BN_GRP0=" + std::to_string(xlocalsize) +
-                            " -Wa,-defsym,MIO_BN_GRP1=" + std::to_string(ylocalsize) +
-                            " -Wa,-defsym,MIO_BN_GRP2=" + std::to_string(zlocalsize);
+                    bnBwdTrainSelectSingle(handle,
+                                           bnScaleBiasDiffDesc.GetType(),
+                                           program_name,
+                                           algo_name,
+                                           kernel_name,
+                                           network_config,
+                                           parms,
+                                           vld,
+                                           vgd,
+                                           x,
+                                           dy,
+                                           dx,
+                                           bnScale,
+                                           resultBnScaleDiff,
+                                           resultBnBiasDiff,
+                                           useSaved,
+                                           epsilon,
+                                           savedMean,
+                                           savedInvVariance,
+                                           inhw);
                 }
-                else
+            }
+            else // Use multi-kernel
+            {
+                if(!kernels.empty())
                 {
-                    program_name = "MIOpenBatchNormBwdSpatial.cl";
-                    kernel_name  = "MIOpenBatchNormBwdSpatial";
+                    float ctime = 0.;
+                    visit_float(bnScaleBiasDiffDesc.GetType(), [&](auto as_float) {
+                        if(useSaved)
+                        {
+                            kernels[0](x, dy, dx, savedMean, savedInvVariance);
+                            profileSequence(handle, 0, &ctime);
 
-                    parms =
-                        " -DMIOPEN_USE_FP16=" + std::to_string(static_cast<int>(bfp16parm)) +
-                        " -DMIOPEN_USE_FP32=" + std::to_string(static_cast<int>(bfp32parm)) +
-                        " -DMIOPEN_USE_FPMIX=" + std::to_string(static_cast<int>(bfpmixparm)) +
-                        " -DMIO_BN_USESAVED=" + std::to_string(static_cast<int>(useSaved)) +
-                        " -DMIO_BN_N=" + std::to_string(n) + " -DMIO_BN_C=" + std::to_string(c) +
-                        " -DMIO_BN_HW=" + std::to_string(in_cstride) + " -DMIO_BN_NHW=" +
-                        std::to_string(in_nhw) + " -DMIO_BN_CHW=" + std::to_string(in_nstride) +
-                        " -DMIO_BN_NCHW=" + std::to_string(in_nchw) + " -DMIO_BN_LDS_SIZE=" +
-                        std::to_string(ldsnogcn) + " -DMIO_BN_LDSGCN_SIZE=" +
-                        std::to_string(ldsgcn) + " -DMIO_BN_VARIANT=" + std::to_string(variant) +
-                        " -DMIO_BN_GRP0=" + std::to_string(xlocalsize) + " -DMIO_BN_GRP1=" +
-                        std::to_string(ylocalsize) + " -DMIO_BN_GRP2=" + std::to_string(zlocalsize);
-                }
+                            kernels[1](dx, resultBnScaleDiff, resultBnBiasDiff);
+                            profileSequence(handle, 1, &ctime);
 
-                MIOPEN_LOG_I2(kernel_name << ":: " << algo_name);
-                MIOPEN_LOG_I2("..." << parms);
-                MIOPEN_LOG_I2("..." << network_config);
-                vld.push_back(xlocalsize);
-                vld.push_back(ylocalsize);
-                vld.push_back(zlocalsize);
-
-                vgd.push_back(xgridsize);
-                vgd.push_back(ygridsize);
-                vgd.push_back(zgridsize);
-
-                MIOPEN_LOG_I2(kernel_name << ":: " << parms);
-
-                bnBwdTrainSelectSingle(handle,
-                                       bnScaleBiasDiffDesc.GetType(),
-                                       program_name,
-                                       algo_name,
-                                       kernel_name,
-                                       network_config,
-                                       parms,
-                                       vld,
-                                       vgd,
-                                       x,
+                            kernels[2](x,
                                        dy,
                                        dx,
                                        bnScale,
                                        resultBnScaleDiff,
                                        resultBnBiasDiff,
-                                       useSaved,
-                                       epsilon,
                                        savedMean,
                                        savedInvVariance,
-                                       inhw);
-            }
-        }
-        else // Use multi-kernel
-        {
-            if(!kernels.empty())
-            {
-                float ctime = 0.;
-                visit_float(bnScaleBiasDiffDesc.GetType(), [&](auto as_float) {
-                    if(useSaved)
-                    {
-                        kernels[0](x, dy, dx, savedMean, savedInvVariance);
-                        profileSequence(handle, 0, &ctime);
+                                       as_float(inhw));
+                            profileSequence(handle, 2, &ctime);
+                        }
+                        else
+                        {
+                            kernels[0](x, dx); // mean variance
+                            profileSequence(handle, 0, &ctime);
 
-                        kernels[1](dx, resultBnScaleDiff, resultBnBiasDiff);
-                        profileSequence(handle, 1, &ctime);
+                            kernels[1](dx, as_float(inhw), epsilon); // final mean variance
+                            profileSequence(handle, 1, &ctime);
 
-                        kernels[2](x,
-                                   dy,
-                                   dx,
-                                   bnScale,
-                                   resultBnScaleDiff,
-                                   resultBnBiasDiff,
-                                   savedMean,
-                                   savedInvVariance,
-                                   as_float(inhw));
-                        profileSequence(handle, 2, &ctime);
-                    }
-                    else
-                    {
-                        kernels[0](x, dx); // mean variance
-                        profileSequence(handle, 0, &ctime);
+                            kernels[2](x, dy, dx); // dscale dbias
+                            profileSequence(handle, 1, &ctime);
+
+                            // final dscale dbias
+                            kernels[3](dx, resultBnScaleDiff, resultBnBiasDiff);
+                            profileSequence(handle, 1, &ctime);
+
+                            kernels[4](x,
+                                       dy,
+                                       dx,
+                                       bnScale,
+                                       resultBnScaleDiff,
+                                       resultBnBiasDiff,
+                                       as_float(inhw)); // dx
+                            profileSequence(handle, 2, &ctime);
+                        }
+                    });
+                }
+                else
+                {
 
-                        kernels[1](dx, as_float(inhw), epsilon); // final mean variance
-                        profileSequence(handle, 1, &ctime);
+                    vld.push_back(xlocalsize);
+                    vld.push_back(ylocalsize);
+                    vld.push_back(zlocalsize);
 
-                        kernels[2](x, dy, dx); // dscale dbias
-                        profileSequence(handle, 1, &ctime);
+                    vgd.push_back(xgridsize);
+                    vgd.push_back(ygridsize);
+                    vgd.push_back(zgridsize);
 
-                        kernels[3](dx, resultBnScaleDiff, resultBnBiasDiff); // final dscale dbias
-                        profileSequence(handle, 1, &ctime);
+                    std::string program_name = "MIOpenBatchNormBwdSpatial.cl";
+                    std::string kernel_name  = "MIOpenBatchNormBwdSpatial";
+                    std::string parms =
+                        " -DMIOPEN_USE_FP16=" + std::to_string(static_cast<int>(bfp16parm)) +
+                        " -DMIOPEN_USE_FP32=" + std::to_string(static_cast<int>(bfp32parm)) +
+                        " -DMIOPEN_USE_FPMIX=" + std::to_string(static_cast<int>(bfpmixparm)) +
+                        " -DMIO_BN_USESAVED=" + std::to_string(static_cast<int>(useSaved)) +
+                        " -DMIO_BN_N=" + std::to_string(n) + " -DMIO_BN_C=" + std::to_string(c) +
+                        " -DMIO_BN_HW=" + std::to_string(in_cstride) + " -DMIO_BN_NHW=" +
+                        std::to_string(in_nhw) + " -DMIO_BN_CHW=" + std::to_string(in_nstride) +
+                        " -DMIO_BN_NCHW=" + std::to_string(in_nchw) + " -DMIO_BN_NGRPS=" +
+                        std::to_string(int(std::ceil(float(ygridsize) / ylocalsize))) +
+                        " -DMIO_BN_LDS_SIZE=" + std::to_string(ldsnogcn) +
+                        " -DMIO_BN_LDSGCN_SIZE=" + std::to_string(ldsgcn) + " -DMIO_BN_VARIANT=" +
+                        std::to_string(variant) + " -DMIO_BN_GRP0=" + std::to_string(xlocalsize) +
+                        " -DMIO_BN_GRP1=" + std::to_string(ylocalsize) + " -DMIO_BN_GRP2=" +
+                        std::to_string(zlocalsize);
 
-                        kernels[4](x,
-                                   dy,
-                                   dx,
-                                   bnScale,
-                                   resultBnScaleDiff,
-                                   resultBnBiasDiff,
-                                   as_float(inhw)); // dx
-                        profileSequence(handle, 2, &ctime);
-                    }
-                });
-            }
-            else
-            {
+                    MIOPEN_LOG_I2(kernel_name << ":: " << parms);
 
-                vld.push_back(xlocalsize);
-                vld.push_back(ylocalsize);
-                vld.push_back(zlocalsize);
-
-                vgd.push_back(xgridsize);
-                vgd.push_back(ygridsize);
-                vgd.push_back(zgridsize);
-
-                std::string program_name = "MIOpenBatchNormBwdSpatial.cl";
-                std::string kernel_name  = "MIOpenBatchNormBwdSpatial";
-                std::string parms =
-                    " -DMIOPEN_USE_FP16=" + std::to_string(static_cast<int>(bfp16parm)) +
-                    " -DMIOPEN_USE_FP32=" + std::to_string(static_cast<int>(bfp32parm)) +
-                    " -DMIOPEN_USE_FPMIX=" + std::to_string(static_cast<int>(bfpmixparm)) +
-                    " -DMIO_BN_USESAVED=" + std::to_string(static_cast<int>(useSaved)) +
-                    " -DMIO_BN_N=" + std::to_string(n) + " -DMIO_BN_C=" + std::to_string(c) +
-                    " -DMIO_BN_HW=" + std::to_string(in_cstride) + " -DMIO_BN_NHW=" +
-                    std::to_string(in_nhw) + " -DMIO_BN_CHW=" + std::to_string(in_nstride) +
-                    " -DMIO_BN_NCHW=" + std::to_string(in_nchw) + " -DMIO_BN_NGRPS=" +
-                    std::to_string(int(std::ceil(float(ygridsize) / ylocalsize))) +
-                    " -DMIO_BN_LDS_SIZE=" + std::to_string(ldsnogcn) + " -DMIO_BN_LDSGCN_SIZE=" +
-                    std::to_string(ldsgcn) + " -DMIO_BN_VARIANT=" + std::to_string(variant) +
-                    " -DMIO_BN_GRP0=" + std::to_string(xlocalsize) + " -DMIO_BN_GRP1=" +
-                    std::to_string(ylocalsize) + " -DMIO_BN_GRP2=" + std::to_string(zlocalsize);
-
-                MIOPEN_LOG_I2(kernel_name << ":: " << parms);
-
-                bnBwdTrainSelectMulti(handle,
-                                      bnScaleBiasDiffDesc.GetType(),
-                                      program_name,
-                                      algo_name,
-                                      kernel_name,
-                                      network_config,
-                                      parms,
-                                      vld,
-                                      vgd,
-                                      x,
-                                      dy,
-                                      dx,
-                                      bnScale,
-                                      resultBnScaleDiff,
-                                      resultBnBiasDiff,
-                                      useSaved,
-                                      epsilon,
-                                      savedMean,
-                                      savedInvVariance,
-                                      inhw);
+                    bnBwdTrainSelectMulti(handle,
+                                          bnScaleBiasDiffDesc.GetType(),
+                                          program_name,
+                                          algo_name,
+                                          kernel_name,
+                                          network_config,
+                                          parms,
+                                          vld,
+                                          vgd,
+                                          x,
+                                          dy,
+                                          dx,
+                                          bnScale,
+                                          resultBnScaleDiff,
+                                          resultBnBiasDiff,
+                                          useSaved,
+                                          epsilon,
+                                          savedMean,
+                                          savedInvVariance,
+                                          inhw);
+                }
             }
-        }
+        };
+
+        BatchNormContext context(false, xDesc, bnScaleBiasDiffDesc);
+        context.saved_mean_variance = useSaved;
+        context.gcn_reduce = StartsWith(handle.GetDeviceName(), "gfx");
+        context.SetStream(&handle);
+        // Searching runs the kernels several times, so it is not allowed in place.
+        if(dx == dy || dx == x)
+            context.disable_search_enforce = true;
+        context.run = run_spatial;
+        run_spatial(solver::FindBnSpatialSolution(context));
     } // END spatial
     else
     { // PER ACT
@@ -25,6 +25,7 @@
  *******************************************************************************/
 #include <miopen/algorithm.hpp>
 #include <miopen/check_numerics.hpp>
+#include <miopen/compile_queue.hpp>
 #include <miopen/config.h>
 #include <miopen/convolution.hpp>
 #include <miopen/conv_algo_name.hpp>
@@ -33,8 +34,10 @@
 #include <miopen/find_db.hpp>
 #include <miopen/finddb_kernel_cache_key.hpp>
 #include <miopen/float_equal.hpp>
+#include <miopen/immediate_mode_cache.hpp>
 #include <miopen/kernel.hpp>
 #include <miopen/solver.hpp>
+#include <miopen/solver_policy.hpp>
 #include <miopen/tensor_ops.hpp>
 #include <miopen/tensor.hpp>
 #include <miopen/util.hpp>
@@ -49,7 +52,10 @@
 #include <miopen/gemm_v2.hpp>
 #endif
 
+#include <algorithm>
 #include <cassert>
+#include <chrono>
+#include <sstream>
 #include <type_traits>
 
 #include <boost/range/adaptors.hpp>
@@ -109,6 +115,14 @@ static inline void AddKernels(Handle& handle,
     }
 }
 
+// Solvers other than GEMM expect packed NCHW/NCDHW tensors.
+static inline bool IsDefaultLayout(const TensorDescriptor& xDesc,
+                                   const TensorDescriptor& wDesc,
+                                   const TensorDescriptor& yDesc)
+{
+    return xDesc.IsDefaultLayout() && wDesc.IsDefaultLayout() && yDesc.IsDefaultLayout();
+}
+
 static inline void ValidateGroupCount(const TensorDescriptor& xDesc,
                                       const TensorDescriptor& wDesc,
                                       const ConvolutionDescriptor& conv)
@@ -506,6 +520,20 @@ struct ConvWrwTensors
     operator ConvTensors() const { return {xDesc, x, dwDesc, dw, dyDesc, dy}; }
 };
 
+/// Drops the find-db items the solver policy does not allow. Find stores only allowed items, but
+/// the find-db may have been filled before the policy changed.
+static void ApplySolverPolicy(const ProblemDescription& problem, std::vector<PerfField>& perf_db)
+{
+    const auto& policy = GetSolverPolicy(problem);
+    perf_db.erase(std::remove_if(perf_db.begin(),
+                                 perf_db.end(),
+                                 [&](const PerfField& entry) {
+                                     return !policy.IsAllowed(entry.solver_id) ||
+                                            !policy.FitsWorkspace(entry.workspace);
+                                 }),
+                  perf_db.end());
+}
+
 static void DirConvFindCore(Handle& handle,
                             const TensorDescriptor& xDesc,
                             ConstData_t x,
@@ -545,14 +573,37 @@ static void DirConvFindCore(Handle& handle,
 
         float time_gemm           = 0;
         const bool time_precision = (!IsDisabled(MIOPEN_CONV_PRECISE_ROCBLAS_TIMING{}));
-        // Use transpose path if input ht and width <= 14 for 1x1_stride=1 convolutions OR
-        // for 1x1_stride=2
-        if(conv.GetSpatialDimension() == 2 &&
-           (miopen::all_of(wei_spatial, [](auto v) { return v == 1; }) &&
-            miopen::all_of(conv.GetConvPads(), [](auto v) { return v == 0; })) &&
-           ((miopen::all_of(in_spatial, [](auto v) { return v <= 14; }) &&
-             miopen::all_of(conv.GetConvStrides(), [](auto v) { return v == 1; })) ||
-            miopen::all_of(conv.GetConvStrides(), [](auto v) { return v == 2; })))
+        if(!IsDefaultLayout(xDesc, wDesc, yDesc))
+        {
+            if(conv.IsGemmNHWCFwd(xDesc, wDesc, yDesc))
+            {
+                MIOPEN_LOG_FUNCTION("convolution, 1x1, channels-last");
+
+                // y[NHW x K] = x[NHW x C] * transpose(w[K x C]), no workspace needed
+                FindDbKCacheKey kcache_key;
+
+                GemmDescriptor gemm_desc = CreateGemmDescriptorConvNHWCFwd(wDesc, xDesc, yDesc);
+
+                miopenStatus_t gemm_status = CallGemmTimeMeasure(handle,
+                                                                 gemm_desc,
+                                                                 x,
+                                                                 0,
+                                                                 w,
+                                                                 0,
+                                                                 y,
+                                                                 0,
+                                                                 &kcache_key,
+                                                                 time_precision,
+                                                                 callGemm);
+
+                time_gemm = handle.GetKernelTime();
+
+                if(gemm_status == miopenStatusSuccess)
+                    record.SetValues("miopenConvolutionFwdAlgoGEMM",
+                                     FindDbData{"gemm", time_gemm, 0, kcache_key});
+            }
+        }
+        else if(conv.IsGemmTransposeFwd(xDesc, wDesc))
         {
             size_t workspace_req = conv.ForwardGetWorkSpaceSizeGEMMTranspose(xDesc, yDesc);
             if(workSpace != nullptr && workSpaceSize >= workspace_req)
@@ -1013,6 +1064,7 @@ static void DirConvFindCore(Handle& handle,
 
     // FFT algo
     if(!use_winograd_only && conv.GetSpatialDimension() == 2 &&
+       IsDefaultLayout(xDesc, wDesc, yDesc) &&
        miopen::all_of(conv.GetConvDilations(), [](auto v) { return v == 1; }) &&
        conv.group_count == 1 && wDesc.GetType() != miopenInt8 && wDesc.GetType() != miopenInt8x4)
     {
@@ -1143,13 +1195,16 @@ void ConvolutionDescriptor::FindConvFwdAlgorithm(Handle& handle,
                         record);
     });
 
+    ApplySolverPolicy(problem, perf_db);
+
     if(perf_db.empty())
         MIOPEN_THROW("Fwd Convolution cannot be executed due to incorrect params");
 
     std::sort(begin(perf_db), end(perf_db));
 
     for(const auto& entry : perf_db)
-        MIOPEN_LOG_I(entry.name << "\t" << entry.time << "\t" << entry.workspace);
+        MIOPEN_LOG_I(entry.name << "\t" << entry.time << "\t" << entry.workspace << "\t"
+                                << entry.roofline);
 
     *returnedAlgoCount = std::min(requestAlgoCount, static_cast<int>(perf_db.size()));
 
@@ -1162,7 +1217,9 @@ void ConvolutionDescriptor::FindConvFwdAlgorithm(Handle& handle,
 
     MIOPEN_LOG_I("FW Chosen Algorithm: " << perf_db[0].solver_id << " , " << perf_db[0].workspace
                                          << ", "
-                                         << perf_db[0].time);
+                                         << perf_db[0].time
+                                         << ", "
+                                         << perf_db[0].roofline);
 }
 
 void ValidateConvTensors(const ConvTensors& tensors)
@@ -1265,6 +1322,10 @@ void ConvolutionDescriptor::ConvolutionForward(Handle& handle,
     {
         MIOPEN_THROW(miopenStatusBadParm);
     }
+    if(algo != miopenConvolutionFwdAlgoGEMM && !IsDefaultLayout(xDesc, wDesc, yDesc))
+    {
+        MIOPEN_THROW(miopenStatusNotImplemented, "Only GEMM supports channels-last layouts");
+    }
 
     ConvForwardCheckNumerics(handle, tensors, [&]() {
         ValidateGroupCount(xDesc, wDesc, *this);
@@ -1604,10 +1665,37 @@ void ConvWinograd(const ConvolutionContext& ctx, const T& tensors, const KernelI
     }
 }
 
+void ConvolutionDescriptor::ConvolutionForwardGemm(Handle& handle,
+                                                   const TensorDescriptor& xDesc,
+                                                   ConstData_t x,
+                                                   const TensorDescriptor& wDesc,
+                                                   ConstData_t w,
+                                                   const TensorDescriptor& yDesc,
+                                                   Data_t y,
+                                                   Data_t workSpace,
+                                                   std::size_t workSpaceSize,
+                                                   ConvLayout x_layout,
+                                                   ConvLayout y_layout) const
+{
+    MIOPEN_LOG_I("workspace = " << workSpaceSize << ", x layout = " << x_layout
+                                << ", y layout = " << y_layout);
+    const auto tensors = ConvFwdTensors{xDesc, x, wDesc, w, yDesc, y};
+    ValidateConvTensors(tensors);
+    ValidateGroupCount(xDesc, wDesc, *this);
+
+    if((x_layout != ConvLayout::NCHW || y_layout != ConvLayout::NCHW) &&
+       !IsGemmTransposeFwd(xDesc, wDesc))
+        MIOPEN_THROW(miopenStatusBadParm, "CNHW layout needs the 1x1 GEMM transpose path");
+
+    ConvFwdGemm(handle, tensors, workSpace, workSpaceSize, x_layout, y_layout);
+}
+
 void ConvolutionDescriptor::ConvFwdGemm(Handle& handle,
                                         const ConvFwdTensors& tensors,
                                         Data_t workSpace,
-                                        std::size_t workSpaceSize) const
+                                        std::size_t workSpaceSize,
+                                        ConvLayout x_layout,
+                                        ConvLayout y_layout) const
 {
 #if MIOPEN_USE_GEMM
     if(miopen::IsDisabled(MIOPEN_DEBUG_CONV_GEMM{}))
@@ -1619,6 +1707,33 @@ void ConvolutionDescriptor::ConvFwdGemm(Handle& handle,
         MIOPEN_THROW("GEMM convolution is unsupported");
     }
 
+    if(!IsDefaultLayout(tensors.xDesc, tensors.wDesc, tensors.yDesc))
+    {
+        if(x_layout != ConvLayout::NCHW || y_layout != ConvLayout::NCHW ||
+           !IsGemmNHWCFwd(tensors.xDesc, tensors.wDesc, tensors.yDesc))
+            MIOPEN_THROW(miopenStatusNotImplemented,
+                         "Channels-last GEMM convolution needs a packed 1x1 filter, unit strides "
+                         "and no padding");
+
+        MIOPEN_LOG_FUNCTION("convolution, 1x1, channels-last");
+
+        // tensors.y = tensors.x * transpose(tensors.w)
+        GemmDescriptor gemm_desc =
+            CreateGemmDescriptorConvNHWCFwd(tensors.wDesc, tensors.xDesc, tensors.yDesc);
+
+        CallGemm(handle,
+                 gemm_desc,
+                 tensors.x,
+                 0,
+                 tensors.w,
+                 0,
+                 tensors.y,
+                 0,
+                 nullptr,
+                 false);
+        return;
+    }
+
     std::size_t in_n, in_c;
     std::tie(in_n, in_c) = tie_pick<0, 1>()(tensors.xDesc.GetLengths());
 
@@ -1630,14 +1745,7 @@ void ConvolutionDescriptor::ConvFwdGemm(Handle& handle,
     auto wei_spatial = boost::adaptors::slice(tensors.wDesc.GetLengths(), 2, 2 + spatial_dim);
     auto out_spatial = boost::adaptors::slice(tensors.yDesc.GetLengths(), 2, 2 + spatial_dim);
 
-    // Use transpose path if input ht and width <= 14 for 1x1_stride=1 convolutions OR for
-    // 1x1_stride=2
-    if(GetSpatialDimension() == 2 &&
-       (miopen::all_of(wei_spatial, [](auto v) { return v == 1; }) &&
-        miopen::all_of(GetConvPads(), [](auto v) { return v == 0; })) &&
-       ((miopen::all_of(in_spatial, [](auto v) { return v <= 14; }) &&
-         miopen::all_of(GetConvStrides(), [](auto v) { return v == 1; })) ||
-        miopen::all_of(GetConvStrides(), [](auto v) { return v == 2; })))
+    if(IsGemmTransposeFwd(tensors.xDesc, tensors.wDesc))
     {
         if(group_count > 1)
         {
@@ -1651,23 +1759,37 @@ void ConvolutionDescriptor::ConvFwdGemm(Handle& handle,
         assert(workSpace != nullptr &&
                workSpaceSize >= ForwardGetWorkSpaceSizeGEMMTranspose(tensors.xDesc, tensors.yDesc));
 
+        const bool x_cnhw = x_layout == ConvLayout::CNHW;
+        const bool y_cnhw = y_layout == ConvLayout::CNHW;
+        if((x_cnhw || y_cnhw) &&
+           (tensors.wDesc.GetType() == miopenInt8 || tensors.wDesc.GetType() == miopenInt8x4))
+            MIOPEN_THROW(miopenStatusNotImplemented, "CNHW layout is unsupported for int8");
+
+        // A CNHW input is read by the GEMM in place unless it has to be subsampled.
+        const bool x_in_place =
+            x_cnhw && miopen::all_of(GetConvStrides(), [](auto v) { return v == 1; });
+
         float t1 = 0;
-        transpose_NCHW2CNHW(handle,
-                            in_n,
-                            in_c,
-                            in_spatial[0],
-                            in_spatial[1],
-                            out_spatial[0],
-                            out_spatial[1],
-                            tensors.x,
-                            workSpace,
-                            0,
-                            0,
-                            GetConvStrides()[0],
-                            GetConvStrides()[1],
-                            tensors.xDesc.GetType());
-        if(handle.IsProfilingEnabled())
-            t1 = handle.GetKernelTime();
+        if(!x_in_place)
+        {
+            // A CNHW input is subsampled as an NCHW tensor of one image with in_n * in_c channels.
+            transpose_NCHW2CNHW(handle,
+                                x_cnhw ? 1 : in_n,
+                                x_cnhw ? in_n * in_c : in_c,
+                                in_spatial[0],
+                                in_spatial[1],
+                                out_spatial[0],
+                                out_spatial[1],
+                                tensors.x,
+                                workSpace,
+                                0,
+                                0,
+                                GetConvStrides()[0],
+                                GetConvStrides()[1],
+                                tensors.xDesc.GetType());
+            if(handle.IsProfilingEnabled())
+                t1 = handle.GetKernelTime();
+        }
 
         std::size_t out_spatial_size = std::accumulate(
             out_spatial.begin(), out_spatial.end(), std::size_t(1), std::multiplies<std::size_t>());
@@ -1704,13 +1826,25 @@ void ConvolutionDescriptor::ConvFwdGemm(Handle& handle,
             }
         }
 
+        const ConstData_t gemm_x        = x_in_place ? tensors.x : workSpace;
+        const Data_t gemm_y             = y_cnhw ? tensors.y : workSpace;
+        const std::size_t gemm_y_offset = y_cnhw ? 0 : x_t_size;
+
         if(group_count > 1)
         {
             GemmDescriptor gemm_desc = CreateGemmDescriptorGroupConvCNHWFwd(
                 tensors.wDesc, tensors.xDesc, tensors.yDesc, group_count);
 
-            CallGemmStridedBatched(
-                handle, gemm_desc, tensors.w, 0, workSpace, 0, workSpace, x_t_size, nullptr, false);
+            CallGemmStridedBatched(handle,
+                                   gemm_desc,
+                                   tensors.w,
+                                   0,
+                                   gemm_x,
+                                   0,
+                                   gemm_y,
+                                   gemm_y_offset,
+                                   nullptr,
+                                   false);
         }
         else
         {
@@ -1723,32 +1857,35 @@ void ConvolutionDescriptor::ConvFwdGemm(Handle& handle,
                      gemm_desc,
                      tensors.w,
                      0,
-                     workSpace,
+                     gemm_x,
                      wksp_offset,
-                     workSpace,
-                     x_t_size,
+                     gemm_y,
+                     gemm_y_offset,
                      nullptr,
                      false);
         }
         if(handle.IsProfilingEnabled())
             t1 += handle.GetKernelTime();
 
-        transpose_CNHW2NCHW(handle,
-                            in_n,
-                            wei_k,
-                            out_spatial[0],
-                            out_spatial[1],
-                            out_spatial[0],
-                            out_spatial[1],
-                            workSpace,
-                            tensors.y,
-                            x_t_size,
-                            0,
-                            1,
-                            1,
-                            tensors.yDesc.GetType());
-        if(handle.IsProfilingEnabled())
-            t1 += handle.GetKernelTime();
+        if(!y_cnhw)
+        {
+            transpose_CNHW2NCHW(handle,
+                                in_n,
+                                wei_k,
+                                out_spatial[0],
+                                out_spatial[1],
+                                out_spatial[0],
+                                out_spatial[1],
+                                workSpace,
+                                tensors.y,
+                                x_t_size,
+                                0,
+                                1,
+                                1,
+                                tensors.yDesc.GetType());
+            if(handle.IsProfilingEnabled())
+                t1 += handle.GetKernelTime();
+        }
 
         if((tensors.wDesc.GetType() == miopenInt8 || tensors.wDesc.GetType() == miopenInt8x4) &&
            tensors.yDesc.GetType() != miopenInt32)
@@ -1920,6 +2057,69 @@ void ConvolutionDescriptor::ConvFwdGemm(Handle& handle,
         std::size_t in_spatial_size = std::accumulate(
             in_spatial.begin(), in_spatial.end(), std::size_t(1), std::multiplies<std::size_t>());
 
+        // When the workspace holds the columns of several images, im2col a chunk of images
+        // and multiply it with one strided batched GEMM instead of a GEMM per image.
+        const std::size_t chunk_size = ForwardGetGEMMChunkSize(
+            tensors.wDesc, tensors.xDesc, tensors.yDesc, workSpaceSize);
+        if(chunk_size > 1)
+        {
+            MIOPEN_LOG_I2("im2col chunk: " << chunk_size << " images");
+            const std::size_t column =
+                ForwardGetWorkSpaceSizeGEMMChunk(tensors.wDesc, tensors.yDesc);
+
+            float time_chunks = 0;
+            for(std::size_t first = 0; first < in_n; first += chunk_size)
+            {
+                const std::size_t images = std::min(chunk_size, in_n - first);
+                for(std::size_t j = 0; j < images; j++)
+                {
+                    auto col = handle.CreateSubBuffer(workSpace, j * column, column);
+                    Im2ColGPU(handle,
+                              GetSpatialDimension(),
+                              tensors.x,
+                              (first + j) * in_c * in_spatial_size,
+                              in_c,
+                              in_spatial,
+                              wei_spatial,
+                              out_spatial,
+                              GetConvPads(),
+                              GetConvStrides(),
+                              GetConvDilations(),
+                              col.get(),
+                              tensors.xDesc.GetType());
+
+                    if(handle.IsProfilingEnabled())
+                        time_chunks += handle.GetKernelTime();
+                }
+
+                GemmDescriptor chunk_desc = gemm_desc;
+                chunk_desc.batch_count    = static_cast<int>(images);
+                chunk_desc.strideB        = column / GetTypeSize(tensors.xDesc.GetType());
+                chunk_desc.strideC        = wei_k * out_spatial_size;
+
+                CallGemmStridedBatched(handle,
+                                       chunk_desc,
+                                       tensors.w,
+                                       0,
+                                       workSpace,
+                                       0,
+                                       tensors.y,
+                                       first * wei_k * out_spatial_size,
+                                       nullptr,
+                                       false);
+
+                if(handle.IsProfilingEnabled())
+                    time_chunks += handle.GetKernelTime();
+            }
+
+            if(handle.IsProfilingEnabled())
+            {
+                handle.ResetKernelTime();
+                handle.AccumKernelTime(time_chunks);
+            }
+            return;
+        }
+
         float time_0 = 0;
         float t1     = 0;
         for(std::size_t i = 0; i < in_n; i++)
@@ -2031,6 +2231,8 @@ void ConvolutionDescriptor::ConvFwdGemm(Handle& handle,
     (void)tensors;
     (void)workSpace;
     (void)workSpaceSize;
+    (void)x_layout;
+    (void)y_layout;
     MIOPEN_THROW("GEMM is not supported");
 #endif
 }
@@ -2109,7 +2311,21 @@ void ConvFwdSCGemm(const ConvolutionContext& ctx,
 #endif
 }
 
-std::size_t ConvolutionDescriptor::GetFwdSolutionCountFallback(const TensorDescriptor& wDesc,
+/// The fallback paths offer GEMM only within the workspace budget of the handle, like the find-db
+/// solutions (see GetSolutions()), so the counts, the lists and the execution agree.
+static bool IsFallbackGemmInBudget(const Handle& handle, std::size_t workspace)
+{
+    if(workspace > handle.workspace_budget)
+    {
+        MIOPEN_LOG_I("Fallback path, GEMM exceeds the workspace budget");
+        return false;
+    }
+    MIOPEN_LOG_I("Fallback path, GEMM");
+    return true;
+}
+
+std::size_t ConvolutionDescriptor::GetFwdSolutionCountFallback(Handle& handle,
+                                                               const TensorDescriptor& wDesc,
                                                                const TensorDescriptor& xDesc,
                                                                const TensorDescriptor& yDesc) const
 {
@@ -2119,8 +2335,8 @@ std::size_t ConvolutionDescriptor::GetFwdSolutionCountFallback(const TensorDescr
 
     if(IsGemmApplicableFwd(wDesc, xDesc, yDesc))
     {
-        MIOPEN_LOG_I("Fallback path, GEMM");
-        return 1;
+        const auto workspace = ForwardGetValidWorkSpaceSizeGemm(handle, wDesc, xDesc, yDesc);
+        return IsFallbackGemmInBudget(handle, workspace) ? 1 : 0;
     }
     MIOPEN_LOG_I("Fallback path, GEMM disabled");
     /// When count=0 the reason could be:
@@ -2138,7 +2354,8 @@ std::size_t ConvolutionDescriptor::GetFwdSolutionCountFallback(const TensorDescr
                  "Requested convolution is not supported or immedate mode fallback has failed.");
 }
 
-std::size_t ConvolutionDescriptor::GetBwdSolutionCountFallback(const TensorDescriptor& dyDesc,
+std::size_t ConvolutionDescriptor::GetBwdSolutionCountFallback(Handle& handle,
+                                                               const TensorDescriptor& dyDesc,
                                                                const TensorDescriptor& wDesc,
                                                                const TensorDescriptor& dxDesc) const
 {
@@ -2146,8 +2363,8 @@ std::size_t ConvolutionDescriptor::GetBwdSolutionCountFallback(const TensorDescr
 
     if(IsGemmApplicableBwd(dyDesc, wDesc, dxDesc))
     {
-        MIOPEN_LOG_I("Fallback path, GEMM");
-        return 1;
+        const auto workspace = BackwardGetValidWorkSpaceSizeGemm(dyDesc, wDesc, dxDesc);
+        return IsFallbackGemmInBudget(handle, workspace) ? 1 : 0;
     }
     MIOPEN_LOG_I("Fallback path, GEMM disabled");
     // See comment in Forward method.
@@ -2161,7 +2378,8 @@ bool ConvolutionDescriptor::IsGemmApplicableWrw(const TensorDescriptor& dyDesc,
 {
 #if MIOPEN_USE_GEMM
     if(!miopen::IsDisabled(MIOPEN_DEBUG_CONV_GEMM{}) &&
-       !(IsAnyBufferBF16(xDesc, dyDesc, dwDesc) && !IsUseRocBlas))
+       !(IsAnyBufferBF16(xDesc, dyDesc, dwDesc) && !IsUseRocBlas) &&
+       IsDefaultLayout(xDesc, dwDesc, dyDesc))
     {
         const std::size_t spatial_dim = GetSpatialDimension();
         const auto wei_spatial = boost::adaptors::slice(dwDesc.GetLengths(), 2, 2 + spatial_dim);
@@ -2193,7 +2411,8 @@ bool ConvolutionDescriptor::IsGemmApplicableFwd(const TensorDescriptor& wDesc,
 {
 #if MIOPEN_USE_GEMM
     return !miopen::IsDisabled(MIOPEN_DEBUG_CONV_GEMM{}) &&
-           !(IsAnyBufferBF16(xDesc, yDesc, wDesc) && !IsUseRocBlas);
+           !(IsAnyBufferBF16(xDesc, yDesc, wDesc) && !IsUseRocBlas) &&
+           (IsDefaultLayout(xDesc, wDesc, yDesc) || IsGemmNHWCFwd(xDesc, wDesc, yDesc));
 #else
     std::ignore = wDesc;
     std::ignore = xDesc;
@@ -2208,7 +2427,8 @@ bool ConvolutionDescriptor::IsGemmApplicableBwd(const TensorDescriptor& dyDesc,
 {
 #if MIOPEN_USE_GEMM
     return !miopen::IsDisabled(MIOPEN_DEBUG_CONV_GEMM{}) &&
-           !(IsAnyBufferBF16(dxDesc, dyDesc, wDesc) && !IsUseRocBlas);
+           !(IsAnyBufferBF16(dxDesc, dyDesc, wDesc) && !IsUseRocBlas) &&
+           IsDefaultLayout(dxDesc, wDesc, dyDesc);
 #else
     std::ignore = dyDesc;
     std::ignore = wDesc;
@@ -2217,16 +2437,17 @@ bool ConvolutionDescriptor::IsGemmApplicableBwd(const TensorDescriptor& dyDesc,
 #endif
 }
 
-std::size_t ConvolutionDescriptor::GetWrwSolutionCountFallback(const TensorDescriptor& dyDesc,
+std::size_t ConvolutionDescriptor::GetWrwSolutionCountFallback(Handle& handle,
+                                                               const TensorDescriptor& dyDesc,
                                                                const TensorDescriptor& xDesc,
                                                                const TensorDescriptor& dwDesc) const
 {
     ValidateGroupCount(xDesc, dwDesc, *this); // See comment in Forward method.
 
-    if(IsGemmApplicableWrw(xDesc, dyDesc, dwDesc))
+    if(IsGemmApplicableWrw(dyDesc, xDesc, dwDesc))
     {
-        MIOPEN_LOG_I("Fallback path, GEMM");
-        return 1;
+        const auto workspace = WrwGetValidWorkSpaceSizeGemm(dyDesc, xDesc, dwDesc);
+        return IsFallbackGemmInBudget(handle, workspace) ? 1 : 0;
     }
     MIOPEN_LOG_I("Fallback path, GEMM disabled");
     // See comment in Forward method.
@@ -2234,27 +2455,6 @@ std::size_t ConvolutionDescriptor::GetWrwSolutionCountFallback(const TensorDescr
                  "Requested convolution is not supported or immedate mode fallback has failed.");
 }
 
-std::size_t GetSolutionCount(Handle& handle, const ProblemDescription& problem)
-{
-    const FindDbRecord fdb_record{handle, problem};
-    if(fdb_record.empty())
-        return 0;
-    return std::distance(fdb_record.begin(), fdb_record.end());
-}
-
-std::size_t ConvolutionDescriptor::GetForwardSolutionCount(Handle& handle,
-                                                           const TensorDescriptor& wDesc,
-                                                           const TensorDescriptor& xDesc,
-                                                           const TensorDescriptor& yDesc) const
-{
-    MIOPEN_LOG_I("");
-    const auto problem = ProblemDescription{xDesc, wDesc, yDesc, *this, 1};
-    const auto n       = GetSolutionCount(handle, problem);
-    if(n > 0)
-        return n;
-    return GetFwdSolutionCountFallback(wDesc, xDesc, yDesc);
-}
-
 static inline bool IsAlgorithmDisabled(const miopenConvAlgorithm_t algo)
 {
     switch(algo)
@@ -2276,36 +2476,23 @@ static inline bool IsAlgorithmDisabled(const miopenConvAlgorithm_t algo)
     } // clang-format on
 }
 
-void GetSolutions(Handle& handle,
-                  const ProblemDescription& problem,
-                  const size_t maxSolutionCount,
-                  size_t* solutionCount,
-                  miopenConvSolution_t* solutions,
-                  std::function<int(const std::string&)>&& algoResolver)
+static int ResolveAlgorithm(const ProblemDescription& problem, const std::string& name)
+{
+    if(problem.direction.IsForward())
+        return StringToConvolutionFwdAlgo(name);
+    if(problem.direction.IsBackwardData())
+        return StringToConvolutionBwdDataAlgo(name);
+    return StringToConvolutionBwdWeightsAlgo(name);
+}
+
+static std::shared_ptr<const ImmediateSolutions>
+LoadImmediateSolutions(Handle& handle, const ProblemDescription& problem)
 {
+    auto result = std::make_shared<ImmediateSolutions>();
     const FindDbRecord fdb_record{handle, problem};
 
     if(fdb_record.empty())
-    {
-        *solutionCount = 0;
-        return;
-    }
-
-    // Read all what we have, then sort and write out up to max asked.
-    // Fallback path currently returns only one solution, so no need to sort there.
-    struct SortWrapper : miopenConvSolution_t // For emplace and sort.
-    {
-        SortWrapper(const float& t,
-                    const size_t& ws,
-                    const uint64_t& id,
-                    const miopenConvAlgorithm_t& algo)
-            : miopenConvSolution_t{t, ws, id, algo}
-        {
-        }
-        bool operator<(const SortWrapper& other) const { return (time < other.time); }
-    };
-    std::vector<SortWrapper> interim;
-    interim.reserve(maxSolutionCount); // For speed. In most cases we have less entries than asked.
+        return result;
 
     // Individual Solvers can be enabled/disabled by environment settings.
     // Applicability is also affected by presence of external tools (e.g. assembler)
@@ -2315,10 +2502,11 @@ void GetSolutions(Handle& handle,
     auto ctx = ConvolutionContext{problem};
     ctx.SetStream(&handle);
     ctx.DetectRocm();
+    const auto& policy = GetSolverPolicy(problem);
 
     for(const auto& pair : fdb_record)
     {
-        const auto algo = static_cast<miopenConvAlgorithm_t>(algoResolver(pair.first));
+        const auto algo = static_cast<miopenConvAlgorithm_t>(ResolveAlgorithm(problem, pair.first));
         if(IsAlgorithmDisabled(algo))
             continue;
 
@@ -2331,25 +2519,89 @@ void GetSolutions(Handle& handle,
             MIOPEN_LOG_I("[Warning] incorrect solver_id: " << pair.second.solver_id);
             continue;
         }
+        if(!policy.IsAllowed(pair.second.solver_id))
+            continue;
         // gemm and fft are always applicable.
         // These can be disabled/enabled at algorithm level.
         if(!(solver_id == solver::Id::gemm() || solver_id == solver::Id::fft()))
             if(!solver_id.GetSolver().IsApplicable(ctx))
                 continue;
 
-        interim.emplace_back(pair.second.time, pair.second.workspace, solver_id.Value(), algo);
+        // Items of a bucket record have the workspace of another problem of the bucket.
+        const auto workspace = fdb_record.IsFromBucket()
+                                   ? solver_id.GetSolver().GetWorkspaceSize(ctx)
+                                   : pair.second.workspace;
+        if(!policy.FitsWorkspace(workspace))
+            continue;
+        result->solutions.push_back({pair.second.time, workspace, solver_id.Value(), algo});
     }
-    std::sort(begin(interim), end(interim));
+    // Fastest first. Fallback path currently returns only one solution, so no need to sort there.
+    std::stable_sort(result->solutions.begin(),
+                     result->solutions.end(),
+                     [](const miopenConvSolution_t& left, const miopenConvSolution_t& right) {
+                         return left.time < right.time;
+                     });
+    return result;
+}
 
-    auto i = std::size_t{0};
-    for(const auto& entry : interim)
+/// Immediate mode queries are answered from ImmediateModeCache, which is refilled from find-db
+/// whenever the find-db changes.
+static std::shared_ptr<const ImmediateSolutions>
+GetImmediateSolutions(Handle& handle, const ProblemDescription& problem)
+{
+    std::ostringstream ss;
+    ss << problem << '@' << handle.GetDbBasename();
+    const auto key     = ss.str();
+    const auto version = FindDbRecord::GetVersion(handle);
+    auto& cache        = ImmediateModeCache::Get();
+
+    auto solutions = cache.Find(key, version);
+    if(solutions != nullptr)
+        return solutions;
+
+    solutions = LoadImmediateSolutions(handle, problem);
+    cache.Insert(key, version, solutions);
+    return solutions;
+}
+
+/// The cache is shared by all handles, so their workspace budgets apply to the cached solutions.
+std::size_t GetSolutionCount(Handle& handle, const ProblemDescription& problem)
+{
+    const auto& found = GetImmediateSolutions(handle, problem)->solutions;
+    return std::count_if(found.begin(), found.end(), [&](const miopenConvSolution_t& solution) {
+        return solution.workspace_size <= handle.workspace_budget;
+    });
+}
+
+void GetSolutions(Handle& handle,
+                  const ProblemDescription& problem,
+                  const size_t maxSolutionCount,
+                  size_t* solutionCount,
+                  miopenConvSolution_t* solutions)
+{
+    const auto& found = GetImmediateSolutions(handle, problem)->solutions;
+    std::size_t n     = 0;
+    for(const auto& solution : found)
     {
-        if(i >= maxSolutionCount)
+        if(n == maxSolutionCount)
             break;
-        solutions[i] = entry;
-        ++i;
+        if(solution.workspace_size <= handle.workspace_budget)
+            solutions[n++] = solution;
     }
-    *solutionCount = i;
+    *solutionCount = n;
+}
+
+std::size_t ConvolutionDescriptor::GetForwardSolutionCount(Handle& handle,
+                                                           const TensorDescriptor& wDesc,
+                                                           const TensorDescriptor& xDesc,
+                                                           const TensorDescriptor& yDesc) const
+{
+    MIOPEN_LOG_I("");
+    const auto problem = ProblemDescription{xDesc, wDesc, yDesc, *this, 1};
+    const auto n       = GetSolutionCount(handle, problem);
+    if(n > 0)
+        return n;
+    return GetFwdSolutionCountFallback(handle, wDesc, xDesc, yDesc);
 }
 
 void ConvolutionDescriptor::GetForwardSolutionsFallback(Handle& handle,
@@ -2367,14 +2619,13 @@ void ConvolutionDescriptor::GetForwardSolutionsFallback(Handle& handle,
 
     if(IsGemmApplicableFwd(wDesc, xDesc, yDesc))
     {
-        MIOPEN_LOG_I("Fallback path, GEMM");
-        if(i < maxSolutionCount)
+        const auto workspace = ForwardGetValidWorkSpaceSizeGemm(handle, wDesc, xDesc, yDesc);
+        if(i < maxSolutionCount && IsFallbackGemmInBudget(handle, workspace))
         {
-            solutions[i].algorithm = miopenConvolutionAlgoGEMM;
-            solutions[i].time      = -1.0; /// \todo Evaluate time.
-            solutions[i].workspace_size =
-                ForwardGetValidWorkSpaceSizeGemm(handle, wDesc, xDesc, yDesc);
-            solutions[i].solution_id = solver::Id::gemm().Value();
+            solutions[i].algorithm      = miopenConvolutionAlgoGEMM;
+            solutions[i].time           = -1.0; /// \todo Evaluate time.
+            solutions[i].workspace_size = workspace;
+            solutions[i].solution_id    = solver::Id::gemm().Value();
             ++i;
         }
     }
@@ -2384,7 +2635,7 @@ void ConvolutionDescriptor::GetForwardSolutionsFallback(Handle& handle,
     *solutionCount = i;
 }
 
-void ConvolutionDescriptor::GetBwdSolutionsFallback(Handle& /*handle*/,
+void ConvolutionDescriptor::GetBwdSolutionsFallback(Handle& handle,
                                                     const TensorDescriptor& dyDesc,
                                                     const TensorDescriptor& wDesc,
                                                     const TensorDescriptor& dxDesc,
@@ -2397,12 +2648,12 @@ void ConvolutionDescriptor::GetBwdSolutionsFallback(Handle& /*handle*/,
 
     if(IsGemmApplicableBwd(dyDesc, wDesc, dxDesc))
     {
-        MIOPEN_LOG_I("Fallback path, GEMM");
-        if(i < maxSolutionCount)
+        const auto workspace = BackwardGetValidWorkSpaceSizeGemm(dyDesc, wDesc, dxDesc);
+        if(i < maxSolutionCount && IsFallbackGemmInBudget(handle, workspace))
         {
             solutions[i].algorithm      = miopenConvolutionAlgoGEMM;
             solutions[i].time           = -1.0; /// \todo Evaluate time.
-            solutions[i].workspace_size = BackwardGetValidWorkSpaceSizeGemm(dyDesc, wDesc, dxDesc);
+            solutions[i].workspace_size = workspace;
             solutions[i].solution_id    = solver::Id::gemm().Value();
             ++i;
         }
@@ -2413,7 +2664,7 @@ void ConvolutionDescriptor::GetBwdSolutionsFallback(Handle& /*handle*/,
     *solutionCount = i;
 }
 
-void ConvolutionDescriptor::GetWrwSolutionsFallback(Handle& /*handle*/,
+void ConvolutionDescriptor::GetWrwSolutionsFallback(Handle& handle,
                                                     const TensorDescriptor& dyDesc,
                                                     const TensorDescriptor& xDesc,
                                                     const TensorDescriptor& dwDesc,
@@ -2426,12 +2677,12 @@ void ConvolutionDescriptor::GetWrwSolutionsFallback(Handle& /*handle*/,
 
     if(IsGemmApplicableWrw(dyDesc, xDesc, dwDesc))
     {
-        MIOPEN_LOG_I("Fallback path, GEMM");
-        if(i < maxSolutionCount)
+        const auto workspace = WrwGetValidWorkSpaceSizeGemm(dyDesc, xDesc, dwDesc);
+        if(i < maxSolutionCount && IsFallbackGemmInBudget(handle, workspace))
         {
             solutions[i].algorithm      = miopenConvolutionAlgoGEMM;
             solutions[i].time           = -1.0; /// \todo Evaluate time.
-            solutions[i].workspace_size = WrwGetValidWorkSpaceSizeGemm(dyDesc, xDesc, dwDesc);
+            solutions[i].workspace_size = workspace;
             solutions[i].solution_id    = solver::Id::gemm().Value();
             ++i;
         }
@@ -2457,8 +2708,7 @@ void ConvolutionDescriptor::GetForwardSolutions(Handle& handle,
         MIOPEN_THROW(miopenStatusBadParm, "solutions cannot be nullptr");
 
     const auto problem = ProblemDescription{xDesc, wDesc, yDesc, *this, 1};
-    GetSolutions(
-        handle, problem, maxSolutionCount, solutionCount, solutions, StringToConvolutionFwdAlgo);
+    GetSolutions(handle, problem, maxSolutionCount, solutionCount, solutions);
 
     if(*solutionCount == 0)
         GetForwardSolutionsFallback(
@@ -2563,6 +2813,16 @@ std::size_t ConvolutionDescriptor::GetForwardSolutionWorkspaceSize(Handle& handl
     return GetFwdSolutionWorkspaceSizeFallback(handle, wDesc, xDesc, yDesc, solver_id);
 }
 
+/// Items of a bucket record were found for another problem of the bucket, see FindDbRecord.
+static bool
+IsApplicableFromBucket(const FindDbRecord& record, ConvolutionContext ctx, solver::Id solver_id)
+{
+    if(!record.IsFromBucket())
+        return true;
+    ctx.DetectRocm();
+    return solver_id.GetSolver().IsApplicable(ctx);
+}
+
 static std::vector<KernelInvoke> CompileSolver(Handle& handle,
                                                ConvolutionContext& ctx,
                                                solver::Id solver_id,
@@ -2600,6 +2860,8 @@ void CompileSolution(Handle& handle,
     {
         if(solver::Id{pair.second.solver_id} != solver_id)
             continue;
+        if(!IsApplicableFromBucket(fdb_record, ctx, solver_id))
+            break;
 
         const auto&& kernels = handle.GetKernels(pair.second.kcache_key.algorithm_name,
                                                  pair.second.kcache_key.network_config);
@@ -2621,6 +2883,58 @@ void CompileSolution(Handle& handle,
     MIOPEN_THROW(miopenStatusNotImplemented);
 }
 
+static bool CompileSolutionAsync(Handle& handle,
+                                 const solver::Id solver_id,
+                                 ConvolutionContext ctx,
+                                 const int priority)
+{
+    if(!solver_id.IsValid())
+        MIOPEN_THROW(miopenStatusBadParm, "solver_id = " + solver_id.ToString());
+
+    // GEMM has nothing to build ahead, FFT kernels are built on first use.
+    if(solver_id == solver::Id::gemm() || solver_id == solver::Id::fft())
+        return true;
+
+    std::ostringstream key;
+    key << static_cast<const ProblemDescription&>(ctx) << ':' << solver_id.ToString();
+
+    const auto job = [&handle, ctx, solver_id]() mutable {
+        ctx.DetectRocm();
+        ctx.SetupFloats();
+        const auto solver = solver_id.GetSolver();
+        if(!solver.IsApplicable(ctx))
+            MIOPEN_THROW(miopenStatusBadParm,
+                         "The supplied solution id: " + solver_id.ToString() +
+                             " is not applicable to the current problem");
+        auto db             = GetDb(ctx);
+        const auto solution = solver.FindSolution(ctx, db);
+        // Only the programs are built, into the handle and the binary cache. The first use of
+        // the solution registers its kernels under the network config without compiling.
+        AddKernels(handle, "", "", solution, nullptr);
+    };
+
+    const auto result = GetCompileQueue(handle).Enqueue(key.str(), priority, job);
+    if(result.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+        return false;
+    result.get(); // Rethrows the failure of the job.
+    return true;
+}
+
+bool ConvolutionDescriptor::CompileForwardSolutionAsync(Handle& handle,
+                                                        const TensorDescriptor& wDesc,
+                                                        const TensorDescriptor& xDesc,
+                                                        const TensorDescriptor& yDesc,
+                                                        const solver::Id solver_id,
+                                                        const int priority) const
+{
+    MIOPEN_LOG_I2("solver_id = " << solver_id.ToString() << ", priority = " << priority);
+
+    auto ctx = ConvolutionContext{xDesc, wDesc, yDesc, *this, 1};
+    ctx.SetStream(&handle);
+    ctx.disable_search_enforce = true;
+    return CompileSolutionAsync(handle, solver_id, ctx, priority);
+}
+
 void ConvolutionDescriptor::CompileForwardSolution(Handle& handle,
                                                    const TensorDescriptor& wDesc,
                                                    const TensorDescriptor& xDesc,
@@ -2658,6 +2972,8 @@ void ConvolutionDescriptor::ConvolutionForwardImmediate(Handle& handle,
     ValidateConvTensors(tensors);
     if(!solver_id.IsValid())
         MIOPEN_THROW(miopenStatusBadParm);
+    if(solver_id != solver::Id::gemm() && !IsDefaultLayout(xDesc, wDesc, yDesc))
+        MIOPEN_THROW(miopenStatusNotImplemented, "Only GEMM supports channels-last layouts");
 
     ConvForwardCheckNumerics(handle, tensors, [&]() {
 
@@ -2707,6 +3023,8 @@ void ConvolutionDescriptor::ConvolutionForwardImmediate(Handle& handle,
         {
             if(solver::Id{pair.second.solver_id} != solver_id)
                 continue;
+            if(!IsApplicableFromBucket(fdb_record, ctx, solver_id))
+                break;
 
             const auto&& kernels = handle.GetKernels(pair.second.kcache_key.algorithm_name,
                                                      pair.second.kcache_key.network_config);
@@ -2775,6 +3093,8 @@ void ConvolutionDescriptor::FindConvBwdDataAlgorithm(Handle& handle,
         MIOPEN_THROW(miopenStatusBadParm, "requestAlgoCount cannot be < 1");
     if(wDesc.GetType() == miopenInt8)
         MIOPEN_THROW(miopenStatusBadParm);
+    if(!IsDefaultLayout(dxDesc, wDesc, dyDesc))
+        MIOPEN_THROW(miopenStatusNotImplemented, "Channels-last layouts are forward only");
 
     *returnedAlgoCount = 0;
 
@@ -3198,13 +3518,16 @@ void ConvolutionDescriptor::FindConvBwdDataAlgorithm(Handle& handle,
 #endif
     });
 
+    ApplySolverPolicy(problem, perf_db);
+
     if(perf_db.empty())
         MIOPEN_THROW(miopenStatusUnknownError, "Backward Data Algo cannot be executed");
 
     std::sort(begin(perf_db), end(perf_db));
 
     for(const auto& entry : perf_db)
-        MIOPEN_LOG_I(entry.name << "\t" << entry.time << "\t" << entry.workspace);
+        MIOPEN_LOG_I(entry.name << "\t" << entry.time << "\t" << entry.workspace << "\t"
+                                << entry.roofline);
 
     *returnedAlgoCount = std::min(requestAlgoCount, static_cast<int>(perf_db.size()));
 
@@ -3217,7 +3540,9 @@ void ConvolutionDescriptor::FindConvBwdDataAlgorithm(Handle& handle,
 
     MIOPEN_LOG_I("BWD Chosen Algorithm: " << perf_db[0].solver_id << " , " << perf_db[0].workspace
                                           << ", "
-                                          << perf_db[0].time);
+                                          << perf_db[0].time
+                                          << ", "
+                                          << perf_db[0].roofline);
 }
 
 template <class TKernels>
@@ -3278,6 +3603,8 @@ void ConvolutionDescriptor::ConvolutionBackwardData(Handle& handle,
 
     if(wDesc.GetType() == miopenInt8)
         MIOPEN_THROW(miopenStatusBadParm);
+    if(!IsDefaultLayout(dxDesc, wDesc, dyDesc))
+        MIOPEN_THROW(miopenStatusNotImplemented, "Channels-last layouts are forward only");
 
     ConvBwdCheckNumerics(handle, tensors, beta, [&]() {
         if(dyDesc.GetLengths()[1] != wDesc.GetLengths()[0])
@@ -3795,7 +4122,7 @@ std::size_t ConvolutionDescriptor::GetBackwardSolutionCount(Handle& handle,
     const auto count   = GetSolutionCount(handle, problem);
     if(count > 0)
         return count;
-    return GetBwdSolutionCountFallback(dyDesc, wDesc, dxDesc);
+    return GetBwdSolutionCountFallback(handle, dyDesc, wDesc, dxDesc);
 }
 
 void ConvolutionDescriptor::GetBackwardSolutions(Handle& handle,
@@ -3813,12 +4140,7 @@ void ConvolutionDescriptor::GetBackwardSolutions(Handle& handle,
         MIOPEN_THROW(miopenStatusBadParm, "solutions cannot be nullptr");
 
     const auto problem = ProblemDescription{dxDesc, wDesc, dyDesc, *this, 0};
-    GetSolutions(handle,
-                 problem,
-                 maxSolutionCount,
-                 solutionCount,
-                 solutions,
-                 StringToConvolutionBwdDataAlgo);
+    GetSolutions(handle, problem, maxSolutionCount, solutionCount, solutions);
 
     if(*solutionCount == 0)
         GetBwdSolutionsFallback(
@@ -3845,6 +4167,21 @@ void ConvolutionDescriptor::CompileBackwardSolution(Handle& handle,
     });
 }
 
+bool ConvolutionDescriptor::CompileBackwardSolutionAsync(Handle& handle,
+                                                         const TensorDescriptor& dyDesc,
+                                                         const TensorDescriptor& wDesc,
+                                                         const TensorDescriptor& dxDesc,
+                                                         const solver::Id solver_id,
+                                                         const int priority) const
+{
+    MIOPEN_LOG_I2("solver_id = " << solver_id.ToString() << ", priority = " << priority);
+
+    auto ctx = ConvolutionContext{dxDesc, wDesc, dyDesc, *this, 0};
+    ctx.SetStream(&handle);
+    ctx.disable_search_enforce = true;
+    return CompileSolutionAsync(handle, solver_id, ctx, priority);
+}
+
 std::size_t ConvolutionDescriptor::GetBackwardSolutionWorkspaceSize(Handle& handle,
                                                                     const TensorDescriptor& dyDesc,
                                                                     const TensorDescriptor& wDesc,
@@ -3892,6 +4229,8 @@ void ConvolutionDescriptor::ConvolutionBackwardImmediate(Handle& handle,
 
     if(wDesc.GetType() == miopenInt8)
         MIOPEN_THROW(miopenStatusBadParm);
+    if(!IsDefaultLayout(dxDesc, wDesc, dyDesc))
+        MIOPEN_THROW(miopenStatusNotImplemented, "Channels-last layouts are forward only");
 
     static const float beta = 0.0f;
     ConvBwdCheckNumerics(handle, tensors, &beta, [&]() {
@@ -3941,6 +4280,8 @@ void ConvolutionDescriptor::ConvolutionBackwardImmediate(Handle& handle,
         {
             if(solver::Id{pair.second.solver_id} != solver_id)
                 continue;
+            if(!IsApplicableFromBucket(fdb_record, ctx, solver_id))
+                break;
 
             const auto&& kernels = handle.GetKernels(pair.second.kcache_key.algorithm_name,
                                                      pair.second.kcache_key.network_config);
@@ -4310,6 +4651,8 @@ void ConvolutionDescriptor::FindConvBwdWeightsAlgorithm(Handle& handle,
         MIOPEN_THROW(miopenStatusBadParm, "requestAlgoCount cannot be < 1");
     if(xDesc.GetType() == miopenInt8)
         MIOPEN_THROW(miopenStatusBadParm);
+    if(!IsDefaultLayout(xDesc, dwDesc, dyDesc))
+        MIOPEN_THROW(miopenStatusNotImplemented, "Channels-last layouts are forward only");
 
     *returnedAlgoCount = 0;
 
@@ -4630,13 +4973,16 @@ void ConvolutionDescriptor::FindConvBwdWeightsAlgorithm(Handle& handle,
         }
     });
 
+    ApplySolverPolicy(problem, perf_db);
+
     if(perf_db.empty())
         MIOPEN_THROW("Bwd Weights Convolution cannot be executed due to incorrect params");
 
     std::sort(begin(perf_db), end(perf_db));
 
     for(const auto& entry : perf_db)
-        MIOPEN_LOG_I(entry.name << "\t" << entry.time << "\t" << entry.workspace);
+        MIOPEN_LOG_I(entry.name << "\t" << entry.time << "\t" << entry.workspace << "\t"
+                                << entry.roofline);
 
     *returnedAlgoCount = std::min(requestAlgoCount, static_cast<int>(perf_db.size()));
 
@@ -4648,7 +4994,9 @@ void ConvolutionDescriptor::FindConvBwdWeightsAlgorithm(Handle& handle,
     }
     MIOPEN_LOG_I("BWrW Chosen Algorithm: " << perf_db[0].solver_id << " , " << perf_db[0].workspace
                                            << ", "
-                                           << perf_db[0].time);
+                                           << perf_db[0].time
+                                           << ", "
+                                           << perf_db[0].roofline);
 }
 
 static void ConvWrwCheckNumerics(Handle& handle,
@@ -4693,6 +5041,8 @@ void ConvolutionDescriptor::ConvolutionBackwardWeights(Handle& handle,
 
     if(xDesc.GetType() == miopenInt8)
         MIOPEN_THROW(miopenStatusBadParm);
+    if(!IsDefaultLayout(xDesc, dwDesc, dyDesc))
+        MIOPEN_THROW(miopenStatusNotImplemented, "Channels-last layouts are forward only");
 
     ConvWrwCheckNumerics(handle, tensors, beta, [&]() {
         ValidateGroupCount(xDesc, dwDesc, *this);
@@ -5143,7 +5493,7 @@ std::size_t ConvolutionDescriptor::GetWrwSolutionCount(Handle& handle,
     const auto count   = GetSolutionCount(handle, problem);
     if(count > 0)
         return count;
-    return GetWrwSolutionCountFallback(dyDesc, xDesc, dwDesc);
+    return GetWrwSolutionCountFallback(handle, dyDesc, xDesc, dwDesc);
 }
 
 void ConvolutionDescriptor::GetWrwSolutions(Handle& handle,
@@ -5161,12 +5511,7 @@ void ConvolutionDescriptor::GetWrwSolutions(Handle& handle,
         MIOPEN_THROW(miopenStatusBadParm, "solutions cannot be nullptr");
 
     const auto problem = MakeWrwProblem(dyDesc, xDesc, dwDesc);
-    GetSolutions(handle,
-                 problem,
-                 maxSolutionCount,
-                 solutionCount,
-                 solutions,
-                 StringToConvolutionBwdWeightsAlgo);
+    GetSolutions(handle, problem, maxSolutionCount, solutionCount, solutions);
 
     if(*solutionCount == 0)
         GetWrwSolutionsFallback(
@@ -5188,6 +5533,21 @@ void ConvolutionDescriptor::CompileWrwSolution(Handle& handle,
     CompileSolution(handle, solver_id, ctx, [&]() { MIOPEN_THROW("FFT is not supported in WrW"); });
 }
 
+bool ConvolutionDescriptor::CompileWrwSolutionAsync(Handle& handle,
+                                                    const TensorDescriptor& dyDesc,
+                                                    const TensorDescriptor& xDesc,
+                                                    const TensorDescriptor& dwDesc,
+                                                    const solver::Id solver_id,
+                                                    const int priority) const
+{
+    MIOPEN_LOG_I2("solver_id = " << solver_id.ToString() << ", priority = " << priority);
+    auto ctx = ConvolutionContext{xDesc, dwDesc, dyDesc, *this, 0};
+    ctx.direction.SetBackwardWrW();
+    ctx.SetStream(&handle);
+    ctx.disable_search_enforce = true;
+    return CompileSolutionAsync(handle, solver_id, ctx, priority);
+}
+
 std::size_t ConvolutionDescriptor::GetWrwSolutionWorkspaceSize(Handle& handle,
                                                                const TensorDescriptor& dyDesc,
                                                                const TensorDescriptor& xDesc,
@@ -5234,6 +5594,8 @@ void ConvolutionDescriptor::ConvolutionWrwImmediate(Handle& handle,
 
     if(xDesc.GetType() == miopenInt8)
         MIOPEN_THROW(miopenStatusBadParm);
+    if(!IsDefaultLayout(xDesc, dwDesc, dyDesc))
+        MIOPEN_THROW(miopenStatusNotImplemented, "Channels-last layouts are forward only");
 
     float beta = 0;
     ConvWrwCheckNumerics(handle, tensors, &beta, [&]() {
@@ -5273,6 +5635,8 @@ void ConvolutionDescriptor::ConvolutionWrwImmediate(Handle& handle,
         {
             if(solver::Id{pair.second.solver_id} != solver_id)
                 continue;
+            if(!IsApplicableFromBucket(fdb_record, ctx, solver_id))
+                break;
 
             const auto&& kernels = handle.GetKernels(pair.second.kcache_key.algorithm_name,
                                                      pair.second.kcache_key.network_config);
@@ -24,10 +24,13 @@
  *
  *******************************************************************************/
 #include <miopen/config.h>
+#include <miopen/check_numerics.hpp>
+#include <miopen/compile_queue.hpp>
 #include <miopen/device_name.hpp>
 #include <miopen/errors.hpp>
 #include <miopen/logger.hpp>
 #include <miopen/handle.hpp>
+#include <miopen/kernel_bundle.hpp>
 #include <miopen/kernel_cache.hpp>
 #include <miopen/manage_ptr.hpp>
 #include <miopen/ocldeviceinfo.hpp>
@@ -35,6 +38,8 @@
 #include <miopen/load_file.hpp>
 #include <boost/filesystem.hpp>
 #include <miopen/handle_lock.hpp>
+#include <miopen/trace.hpp>
+#include <miopen/workspace_arena.hpp>
 #if MIOPEN_USE_MIOPENGEMM
 #include <miopen/gemm_geometry.hpp>
 #endif
@@ -435,7 +440,21 @@ Handle::Handle() : impl(new HandleImpl())
 }
 
 Handle::Handle(Handle&&) noexcept = default;
-Handle::~Handle()                 = default;
+Handle::~Handle()
+{
+    // The running compile jobs use the handle.
+    compile_queue.reset();
+    if(check_numerics_ring == nullptr)
+        return;
+    try
+    {
+        miopen::flushCheckNumerics(*this);
+    }
+    catch(const Exception& ex)
+    {
+        MIOPEN_LOG_E(ex.what());
+    }
+}
 
 void Handle::SetStream(miopenAcceleratorQueue_t streamID) const
 {
@@ -536,6 +555,18 @@ Program Handle::LoadProgram(const std::string& program_name,
                             bool is_kernel_str,
                             const std::string& kernel_src)
 {
+    MIOPEN_TRACE_SCOPE("compile", program_name);
+    // May run on the compile queue while the bundle is loaded.
+    const auto bundle = std::atomic_load(&this->kernel_bundle);
+    if(bundle != nullptr)
+    {
+        const auto binary = bundle->FindProgram(program_name, params, is_kernel_str);
+        if(binary != nullptr)
+            return LoadBinaryProgram(miopen::GetContext(this->GetStream()),
+                                     miopen::GetDevice(this->GetStream()),
+                                     *binary);
+    }
+
     auto cache_file =
         miopen::LoadBinary(this->GetDeviceName(), program_name, params, is_kernel_str);
     if(cache_file.empty())
@@ -550,6 +581,12 @@ Program Handle::LoadProgram(const std::string& program_name,
         // Save to cache
         auto path = miopen::GetCachePath() / boost::filesystem::unique_path();
         miopen::SaveProgramBinary(p, path.string());
+        if(miopen::IsRecordingKernelBundle())
+            miopen::RecordBundleProgram(this->GetDeviceName(),
+                                        program_name,
+                                        params,
+                                        is_kernel_str,
+                                        miopen::LoadFile(path.string()));
         miopen::SaveBinary(
             path.string(), this->GetDeviceName(), program_name, params, is_kernel_str);
 
@@ -557,9 +594,13 @@ Program Handle::LoadProgram(const std::string& program_name,
     }
     else
     {
+        auto binary = miopen::LoadFile(cache_file);
+        if(miopen::IsRecordingKernelBundle())
+            miopen::RecordBundleProgram(
+                this->GetDeviceName(), program_name, params, is_kernel_str, binary);
         return LoadBinaryProgram(miopen::GetContext(this->GetStream()),
                                  miopen::GetDevice(this->GetStream()),
-                                 miopen::LoadFile(cache_file));
+                                 binary);
     }
 }
 
@@ -605,6 +646,12 @@ std::size_t Handle::GetMaxComputeUnits()
     return miopen::GetDeviceInfo<CL_DEVICE_MAX_COMPUTE_UNITS>(miopen::GetDevice(this->GetStream()));
 }
 
+std::size_t Handle::GetMaxClockFrequency()
+{
+    return miopen::GetDeviceInfo<CL_DEVICE_MAX_CLOCK_FREQUENCY>(
+        miopen::GetDevice(this->GetStream()));
+}
+
 std::size_t Handle::GetImage3dMaxWidth()
 {
     return miopen::GetDeviceInfo<CL_DEVICE_IMAGE3D_MAX_WIDTH>(miopen::GetDevice(this->GetStream()));
@@ -124,6 +124,12 @@ int mlo_construct_pooling2D::mloConstructFwd()
         _out_pix_tile1 >>= 1;
     }
 
+    if(_tuned_out_pix_tile0 > 0 && _tuned_out_pix_tile1 > 0)
+    {
+        _out_pix_tile0 = _tuned_out_pix_tile0;
+        _out_pix_tile1 = _tuned_out_pix_tile1;
+    }
+
     _comp_options = std::string(" -DMLO_POOLING_OP_ID=") +
                     std::to_string(static_cast<long long>(_pooling_method)) +
                     std::string(" -DMLO_POOLING_KERNEL_SZ1=") +
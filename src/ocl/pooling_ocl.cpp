@@ -26,6 +26,7 @@
 #include <miopen/kernel_cache.hpp>
 #include <miopen/mlo_internal.hpp>
 #include <miopen/pooling.hpp>
+#include <miopen/pooling_solver.hpp>
 #include <miopen/float_equal.hpp>
 #include <miopen/check_numerics.hpp>
 #include <miopen/datatype.hpp>
@@ -123,26 +124,51 @@ miopenStatus_t PoolingDescriptor::Forward(Handle& handle,
         std::to_string(GetIndexType());
 
     std::string algo_name = "miopenPooling2dForward";
-    // printf("Pooling forward network_config: %s\n", network_config.c_str());
-    auto&& kernels = handle.GetKernels(algo_name, network_config);
-    if(!kernels.empty())
-    {
-        kernels.front()(x, y, workSpace);
-    }
-    else
-    {
-        construct_params.doBackward(save_index);
 
-        mloConstruct(construct_params);
-        std::string parms              = construct_params.getCompilerOptions(); // kernel parameters
-        std::string program_name       = construct_params.getKernelFile(); // CL kernel filename
-        std::string kernel_name        = construct_params.getKernelName(); // kernel name
-        const std::vector<size_t>& vld = construct_params.getLocalWkSize();
-        const std::vector<size_t>& vgd = construct_params.getGlobalWkSize();
+    const auto run = [&](const solver::PoolingFwdSolution& solution) {
+        const auto tuned_network_config = network_config + "t" +
+                                          std::to_string(solution.out_pix_tile0) + "x" +
+                                          std::to_string(solution.out_pix_tile1);
+        auto&& kernels = handle.GetKernels(algo_name, tuned_network_config);
+        if(!kernels.empty())
+        {
+            kernels.front()(x, y, workSpace);
+        }
+        else
+        {
+            construct_params.doBackward(save_index);
+            construct_params.setOutPixTile(solution.out_pix_tile0, solution.out_pix_tile1);
+
+            mloConstruct(construct_params);
+            std::string parms        = construct_params.getCompilerOptions(); // kernel parameters
+            std::string program_name = construct_params.getKernelFile(); // CL kernel filename
+            std::string kernel_name  = construct_params.getKernelName(); // kernel name
+            const std::vector<size_t>& vld = construct_params.getLocalWkSize();
+            const std::vector<size_t>& vgd = construct_params.getGlobalWkSize();
+
+            handle.AddKernel(
+                algo_name, tuned_network_config, program_name, kernel_name, vld, vgd, parms)(
+                x, y, workSpace);
+        }
+    };
+
+    PoolingContext context(xDesc, yDesc);
+    context.win_h          = lens[0];
+    context.win_w          = lens[1];
+    context.pad_h          = pads[0];
+    context.pad_w          = pads[1];
+    context.stride_h       = strides[0];
+    context.stride_w       = strides[1];
+    context.pooling_method = pooling_method;
+    context.save_index     = save_index;
+    context.SetStream(&handle);
+    context.run = run;
+    // Searching runs the kernel several times, so it is not allowed in place.
+    if(x == y)
+        context.disable_search_enforce = true;
+
+    run(solver::FindPoolingFwdSolution(context));
 
-        handle.AddKernel(algo_name, network_config, program_name, kernel_name, vld, vgd, parms)(
-            x, y, workSpace);
-    }
     if(miopen::CheckNumericsEnabled())
     {
         miopen::checkNumericsOutput(handle, yDesc, y);
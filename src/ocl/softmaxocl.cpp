@@ -25,32 +25,13 @@
  *******************************************************************************/
 #include <miopen/kernel_cache.hpp>
 #include <miopen/softmax.hpp>
+#include <miopen/softmax_solver.hpp>
 #include <miopen/float_equal.hpp>
 #include <miopen/check_numerics.hpp>
 #include <miopen/tensor.hpp>
 
 namespace miopen {
 
-int nextPow2(int v)
-{
-
-    if(v == 1)
-    {
-        return (v << 1);
-    }
-    else
-    {
-        v--;
-        v |= v >> 1;
-        v |= v >> 2;
-        v |= v >> 4;
-        v |= v >> 8;
-        v |= v >> 16;
-        v++;
-        return v;
-    }
-}
-
 miopenStatus_t SoftmaxForward(Handle& handle,
                               const void* alpha,
                               const void* beta,
@@ -87,12 +68,13 @@ miopenStatus_t SoftmaxForward(Handle& handle,
     int out_nstr, out_cstr, out_hstr, out_wstr;
     std::tie(out_nstr, out_cstr, out_hstr, out_wstr) = tien<4>(yDesc.GetStrides());
 
-    // using workgroup size of 256 by default
-    int grid_size   = mode == MIOPEN_SOFTMAX_MODE_INSTANCE ? n : n * h * w;
-    int spatial_dim = mode == MIOPEN_SOFTMAX_MODE_INSTANCE ? 1 : h * w;
-    int vector_size = mode == MIOPEN_SOFTMAX_MODE_INSTANCE ? c * h * w : c;
-    // num_spatial_dims or pixels each workgroup can compute
-    int num_batch = vector_size < 256 ? nextPow2(256 / vector_size) : 1;
+    SoftmaxContext context(true, yDesc, algorithm, mode);
+    context.SetStream(&handle);
+
+    // using workgroup size of 256
+    int grid_size   = context.GetGridSize();
+    int spatial_dim = context.GetSpatialDim();
+    int vector_size = context.GetVectorSize();
 
     const std::vector<size_t> vld{256, 1, 1};
 
@@ -108,168 +90,101 @@ miopenStatus_t SoftmaxForward(Handle& handle,
     auto beta_fp  = *(static_cast<const float*>(beta));
 
     // See Kernels/MIOpenSoftmax.cl for description
-    if(num_batch == 1)
-    { // CSR-Vector like approach
-
-        // Control the max. number of workgroups launched so that we do not
-        // start getting workgroup scheduling overheads
-        size_t workgroups = std::min(grid_size, 64 * 40 * 8);
+    context.run = [&](const solver::SoftmaxSolution& solution) {
+        // num_spatial_dims or pixels each workgroup can compute
+        const int num_batch = solution.num_batch;
+        // num_threads iterating over channels for one spatial_dim
+        const int batch_size = solution.batch_size;
+        // num_channels each threads iterates over to cover all the channels
+        const int u_batch_size = solution.u_batch_size;
+        // CSR-Vector like approach launches at most a limited number of workgroups
+        // looping through the grid, CSR-Stream like one covers the grid.
+        const size_t workgroups = solution.workgroups;
         const std::vector<size_t> vgd{workgroups * vld[0], 1, 1};
 
-        std::string algo_name = "SoftmaxForwardOneBatch";
+        std::string algo_name =
+            num_batch == 1 ? "SoftmaxForwardOneBatch" : "SoftmaxForwardMultiBatch";
         std::string network_config =
             "n" + std::to_string(num_batch) + "half" + std::to_string(static_cast<int>(usefp16)) +
             "float" + std::to_string(static_cast<int>(usefp32)) + "g" + std::to_string(vgd[0]) +
             "l" + std::to_string(vld[0]) + "dim" + std::to_string(spatial_dim) + "grid" +
             std::to_string(grid_size) + "wg" + std::to_string(workgroups) + "v" +
-            std::to_string(vector_size) + "a" + std::to_string(alpha_fp) + "b" +
-            std::to_string(beta_fp) + "algo" + std::to_string(static_cast<int>(algorithm)) +
-            "mode" + std::to_string(static_cast<int>(mode));
+            std::to_string(vector_size);
+        if(num_batch != 1)
+            network_config += "ubatch" + std::to_string(u_batch_size) + "batch" +
+                              std::to_string(batch_size);
+        network_config += "a" + std::to_string(alpha_fp) + "b" + std::to_string(beta_fp) + "algo" +
+                          std::to_string(static_cast<int>(algorithm)) + "mode" +
+                          std::to_string(static_cast<int>(mode));
 
         auto&& kernels = handle.GetKernels(algo_name, network_config);
 
         if(!kernels.empty())
         {
             kernels.front()(x, y, vector_size, grid_size, spatial_dim, alpha_fp, beta_fp);
+            return;
         }
+
+        std::string program_name = "MIOpenSoftmax.cl";
+        std::string kernel_name  = "SoftmaxForward";
+
+        // compile parameters
+        std::string parms = "-DNUM_BATCH=" + std::to_string(num_batch);
+        if(num_batch != 1)
+            parms += " -DBATCH_SIZE=" + std::to_string(batch_size) + " -DU_BATCH_SIZE=" +
+                     std::to_string(u_batch_size);
+        parms += " -DMIOPEN_USE_FP16=" + std::to_string(static_cast<int>(usefp16)) +
+                 " -DMIOPEN_USE_FP32=" + std::to_string(static_cast<int>(usefp32));
+
+        parms += " -DOUT_OFFSET=" + std::to_string(y_offset) + " -DIN_OFFSET=" +
+                 std::to_string(x_offset);
+        if(algorithm == MIOPEN_SOFTMAX_LOG)
+            parms += " -DUSE_SOFTMAX_LOG=1";
+        else if(algorithm == MIOPEN_SOFTMAX_FAST)
+            parms += " -DUSE_SOFTMAX_FAST=1";
         else
-        {
-            std::string program_name = "MIOpenSoftmax.cl";
-            std::string kernel_name  = "SoftmaxForward";
-
-            // compile parameters
-            std::string parms = "-DNUM_BATCH=" + std::to_string(num_batch) + " -DMIOPEN_USE_FP16=" +
-                                std::to_string(static_cast<int>(usefp16)) + " -DMIOPEN_USE_FP32=" +
-                                std::to_string(static_cast<int>(usefp32));
-
-            parms += " -DOUT_OFFSET=" + std::to_string(y_offset) + " -DIN_OFFSET=" +
-                     std::to_string(x_offset);
-            if(algorithm == MIOPEN_SOFTMAX_LOG)
-                parms += " -DUSE_SOFTMAX_LOG=1";
-            else if(algorithm == MIOPEN_SOFTMAX_FAST)
-                parms += " -DUSE_SOFTMAX_FAST=1";
-            else
-                parms += " -DUSE_SOFTMAX_ACCURATE=1";
-
-            if(mode == MIOPEN_SOFTMAX_MODE_INSTANCE)
-                parms += " -DUSE_SOFTMAX_MODE_INSTANCE=1";
-            else
-                parms += " -DUSE_SOFTMAX_MODE_CHANNEL=1";
-
-            parms += " -DRUN_FORWARD=1";
-            if(xDesc.IsPacked())
-                parms += " -DIS_INPUT_PACKED=1";
-            else
-                parms += " -DINPUT_N_STRIDE=" + std::to_string(in_nstr) + " -DINPUT_C_STRIDE=" +
-                         std::to_string(in_cstr) + " -DINPUT_H_STRIDE=" + std::to_string(in_hstr) +
-                         " -DINPUT_W_STRIDE=" + std::to_string(in_wstr) + " -DIS_INPUT_PACKED=0";
-
-            if(yDesc.IsPacked())
-                parms += " -DIS_OUTPUT_PACKED=1";
-            else
-                parms += " -DOUTPUT_N_STRIDE=" + std::to_string(out_nstr) + " -DOUTPUT_C_STRIDE=" +
-                         std::to_string(out_cstr) + " -DOUTPUT_H_STRIDE=" +
-                         std::to_string(out_hstr) + " -DOUTPUT_W_STRIDE=" +
-                         std::to_string(out_wstr) + " -DIS_OUTPUT_PACKED=0";
-
-            if(!(xDesc.IsPacked() && yDesc.IsPacked()))
-                parms += " -DINPUT_H=" + std::to_string(h) + " -DINPUT_W=" + std::to_string(w);
-
-            if(!float_equal(alpha_fp, 1.0))
-                parms += " -DUSE_ALPHA=1";
-
-            if(!float_equal(beta_fp, 0))
-                parms += " -DUSE_BETA=1";
-
-            handle.AddKernel(algo_name, network_config, program_name, kernel_name, vld, vgd, parms)(
-                x, y, vector_size, grid_size, spatial_dim, alpha_fp, beta_fp);
-        }
-    }
-    else
-    { // CSR-Stream like approach
+            parms += " -DUSE_SOFTMAX_ACCURATE=1";
 
-        // num_threads iterating over channels for one spatial_dim
-        int batch_size = 256 / num_batch;
-        // num_channels each threads iterates over to cover all the channels
-        int u_batch_size = (vector_size > batch_size) ? nextPow2(vector_size / batch_size) : 1;
+        if(mode == MIOPEN_SOFTMAX_MODE_INSTANCE)
+            parms += " -DUSE_SOFTMAX_MODE_INSTANCE=1";
+        else
+            parms += " -DUSE_SOFTMAX_MODE_CHANNEL=1";
 
-        size_t workgroups =
-            (grid_size % num_batch == 0) ? (grid_size / num_batch) : (grid_size / num_batch + 1);
-        const std::vector<size_t> vgd{workgroups * vld[0], 1, 1};
+        parms += " -DRUN_FORWARD=1";
+        if(xDesc.IsPacked())
+            parms += " -DIS_INPUT_PACKED=1";
+        else
+            parms += " -DINPUT_N_STRIDE=" + std::to_string(in_nstr) + " -DINPUT_C_STRIDE=" +
+                     std::to_string(in_cstr) + " -DINPUT_H_STRIDE=" + std::to_string(in_hstr) +
+                     " -DINPUT_W_STRIDE=" + std::to_string(in_wstr) + " -DIS_INPUT_PACKED=0";
 
-        if((u_batch_size + 1) * 256 > 65536 && yDesc.GetType() == miopenHalf)
-            MIOPEN_THROW(miopenStatusBadParm, "Exceed local memory capacity");
+        if(yDesc.IsPacked())
+            parms += " -DIS_OUTPUT_PACKED=1";
+        else
+            parms += " -DOUTPUT_N_STRIDE=" + std::to_string(out_nstr) + " -DOUTPUT_C_STRIDE=" +
+                     std::to_string(out_cstr) + " -DOUTPUT_H_STRIDE=" + std::to_string(out_hstr) +
+                     " -DOUTPUT_W_STRIDE=" + std::to_string(out_wstr) + " -DIS_OUTPUT_PACKED=0";
 
-        std::string algo_name = "SoftmaxForwardMultiBatch";
-        std::string network_config =
-            "n" + std::to_string(num_batch) + "half" + std::to_string(static_cast<int>(usefp16)) +
-            "float" + std::to_string(static_cast<int>(usefp32)) + "g" + std::to_string(vgd[0]) +
-            "l" + std::to_string(vld[0]) + "dim" + std::to_string(spatial_dim) + "grid" +
-            std::to_string(grid_size) + "wg" + std::to_string(workgroups) + "v" +
-            std::to_string(vector_size) + "ubatch" + std::to_string(u_batch_size) + "batch" +
-            std::to_string(batch_size) + "a" + std::to_string(alpha_fp) + "b" +
-            std::to_string(beta_fp) + "algo" + std::to_string(static_cast<int>(algorithm)) +
-            "mode" + std::to_string(static_cast<int>(mode));
+        if(!(xDesc.IsPacked() && yDesc.IsPacked()))
+            parms += " -DINPUT_H=" + std::to_string(h) + " -DINPUT_W=" + std::to_string(w);
 
-        auto&& kernels = handle.GetKernels(algo_name, network_config);
+        if(!float_equal(alpha_fp, 1.0))
+            parms += " -DUSE_ALPHA=1";
+
+        if(!float_equal(beta_fp, 0))
+            parms += " -DUSE_BETA=1";
+
+        handle.AddKernel(algo_name, network_config, program_name, kernel_name, vld, vgd, parms)(
+            x, y, vector_size, grid_size, spatial_dim, alpha_fp, beta_fp);
+    };
+
+    // Searching runs the kernels several times, so it is not allowed when
+    // the result is accumulated (beta != 0) or computed in place.
+    if(!float_equal(beta_fp, 0) || x == y)
+        context.disable_search_enforce = true;
+
+    context.run(solver::FindSoftmaxSolution(context));
 
-        if(!kernels.empty())
-        {
-            kernels.front()(x, y, vector_size, grid_size, spatial_dim, alpha_fp, beta_fp);
-        }
-        else
-        {
-            std::string program_name = "MIOpenSoftmax.cl";
-            std::string kernel_name  = "SoftmaxForward";
-            std::string parms = "-DNUM_BATCH=" + std::to_string(num_batch) + " -DBATCH_SIZE=" +
-                                std::to_string(batch_size) + " -DU_BATCH_SIZE=" +
-                                std::to_string(u_batch_size) + " -DMIOPEN_USE_FP16=" +
-                                std::to_string(static_cast<int>(usefp16)) + " -DMIOPEN_USE_FP32=" +
-                                std::to_string(static_cast<int>(usefp32));
-
-            parms += " -DOUT_OFFSET=" + std::to_string(y_offset) + " -DIN_OFFSET=" +
-                     std::to_string(x_offset);
-            if(algorithm == MIOPEN_SOFTMAX_LOG)
-                parms += " -DUSE_SOFTMAX_LOG=1";
-            else if(algorithm == MIOPEN_SOFTMAX_FAST)
-                parms += " -DUSE_SOFTMAX_FAST=1";
-            else
-                parms += " -DUSE_SOFTMAX_ACCURATE=1";
-
-            if(mode == MIOPEN_SOFTMAX_MODE_INSTANCE)
-                parms += " -DUSE_SOFTMAX_MODE_INSTANCE=1";
-            else
-                parms += " -DUSE_SOFTMAX_MODE_CHANNEL=1";
-
-            parms += " -DRUN_FORWARD=1";
-            if(xDesc.IsPacked())
-                parms += " -DIS_INPUT_PACKED=1";
-            else
-                parms += " -DINPUT_N_STRIDE=" + std::to_string(in_nstr) + " -DINPUT_C_STRIDE=" +
-                         std::to_string(in_cstr) + " -DINPUT_H_STRIDE=" + std::to_string(in_hstr) +
-                         " -DINPUT_W_STRIDE=" + std::to_string(in_wstr) + " -DIS_INPUT_PACKED=0";
-
-            if(yDesc.IsPacked())
-                parms += " -DIS_OUTPUT_PACKED=1";
-            else
-                parms += " -DOUTPUT_N_STRIDE=" + std::to_string(out_nstr) + " -DOUTPUT_C_STRIDE=" +
-                         std::to_string(out_cstr) + " -DOUTPUT_H_STRIDE=" +
-                         std::to_string(out_hstr) + " -DOUTPUT_W_STRIDE=" +
-                         std::to_string(out_wstr) + " -DIS_OUTPUT_PACKED=0";
-
-            if(!(xDesc.IsPacked() && yDesc.IsPacked()))
-                parms += " -DINPUT_H=" + std::to_string(h) + " -DINPUT_W=" + std::to_string(w);
-
-            if(!float_equal(alpha_fp, 1.0))
-                parms += " -DUSE_ALPHA=1";
-
-            if(!float_equal(beta_fp, 0))
-                parms += " -DUSE_BETA=1";
-
-            handle.AddKernel(algo_name, network_config, program_name, kernel_name, vld, vgd, parms)(
-                x, y, vector_size, grid_size, spatial_dim, alpha_fp, beta_fp);
-        }
-    }
     if(miopen::CheckNumericsEnabled())
     {
         miopen::checkNumericsOutput(handle, yDesc, y);
@@ -329,12 +244,13 @@ miopenStatus_t SoftmaxBackward(Handle& handle,
     int out_nstr, out_cstr, out_hstr, out_wstr;
     std::tie(out_nstr, out_cstr, out_hstr, out_wstr) = tien<4>(yDesc.GetStrides());
 
-    // using workgroup size of 256 by default
-    int grid_size   = mode == MIOPEN_SOFTMAX_MODE_INSTANCE ? n : n * h * w;
-    int spatial_dim = mode == MIOPEN_SOFTMAX_MODE_INSTANCE ? 1 : h * w;
-    int vector_size = mode == MIOPEN_SOFTMAX_MODE_INSTANCE ? c * h * w : c;
-    // num_spatial_dims or pixels each workgroup can compute
-    int num_batch = vector_size < 256 ? nextPow2(256 / vector_size) : 1;
+    SoftmaxContext context(false, dxDesc, algorithm, mode);
+    context.SetStream(&handle);
+
+    // using workgroup size of 256
+    int grid_size   = context.GetGridSize();
+    int spatial_dim = context.GetSpatialDim();
+    int vector_size = context.GetVectorSize();
 
     const std::vector<size_t> vld{256, 1, 1};
 
@@ -350,180 +266,102 @@ miopenStatus_t SoftmaxBackward(Handle& handle,
     auto beta_fp  = *(static_cast<const float*>(beta));
 
     // See Kernels/MIOpenSoftmax.cl for description
-    if(num_batch == 1)
-    { // CSR-Vector like approach
-
-        // Control the max. number of workgroups launched so that we do not
-        // start getting workgroup scheduling overheads
-        size_t workgroups = std::min(grid_size, 64 * 40 * 8);
+    context.run = [&](const solver::SoftmaxSolution& solution) {
+        const int num_batch     = solution.num_batch;
+        const int batch_size    = solution.batch_size;
+        const int u_batch_size  = solution.u_batch_size;
+        const size_t workgroups = solution.workgroups;
         const std::vector<size_t> vgd{workgroups * vld[0], 1, 1};
 
-        std::string algo_name = "SoftmaxBackwardOneBatch";
+        std::string algo_name =
+            num_batch == 1 ? "SoftmaxBackwardOneBatch" : "SoftmaxBackwardMultiBatch";
         std::string network_config =
             "n" + std::to_string(num_batch) + "half" + std::to_string(static_cast<int>(usefp16)) +
             "float" + std::to_string(static_cast<int>(usefp32)) + "g" + std::to_string(vgd[0]) +
             "l" + std::to_string(vld[0]) + "dim" + std::to_string(spatial_dim) + "grid" +
             std::to_string(grid_size) + "wg" + std::to_string(workgroups) + "v" +
-            std::to_string(vector_size) + "a" + std::to_string(alpha_fp) + "b" +
-            std::to_string(beta_fp) + "algo" + std::to_string(static_cast<int>(algorithm)) +
-            "mode" + std::to_string(static_cast<int>(mode));
+            std::to_string(vector_size);
+        if(num_batch != 1)
+            network_config += "ubatch" + std::to_string(u_batch_size) + "batch" +
+                              std::to_string(batch_size);
+        network_config += "a" + std::to_string(alpha_fp) + "b" + std::to_string(beta_fp) + "algo" +
+                          std::to_string(static_cast<int>(algorithm)) + "mode" +
+                          std::to_string(static_cast<int>(mode));
 
         auto&& kernels = handle.GetKernels(algo_name, network_config);
 
         if(!kernels.empty())
         {
             kernels.front()(y, dy, dx, vector_size, grid_size, spatial_dim, alpha_fp, beta_fp);
+            return;
         }
+
+        std::string program_name = "MIOpenSoftmax.cl";
+        std::string kernel_name  = "SoftmaxBackward";
+        std::string parms        = "-DNUM_BATCH=" + std::to_string(num_batch);
+        if(num_batch != 1)
+            parms += " -DBATCH_SIZE=" + std::to_string(batch_size) + " -DU_BATCH_SIZE=" +
+                     std::to_string(u_batch_size);
+        parms += " -DMIOPEN_USE_FP16=" + std::to_string(static_cast<int>(usefp16)) +
+                 " -DMIOPEN_USE_FP32=" + std::to_string(static_cast<int>(usefp32));
+
+        parms += " -DOUT_OFFSET=" + std::to_string(y_offset) + " -DDOUT_OFFSET=" +
+                 std::to_string(dy_offset) + " -DDIN_OFFSET=" + std::to_string(dx_offset);
+        if(algorithm == MIOPEN_SOFTMAX_LOG)
+            parms += " -DUSE_SOFTMAX_LOG=1";
+        else if(algorithm == MIOPEN_SOFTMAX_FAST)
+            parms += " -DUSE_SOFTMAX_FAST=1";
         else
-        {
-            std::string program_name = "MIOpenSoftmax.cl";
-            std::string kernel_name  = "SoftmaxBackward";
-            std::string parms = "-DNUM_BATCH=" + std::to_string(num_batch) + " -DMIOPEN_USE_FP16=" +
-                                std::to_string(static_cast<int>(usefp16)) + " -DMIOPEN_USE_FP32=" +
-                                std::to_string(static_cast<int>(usefp32));
-
-            parms += " -DOUT_OFFSET=" + std::to_string(y_offset) + " -DDOUT_OFFSET=" +
-                     std::to_string(dy_offset) + " -DDIN_OFFSET=" + std::to_string(dx_offset);
-            if(algorithm == MIOPEN_SOFTMAX_LOG)
-                parms += " -DUSE_SOFTMAX_LOG=1";
-            else if(algorithm == MIOPEN_SOFTMAX_FAST)
-                parms += " -DUSE_SOFTMAX_FAST=1";
-            else
-                parms += " -DUSE_SOFTMAX_ACCURATE=1";
-
-            if(mode == MIOPEN_SOFTMAX_MODE_INSTANCE)
-                parms += " -DUSE_SOFTMAX_MODE_INSTANCE=1";
-            else
-                parms += " -DUSE_SOFTMAX_MODE_CHANNEL=1";
-
-            parms += " -DRUN_FORWARD=0";
-            if(yDesc.IsPacked())
-                parms += " -DIS_OUTPUT_PACKED=1";
-            else
-                parms += " -DOUTPUT_N_STRIDE=" + std::to_string(out_nstr) + " -DOUTPUT_C_STRIDE=" +
-                         std::to_string(out_cstr) + " -DOUTPUT_H_STRIDE=" +
-                         std::to_string(out_hstr) + " -DOUTPUT_W_STRIDE=" +
-                         std::to_string(out_wstr) + " -DIS_OUTPUT_PACKED=0";
-
-            if(dyDesc.IsPacked())
-                parms += " -DIS_DOUTPUT_PACKED=1";
-            else
-                parms +=
-                    " -DDOUTPUT_N_STRIDE=" + std::to_string(dout_nstr) + " -DDOUTPUT_C_STRIDE=" +
-                    std::to_string(dout_cstr) + " -DDOUTPUT_H_STRIDE=" + std::to_string(dout_hstr) +
-                    " -DDOUTPUT_W_STRIDE=" + std::to_string(dout_wstr) + " -DIS_DOUTPUT_PACKED=0";
-
-            if(dxDesc.IsPacked())
-                parms += " -DIS_DINPUT_PACKED=1";
-            else
-                parms += " -DDINPUT_N_STRIDE=" + std::to_string(din_nstr) + " -DDINPUT_C_STRIDE=" +
-                         std::to_string(din_cstr) + " -DDINPUT_H_STRIDE=" +
-                         std::to_string(din_hstr) + " -DDINPUT_W_STRIDE=" +
-                         std::to_string(din_wstr) + " -DIS_DINPUT_PACKED=0";
-
-            if(!(dxDesc.IsPacked() && dyDesc.IsPacked() && yDesc.IsPacked()))
-                parms += " -DINPUT_H=" + std::to_string(h) + " -DINPUT_W=" + std::to_string(w);
-
-            if(!float_equal(alpha_fp, 1.0))
-                parms += " -DUSE_ALPHA=1";
-
-            if(!float_equal(beta_fp, 0))
-                parms += " -DUSE_BETA=1";
-
-            handle.AddKernel(algo_name, network_config, program_name, kernel_name, vld, vgd, parms)(
-                y, dy, dx, vector_size, grid_size, spatial_dim, alpha_fp, beta_fp);
-        }
-    }
-    else
-    { // CSR-Stream like approach
-        int batch_size   = 256 / num_batch;
-        int u_batch_size = (vector_size > batch_size) ? nextPow2(vector_size / batch_size) : 1;
-        size_t workgroups =
-            (grid_size % num_batch == 0) ? (grid_size / num_batch) : (grid_size / num_batch + 1);
-        const std::vector<size_t> vgd{workgroups * vld[0], 1, 1};
+            parms += " -DUSE_SOFTMAX_ACCURATE=1";
 
-        if((2 * u_batch_size + 1) * 256 > 65536 && yDesc.GetType() == miopenHalf)
-            MIOPEN_THROW(miopenStatusBadParm, "Exceed local memory capacity");
+        if(mode == MIOPEN_SOFTMAX_MODE_INSTANCE)
+            parms += " -DUSE_SOFTMAX_MODE_INSTANCE=1";
+        else
+            parms += " -DUSE_SOFTMAX_MODE_CHANNEL=1";
 
-        std::string algo_name = "SoftmaxBackwardMultiBatch";
-        std::string network_config =
-            "n" + std::to_string(num_batch) + "half" + std::to_string(static_cast<int>(usefp16)) +
-            "float" + std::to_string(static_cast<int>(usefp32)) + "g" + std::to_string(vgd[0]) +
-            "l" + std::to_string(vld[0]) + "dim" + std::to_string(spatial_dim) + "grid" +
-            std::to_string(grid_size) + "wg" + std::to_string(workgroups) + "v" +
-            std::to_string(vector_size) + "ubatch" + std::to_string(u_batch_size) + "batch" +
-            std::to_string(batch_size) + "a" + std::to_string(alpha_fp) + "b" +
-            std::to_string(beta_fp) + "algo" + std::to_string(static_cast<int>(algorithm)) +
-            "mode" + std::to_string(static_cast<int>(mode));
+        parms += " -DRUN_FORWARD=0";
+        if(yDesc.IsPacked())
+            parms += " -DIS_OUTPUT_PACKED=1";
+        else
+            parms += " -DOUTPUT_N_STRIDE=" + std::to_string(out_nstr) + " -DOUTPUT_C_STRIDE=" +
+                     std::to_string(out_cstr) + " -DOUTPUT_H_STRIDE=" + std::to_string(out_hstr) +
+                     " -DOUTPUT_W_STRIDE=" + std::to_string(out_wstr) + " -DIS_OUTPUT_PACKED=0";
 
-        auto&& kernels = handle.GetKernels(algo_name, network_config);
+        if(dyDesc.IsPacked())
+            parms += " -DIS_DOUTPUT_PACKED=1";
+        else
+            parms += " -DDOUTPUT_N_STRIDE=" + std::to_string(dout_nstr) + " -DDOUTPUT_C_STRIDE=" +
+                     std::to_string(dout_cstr) + " -DDOUTPUT_H_STRIDE=" +
+                     std::to_string(dout_hstr) + " -DDOUTPUT_W_STRIDE=" +
+                     std::to_string(dout_wstr) + " -DIS_DOUTPUT_PACKED=0";
 
-        if(!kernels.empty())
-        {
-            kernels.front()(y, dy, dx, vector_size, grid_size, spatial_dim, alpha_fp, beta_fp);
-        }
+        if(dxDesc.IsPacked())
+            parms += " -DIS_DINPUT_PACKED=1";
         else
-        {
-            std::string program_name = "MIOpenSoftmax.cl";
-            std::string kernel_name  = "SoftmaxBackward";
-            std::string parms = "-DNUM_BATCH=" + std::to_string(num_batch) + " -DBATCH_SIZE=" +
-                                std::to_string(batch_size) + " -DU_BATCH_SIZE=" +
-                                std::to_string(u_batch_size) + " -DMIOPEN_USE_FP16=" +
-                                std::to_string(static_cast<int>(usefp16)) + " -DMIOPEN_USE_FP32=" +
-                                std::to_string(static_cast<int>(usefp32));
-
-            parms += " -DOUT_OFFSET=" + std::to_string(y_offset) + " -DDOUT_OFFSET=" +
-                     std::to_string(dy_offset) + " -DDIN_OFFSET=" + std::to_string(dx_offset);
-            if(algorithm == MIOPEN_SOFTMAX_LOG)
-                parms += " -DUSE_SOFTMAX_LOG=1";
-            else if(algorithm == MIOPEN_SOFTMAX_FAST)
-                parms += " -DUSE_SOFTMAX_FAST=1";
-            else
-                parms += " -DUSE_SOFTMAX_ACCURATE=1";
-
-            if(mode == MIOPEN_SOFTMAX_MODE_INSTANCE)
-                parms += " -DUSE_SOFTMAX_MODE_INSTANCE=1";
-            else
-                parms += " -DUSE_SOFTMAX_MODE_CHANNEL=1";
-
-            parms += " -DRUN_FORWARD=0";
-            if(yDesc.IsPacked())
-                parms += " -DIS_OUTPUT_PACKED=1";
-            else
-                parms += " -DOUTPUT_N_STRIDE=" + std::to_string(out_nstr) + " -DOUTPUT_C_STRIDE=" +
-                         std::to_string(out_cstr) + " -DOUTPUT_H_STRIDE=" +
-                         std::to_string(out_hstr) + " -DOUTPUT_W_STRIDE=" +
-                         std::to_string(out_wstr) + " -DIS_OUTPUT_PACKED=0";
-
-            if(dyDesc.IsPacked())
-                parms += " -DIS_DOUTPUT_PACKED=1";
-            else
-                parms +=
-                    " -DDOUTPUT_N_STRIDE=" + std::to_string(dout_nstr) + " -DDOUTPUT_C_STRIDE=" +
-                    std::to_string(dout_cstr) + " -DDOUTPUT_H_STRIDE=" + std::to_string(dout_hstr) +
-                    " -DDOUTPUT_W_STRIDE=" + std::to_string(dout_wstr) + " -DIS_DOUTPUT_PACKED=0";
-
-            if(dxDesc.IsPacked())
-                parms += " -DIS_DINPUT_PACKED=1";
-            else
-                parms += " -DDINPUT_N_STRIDE=" + std::to_string(din_nstr) + " -DDINPUT_C_STRIDE=" +
-                         std::to_string(din_cstr) + " -DDINPUT_H_STRIDE=" +
-                         std::to_string(din_hstr) + " -DDINPUT_W_STRIDE=" +
-                         std::to_string(din_wstr) + " -DIS_DINPUT_PACKED=0";
-
-            if(!(dxDesc.IsPacked() && dyDesc.IsPacked() && yDesc.IsPacked()))
-                parms += " -DINPUT_H=" + std::to_string(h) + " -DINPUT_W=" + std::to_string(w);
-
-            if(!float_equal(alpha_fp, 1.0))
-                parms += " -DUSE_ALPHA=1";
-
-            if(!float_equal(beta_fp, 0))
-                parms += " -DUSE_BETA=1";
-
-            handle.AddKernel(algo_name, network_config, program_name, kernel_name, vld, vgd, parms)(
-                y, dy, dx, vector_size, grid_size, spatial_dim, alpha_fp, beta_fp);
-        }
-    }
+            parms += " -DDINPUT_N_STRIDE=" + std::to_string(din_nstr) + " -DDINPUT_C_STRIDE=" +
+                     std::to_string(din_cstr) + " -DDINPUT_H_STRIDE=" + std::to_string(din_hstr) +
+                     " -DDINPUT_W_STRIDE=" + std::to_string(din_wstr) + " -DIS_DINPUT_PACKED=0";
+
+        if(!(dxDesc.IsPacked() && dyDesc.IsPacked() && yDesc.IsPacked()))
+            parms += " -DINPUT_H=" + std::to_string(h) + " -DINPUT_W=" + std::to_string(w);
+
+        if(!float_equal(alpha_fp, 1.0))
+            parms += " -DUSE_ALPHA=1";
+
+        if(!float_equal(beta_fp, 0))
+            parms += " -DUSE_BETA=1";
+
+        handle.AddKernel(algo_name, network_config, program_name, kernel_name, vld, vgd, parms)(
+            y, dy, dx, vector_size, grid_size, spatial_dim, alpha_fp, beta_fp);
+    };
+
+    // Searching runs the kernels several times, so it is not allowed when
+    // the result is accumulated (beta != 0) or computed in place.
+    if(!float_equal(beta_fp, 0) || dx == y || dx == dy)
+        context.disable_search_enforce = true;
+
+    context.run(solver::FindSoftmaxSolution(context));
+
     if(miopen::CheckNumericsEnabled())
     {
         miopen::checkNumericsOutput(handle, dxDesc, dx);
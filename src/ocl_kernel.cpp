@@ -25,6 +25,7 @@
  *******************************************************************************/
 #include <miopen/oclkernel.hpp>
 #include <miopen/handle_lock.hpp>
+#include <miopen/trace.hpp>
 #include <miopen/logger.hpp>
 
 namespace miopen {
@@ -59,6 +60,7 @@ void OCLKernelInvoke::run() const
                                    << DimToFormattedString(local_work_dim.data(), work_dim));
 #endif // !NDEBUG
 
+    MIOPEN_TRACE_SCOPE("kernel", GetName());
     MIOPEN_HANDLE_LOCK
 
     cl_event ev;
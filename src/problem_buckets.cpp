@@ -0,0 +1,193 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2019 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/problem_buckets.hpp>
+#include <miopen/env.hpp>
+#include <miopen/logger.hpp>
+
+#include <algorithm>
+#include <map>
+#include <mutex>
+#include <sstream>
+
+namespace miopen {
+
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_FIND_DB_BATCH_BUCKETS)
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_FIND_DB_SPATIAL_BUCKETS)
+
+std::vector<int> ParseBucketBounds(const std::string& s)
+{
+    std::vector<int> bounds;
+    std::istringstream ss(s);
+    std::string item;
+    while(std::getline(ss, item, ','))
+    {
+        std::size_t end = 0;
+        int bound       = 0;
+        try
+        {
+            bound = std::stoi(item, &end);
+        }
+        catch(const std::exception&)
+        {
+            end = 0;
+        }
+        if(end == 0 || end != item.size() || bound <= 0 ||
+           (!bounds.empty() && bound <= bounds.back()))
+        {
+            MIOPEN_LOG_W("Ignoring malformed problem buckets: " << s);
+            return {};
+        }
+        bounds.push_back(bound);
+    }
+    return bounds;
+}
+
+int GetBucketBound(const std::vector<int>& bounds, int size)
+{
+    const auto bound = std::lower_bound(bounds.begin(), bounds.end(), size);
+    return bound != bounds.end() ? *bound : size;
+}
+
+static const std::vector<int>& GetBatchBounds()
+{
+    static const auto bounds = [] {
+        const auto s = GetStringEnv(MIOPEN_FIND_DB_BATCH_BUCKETS{});
+        return s != nullptr ? ParseBucketBounds(s) : std::vector<int>{};
+    }();
+    return bounds;
+}
+
+static const std::vector<int>& GetSpatialBounds()
+{
+    static const auto bounds = [] {
+        const auto s = GetStringEnv(MIOPEN_FIND_DB_SPATIAL_BUCKETS{});
+        return s != nullptr ? ParseBucketBounds(s) : std::vector<int>{};
+    }();
+    return bounds;
+}
+
+bool IsProblemBucketingEnabled()
+{
+    return !GetBatchBounds().empty() || !GetSpatialBounds().empty();
+}
+
+ProblemDescription GetBucketRepresentative(const ProblemDescription& problem)
+{
+    auto representative     = problem;
+    representative.batch_sz = GetBucketBound(GetBatchBounds(), problem.batch_sz);
+
+    const auto& spatial = GetSpatialBounds();
+    if(!spatial.empty())
+    {
+        for(auto size : {&ProblemDescription::in_depth,
+                         &ProblemDescription::in_height,
+                         &ProblemDescription::in_width,
+                         &ProblemDescription::out_depth,
+                         &ProblemDescription::out_height,
+                         &ProblemDescription::out_width})
+            representative.*size = GetBucketBound(spatial, problem.*size);
+    }
+    return representative;
+}
+
+void ProblemBucket::Serialize(std::ostream& stream) const
+{
+    representative.Serialize(stream);
+    stream << "_bucket";
+}
+
+namespace {
+
+struct BucketStats
+{
+    std::size_t exact  = 0;
+    std::size_t bucket = 0;
+    std::size_t miss   = 0;
+};
+
+class BucketStatsRegistry
+{
+    public:
+    static BucketStatsRegistry& Get()
+    {
+        static BucketStatsRegistry registry;
+        return registry;
+    }
+
+    void Record(const std::string& key, BucketLookup lookup)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto& item = stats[key];
+        switch(lookup)
+        {
+        case BucketLookup::Exact: ++item.exact; break;
+        case BucketLookup::Bucket: ++item.bucket; break;
+        case BucketLookup::Miss: ++item.miss; break;
+        }
+    }
+
+    void Write(std::ostream& os)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        for(const auto& item : stats)
+        {
+            const auto& s    = item.second;
+            const auto total = s.exact + s.bucket + s.miss;
+            os << item.first << ": " << total << " lookups, " << s.exact << " exact, " << s.bucket
+               << " from bucket, " << s.miss << " missed, hit rate "
+               << (100.0 * (s.exact + s.bucket) / total) << "%\n";
+        }
+    }
+
+    ~BucketStatsRegistry()
+    {
+        if(stats.empty() || !IsLogging(LoggingLevel::Info))
+            return;
+        std::ostringstream ss;
+        Write(ss);
+        MIOPEN_LOG_I("Find-db problem buckets:\n" << ss.str());
+    }
+
+    private:
+    BucketStatsRegistry() = default;
+
+    std::mutex mutex;
+    std::map<std::string, BucketStats> stats;
+};
+
+} // namespace
+
+void RecordBucketLookup(const ProblemDescription& representative, BucketLookup lookup)
+{
+    std::ostringstream ss;
+    representative.Serialize(ss);
+    BucketStatsRegistry::Get().Record(ss.str(), lookup);
+}
+
+void WriteBucketStats(std::ostream& os) { BucketStatsRegistry::Get().Write(os); }
+
+} // namespace miopen
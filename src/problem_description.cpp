@@ -84,6 +84,10 @@ void ProblemDescription::Serialize(std::ostream& stream) const
         // Group count > 1 identifies Group/Depthwise modes.
         if(group_counts != 1)
             optional << 'g' << group_counts;
+        // Weights and output laid out other than the input.
+        const auto wei_layout = weights_layout.empty() ? std::string("NCHW") : weights_layout;
+        if(wei_layout != in_layout || out_layout != in_layout)
+            optional << 'l' << wei_layout << 'x' << out_layout;
     }
     if(!optional.str().empty())
     {
@@ -105,6 +109,11 @@ ProblemDescription::ProblemDescription(const TensorDescriptor& in,
     SetDescFromMLDesc(spatial_dims, *this, in, &ProblemDescription::setInputDescr);
     SetDescFromMLDesc(spatial_dims, *this, weights, &ProblemDescription::setWeightsDescr);
     SetDescFromMLDesc(spatial_dims, *this, out, &ProblemDescription::setOutputDescr);
+
+    // Strides of 1x1 weights fit NCHW and NHWC alike, so take the layout of the input for them.
+    const std::string labels = spatial_dims == 3 ? "NCDHW" : "NCHW";
+    if(weights_layout.empty() && in_layout != "NCHW" && weights.FitsLayout(labels, in_layout))
+        weights_layout = in_layout;
 }
 
 std::tuple<int, int, int> GetDHW(int spatial_dims, const std::vector<int>& data)
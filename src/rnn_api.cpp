@@ -29,6 +29,7 @@
 #include <miopen/handle.hpp>
 #include <miopen/logger.hpp>
 #include <miopen/tensor_ops.hpp>
+#include <miopen/workspace_arena.hpp>
 #include <vector>
 
 extern "C" miopenStatus_t miopenCreateRNNDescriptor(miopenRNNDescriptor_t* rnnDesc)
@@ -673,6 +674,10 @@ extern "C" miopenStatus_t miopenRNNForwardInference(miopenHandle_t handle,
     return miopen::try_([&] {
         miopen::c_array_view<const miopenTensorDescriptor_t> xDescArray{xDesc, size_t(sequenceLen)};
         miopen::c_array_view<const miopenTensorDescriptor_t> yDescArray{yDesc, size_t(sequenceLen)};
+        miopen::UseWorkspaceArena(miopen::deref(handle), workSpace, workSpaceNumBytes, [&] {
+            return miopen::deref(rnnDesc).GetWorkspaceSize(
+                miopen::deref(handle), sequenceLen, xDescArray);
+        });
         miopen::deref(rnnDesc).RNNForwardInference(miopen::deref(handle),
                                                    sequenceLen,
                                                    xDescArray,
@@ -0,0 +1,122 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2019 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/roofline.hpp>
+#include <miopen/handle.hpp>
+#include <miopen/problem_description.hpp>
+#include <miopen/tensor.hpp>
+
+#include <algorithm>
+#include <iomanip>
+
+namespace miopen {
+
+OperationCost GetConvolutionCost(const ProblemDescription& problem)
+{
+    // For backward problems in_* describe y and out_* describe x, see ProblemDescription.
+    const auto is_forward = problem.direction.IsForward();
+    const double in_spatial =
+        static_cast<double>(problem.in_depth) * problem.in_height * problem.in_width;
+    const double out_spatial =
+        static_cast<double>(problem.out_depth) * problem.out_height * problem.out_width;
+    const double kernel_spatial = static_cast<double>(problem.kernel_size_d) *
+                                  problem.kernel_size_h * problem.kernel_size_w;
+    const auto groups     = std::max(problem.group_counts, 1);
+    const auto x_channels = is_forward ? problem.n_inputs : problem.n_outputs;
+    const auto y_channels = is_forward ? problem.n_outputs : problem.n_inputs;
+    const auto y_spatial  = is_forward ? out_spatial : in_spatial;
+
+    const double in_bytes = static_cast<double>(problem.batch_sz) * problem.n_inputs * in_spatial *
+                            GetTypeSize(problem.in_data_type);
+    const double out_bytes = static_cast<double>(problem.batch_sz) * problem.n_outputs *
+                             out_spatial * GetTypeSize(problem.out_data_type);
+    const double weights_bytes = static_cast<double>(y_channels) * (x_channels / groups) *
+                                 kernel_spatial * GetTypeSize(problem.weights_data_type);
+
+    OperationCost cost;
+    cost.flops = 2.0 * problem.batch_sz * y_channels * (x_channels / groups) * kernel_spatial *
+                 y_spatial;
+    if(problem.direction.IsBackwardWrW())
+    {
+        cost.bytes_read    = in_bytes + out_bytes;
+        cost.bytes_written = weights_bytes;
+    }
+    else
+    {
+        cost.bytes_read    = in_bytes + weights_bytes;
+        cost.bytes_written = out_bytes;
+    }
+    return cost;
+}
+
+double GetPeakTflops(std::size_t compute_units, std::size_t clock_mhz, miopenDataType_t type)
+{
+    const auto flops_per_clock = 2.0 * 64 * compute_units;
+    double rate                = 1;
+    switch(type)
+    {
+    case miopenHalf: rate = 2; break;
+    case miopenInt8:
+    case miopenInt8x4: rate = 4; break;
+    case miopenFloat:
+    case miopenBFloat16:
+    case miopenInt32: break;
+    }
+    return flops_per_clock * rate * clock_mhz * 1e-6;
+}
+
+double GetPeakTflops(Handle& handle, miopenDataType_t type)
+{
+    return GetPeakTflops(handle.GetMaxComputeUnits(), handle.GetMaxClockFrequency(), type);
+}
+
+RooflineMetrics GetRooflineMetrics(const OperationCost& cost, float time_ms, double peak_tflops)
+{
+    RooflineMetrics metrics;
+    if(time_ms <= 0)
+        return metrics;
+    metrics.tflops = static_cast<float>(cost.flops / time_ms * 1e-9);
+    metrics.gbps   = static_cast<float>(cost.GetBytes() / time_ms * 1e-6);
+    if(peak_tflops > 0)
+        metrics.peak_percent = static_cast<float>(100 * metrics.tflops / peak_tflops);
+    return metrics;
+}
+
+std::ostream& operator<<(std::ostream& os, const RooflineMetrics& metrics)
+{
+    if(!metrics.IsValid())
+        return os << "<unknown>";
+    const auto flags     = os.flags();
+    const auto precision = os.precision();
+    os << std::fixed << std::setprecision(3) << metrics.tflops << " TFLOP/s, "
+       << std::setprecision(1) << metrics.gbps << " GB/s";
+    if(metrics.peak_percent >= 0)
+        os << ", " << metrics.peak_percent << "% of peak";
+    os.flags(flags);
+    os.precision(precision);
+    return os;
+}
+
+} // namespace miopen
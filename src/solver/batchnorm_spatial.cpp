@@ -0,0 +1,238 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2019 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/batch_norm_solver.hpp>
+#include <miopen/find_primitive_solution.hpp>
+#include <miopen/logger.hpp>
+#include <miopen/tensor.hpp>
+
+#include <algorithm>
+#include <tuple>
+
+namespace miopen {
+
+BatchNormContext::BatchNormContext(bool forward_,
+                                   const TensorDescriptor& xDesc,
+                                   const TensorDescriptor& bnScaleBiasDesc)
+    : forward(forward_), in_data_type(xDesc.GetType()), param_data_type(bnScaleBiasDesc.GetType())
+{
+    std::tie(n, c, h, w) = tien<4>(xDesc.GetLengths());
+}
+
+void BatchNormContext::Serialize(std::ostream& stream) const
+{
+    // The running mean and variance are not a part of the key: they do not affect
+    // the choice of kernels and are not updated while searching.
+    // BN-64-256-14x14-FP32-FP32-1-F
+    stream << "BN-" << n << '-' << c << '-' << h << 'x' << w << '-'
+           << GetDataTypeName(in_data_type) << '-' << GetDataTypeName(param_data_type) << '-'
+           << static_cast<int>(saved_mean_variance) << '-' << (forward ? 'F' : 'B');
+}
+
+namespace solver {
+
+static unsigned int RoundUpToWave(unsigned int x) { return 64 * ((x + 63) / 64); }
+
+// Thresholds for N*H*W and H*W which used to select the variant
+// before batch normalization became tunable. Still used by default.
+static const unsigned int bn_large_nhw = 32 * 1024 * 1024;
+
+static PerformanceConfigBnSpatial GetFwdTrainingEuristic(const BatchNormContext& context)
+{
+    const auto hw  = context.GetHW();
+    const auto nhw = context.GetNHW();
+    if(nhw < bn_large_nhw && hw > 1024)
+        return {1, 1024};
+    if(nhw < bn_large_nhw && hw > 512)
+        return {3, static_cast<int>(RoundUpToWave(hw))};
+    if(hw <= 512)
+        return {0, 1024};
+    return {2, 1024};
+}
+
+static PerformanceConfigBnSpatial GetBwdTrainingEuristic(const BatchNormContext& context)
+{
+    const auto hw      = context.GetHW();
+    const auto nhw     = context.GetNHW();
+    const auto wg_size = static_cast<int>(std::min(RoundUpToWave(hw), 1024U));
+    // N*H*W < 32M and H*W > 1024: work-groups over channels looping through N*H*W.
+    if(nhw < bn_large_nhw && hw > 1024)
+        return {1, 1024};
+    // N*H*W < 32M and H*W > 512: work-groups over channels looping through N.
+    if(nhw < bn_large_nhw && hw > 512)
+        return {context.n >= 32 ? 1 : 3, wg_size};
+    // H*W <= 512: depends on batch size and H*W.
+    if(hw <= 512)
+        return (context.n > 64 && hw > 160) ? PerformanceConfigBnSpatial{3, wg_size}
+                                            : PerformanceConfigBnSpatial{0, 1024};
+    // N*H*W >= 32M: work-groups over channels and image segments.
+    return {2, 1024};
+}
+
+// The default is always the launch config used before batch normalization became tunable,
+// even where IsValid() would not accept it for a search or a Perf Db entry.
+void PerformanceConfigBnSpatial::EuristicInit(const BatchNormContext& context)
+{
+    *this = context.forward ? GetFwdTrainingEuristic(context) : GetBwdTrainingEuristic(context);
+}
+
+bool PerformanceConfigBnSpatial::SetNextValue()
+{
+    // Increment with wrap-around:
+    do
+    {
+        if((wg_size += 64) <= 1024) // [64..1024], step 64
+            break;
+        wg_size = 64;
+        if(++variant <= 3) // [0..3]
+            break;
+        // All the fields (components) of performance confic have wrapped around.
+        return false;
+    } while(false);
+    return true;
+}
+
+bool PerformanceConfigBnSpatial::operator==(const PerformanceConfigBnSpatial& other) const
+{
+    return variant == other.variant && wg_size == other.wg_size;
+}
+
+bool PerformanceConfigBnSpatial::IsValidValue() const
+{
+    // clang-format off
+    return (0 <= variant && variant <= 3)
+        && (64 <= wg_size && wg_size <= 1024 && wg_size % 64 == 0); // clang-format on
+}
+
+bool PerformanceConfigBnSpatial::IsValid(const BatchNormContext& context) const
+{
+    if(!IsValidValue())
+        return false;
+
+    const auto hw = context.GetHW();
+    const auto wg = static_cast<unsigned int>(wg_size);
+    const bool pow2 = wg >= 256 && (wg & (wg - 1)) == 0;
+    // Work-groups that are not a power of 2 are reduced correctly by gcn_reduce2() only.
+    const bool reducible = pow2 || context.gcn_reduce;
+
+    switch(variant)
+    {
+    // Whole images per work-group, the minibatch of a channel is kept in registers.
+    case 0: return pow2 && hw <= wg;
+    // Loops through N*H*W. The backward heuristic also uses work-groups fitting an image.
+    case 1: return pow2 || (reducible && wg == std::min(RoundUpToWave(hw), 1024U));
+    // Partial sums of each segment are stashed into the image of the channel,
+    // so the last segment shall have room for them.
+    case 2: return pow2 && wg * ((hw + wg - 1) / wg - 1) + 4 <= hw;
+    // A work-item per pixel looping through N, images larger than a wave.
+    case 3: return reducible && hw > 64 && wg == RoundUpToWave(hw);
+    default: return false;
+    }
+}
+
+static BnSpatialSolution GetBnSpatialSolution(const BatchNormContext& context,
+                                              const PerformanceConfigBnSpatial& config)
+{
+    const size_t wg_size = config.wg_size;
+    BnSpatialSolution solution;
+    solution.variant = config.variant;
+    if(config.variant == 2)
+    {
+        solution.single     = false;
+        solution.ylocalsize = wg_size;
+        solution.xgridsize  = context.c;
+        solution.ygridsize  = ((context.GetHW() + wg_size - 1) / wg_size) * wg_size;
+    }
+    else
+    {
+        solution.xlocalsize = wg_size;
+        solution.xgridsize  = context.c * wg_size;
+    }
+    solution.ldsgcn   = wg_size / 64;
+    solution.ldsnogcn = wg_size;
+    return solution;
+}
+
+PerformanceConfigBnSpatial
+BnFwdTrainingSpatial::GetPerformanceConfig(const BatchNormContext& context) const
+{
+    PerformanceConfigBnSpatial pp;
+    pp.EuristicInit(context);
+    MIOPEN_LOG_I(pp);
+    return pp;
+}
+
+bool BnFwdTrainingSpatial::IsValidPerformanceConfig(const BatchNormContext& context,
+                                                    const PerformanceConfigBnSpatial& config) const
+{
+    return config.IsValidValue() && config.IsValid(context);
+}
+
+PerformanceConfigBnSpatial BnFwdTrainingSpatial::Search(const BatchNormContext& context) const
+{
+    return SearchPrimitive(*this, context);
+}
+
+BnSpatialSolution BnFwdTrainingSpatial::GetSolution(const BatchNormContext& context,
+                                                    const PerformanceConfigBnSpatial& config) const
+{
+    return GetBnSpatialSolution(context, config);
+}
+
+PerformanceConfigBnSpatial
+BnBwdTrainingSpatial::GetPerformanceConfig(const BatchNormContext& context) const
+{
+    PerformanceConfigBnSpatial pp;
+    pp.EuristicInit(context);
+    MIOPEN_LOG_I(pp);
+    return pp;
+}
+
+bool BnBwdTrainingSpatial::IsValidPerformanceConfig(const BatchNormContext& context,
+                                                    const PerformanceConfigBnSpatial& config) const
+{
+    return config.IsValidValue() && config.IsValid(context);
+}
+
+PerformanceConfigBnSpatial BnBwdTrainingSpatial::Search(const BatchNormContext& context) const
+{
+    return SearchPrimitive(*this, context);
+}
+
+BnSpatialSolution BnBwdTrainingSpatial::GetSolution(const BatchNormContext& context,
+                                                    const PerformanceConfigBnSpatial& config) const
+{
+    return GetBnSpatialSolution(context, config);
+}
+
+BnSpatialSolution FindBnSpatialSolution(const BatchNormContext& context)
+{
+    return FindPrimitiveSolution<BnSpatialSolution>(
+        context, BnFwdTrainingSpatial{}, BnBwdTrainingSpatial{});
+}
+
+} // namespace solver
+} // namespace miopen
@@ -370,6 +370,8 @@ bool ConvAsm1x1U::IsValidPerformanceConfig(const ConvolutionContext& problem,
 
 bool ConvAsm1x1U::IsApplicable(const ConvolutionContext& params) const
 {
+    if(!params.IsLayoutDefault())
+        return false;
     if(!params.use_asm_kernels)
         return false;
     if(!params.Is2d())
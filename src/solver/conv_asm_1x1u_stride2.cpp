@@ -468,6 +468,8 @@ bool ConvAsm1x1UV2::IsValidPerformanceConfig(const ConvolutionContext& problem,
 
 bool ConvAsm1x1UV2::IsApplicable(const ConvolutionContext& params) const
 {
+    if(!params.IsLayoutDefault())
+        return false;
     if(!params.use_asm_kernels)
         return false;
     if(!params.Is2d())
@@ -177,6 +177,8 @@ bool ConvAsm3x3U::IsValidPerformanceConfig(const ConvolutionContext& problem,
 
 bool ConvAsm3x3U::IsApplicable(const ConvolutionContext& params) const
 {
+    if(!params.IsLayoutDefault())
+        return false;
     if(!params.use_asm_kernels)
         return false;
     if(!params.Is2d())
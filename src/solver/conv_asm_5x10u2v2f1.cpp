@@ -33,6 +33,8 @@ namespace solver {
 
 bool ConvAsm5x10u2v2f1::IsApplicable(const ConvolutionContext& params) const
 {
+    if(!params.IsLayoutDefault())
+        return false;
     if(!params.use_asm_kernels)
         return false;
     if(!params.Is2d())
@@ -35,6 +35,8 @@ namespace solver {
 
 bool ConvBinWinograd3x3U::IsApplicable(const ConvolutionContext& params) const
 {
+    if(!params.IsLayoutDefault())
+        return false;
     if(miopen::IsDisabled(MIOPEN_DEBUG_AMD_WINOGRAD_3X3{}))
         return false;
     if(!params.Is2d())
@@ -34,6 +34,8 @@ namespace solver {
 
 bool ConvHipImplicitGemmV4Fwd::IsApplicable(const ConvolutionContext& ctx) const
 {
+    if(!ctx.IsLayoutDefault())
+        return false;
     // disable IsFp16 due to NaN (issue #2071);
     ///\todo: 1) Fixed NaN issue in Fp16, 2) enable Fp16 and 3) add Fp16 tests
     bool isTypeSupported = ctx.IsFp32();
@@ -342,6 +342,8 @@ template <int WinoDataW, int WinoFilterW>
 bool ConvWinograd3x3MultipassWrW<WinoDataW, WinoFilterW>::IsApplicable(
     const ConvolutionContext& params) const
 {
+    if(!params.IsLayoutDefault())
+        return false;
 // HIP backend required for sending ptr (buffer + offset)
 // ROCBLAS for GEMM step
 
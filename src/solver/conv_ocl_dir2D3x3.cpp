@@ -32,6 +32,8 @@ namespace solver {
 
 bool ConvOclDirectFwd3x3::IsApplicable(const ConvolutionContext& params) const
 {
+    if(!params.IsLayoutDefault())
+        return false;
     if(!params.Is2d())
         return false;
     if(!(params.IsFp32() || params.IsFp16() || params.IsBfp16()))
@@ -138,6 +138,8 @@ static bool IsTunable(const ConvolutionContext& params)
 
 bool ConvOclBwdWrW2NonTunable::IsApplicable(const ConvolutionContext& params) const
 {
+    if(!params.IsLayoutDefault())
+        return false;
     // At present, auto-tuning is disabled for non-group 3x3 and 1x1 filters for multiple
     // reasons: after tuning ocl kernel for 3x3 and 1x1 filters, assembly kernel still
     // dominates. Thus, this solver is used for non-group 3x3 and 1x1 filters only.
@@ -503,6 +505,8 @@ bool ConvOclBwdWrW2<N_BATCH_LOOPS>::IsApplicableBase(const ConvolutionContext& p
 template <int N_BATCH_LOOPS>
 bool ConvOclBwdWrW2<N_BATCH_LOOPS>::IsApplicable(const ConvolutionContext& params) const
 {
+    if(!params.IsLayoutDefault())
+        return false;
     return IsApplicableBase(params) && IsTunable(params);
 }
 
@@ -532,6 +536,17 @@ size_t ConvOclBwdWrW2<N_BATCH_LOOPS>::GetWorkspaceSize(const ConvolutionContext&
         return 0;
 }
 
+template <int N_BATCH_LOOPS>
+OperationCost ConvOclBwdWrW2<N_BATCH_LOOPS>::GetCost(const ConvolutionContext& params) const
+{
+    // Partial sums of the weights are written to the workspace and read back by the reduction.
+    auto cost            = GetConvolutionCost(params);
+    const auto workspace = GetWorkspaceSize(params);
+    cost.bytes_read += workspace;
+    cost.bytes_written += workspace;
+    return cost;
+}
+
 template <int N_BATCH_LOOPS>
 ConvSolution ConvOclBwdWrW2<N_BATCH_LOOPS>::GetSolution(
     const ConvolutionContext& params,
@@ -38,6 +38,8 @@ static bool WorkaroundSwdev168168() { return true; }
 
 bool ConvOclBwdWrW53::IsApplicable(const ConvolutionContext& params) const
 {
+    if(!params.IsLayoutDefault())
+        return false;
     if(!params.Is2d())
         return false;
     if(!(params.IsFp32() || params.IsFp16() || params.IsBfp16()))
@@ -297,6 +299,16 @@ size_t ConvOclBwdWrW53::GetWorkspaceSize(const ConvolutionContext& params) const
         return 0;
 }
 
+OperationCost ConvOclBwdWrW53::GetCost(const ConvolutionContext& params) const
+{
+    // Partial sums of the weights are written to the workspace and read back by the reduction.
+    auto cost            = GetConvolutionCost(params);
+    const auto workspace = GetWorkspaceSize(params);
+    cost.bytes_read += workspace;
+    cost.bytes_written += workspace;
+    return cost;
+}
+
 ConvSolution ConvOclBwdWrW53::GetSolution(const ConvolutionContext& params) const
 {
     ConvSolution result;
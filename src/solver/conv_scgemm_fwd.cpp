@@ -128,6 +128,8 @@ bool ConvSCGemmFwd<T>::IsValidPerformanceConfig(const ConvolutionContext& proble
 template <SCGemmOpType T>
 bool ConvSCGemmFwd<T>::IsApplicable(const ConvolutionContext& params) const
 {
+    if(!params.IsLayoutDefault())
+        return false;
     if(!params.use_binaries)
     {
         // for debugging purpose.
@@ -200,6 +200,8 @@ namespace solver {
 
 bool ConvBinWinogradRxSf3x2::IsApplicable(const ConvolutionContext& params) const
 {
+    if(!params.IsLayoutDefault())
+        return false;
     if(!params.Is2d())
         return false;
     if(!params.IsFp32())
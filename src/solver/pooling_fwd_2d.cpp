@@ -0,0 +1,146 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2019 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/pooling_solver.hpp>
+#include <miopen/find_primitive_solution.hpp>
+#include <miopen/logger.hpp>
+#include <miopen/tensor.hpp>
+
+#include <algorithm>
+#include <tuple>
+
+namespace miopen {
+
+PoolingContext::PoolingContext(const TensorDescriptor& xDesc, const TensorDescriptor& yDesc)
+    : data_type(xDesc.GetType())
+{
+    std::tie(n, c, in_h, in_w)                       = tien<4>(xDesc.GetLengths());
+    std::tie(std::ignore, std::ignore, out_h, out_w) = tien<4>(yDesc.GetLengths());
+}
+
+void PoolingContext::Serialize(std::ostream& stream) const
+{
+    // The output size is defined by the rest.
+    // PL-64-64-112x112-3x3-1x1-2x2-1-0-FP32-F
+    stream << "PL-" << n << '-' << c << '-' << in_h << 'x' << in_w << '-' << win_h << 'x' << win_w
+           << '-' << pad_h << 'x' << pad_w << '-' << stride_h << 'x' << stride_w << '-'
+           << pooling_method << '-' << static_cast<int>(save_index) << '-'
+           << GetDataTypeName(data_type) << "-F";
+}
+
+namespace solver {
+
+// Work-groups are 8x8, see mlo_construct_pooling2D::mloConstructFwd().
+static const int pooling_grp_tile = 8;
+
+// Same as the default of mlo_construct_pooling2D::mloConstructFwd().
+static int GetPoolingOutPixTile(int stride, int out_size)
+{
+    int tile = std::max(1, 8 / stride);
+    while(tile * pooling_grp_tile > out_size * 2 && tile > 1)
+        tile >>= 1;
+    return tile;
+}
+
+void PerformanceConfigPoolingFwd::EuristicInit(const PoolingContext& context)
+{
+    out_pix_tile0 = GetPoolingOutPixTile(context.stride_w, context.out_w);
+    out_pix_tile1 = GetPoolingOutPixTile(context.stride_h, context.out_h);
+}
+
+bool PerformanceConfigPoolingFwd::SetNextValue()
+{
+    // Increment with wrap-around:
+    do
+    {
+        if((out_pix_tile0 *= 2) <= 8)
+            break;
+        out_pix_tile0 = 1;
+        if((out_pix_tile1 *= 2) <= 8)
+            break;
+        out_pix_tile1 = 1;
+        return false;
+    } while(false);
+    return true;
+}
+
+bool PerformanceConfigPoolingFwd::operator==(const PerformanceConfigPoolingFwd& other) const
+{
+    return out_pix_tile0 == other.out_pix_tile0 && out_pix_tile1 == other.out_pix_tile1;
+}
+
+static bool IsValidOutPixTile(int tile) { return tile == 1 || tile == 2 || tile == 4 || tile == 8; }
+
+bool PerformanceConfigPoolingFwd::IsValidValue() const
+{
+    return IsValidOutPixTile(out_pix_tile0) && IsValidOutPixTile(out_pix_tile1);
+}
+
+bool PerformanceConfigPoolingFwd::IsValid(const PoolingContext& context) const
+{
+    if(!IsValidValue())
+        return false;
+    // Work-groups mostly out of the image are a waste.
+    // clang-format off
+    return (out_pix_tile0 == 1 || out_pix_tile0 * pooling_grp_tile <= context.out_w * 2)
+        && (out_pix_tile1 == 1 || out_pix_tile1 * pooling_grp_tile <= context.out_h * 2);
+    // clang-format on
+}
+
+PerformanceConfigPoolingFwd PoolingFwd2d::GetPerformanceConfig(const PoolingContext& context) const
+{
+    PerformanceConfigPoolingFwd pp;
+    pp.EuristicInit(context);
+    MIOPEN_LOG_I(pp);
+    return pp;
+}
+
+bool PoolingFwd2d::IsValidPerformanceConfig(const PoolingContext& context,
+                                            const PerformanceConfigPoolingFwd& config) const
+{
+    return config.IsValidValue() && config.IsValid(context);
+}
+
+PerformanceConfigPoolingFwd PoolingFwd2d::Search(const PoolingContext& context) const
+{
+    return SearchPrimitive(*this, context);
+}
+
+PoolingFwdSolution PoolingFwd2d::GetSolution(const PoolingContext&,
+                                             const PerformanceConfigPoolingFwd& config) const
+{
+    PoolingFwdSolution solution;
+    solution.out_pix_tile0 = config.out_pix_tile0;
+    solution.out_pix_tile1 = config.out_pix_tile1;
+    return solution;
+}
+
+PoolingFwdSolution FindPoolingFwdSolution(const PoolingContext& context)
+{
+    return FindPrimitiveSolution<PoolingFwdSolution>(context, PoolingFwd2d{});
+}
+
+} // namespace solver
+} // namespace miopen
@@ -0,0 +1,212 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2019 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/softmax_solver.hpp>
+#include <miopen/find_primitive_solution.hpp>
+#include <miopen/logger.hpp>
+#include <miopen/tensor.hpp>
+
+#include <algorithm>
+#include <tuple>
+
+namespace miopen {
+
+SoftmaxContext::SoftmaxContext(bool forward_,
+                               const TensorDescriptor& desc,
+                               miopenSoftmaxAlgorithm_t algorithm_,
+                               miopenSoftmaxMode_t mode_)
+    : forward(forward_), data_type(desc.GetType()), algorithm(algorithm_), mode(mode_)
+{
+    std::tie(n, c, h, w) = tien<4>(desc.GetLengths());
+}
+
+static const char* GetSoftmaxAlgorithmName(miopenSoftmaxAlgorithm_t algorithm)
+{
+    switch(algorithm)
+    {
+    case MIOPEN_SOFTMAX_FAST: return "FAST";
+    case MIOPEN_SOFTMAX_ACCURATE: return "ACCURATE";
+    case MIOPEN_SOFTMAX_LOG: return "LOG";
+    }
+    return "Unknown";
+}
+
+void SoftmaxContext::Serialize(std::ostream& stream) const
+{
+    // The strides, alpha and beta only affect the addressing and the final scaling,
+    // they are not a part of the key.
+    // SM-128-1000-1x1-FP32-ACCURATE-INSTANCE-F
+    stream << "SM-" << n << '-' << c << '-' << h << 'x' << w << '-' << GetDataTypeName(data_type)
+           << '-' << GetSoftmaxAlgorithmName(algorithm) << '-'
+           << (mode == MIOPEN_SOFTMAX_MODE_INSTANCE ? "INSTANCE" : "CHANNEL") << '-'
+           << (forward ? 'F' : 'B');
+}
+
+namespace solver {
+
+static const int softmax_wg_size = 256;
+
+// Caps the number of values each work-item of CSR-Stream keeps in registers (or in LDS for fp16).
+static const int softmax_max_u_batch_size = 16;
+
+// Limits the number of work-groups of CSR-Vector, which loops through the vectors,
+// to avoid scheduling overheads.
+static const int softmax_max_workgroups = 64 * 40 * 8;
+
+// Returns 2 for 1, the default config relies on that.
+static int nextPow2(int v)
+{
+    if(v == 1)
+    {
+        return (v << 1);
+    }
+    else
+    {
+        v--;
+        v |= v >> 1;
+        v |= v >> 2;
+        v |= v >> 4;
+        v |= v >> 8;
+        v |= v >> 16;
+        v++;
+        return v;
+    }
+}
+
+static int GetUBatchSize(const SoftmaxContext& context, int batch_size)
+{
+    const auto vector_size = context.GetVectorSize();
+    return vector_size > batch_size ? nextPow2((vector_size + batch_size - 1) / batch_size) : 1;
+}
+
+void PerformanceConfigSoftmax::EuristicInit(const SoftmaxContext& context)
+{
+    const auto vector_size = context.GetVectorSize();
+    num_batch = vector_size < softmax_wg_size ? nextPow2(softmax_wg_size / vector_size) : 1;
+}
+
+bool PerformanceConfigSoftmax::SetNextValue()
+{
+    if((num_batch *= 2) <= softmax_wg_size) // [1..256], powers of 2
+        return true;
+    num_batch = 1;
+    return false;
+}
+
+bool PerformanceConfigSoftmax::operator==(const PerformanceConfigSoftmax& other) const
+{
+    return num_batch == other.num_batch;
+}
+
+bool PerformanceConfigSoftmax::IsValidValue() const
+{
+    return 1 <= num_batch && num_batch <= softmax_wg_size && (num_batch & (num_batch - 1)) == 0;
+}
+
+bool PerformanceConfigSoftmax::IsValid(const SoftmaxContext& context) const
+{
+    if(!IsValidValue())
+        return false;
+    if(num_batch == 1)
+        return true;
+    return GetUBatchSize(context, softmax_wg_size / num_batch) <= softmax_max_u_batch_size;
+}
+
+static SoftmaxSolution GetSoftmaxSolution(const SoftmaxContext& context,
+                                          const PerformanceConfigSoftmax& config)
+{
+    const size_t grid_size = context.GetGridSize();
+    SoftmaxSolution solution;
+    solution.num_batch = config.num_batch;
+    if(config.num_batch == 1)
+    {
+        solution.workgroups = std::min<size_t>(grid_size, softmax_max_workgroups);
+    }
+    else
+    {
+        solution.batch_size   = softmax_wg_size / config.num_batch;
+        solution.u_batch_size = GetUBatchSize(context, solution.batch_size);
+        solution.workgroups   = (grid_size + config.num_batch - 1) / config.num_batch;
+    }
+    return solution;
+}
+
+PerformanceConfigSoftmax SoftmaxFwd::GetPerformanceConfig(const SoftmaxContext& context) const
+{
+    PerformanceConfigSoftmax pp;
+    pp.EuristicInit(context);
+    MIOPEN_LOG_I(pp);
+    return pp;
+}
+
+bool SoftmaxFwd::IsValidPerformanceConfig(const SoftmaxContext& context,
+                                          const PerformanceConfigSoftmax& config) const
+{
+    return config.IsValidValue() && config.IsValid(context);
+}
+
+PerformanceConfigSoftmax SoftmaxFwd::Search(const SoftmaxContext& context) const
+{
+    return SearchPrimitive(*this, context);
+}
+
+SoftmaxSolution SoftmaxFwd::GetSolution(const SoftmaxContext& context,
+                                        const PerformanceConfigSoftmax& config) const
+{
+    return GetSoftmaxSolution(context, config);
+}
+
+PerformanceConfigSoftmax SoftmaxBwd::GetPerformanceConfig(const SoftmaxContext& context) const
+{
+    PerformanceConfigSoftmax pp;
+    pp.EuristicInit(context);
+    MIOPEN_LOG_I(pp);
+    return pp;
+}
+
+bool SoftmaxBwd::IsValidPerformanceConfig(const SoftmaxContext& context,
+                                          const PerformanceConfigSoftmax& config) const
+{
+    return config.IsValidValue() && config.IsValid(context);
+}
+
+PerformanceConfigSoftmax SoftmaxBwd::Search(const SoftmaxContext& context) const
+{
+    return SearchPrimitive(*this, context);
+}
+
+SoftmaxSolution SoftmaxBwd::GetSolution(const SoftmaxContext& context,
+                                        const PerformanceConfigSoftmax& config) const
+{
+    return GetSoftmaxSolution(context, config);
+}
+
+SoftmaxSolution FindSoftmaxSolution(const SoftmaxContext& context)
+{
+    return FindPrimitiveSolution<SoftmaxSolution>(context, SoftmaxFwd{}, SoftmaxBwd{});
+}
+
+} // namespace solver
+} // namespace miopen
@@ -0,0 +1,214 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2019 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/solver_policy.hpp>
+#include <miopen/env.hpp>
+#include <miopen/errors.hpp>
+#include <miopen/logger.hpp>
+
+#include <algorithm>
+#include <fstream>
+#include <mutex>
+#include <sstream>
+#include <unordered_map>
+
+namespace miopen {
+
+/// Path to the solver policy file, see SolverPolicyFile.
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_SOLVER_POLICY_FILE)
+
+bool SolverPolicy::IsAllowed(const std::string& solver) const
+{
+    if(!pinned.empty() && std::find(pinned.begin(), pinned.end(), solver) == pinned.end())
+        return false;
+    return std::find(disabled.begin(), disabled.end(), solver) == disabled.end();
+}
+
+const std::string* SolverPolicy::FindConfig(const std::string& solver) const
+{
+    const auto it = configs.find(solver);
+    return it != configs.end() ? &it->second : nullptr;
+}
+
+bool SolverPolicy::IsEmpty() const
+{
+    return pinned.empty() && disabled.empty() && configs.empty() &&
+           workspace_limit == std::numeric_limits<std::size_t>::max();
+}
+
+bool MatchKeyPattern(const std::string& pattern, const std::string& text)
+{
+    // Greedy matching with backtracking to the last '*'.
+    std::size_t p = 0, t = 0;
+    std::size_t star = std::string::npos, star_t = 0;
+    while(t < text.size())
+    {
+        if(p < pattern.size() && (pattern[p] == '?' || pattern[p] == text[t]))
+        {
+            ++p;
+            ++t;
+        }
+        else if(p < pattern.size() && pattern[p] == '*')
+        {
+            star   = p++;
+            star_t = t;
+        }
+        else if(star != std::string::npos)
+        {
+            p = star + 1;
+            t = ++star_t;
+        }
+        else
+        {
+            return false;
+        }
+    }
+    while(p < pattern.size() && pattern[p] == '*')
+        ++p;
+    return p == pattern.size();
+}
+
+static bool ParseWorkspaceLimit(const std::string& text, std::size_t& limit)
+{
+    if(text.empty() || text.find_first_not_of("0123456789") != std::string::npos)
+        return false;
+    limit = 0;
+    for(const auto c : text)
+    {
+        const auto digit = static_cast<std::size_t>(c - '0');
+        if(limit > (std::numeric_limits<std::size_t>::max() - digit) / 10)
+            return false;
+        limit = limit * 10 + digit;
+    }
+    return true;
+}
+
+static bool IsValidRule(const std::string& action, const std::vector<std::string>& args)
+{
+    if(action == "solver" || action == "disable" || action == "workspace")
+        return args.size() == 1;
+    if(action == "config")
+        return args.size() == 2;
+    return false;
+}
+
+SolverPolicyFile::SolverPolicyFile(std::istream& stream, const std::string& source)
+{
+    std::string line;
+    auto n_line = 0;
+    while(std::getline(stream, line))
+    {
+        ++n_line;
+        std::istringstream ss(line);
+        Rule rule;
+        if(!(ss >> rule.pattern) || rule.pattern[0] == '#')
+            continue;
+        ss >> rule.action;
+        for(std::string arg; ss >> arg;)
+            rule.args.push_back(arg);
+
+        if(!IsValidRule(rule.action, rule.args) ||
+           (rule.action == "workspace" && !ParseWorkspaceLimit(rule.args[0], rule.workspace_limit)))
+        {
+            MIOPEN_LOG_E("Invalid solver policy rule at " << source << ':' << n_line << ": "
+                                                          << line);
+            continue;
+        }
+        rules.push_back(std::move(rule));
+    }
+}
+
+SolverPolicy SolverPolicyFile::Match(const std::string& key) const
+{
+    SolverPolicy policy;
+    auto has_workspace_limit = false;
+
+    for(const auto& rule : rules)
+    {
+        if(!MatchKeyPattern(rule.pattern, key))
+            continue;
+
+        if(rule.action == "solver")
+        {
+            policy.pinned.push_back(rule.args[0]);
+        }
+        else if(rule.action == "disable")
+        {
+            policy.disabled.push_back(rule.args[0]);
+        }
+        else if(rule.action == "config")
+        {
+            policy.configs.emplace(rule.args[0], rule.args[1]);
+        }
+        else if(rule.action == "workspace" && !has_workspace_limit)
+        {
+            policy.workspace_limit = rule.workspace_limit;
+            has_workspace_limit    = true;
+        }
+    }
+    return policy;
+}
+
+static const SolverPolicyFile& GetSolverPolicyFile()
+{
+    static const SolverPolicyFile file = [] {
+        const auto path = miopen::GetStringEnv(MIOPEN_SOLVER_POLICY_FILE{});
+        if(path == nullptr)
+            return SolverPolicyFile{};
+        std::ifstream stream(path);
+        if(!stream)
+        {
+            MIOPEN_LOG_E("Unable to read solver policy file: " << path);
+            return SolverPolicyFile{};
+        }
+        MIOPEN_LOG_I("Solver policy file: " << path);
+        return SolverPolicyFile{stream, path};
+    }();
+    return file;
+}
+
+bool HasSolverPolicy() { return !GetSolverPolicyFile().IsEmpty(); }
+
+const SolverPolicy& GetSolverPolicy(const std::string& key)
+{
+    static const SolverPolicy empty;
+    const auto& file = GetSolverPolicyFile();
+    if(file.IsEmpty())
+        return empty;
+
+    static std::mutex mutex;
+    // References to the elements stay valid when the map grows.
+    static std::unordered_map<std::string, SolverPolicy> cache;
+    std::lock_guard<std::mutex> lock(mutex);
+    const auto it = cache.find(key);
+    if(it != cache.end())
+        return it->second;
+    auto policy = file.Match(key);
+    if(!policy.IsEmpty())
+        MIOPEN_LOG_I2("Solver policy applies to " << key);
+    return cache.emplace(key, std::move(policy)).first->second;
+}
+
+} // namespace miopen
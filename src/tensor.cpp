@@ -139,6 +139,66 @@ std::size_t TensorDescriptor::GetNumBytes() const
 
 bool TensorDescriptor::IsPacked() const { return this->packed; }
 
+std::string TensorDescriptor::GetLayout(std::string labels) const
+{
+    if(labels.size() != lens.size())
+        MIOPEN_THROW(miopenStatusBadParm, "Layout labels do not match the tensor: " + labels);
+
+    if(FitsLayout(labels, labels))
+        return labels;
+
+    auto channels_last = labels;
+    const auto c       = channels_last.find('C');
+    if(c != std::string::npos)
+    {
+        channels_last.erase(c, 1);
+        channels_last.push_back('C');
+        if(FitsLayout(labels, channels_last))
+            return channels_last;
+    }
+
+    // Overlapping or otherwise unusual strides.
+    std::vector<std::size_t> order(lens.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&](auto x, auto y) {
+        return strides[x] > strides[y];
+    });
+    std::string layout;
+    for(const auto i : order)
+        layout.push_back(labels[i]);
+    return layout;
+}
+
+bool TensorDescriptor::FitsLayout(const std::string& labels, const std::string& layout) const
+{
+    if(labels.size() != lens.size() || layout.size() != lens.size())
+        return false;
+
+    std::size_t inner = 0;
+    for(auto it = layout.rbegin(); it != layout.rend(); ++it)
+    {
+        const auto i = labels.find(*it);
+        if(i == std::string::npos)
+            return false;
+        if(lens[i] == 1)
+            continue;
+        if(strides[i] < inner)
+            return false;
+        inner = strides[i] * lens[i];
+    }
+    return true;
+}
+
+bool TensorDescriptor::IsDefaultLayout() const
+{
+    switch(lens.size())
+    {
+    case 4: return FitsLayout("NCHW", "NCHW");
+    case 5: return FitsLayout("NCDHW", "NCDHW");
+    default: return true;
+    }
+}
+
 bool TensorDescriptor::operator==(const TensorDescriptor& rhs) const
 {
     assert(this->lens.size() == rhs.strides.size());
@@ -0,0 +1,222 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2019 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/trace.hpp>
+#include <miopen/env.hpp>
+#include <miopen/logger.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#ifdef __linux__
+#include <unistd.h>
+#endif
+
+namespace miopen {
+
+/// Enables tracing. Spans are written into the given file
+/// in the Chrome trace JSON format at process exit.
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_TRACE_FILE)
+
+/// Capacity of the per-thread ring buffer of spans, 65536 by default.
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_TRACE_BUFFER_SIZE)
+
+namespace {
+
+struct TraceEvent
+{
+    const char* category = nullptr;
+    std::string name;
+    std::uint64_t start = 0;
+    std::uint64_t end   = 0;
+};
+
+struct ThreadTraceBuffer
+{
+    ThreadTraceBuffer(std::size_t tid_, std::size_t capacity) : tid(tid_), events(capacity) {}
+
+    const std::size_t tid;
+    /// Uncontended except while the trace is being written.
+    std::mutex mutex;
+    std::vector<TraceEvent> events;
+    std::size_t recorded = 0;
+};
+
+inline int GetProcessId()
+{
+#ifdef __linux__
+    return getpid();
+#else
+    return 0; // Not implemented.
+#endif
+}
+
+void WriteJsonString(std::ostream& os, const std::string& s)
+{
+    os << '"';
+    for(const auto c : s)
+    {
+        switch(c)
+        {
+        case '"': os << "\\\""; break;
+        case '\\': os << "\\\\"; break;
+        case '\n': os << "\\n"; break;
+        case '\t': os << "\\t"; break;
+        default:
+            if(static_cast<unsigned char>(c) < 0x20)
+            {
+                char buf[8];
+                std::snprintf(buf, sizeof(buf), "\\u%04x", static_cast<unsigned int>(c));
+                os << buf;
+            }
+            else
+            {
+                os << c;
+            }
+        }
+    }
+    os << '"';
+}
+
+class TraceRegistry
+{
+    public:
+    static TraceRegistry& Get()
+    {
+        static TraceRegistry registry;
+        return registry;
+    }
+
+    std::shared_ptr<ThreadTraceBuffer> Register()
+    {
+        const auto size = miopen::Value(MIOPEN_TRACE_BUFFER_SIZE{});
+        std::lock_guard<std::mutex> lock(mutex);
+        buffers.push_back(
+            std::make_shared<ThreadTraceBuffer>(buffers.size(), size != 0 ? size : 65536));
+        return buffers.back();
+    }
+
+    void Write(std::ostream& os)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        const auto pid      = GetProcessId();
+        std::size_t dropped = 0;
+        bool first          = true;
+
+        os << "{\"traceEvents\":[";
+        for(const auto& buffer : buffers)
+        {
+            std::lock_guard<std::mutex> buffer_lock(buffer->mutex);
+            const auto capacity = buffer->events.size();
+            const auto count    = std::min(buffer->recorded, capacity);
+            dropped += buffer->recorded - count;
+
+            // Oldest first.
+            for(std::size_t i = buffer->recorded - count; i < buffer->recorded; ++i)
+            {
+                const auto& event = buffer->events[i % capacity];
+                os << (first ? "\n" : ",\n");
+                first = false;
+                os << "{\"name\":";
+                WriteJsonString(os, event.name);
+                os << ",\"cat\":\"" << event.category << "\",\"ph\":\"X\"" << std::fixed
+                   << std::setprecision(3) << ",\"ts\":" << event.start * 1e-3
+                   << ",\"dur\":" << (event.end - event.start) * 1e-3 << ",\"pid\":" << pid
+                   << ",\"tid\":" << buffer->tid << "}";
+            }
+        }
+        os << "\n],\"displayTimeUnit\":\"ms\",\"otherData\":{\"dropped_spans\":" << dropped
+           << "}}\n";
+    }
+
+    ~TraceRegistry()
+    {
+        const auto path = miopen::GetStringEnv(MIOPEN_TRACE_FILE{});
+        if(path == nullptr)
+            return;
+        std::ofstream file(path);
+        if(!file)
+        {
+            MIOPEN_LOG_E("Unable to write trace file: " << path);
+            return;
+        }
+        Write(file);
+    }
+
+    private:
+    TraceRegistry() = default;
+
+    std::mutex mutex;
+    std::vector<std::shared_ptr<ThreadTraceBuffer>> buffers;
+};
+
+ThreadTraceBuffer& GetThreadTraceBuffer()
+{
+    thread_local const auto buffer = TraceRegistry::Get().Register();
+    return *buffer;
+}
+
+} // namespace
+
+bool IsTracing()
+{
+    static const bool result = [] {
+        const bool enabled = miopen::GetStringEnv(MIOPEN_TRACE_FILE{}) != nullptr;
+        // Construct the registry early so the trace file is written at exit even if empty.
+        if(enabled)
+            TraceRegistry::Get();
+        return enabled;
+    }();
+    return result;
+}
+
+std::uint64_t TraceNow()
+{
+    static const auto epoch = std::chrono::steady_clock::now();
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() -
+                                                                epoch)
+        .count();
+}
+
+void TraceSpan(const char* category, std::string name, std::uint64_t start, std::uint64_t end)
+{
+    auto& buffer = GetThreadTraceBuffer();
+    std::lock_guard<std::mutex> lock(buffer.mutex);
+    auto& event    = buffer.events[buffer.recorded++ % buffer.events.size()];
+    event.category = category;
+    event.name     = std::move(name);
+    event.start    = start;
+    event.end      = end;
+}
+
+void WriteTrace(std::ostream& os) { TraceRegistry::Get().Write(os); }
+
+} // namespace miopen
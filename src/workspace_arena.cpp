@@ -0,0 +1,67 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2019 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/workspace_arena.hpp>
+#include <miopen/handle.hpp>
+#include <miopen/logger.hpp>
+
+#include <algorithm>
+
+namespace miopen {
+
+Data_t WorkspaceArena::Get(Handle& handle, std::size_t size)
+{
+    high_water_mark = std::max(high_water_mark, size);
+    if(size <= capacity && buffer != nullptr)
+        return buffer.get();
+
+    // Grow at least twice to amortize reallocations, but keep within the budget if possible.
+    const auto grown =
+        capacity > handle.workspace_budget / 2 ? handle.workspace_budget : capacity * 2;
+    const auto new_capacity = std::max(size, grown);
+    MIOPEN_LOG_I2("Workspace arena: " << capacity << " -> " << new_capacity << " bytes");
+    buffer.reset();
+    capacity = 0;
+    buffer   = handle.Create(new_capacity);
+    capacity = new_capacity;
+    ++allocations;
+    return buffer.get();
+}
+
+void UseWorkspaceArena(Handle& handle,
+                       void*& workspace,
+                       std::size_t& size,
+                       const std::function<std::size_t()>& get_size)
+{
+    if(workspace != nullptr || handle.workspace_arena == nullptr)
+        return;
+    if(size == 0)
+        size = get_size();
+    if(size == 0)
+        return;
+    workspace = reinterpret_cast<void*>(handle.workspace_arena->Get(handle, size)); // NOLINT
+}
+
+} // namespace miopen
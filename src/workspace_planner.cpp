@@ -0,0 +1,153 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2019 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/workspace_planner.hpp>
+#include <miopen/errors.hpp>
+#include <miopen/logger.hpp>
+
+#include <algorithm>
+#include <limits>
+
+namespace miopen {
+
+namespace {
+
+constexpr std::size_t mb = 1024 * 1024;
+
+struct PlanPoint
+{
+    std::size_t workspace;
+    float time;
+    /// Point of the previous layer this one extends, and the solution it adds.
+    std::size_t parent;
+    std::size_t choice;
+};
+
+std::size_t SaturatingAdd(std::size_t a, std::size_t b)
+{
+    return a > std::numeric_limits<std::size_t>::max() - b
+               ? std::numeric_limits<std::size_t>::max()
+               : a + b;
+}
+
+/// Leaves the points not dominated by another point, by increasing workspace.
+void KeepFrontier(std::vector<PlanPoint>& points, std::size_t limit)
+{
+    std::sort(points.begin(), points.end(), [](const PlanPoint& l, const PlanPoint& r) {
+        return l.workspace < r.workspace || (l.workspace == r.workspace && l.time < r.time);
+    });
+
+    const auto granularity = points.size() > max_plan_points ? limit / max_plan_points : 0;
+    std::size_t kept       = 0;
+    for(const auto& point : points)
+    {
+        if(kept != 0)
+        {
+            const auto& last = points[kept - 1];
+            if(point.time >= last.time)
+                continue;
+            // Thin out a too large frontier: a faster point replaces a close previous one.
+            if(point.workspace - last.workspace < granularity && kept > 1)
+            {
+                points[kept - 1] = point;
+                continue;
+            }
+        }
+        points[kept++] = point;
+    }
+    points.resize(kept);
+}
+
+} // namespace
+
+WorkspacePlan PlanWorkspace(const std::vector<std::vector<miopenConvSolution_t>>& layers,
+                            std::size_t budget)
+{
+    // Plan for one more MB at once to see what it would buy.
+    const auto limit = SaturatingAdd(budget, mb);
+
+    // frontiers[i] are the plans of the first i layers.
+    std::vector<std::vector<PlanPoint>> frontiers(1, {{0, 0.0f, 0, 0}});
+    frontiers.reserve(layers.size() + 1);
+
+    for(std::size_t i = 0; i < layers.size(); ++i)
+    {
+        const auto& solutions = layers[i];
+        if(solutions.empty())
+            MIOPEN_THROW(miopenStatusBadParm, "Layer " + std::to_string(i) + " has no solutions");
+
+        const auto& previous = frontiers.back();
+        std::vector<PlanPoint> points;
+        points.reserve(previous.size() * solutions.size());
+        for(std::size_t p = 0; p < previous.size(); ++p)
+        {
+            for(std::size_t s = 0; s < solutions.size(); ++s)
+            {
+                const auto workspace =
+                    SaturatingAdd(previous[p].workspace, solutions[s].workspace_size);
+                if(workspace > limit)
+                    continue;
+                const auto time = previous[p].time + std::max(solutions[s].time, 0.0f);
+                points.push_back({workspace, time, p, s});
+            }
+        }
+        if(points.empty())
+            MIOPEN_THROW(miopenStatusBadParm,
+                         "The layers do not fit into the workspace budget of " +
+                             std::to_string(budget) + " bytes");
+        KeepFrontier(points, limit);
+        frontiers.push_back(std::move(points));
+    }
+
+    // The frontier is ordered by increasing workspace and decreasing time.
+    const auto& last = frontiers.back();
+    const auto best  = std::find_if(last.rbegin(), last.rend(), [&](const PlanPoint& point) {
+        return point.workspace <= budget;
+    });
+    if(best == last.rend())
+        MIOPEN_THROW(miopenStatusBadParm,
+                     "The layers do not fit into the workspace budget of " +
+                         std::to_string(budget) + " bytes");
+
+    WorkspacePlan plan;
+    plan.time        = best->time;
+    plan.workspace   = best->workspace;
+    plan.time_per_mb = best->time - last.back().time;
+    plan.choices.resize(layers.size());
+    auto index = static_cast<std::size_t>(std::distance(last.begin(), best.base()) - 1);
+    for(auto i = layers.size(); i > 0; --i)
+    {
+        const auto& point   = frontiers[i][index];
+        plan.choices[i - 1] = point.choice;
+        index               = point.parent;
+    }
+
+    MIOPEN_LOG_I("Workspace plan: " << layers.size() << " layers, " << plan.time << " ms, "
+                                    << plan.workspace << " of " << budget << " bytes, "
+                                    << plan.time_per_mb << " ms per extra MB");
+    return plan;
+}
+
+} // namespace miopen
@@ -0,0 +1,236 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2019 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+// Compares the host tensor operations of cpu_tensor_ops.hpp with the element-by-element loops
+// the tensor tests used before, on subtensors of 5-D tensors.
+//
+//   bench_cpu_tensor_ops [repeats]
+
+#include <miopen/tensor.hpp>
+
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "serialize.hpp"
+#include "cpu_tensor_ops.hpp"
+#include "tensor_util.hpp"
+
+namespace {
+
+// The loops of test/tensor_copy.cpp, test/tensor_transform.cpp and test/tensor_ops.cpp: one
+// recursion level per dimension and an index computed per element.
+template <class F>
+void naive_loop(const std::vector<std::size_t>& lens,
+                const std::vector<std::size_t>& a_strides,
+                const std::vector<std::size_t>& b_strides,
+                std::size_t a_index,
+                std::size_t b_index,
+                std::size_t dim,
+                F f)
+{
+    for(std::size_t idx = 0; idx < lens[dim]; idx++)
+    {
+        const std::size_t a = a_index + a_strides[dim] * idx;
+        const std::size_t b = b_index + b_strides[dim] * idx;
+        if(dim < lens.size() - 1)
+            naive_loop(lens, a_strides, b_strides, a, b, dim + 1, f);
+        else
+            f(a, b);
+    }
+}
+
+template <typename T>
+struct scale_data_t
+{
+    const T alpha;
+
+    void operator()(T& r_data) const { r_data *= alpha; }
+};
+
+template <class F>
+double best_ms(int repeats, F f)
+{
+    double best = 0;
+    for(int i = 0; i < repeats; ++i)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        f();
+        const auto ms = std::chrono::duration<double, std::milli>(
+                            std::chrono::steady_clock::now() - start)
+                            .count();
+        best = i == 0 ? ms : std::min(best, ms);
+    }
+    return best;
+}
+
+bool report(const std::string& name,
+            double naive,
+            double vectorized,
+            const std::vector<float>& expected,
+            const std::vector<float>& actual)
+{
+    const bool match = expected == actual;
+    std::cout << std::left << std::setw(24) << name << std::right << std::fixed
+              << std::setprecision(2) << std::setw(10) << naive << std::setw(10) << vectorized
+              << std::setw(9) << naive / vectorized << "x" << (match ? "" : "  MISMATCH")
+              << std::endl;
+    return match;
+}
+
+} // namespace
+
+int main(int argc, const char* argv[])
+{
+    const int repeats = argc > 1 ? std::atoi(argv[1]) : 5;
+
+    const std::vector<std::size_t> super_lens{32, 32, 16, 16, 16};
+    const std::vector<std::size_t> sub_lens{32, 24, 16, 16, 12};
+    const std::vector<std::size_t> b_lens{1, 24, 1, 1, 1};
+
+    tensor<float> src{super_lens};
+    tensor<float> dst{super_lens};
+    tensor<float> bias{super_lens};
+    for(std::size_t i = 0; i < src.data.size(); ++i)
+    {
+        src.data[i]  = float(i % 17);
+        dst.data[i]  = float(i % 13);
+        bias.data[i] = float(i % 11) - 5;
+    }
+
+    const auto& strides = src.desc.GetStrides();
+    const miopen::TensorDescriptor sub{miopenFloat, sub_lens, strides};
+    const miopen::TensorDescriptor packed{miopenFloat, sub_lens};
+    const miopen::TensorDescriptor sub_b{miopenFloat, b_lens, strides};
+    const std::size_t offset = 7;
+
+    std::cout << std::left << std::setw(24) << "op" << std::right << std::setw(10) << "loop ms"
+              << std::setw(10) << "new ms" << std::setw(10) << "speedup" << std::endl;
+    bool ok = true;
+
+    {
+        auto expected   = dst;
+        auto actual     = dst;
+        const auto slow = best_ms(repeats, [&] {
+            operate_over_subtensor(scale_data_t<float>{0.5f}, expected, sub, offset);
+        });
+        expected = dst;
+        operate_over_subtensor(scale_data_t<float>{0.5f}, expected, sub, offset);
+        const auto fast = best_ms(repeats, [&] { cpu_scale_tensor(actual, sub, offset, 0.5f); });
+        actual = dst;
+        cpu_scale_tensor(actual, sub, offset, 0.5f);
+        ok &= report("scale", slow, fast, expected.data, actual.data);
+    }
+
+    {
+        auto expected   = dst;
+        auto actual     = dst;
+        const auto slow = best_ms(repeats, [&] {
+            naive_loop(sub_lens, strides, strides, offset, 0, 0, [&](auto s, auto d) {
+                expected[d] = src[s];
+            });
+        });
+        const auto fast =
+            best_ms(repeats, [&] { cpu_copy_tensor(src, sub, offset, actual, sub, 0); });
+        ok &= report("copy", slow, fast, expected.data, actual.data);
+    }
+
+    {
+        const auto& packed_strides = packed.GetStrides();
+        tensor<float> expected{sub_lens};
+        tensor<float> actual{sub_lens};
+        const auto slow = best_ms(repeats, [&] {
+            naive_loop(sub_lens, strides, packed_strides, offset, 0, 0, [&](auto s, auto d) {
+                expected[d] = src[s];
+            });
+        });
+        const auto fast =
+            best_ms(repeats, [&] { cpu_copy_tensor(src, sub, offset, actual, packed, 0); });
+        ok &= report("copy to packed", slow, fast, expected.data, actual.data);
+    }
+
+    {
+        auto expected = dst;
+        auto actual   = dst;
+        const auto run_slow = [&] {
+            naive_loop(sub_lens, strides, strides, offset, offset, 0, [&](auto s, auto d) {
+                expected[d] = 0.5f * src[s] + 0.25f * expected[d];
+            });
+        };
+        const auto run_fast = [&] {
+            cpu_transform_tensor(0.5f, src, sub, offset, 0.25f, actual, sub, offset);
+        };
+        const auto slow = best_ms(repeats, run_slow);
+        const auto fast = best_ms(repeats, run_fast);
+        expected        = dst;
+        actual          = dst;
+        run_slow();
+        run_fast();
+        ok &= report("transform", slow, fast, expected.data, actual.data);
+    }
+
+    {
+        auto b_strides = strides;
+        for(std::size_t d = 0; d < b_lens.size(); ++d)
+            if(b_lens[d] != sub_lens[d])
+                b_strides[d] = 0;
+
+        auto expected       = dst;
+        auto actual         = dst;
+        const auto run_slow = [&] {
+            naive_loop(sub_lens, strides, b_strides, 0, 0, 0, [&](auto i, auto b) {
+                expected[i] = src[i] * bias[b] + 0.5f * expected[i];
+            });
+        };
+        const auto run_fast = [&] {
+            cpu_op_tensor(miopenTensorOpMul,
+                          1.0f,
+                          src,
+                          sub,
+                          0,
+                          1.0f,
+                          bias,
+                          sub_b,
+                          0,
+                          0.5f,
+                          actual,
+                          sub,
+                          0);
+        };
+        const auto slow = best_ms(repeats, run_slow);
+        const auto fast = best_ms(repeats, run_fast);
+        expected        = dst;
+        actual          = dst;
+        run_slow();
+        run_fast();
+        ok &= report("op mul, broadcast b", slow, fast, expected.data, actual.data);
+    }
+
+    return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -67,6 +67,14 @@ struct check_numeric_normal : check_numerics_base
                                          desc,
                                          buffer.get(),
                                          false));
+
+        // More checks than slots, the ring is drained on the way.
+        const int mode = miopen::CheckNumerics::Throw | miopen::CheckNumerics::Deferred;
+        miopen::CheckNumericsRing ring{h, 4};
+        for(int i = 0; i < 10; ++i)
+            ring.Queue(h, mode, desc, buffer.get(), (i % 2) == 0);
+        CHECK(!ring.Drain(h, mode));
+        CHECK(!ring.Drain(h, mode));
     }
 };
 
@@ -115,6 +123,24 @@ struct check_numeric_abnormal : check_numerics_base
                                       buffer.get(),
                                       false);
         }));
+
+        // Deferred checks report nothing until the ring is drained.
+        const int warn   = miopen::CheckNumerics::Warn | miopen::CheckNumerics::Deferred;
+        const int throw_ = miopen::CheckNumerics::Throw | miopen::CheckNumerics::Deferred;
+        miopen::CheckNumericsRing ring{h, 4};
+        ring.Queue(h, warn, desc, buffer.get(), true);
+        ring.Queue(h, warn, desc, buffer.get(), false);
+        CHECK(ring.Drain(h, warn));
+        CHECK(!ring.Drain(h, warn));
+
+        ring.Queue(h, throw_, desc, buffer.get(), false);
+        CHECK(throws([&] { ring.Drain(h, throw_); }));
+        CHECK(!ring.Drain(h, throw_));
+
+        // A full ring is drained by the next check.
+        for(int i = 0; i < 4; ++i)
+            ring.Queue(h, throw_, desc, buffer.get(), true);
+        CHECK(throws([&] { ring.Queue(h, throw_, desc, buffer.get(), true); }));
     }
 };
 
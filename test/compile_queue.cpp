@@ -0,0 +1,135 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2019 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/compile_queue.hpp>
+#include <miopen/errors.hpp>
+#include <future>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "test.hpp"
+
+template <class F>
+bool Throws(F f)
+{
+    try
+    {
+        f();
+    }
+    catch(const miopen::Exception&)
+    {
+        return true;
+    }
+    return false;
+}
+
+struct BlockedQueue
+{
+    miopen::CompileQueue queue{1};
+    std::promise<void> release;
+    std::shared_future<void> blocker;
+    std::mutex mutex;
+    std::vector<std::string> order;
+
+    BlockedQueue()
+    {
+        // Keeps the only thread busy until released, so the next jobs stay queued.
+        std::promise<void> started;
+        auto released = release.get_future().share();
+        blocker       = queue.Enqueue("blocker", 0, [&started, released] {
+            started.set_value();
+            released.wait();
+        });
+        started.get_future().wait();
+    }
+
+    std::shared_future<void> Enqueue(const std::string& key, int priority)
+    {
+        return queue.Enqueue(key, priority, [=] {
+            std::lock_guard<std::mutex> lock(mutex);
+            order.push_back(key);
+        });
+    }
+};
+
+void check_priority()
+{
+    BlockedQueue q;
+    q.Enqueue("low", 0);
+    q.Enqueue("high", 10);
+    q.Enqueue("low2", 0);
+    // Raises the priority of the queued job instead of queueing it again.
+    q.Enqueue("low2", 20);
+    const auto last = q.Enqueue("mid", 5);
+    q.release.set_value();
+    last.wait();
+    q.Enqueue("low", 0).wait();
+
+    std::lock_guard<std::mutex> lock(q.mutex);
+    EXPECT(q.order == (std::vector<std::string>{"low2", "high", "mid", "low"}));
+}
+
+void check_cancel()
+{
+    BlockedQueue q;
+    const auto cancelled = q.Enqueue("cancelled", 0);
+    q.queue.CancelPending();
+    q.release.set_value();
+    q.blocker.get();
+    EXPECT(Throws([&] { cancelled.get(); }));
+
+    // The cancelled job is forgotten once reported, so it is queued again.
+    EXPECT(Throws([&] { q.Enqueue("cancelled", 0).get(); }));
+    q.Enqueue("cancelled", 0).get();
+    std::lock_guard<std::mutex> lock(q.mutex);
+    EXPECT(q.order == std::vector<std::string>{"cancelled"});
+}
+
+void check_failure()
+{
+    miopen::CompileQueue queue{2};
+    int runs = 0;
+    const auto fail = [&] {
+        ++runs;
+        MIOPEN_THROW(miopenStatusBadParm, "failed");
+    };
+    EXPECT(Throws([&] { queue.Enqueue("job", 0, fail).get(); }));
+    EXPECT(Throws([&] { queue.Enqueue("job", 0, fail).get(); }));
+    EXPECT(runs == 1);
+    EXPECT(Throws([&] { queue.Enqueue("job", 0, fail).get(); }));
+    EXPECT(runs == 2);
+
+    queue.Enqueue("done", 0, [&] { ++runs; }).get();
+    queue.Enqueue("done", 0, [&] { ++runs; }).get();
+    EXPECT(runs == 3);
+}
+
+int main()
+{
+    check_priority();
+    check_cancel();
+    check_failure();
+}
@@ -153,17 +153,39 @@ struct tensor_elem_gen_one
     }
 };
 
+// The same values laid out channels-last: NHWC, or NDHWC for 3D tensors.
+template <class T>
+tensor<T> get_channels_last_tensor(const tensor<T>& t)
+{
+    const auto& lens = t.desc.GetLengths();
+    std::vector<std::size_t> strides(lens.size());
+    std::size_t stride = lens[1];
+    strides[1]         = 1;
+    for(auto i = lens.size() - 1; i >= 2; --i)
+    {
+        strides[i] = stride;
+        stride *= lens[i];
+    }
+    strides[0] = stride;
+
+    tensor<T> result{lens, strides};
+    t.for_each([&](auto... is) { result(is...) = t(is...); });
+    return result;
+}
+
 template <class T, class Tout = T>
 tensor<Tout> get_output_tensor(const miopen::ConvolutionDescriptor& filter,
                                const tensor<T>& input,
                                const tensor<T>& weights)
 {
-    return tensor<Tout>{filter.GetForwardOutputTensor(
+    auto output = tensor<Tout>{filter.GetForwardOutputTensor(
         input.desc,
         weights.desc,
         weights.desc.GetType() == miopenInt8 || weights.desc.GetType() == miopenInt8x4
             ? (std::is_same<Tout, int>{} ? miopenInt32 : miopenFloat)
             : weights.desc.GetType())};
+    // The output follows the layout of the input.
+    return input.desc.IsDefaultLayout() ? output : get_channels_last_tensor(output);
 }
 
 template <class T, class Tout = T>
@@ -704,6 +726,7 @@ struct conv_driver : test_driver
     std::string conv_dim_type;
     std::string conv_mode;
     std::string pad_mode;
+    std::string layout;
     std::vector<int> pads_strides_dilations;
     std::vector<int> trans_output_pads;
     int groupCount{};
@@ -730,6 +753,7 @@ struct conv_driver : test_driver
     {
         add(conv_mode, "cmode", generate_data({"conv"}));
         add(pad_mode, "pmode", generate_data({"default", "same", "valid"}));
+        add(layout, "layout", generate_data({"NCHW"}));
         add(groupCount, "group-count", generate_data({1}));
         add(do_forward, "disable-forward", set_value(false));
         add(do_backward_data, "disable-backward-data", set_value(false));
@@ -787,6 +811,16 @@ struct conv_driver : test_driver
             return;
         }
 
+        // Channels-last (NHWC, NDHWC) tensors are supported by the forward GEMM path only.
+        const bool is_channels_last = miopen::ToUpper(layout) == "NHWC";
+        if(is_channels_last && (is_int8 || filter.mode != miopenConvolution))
+        {
+            show_command();
+            std::cout << "MIOpen doesn't support channels-last int8 type or transpose convolution."
+                      << std::endl;
+            return;
+        }
+
         bool is_bfloat16 =
             (input.desc.GetType() == miopenBFloat16 && weights.desc.GetType() == miopenBFloat16);
 
@@ -1005,29 +1039,44 @@ struct conv_driver : test_driver
                     return;
                 }
 
+                const auto fwd_input = is_channels_last ? get_channels_last_tensor(input) : input;
+                const auto fwd_weights =
+                    is_channels_last ? get_channels_last_tensor(weights) : weights;
+
                 if(do_forward && !skip_forward)
                 {
+                    // The host reference accumulates int8 in int32 and bfloat16 in fp32 like the
+                    // device. Int8 results are exact, bfloat16 ones differ in the order of the
+                    // fp32 additions only, which is within one bfloat16 ulp.
                     if(is_int8)
                     {
-                        verify(verify_forward_conv<T, float>{input, weights, filter, 0, search});
-                        verify(
+                        verify_equals(
+                            verify_forward_conv<T, float>{input, weights, filter, 0, search});
+                        verify_equals(
                             verify_forward_conv<T, float>{input, weights, filter, 0, search, true});
-                        verify(verify_forward_conv<T, int>{input, weights, filter, 0, search});
-                        verify(
+                        verify_equals(
+                            verify_forward_conv<T, int>{input, weights, filter, 0, search});
+                        verify_equals(
                             verify_forward_conv<T, int>{input, weights, filter, 0, search, true});
                     }
+                    else if(input.desc.GetType() == miopenBFloat16)
+                    {
+                        verify_with_tolerance(
+                            std::min(tolerance, 2.0),
+                            verify_forward_conv<T>{fwd_input, fwd_weights, filter, 0, search});
+                    }
                     else
                     {
-                        verify(verify_forward_conv<T>{input, weights, filter, 0, search});
+                        verify(verify_forward_conv<T>{fwd_input, fwd_weights, filter, 0, search});
                     }
                 }
 
-                if(do_backward_data && !skip_backward_data)
+                if(do_backward_data && !skip_backward_data && !is_channels_last)
                 {
                     verify(verify_backward_conv<T>{input, weights, output, filter, 0, search});
                 }
 
-                if(do_backward_weights && !skip_backward_weights)
+                if(do_backward_weights && !skip_backward_weights && !is_channels_last)
                 {
                     output.generate(gen_sign_value);
 
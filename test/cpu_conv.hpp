@@ -27,16 +27,21 @@
 #define GUARD_CPU_CONV_HPP
 
 #include "test.hpp"
+#include <algorithm>
 #include <array>
+#include <cstdint>
 #include <iostream>
 #include <iterator>
 #include <limits>
 #include <memory>
 #include <miopen/miopen.h>
 #include <miopen/tensor.hpp>
+#include <tuple>
 #include <utility>
+#include <vector>
 
 #include "tensor_holder.hpp"
+#include <miopen/bfloat16.hpp>
 #include <miopen/stringutils.hpp>
 #include <miopen/functional.hpp>
 
@@ -46,6 +51,32 @@ static constexpr auto make_array(T x, Ts... xs)
     return std::array<T, 1 + sizeof...(Ts)>{{x, xs...}};
 }
 
+// Type the forward reference accumulates products of T and U in. Int8 and bf16 take the type the
+// device accumulates in: int32 (dot4 and xdlops int8 instructions) and fp32 (MFMA instructions and
+// the fp32 compute type of the GEMM solvers). Products of such operands are exact in it, so the
+// reference only rounds where the device does: on every addition and once on the store. Other
+// types, fp16 included, and the backward references accumulate in double.
+template <class T, class U>
+struct cpu_conv_accumulator
+{
+    using type = double;
+};
+
+template <>
+struct cpu_conv_accumulator<int8_t, int8_t>
+{
+    using type = std::int32_t;
+};
+
+template <>
+struct cpu_conv_accumulator<bfloat16, bfloat16>
+{
+    using type = float;
+};
+
+template <class T, class U>
+using cpu_conv_accumulator_t = typename cpu_conv_accumulator<T, U>::type;
+
 template <std::size_t ConvDim, typename Tin, typename Twei, typename Tout, typename Range>
 void cpu_convolution_forward_impl(const tensor<Tin>& in,
                                   const tensor<Twei>& wei,
@@ -87,7 +118,7 @@ void cpu_convolution_forward_impl(const tensor<Tin>& in,
 
         std::size_t group_id = out_k_id / wei_k_len_per_group;
 
-        double acc = 0;
+        cpu_conv_accumulator_t<Tin, Twei> acc = 0;
 
         ford(wei_c_len)([&](std::size_t wei_c_id) {
             std::size_t in_c_id = group_id * wei_c_len + wei_c_id;
@@ -119,13 +150,13 @@ void cpu_convolution_forward_impl(const tensor<Tin>& in,
                     in_id[1] = in_c_id;
                     std::copy_n(in_spatial_id.begin(), ConvDim, in_id.begin() + 2);
 
-                    acc +=
-                        double(in(in_id)) * double(wei(out_k_id, wei_c_id, wei_spatial_id_pack...));
+                    using Tacc = decltype(acc);
+                    acc += Tacc(in(in_id)) * Tacc(wei(out_k_id, wei_c_id, wei_spatial_id_pack...));
                 }
             });
         });
 
-        out(out_n_id, out_k_id, out_spatial_id_pack...) = acc;
+        out(out_n_id, out_k_id, out_spatial_id_pack...) = static_cast<Tout>(acc);
     });
 }
 
@@ -294,6 +325,108 @@ void cpu_convolution_backward_weight_impl(const tensor<Tin>& in,
     });
 }
 
+// Packed NCHW 2D convolution. Each (n, k) pair accumulates its whole output plane, adding one
+// weight times a contiguous row segment of the input at a time, so the innermost loop is a
+// vectorizable axpy instead of a strided gather. The products of every output element are added
+// in the same (c, y, x) order as cpu_convolution_forward_impl, hence both give the same results.
+template <typename Tin, typename Twei, typename Tout, typename Range>
+void cpu_convolution_forward_nchw(const tensor<Tin>& in,
+                                  const tensor<Twei>& wei,
+                                  tensor<Tout>& out,
+                                  const Range& pads,
+                                  const Range& strides,
+                                  const Range& dilations,
+                                  std::size_t group_count)
+{
+    using Tacc = cpu_conv_accumulator_t<Tin, Twei>;
+
+    std::size_t in_c_len, in_h_len, in_w_len;
+    std::size_t wei_k_len, wei_c_len, wei_y_len, wei_x_len;
+    std::size_t out_n_len, out_h_len, out_w_len;
+    std::tie(std::ignore, in_c_len, in_h_len, in_w_len) = miopen::tien<4>(in.desc.GetLengths());
+    std::tie(wei_k_len, wei_c_len, wei_y_len, wei_x_len) = miopen::tien<4>(wei.desc.GetLengths());
+    std::tie(out_n_len, std::ignore, out_h_len, out_w_len) =
+        miopen::tien<4>(out.desc.GetLengths());
+
+    const std::size_t wei_k_len_per_group = wei_k_len / group_count;
+    const std::size_t in_plane            = in_h_len * in_w_len;
+    const std::size_t out_plane           = out_h_len * out_w_len;
+
+    const std::ptrdiff_t pad_h = pads[0], pad_w = pads[1];
+    const std::ptrdiff_t stride_h = strides[0], stride_w = strides[1];
+    const std::ptrdiff_t dilation_h = dilations[0], dilation_w = dilations[1];
+    const auto in_h = static_cast<std::ptrdiff_t>(in_h_len);
+    const auto in_w = static_cast<std::ptrdiff_t>(in_w_len);
+    const auto out_w = static_cast<std::ptrdiff_t>(out_w_len);
+
+    par_ford(out_n_len, wei_k_len)([&](std::size_t n, std::size_t k) {
+        std::vector<Tacc> acc(out_plane, Tacc(0));
+        const std::size_t group_id = k / wei_k_len_per_group;
+
+        for(std::size_t c = 0; c < wei_c_len; ++c)
+        {
+            const Tin* in_data =
+                in.data.data() + (n * in_c_len + group_id * wei_c_len + c) * in_plane;
+            const Twei* wei_data = wei.data.data() + (k * wei_c_len + c) * wei_y_len * wei_x_len;
+
+            for(std::size_t y = 0; y < wei_y_len; ++y)
+            {
+                for(std::size_t x = 0; x < wei_x_len; ++x)
+                {
+                    const Tacc w = Tacc(wei_data[y * wei_x_len + x]);
+
+                    // Output columns whose input column ox * stride_w + x_offset is in bounds.
+                    const std::ptrdiff_t x_offset = std::ptrdiff_t(x) * dilation_w - pad_w;
+                    const std::ptrdiff_t ox_begin =
+                        x_offset < 0 ? (-x_offset + stride_w - 1) / stride_w : 0;
+                    const std::ptrdiff_t ox_end =
+                        in_w > x_offset
+                            ? std::min(out_w, (in_w - x_offset + stride_w - 1) / stride_w)
+                            : 0;
+
+                    for(std::size_t oy = 0; oy < out_h_len; ++oy)
+                    {
+                        const std::ptrdiff_t iy =
+                            std::ptrdiff_t(oy) * stride_h + std::ptrdiff_t(y) * dilation_h - pad_h;
+                        if(iy < 0 or iy >= in_h)
+                            continue;
+
+                        const Tin* in_row = in_data + iy * in_w;
+                        Tacc* acc_row     = acc.data() + oy * out_w_len;
+                        if(stride_w == 1)
+                        {
+                            for(std::ptrdiff_t ox = ox_begin; ox < ox_end; ++ox)
+                                acc_row[ox] += Tacc(in_row[ox + x_offset]) * w;
+                        }
+                        else
+                        {
+                            for(std::ptrdiff_t ox = ox_begin; ox < ox_end; ++ox)
+                                acc_row[ox] += Tacc(in_row[ox * stride_w + x_offset]) * w;
+                        }
+                    }
+                }
+            }
+        }
+
+        Tout* out_data = out.data.data() + (n * wei_k_len + k) * out_plane;
+        std::transform(
+            acc.begin(), acc.end(), out_data, [](Tacc v) { return static_cast<Tout>(v); });
+    });
+}
+
+template <typename Range>
+bool is_nchw_2d_problem(const miopen::TensorDescriptor& in,
+                        const miopen::TensorDescriptor& wei,
+                        const miopen::TensorDescriptor& out,
+                        const Range& strides)
+{
+    const auto fits = [](const miopen::TensorDescriptor& desc) {
+        return desc.GetSize() == 4 and desc.IsPacked() and desc.IsDefaultLayout();
+    };
+    return fits(in) and fits(wei) and fits(out) and
+           std::all_of(strides.begin(), strides.end(), [](auto v) { return v > 0; });
+}
+
 template <typename Tin, typename Twei, typename Tout, typename Range>
 void cpu_convolution_forward(std::size_t spatial_dim,
                              const tensor<Tin>& in,
@@ -304,6 +437,12 @@ void cpu_convolution_forward(std::size_t spatial_dim,
                              const Range& dilations,
                              std::size_t group_count)
 {
+    if(spatial_dim == 2 and is_nchw_2d_problem(in.desc, wei.desc, out.desc, strides))
+    {
+        cpu_convolution_forward_nchw(in, wei, out, pads, strides, dilations, group_count);
+        return;
+    }
+
     switch(spatial_dim)
     {
     case 1:
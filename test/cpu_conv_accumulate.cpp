@@ -0,0 +1,150 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2019 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/tensor.hpp>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+#include "serialize.hpp"
+#include "cpu_conv.hpp"
+#include "test.hpp"
+
+template <class T>
+tensor<T> make_tensor(std::vector<std::size_t> lens, const std::vector<float>& values)
+{
+    tensor<T> t{lens};
+    for(std::size_t i = 0; i < t.data.size(); ++i)
+        t.data[i] = T(values[i % values.size()]);
+    return t;
+}
+
+// 1x1 convolution of a single pixel, i.e. a dot product over the channels.
+template <class Tout, class T>
+Tout dot(const tensor<T>& in, const tensor<T>& wei)
+{
+    const std::vector<int> zeros{0, 0};
+    const std::vector<int> ones{1, 1};
+    tensor<Tout> out{std::vector<std::size_t>{1, 1, 1, 1}};
+    cpu_convolution_forward(2, in, wei, out, zeros, ones, ones, 1);
+    return out.data[0];
+}
+
+void check_int8_accumulation()
+{
+    // 1100 * 127 * 127 = 17741900 is above 2^24, the sum is still exact.
+    const auto in  = make_tensor<int8_t>({1, 1100, 1, 1}, {127});
+    const auto wei = make_tensor<int8_t>({1, 1100, 1, 1}, {127});
+    EXPECT(dot<int>(in, wei) == 17741900);
+    EXPECT(dot<float>(in, wei) == static_cast<float>(17741900));
+
+    const auto neg = make_tensor<int8_t>({1, 1100, 1, 1}, {-128});
+    EXPECT(dot<int>(neg, neg) == 1100 * 128 * 128);
+}
+
+void check_bfloat16_accumulation()
+{
+    // Products 1, 2^-24, 2^-24: each addition of 2^-24 to 1 is a tie that fp32 rounds to even,
+    // so the device gets exactly 1 where a double accumulator would give 1 + 2^-23.
+    const float tiny = 1.0f / 4096;
+    const auto in    = make_tensor<bfloat16>({1, 3, 1, 1}, {1.0f, tiny, tiny});
+    const auto wei   = make_tensor<bfloat16>({1, 3, 1, 1}, {1.0f, tiny, tiny});
+    EXPECT(dot<float>(in, wei) == 1.0f);
+
+    // bf16 output is rounded once from the fp32 sum.
+    const auto a = make_tensor<bfloat16>({1, 2, 1, 1}, {1.0f, 1.0f / 256});
+    const auto b = make_tensor<bfloat16>({1, 2, 1, 1}, {1.0f, 3.0f});
+    EXPECT(float(dot<bfloat16>(a, b)) == float(bfloat16(1.0f + 3.0f / 256)));
+}
+
+void check_half_accumulation()
+{
+    // fp16 keeps accumulating in double, as some direct kernels accumulate in fp16 and the
+    // tolerance of the checks covers them: the same sum as above is not rounded to 1 here.
+    const float tiny = 1.0f / 4096;
+    const auto in    = make_tensor<half_float::half>({1, 3, 1, 1}, {1.0f, tiny, tiny});
+    const auto wei   = make_tensor<half_float::half>({1, 3, 1, 1}, {1.0f, tiny, tiny});
+    EXPECT(dot<float>(in, wei) == 1.0f + 2.0f * tiny * tiny);
+}
+
+// The packed NCHW path must match the generic reference bit for bit.
+template <class T, class Tout>
+void check_nchw(std::vector<std::size_t> in_lens,
+                std::vector<std::size_t> wei_lens,
+                std::vector<int> pads,
+                std::vector<int> strides,
+                std::vector<int> dilations,
+                std::size_t group_count)
+{
+    std::vector<float> values;
+    for(int i = 0; i < 97; ++i)
+        values.push_back(std::is_integral<T>{} ? float(i % 17 - 8) : float(i % 23 - 11) / 7);
+
+    const auto in  = make_tensor<T>(in_lens, values);
+    const auto wei = make_tensor<T>(wei_lens, {values.rbegin(), values.rend()});
+
+    std::vector<std::size_t> out_lens{in_lens[0], wei_lens[0], 0, 0};
+    for(std::size_t i = 0; i < 2; ++i)
+    {
+        out_lens[i + 2] =
+            (in_lens[i + 2] + 2 * pads[i] - dilations[i] * (wei_lens[i + 2] - 1) - 1) /
+                strides[i] +
+            1;
+    }
+    tensor<Tout> fast{out_lens};
+    tensor<Tout> ref{out_lens};
+
+    EXPECT(is_nchw_2d_problem(in.desc, wei.desc, fast.desc, strides));
+    cpu_convolution_forward(2, in, wei, fast, pads, strides, dilations, group_count);
+    cpu_convolution_forward_impl<2>(in, wei, ref, pads, strides, dilations, group_count);
+    for(std::size_t i = 0; i < ref.data.size(); ++i)
+        EXPECT(double(fast.data[i]) == double(ref.data[i]));
+}
+
+template <class T, class Tout = T>
+void check_nchw_configs()
+{
+    check_nchw<T, Tout>({2, 3, 9, 11}, {4, 3, 3, 3}, {0, 0}, {1, 1}, {1, 1}, 1);
+    check_nchw<T, Tout>({2, 3, 9, 11}, {4, 3, 3, 3}, {1, 1}, {1, 1}, {1, 1}, 1);
+    check_nchw<T, Tout>({1, 4, 13, 10}, {6, 4, 5, 3}, {2, 3}, {2, 3}, {1, 1}, 1);
+    check_nchw<T, Tout>({2, 2, 12, 12}, {3, 2, 3, 3}, {2, 1}, {1, 2}, {2, 3}, 1);
+    check_nchw<T, Tout>({1, 6, 8, 7}, {4, 3, 3, 1}, {1, 0}, {1, 1}, {1, 1}, 2);
+    check_nchw<T, Tout>({3, 5, 6, 6}, {5, 1, 3, 3}, {1, 1}, {2, 2}, {1, 1}, 5);
+    check_nchw<T, Tout>({1, 2, 5, 4}, {2, 2, 1, 1}, {0, 4}, {1, 1}, {1, 1}, 1);
+}
+
+int main()
+{
+    check_int8_accumulation();
+    check_bfloat16_accumulation();
+    check_half_accumulation();
+
+    check_nchw_configs<float>();
+    check_nchw_configs<half_float::half>();
+    check_nchw_configs<bfloat16>();
+    check_nchw_configs<bfloat16, float>();
+    check_nchw_configs<int8_t, float>();
+    check_nchw_configs<int8_t, int>();
+}
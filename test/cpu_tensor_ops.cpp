@@ -0,0 +1,199 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2019 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/tensor.hpp>
+#include <vector>
+#include "serialize.hpp"
+#include "cpu_tensor_ops.hpp"
+#include "test.hpp"
+
+// Element-by-element references with a multi-index per element.
+template <class F>
+void for_each_index(const std::vector<std::size_t>& lens, F f)
+{
+    std::vector<std::size_t> idx(lens.size(), 0);
+    if(std::any_of(lens.begin(), lens.end(), [](auto l) { return l == 0; }))
+        return;
+    for(;;)
+    {
+        f(idx);
+        std::size_t d = lens.size();
+        while(d-- > 0 && ++idx[d] == lens[d])
+            idx[d] = 0;
+        if(d == std::size_t(-1))
+            return;
+    }
+}
+
+std::size_t offset_of(const miopen::TensorDescriptor& desc,
+                      const std::vector<std::size_t>& idx,
+                      bool bcast = false)
+{
+    std::size_t offset = 0;
+    for(std::size_t d = 0; d < idx.size(); ++d)
+        offset += (bcast && desc.GetLengths()[d] == 1 ? 0 : idx[d]) * desc.GetStrides()[d];
+    return offset;
+}
+
+tensor<float> make_super(std::vector<std::size_t> lens)
+{
+    tensor<float> t{lens};
+    for(std::size_t i = 0; i < t.data.size(); ++i)
+        t.data[i] = float((i * 7) % 13) - 6.0f;
+    return t;
+}
+
+miopen::TensorDescriptor sub_desc(const tensor<float>& super, std::vector<std::size_t> lens)
+{
+    const auto& strides = super.desc.GetStrides();
+    return {miopenFloat, lens, {strides.end() - lens.size(), strides.end()}};
+}
+
+void check_collapse()
+{
+    const std::vector<std::size_t> packed{1920, 120, 24, 6, 1};
+    const auto loop = collapse_strided_loop<1>({2, 16, 5, 4, 6}, {{packed}});
+    EXPECT(loop.lens == std::vector<std::size_t>{2 * 16 * 5 * 4 * 6});
+    EXPECT(loop.strides[0][0] == 1);
+
+    // The subtensor is contiguous in its two innermost dimensions only, and the other tensor
+    // is broadcast along the outermost one.
+    const std::vector<std::size_t> sub{4096, 16, 1};
+    const std::vector<std::size_t> bcast{0, 16, 1};
+    const auto loop2 = collapse_strided_loop<2>({3, 8, 16}, {{sub, bcast}});
+    EXPECT(loop2.lens == (std::vector<std::size_t>{3, 128}));
+    EXPECT(loop2.strides[0][0] == 4096 && loop2.strides[0][1] == 0);
+
+    EXPECT(collapse_strided_loop<1>({1, 1}, {{{1, 1}}}).lens == std::vector<std::size_t>{1});
+}
+
+void check_unary_ops(const std::vector<std::size_t>& lens, std::size_t offset)
+{
+    const auto super = make_super({8, 12, 10, 9, 7});
+    const auto desc  = sub_desc(super, lens);
+
+    auto set_ref = super;
+    auto set     = super;
+    for_each_index(lens, [&](auto& idx) { set_ref[offset + offset_of(desc, idx)] = 3.0f; });
+    cpu_set_tensor(set, desc, offset, 3.0f);
+    EXPECT(set.data == set_ref.data);
+
+    auto scale_ref = super;
+    auto scale     = super;
+    for_each_index(lens, [&](auto& idx) { scale_ref[offset + offset_of(desc, idx)] *= -2.0f; });
+    cpu_scale_tensor(scale, desc, offset, -2.0f);
+    EXPECT(scale.data == scale_ref.data);
+}
+
+void check_binary_ops(const std::vector<std::size_t>& lens,
+                      std::size_t src_offset,
+                      std::size_t dst_offset)
+{
+    const auto src_super = make_super({6, 10, 12, 8, 9});
+    const auto dst_super = make_super({6, 12, 10, 9, 8});
+    const auto src_desc  = sub_desc(src_super, lens);
+    const auto dst_desc  = sub_desc(dst_super, lens);
+
+    // Elements past the end of either buffer are skipped.
+    const auto in_range = [&](auto& idx) {
+        return src_offset + offset_of(src_desc, idx) < src_super.data.size() &&
+               dst_offset + offset_of(dst_desc, idx) < dst_super.data.size();
+    };
+
+    auto copy_ref = dst_super;
+    auto copy     = dst_super;
+    for_each_index(lens, [&](auto& idx) {
+        if(in_range(idx))
+            copy_ref[dst_offset + offset_of(dst_desc, idx)] =
+                src_super[src_offset + offset_of(src_desc, idx)];
+    });
+    cpu_copy_tensor(src_super, src_desc, src_offset, copy, dst_desc, dst_offset);
+    EXPECT(copy.data == copy_ref.data);
+
+    auto transform_ref = dst_super;
+    auto transform     = dst_super;
+    for_each_index(lens, [&](auto& idx) {
+        if(!in_range(idx))
+            return;
+        auto& y = transform_ref[dst_offset + offset_of(dst_desc, idx)];
+        y       = 0.5f * src_super[src_offset + offset_of(src_desc, idx)] + 0.25f * y;
+    });
+    cpu_transform_tensor(
+        0.5f, src_super, src_desc, src_offset, 0.25f, transform, dst_desc, dst_offset);
+    EXPECT(transform.data == transform_ref.data);
+}
+
+void check_op_tensor(const std::vector<std::size_t>& lens, const std::vector<std::size_t>& b_lens)
+{
+    const auto a_super = make_super({4, 10, 12, 8, 9});
+    const auto b_super = make_super({4, 12, 10, 9, 8});
+    const auto c_super = make_super({4, 10, 12, 9, 8});
+    const auto a_desc  = sub_desc(a_super, lens);
+    const auto b_desc  = sub_desc(b_super, b_lens);
+    const auto c_desc  = sub_desc(c_super, lens);
+
+    for(auto op : {miopenTensorOpAdd, miopenTensorOpMul, miopenTensorOpMin, miopenTensorOpMax})
+    {
+        auto ref = c_super;
+        auto c   = c_super;
+        for_each_index(lens, [&](auto& idx) {
+            const float a = 2.0f * a_super[3 + offset_of(a_desc, idx)];
+            const float b = -1.0f * b_super[5 + offset_of(b_desc, idx, true)];
+            auto& y       = ref[1 + offset_of(c_desc, idx)];
+            float r       = 0;
+            switch(op)
+            {
+            case miopenTensorOpAdd: r = a + b; break;
+            case miopenTensorOpMul: r = a * b; break;
+            case miopenTensorOpMin: r = std::min(a, b); break;
+            case miopenTensorOpMax: r = std::max(a, b); break;
+            }
+            y = r + 0.5f * y;
+        });
+        cpu_op_tensor(
+            op, 2.0f, a_super, a_desc, 3, -1.0f, b_super, b_desc, 5, 0.5f, c, c_desc, 1);
+        EXPECT(c.data == ref.data);
+    }
+}
+
+int main()
+{
+    check_collapse();
+
+    check_unary_ops({8, 12, 10, 9, 7}, 0);
+    check_unary_ops({5, 4, 3, 2}, 11);
+    check_unary_ops({3, 1, 8}, 7);
+
+    check_binary_ops({6, 10, 10, 8, 8}, 0, 0);
+    check_binary_ops({4, 9, 7}, 13, 5);
+    // Runs past the end of the buffers.
+    check_binary_ops({6, 10, 10, 8, 8}, 700, 1900);
+
+    check_op_tensor({4, 10, 10, 8, 8}, {4, 10, 10, 8, 8});
+    check_op_tensor({4, 10, 10, 8, 8}, {1, 10, 1, 1, 1});
+    check_op_tensor({4, 10, 10, 8, 8}, {4, 1, 10, 8, 1});
+    check_op_tensor({10, 8, 8}, {1, 1, 8});
+}
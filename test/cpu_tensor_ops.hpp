@@ -0,0 +1,301 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2019 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_CPU_TENSOR_OPS_HPP
+#define GUARD_CPU_TENSOR_OPS_HPP
+
+#include <miopen/miopen.h>
+#include <miopen/tensor.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <functional>
+#include <numeric>
+#include <utility>
+#include <vector>
+
+#include "ford.hpp"
+#include "tensor_holder.hpp"
+
+// Host versions of SetTensor, ScaleTensor, CopyTensor, TransformTensor and OpTensor for the
+// verification of the device ones. Instead of computing a multi-index per element, the tensors
+// are walked as runs along the innermost dimension: dimensions of length 1 are dropped and
+// neighbouring dimensions that are contiguous in all the tensors are merged, the same way
+// GetConsistentFlattenedTensorDescriptors() does for the kernels. The runs are split between
+// threads, and runs of unit strides are plain loops over arrays that the compiler vectorizes.
+
+// Lengths of a loop over N tensors and the strides of every tensor per dimension.
+template <std::size_t N>
+struct cpu_strided_loop
+{
+    std::vector<std::size_t> lens;
+    std::vector<std::array<std::size_t, N>> strides;
+};
+
+template <std::size_t N>
+cpu_strided_loop<N> collapse_strided_loop(const std::vector<std::size_t>& lens,
+                                          const std::array<std::vector<std::size_t>, N>& strides)
+{
+    cpu_strided_loop<N> loop;
+    for(std::size_t d = 0; d < lens.size(); ++d)
+    {
+        if(lens[d] == 1)
+            continue;
+
+        std::array<std::size_t, N> dim_strides{};
+        for(std::size_t t = 0; t < N; ++t)
+            dim_strides[t] = strides[t][d];
+
+        // Merge with the previous dimension if it steps over the whole of this one in every
+        // tensor.
+        bool mergeable = !loop.lens.empty();
+        for(std::size_t t = 0; mergeable && t < N; ++t)
+            mergeable = loop.strides.back()[t] == dim_strides[t] * lens[d];
+
+        if(mergeable)
+        {
+            loop.lens.back() *= lens[d];
+            loop.strides.back() = dim_strides;
+        }
+        else
+        {
+            loop.lens.push_back(lens[d]);
+            loop.strides.push_back(dim_strides);
+        }
+    }
+
+    if(loop.lens.empty())
+    {
+        loop.lens.push_back(1);
+        loop.strides.push_back({});
+    }
+    return loop;
+}
+
+template <class F, class... Ts, std::size_t... Is>
+void cpu_tensor_run_impl(std::size_t count,
+                         const std::array<std::size_t, sizeof...(Ts)>& strides,
+                         F f,
+                         std::index_sequence<Is...>,
+                         Ts*... ps)
+{
+    if(std::all_of(strides.begin(), strides.end(), [](auto s) { return s == 1; }))
+    {
+        for(std::size_t i = 0; i < count; ++i)
+            f(ps[i]...);
+    }
+    else
+    {
+        for(std::size_t i = 0; i < count; ++i)
+            f(ps[i * strides[Is]]...);
+    }
+}
+
+// Calls f(elements...) for the count elements of a run.
+template <class F, class... Ts>
+void cpu_tensor_run(std::size_t count,
+                    const std::array<std::size_t, sizeof...(Ts)>& strides,
+                    F f,
+                    Ts*... ps)
+{
+    cpu_tensor_run_impl(count, strides, f, std::make_index_sequence<sizeof...(Ts)>{}, ps...);
+}
+
+// Calls run(offsets, count, strides) for every run along the innermost collapsed dimension.
+// Elements at or past spaces[t] in any tensor t are skipped, which with non-negative strides
+// only shortens the runs.
+template <std::size_t N, class F>
+void cpu_for_each_run(const std::vector<std::size_t>& lens,
+                      const std::array<std::vector<std::size_t>, N>& strides,
+                      const std::array<std::size_t, N>& offsets,
+                      const std::array<std::size_t, N>& spaces,
+                      F run)
+{
+    const auto loop      = collapse_strided_loop(lens, strides);
+    const auto inner     = loop.lens.size() - 1;
+    const auto inner_len = loop.lens[inner];
+    const auto runs      = std::accumulate(
+        loop.lens.begin(), loop.lens.end() - 1, std::size_t{1}, std::multiplies<std::size_t>());
+
+    // At least 64K elements per thread.
+    const std::size_t min_grain = std::max<std::size_t>(1, (std::size_t{1} << 16) / inner_len);
+
+    par_for(runs, min_grain, [&](std::size_t r) {
+        auto run_offsets = offsets;
+        for(std::size_t d = inner; d-- > 0;)
+        {
+            const auto idx = r % loop.lens[d];
+            r /= loop.lens[d];
+            for(std::size_t t = 0; t < N; ++t)
+                run_offsets[t] += idx * loop.strides[d][t];
+        }
+
+        auto count = inner_len;
+        for(std::size_t t = 0; t < N; ++t)
+        {
+            const auto stride = loop.strides[inner][t];
+            if(run_offsets[t] >= spaces[t])
+                count = 0;
+            else if(stride != 0)
+                count = std::min(count, (spaces[t] - run_offsets[t] + stride - 1) / stride);
+        }
+        if(count != 0)
+            run(run_offsets, count, loop.strides[inner]);
+    });
+}
+
+template <class T>
+void cpu_set_tensor(tensor<T>& super,
+                    const miopen::TensorDescriptor& desc,
+                    std::size_t offset,
+                    T alpha)
+{
+    cpu_for_each_run<1>(desc.GetLengths(),
+                        {{desc.GetStrides()}},
+                        {{offset}},
+                        {{super.data.size()}},
+                        [&](const auto& offsets, std::size_t count, const auto& strides) {
+                            cpu_tensor_run(count,
+                                           strides,
+                                           [&](T& y) { y = alpha; },
+                                           super.data.data() + offsets[0]);
+                        });
+}
+
+template <class T>
+void cpu_scale_tensor(tensor<T>& super,
+                      const miopen::TensorDescriptor& desc,
+                      std::size_t offset,
+                      T alpha)
+{
+    cpu_for_each_run<1>(desc.GetLengths(),
+                        {{desc.GetStrides()}},
+                        {{offset}},
+                        {{super.data.size()}},
+                        [&](const auto& offsets, std::size_t count, const auto& strides) {
+                            cpu_tensor_run(count,
+                                           strides,
+                                           [&](T& y) { y *= alpha; },
+                                           super.data.data() + offsets[0]);
+                        });
+}
+
+template <class T>
+void cpu_copy_tensor(const tensor<T>& src_super,
+                     const miopen::TensorDescriptor& src_desc,
+                     std::size_t src_offset,
+                     tensor<T>& dst_super,
+                     const miopen::TensorDescriptor& dst_desc,
+                     std::size_t dst_offset)
+{
+    cpu_for_each_run<2>(src_desc.GetLengths(),
+                        {{src_desc.GetStrides(), dst_desc.GetStrides()}},
+                        {{src_offset, dst_offset}},
+                        {{src_super.data.size(), dst_super.data.size()}},
+                        [&](const auto& offsets, std::size_t count, const auto& strides) {
+                            cpu_tensor_run(count,
+                                           strides,
+                                           [](const T& x, T& y) { y = x; },
+                                           src_super.data.data() + offsets[0],
+                                           dst_super.data.data() + offsets[1]);
+                        });
+}
+
+// dst = alpha * src + beta * dst
+template <class T>
+void cpu_transform_tensor(T alpha,
+                          const tensor<T>& src_super,
+                          const miopen::TensorDescriptor& src_desc,
+                          std::size_t src_offset,
+                          T beta,
+                          tensor<T>& dst_super,
+                          const miopen::TensorDescriptor& dst_desc,
+                          std::size_t dst_offset)
+{
+    cpu_for_each_run<2>(src_desc.GetLengths(),
+                        {{src_desc.GetStrides(), dst_desc.GetStrides()}},
+                        {{src_offset, dst_offset}},
+                        {{src_super.data.size(), dst_super.data.size()}},
+                        [&](const auto& offsets, std::size_t count, const auto& strides) {
+                            cpu_tensor_run(count,
+                                           strides,
+                                           [&](const T& x, T& y) { y = alpha * x + beta * y; },
+                                           src_super.data.data() + offsets[0],
+                                           dst_super.data.data() + offsets[1]);
+                        });
+}
+
+// c = op(alpha0 * a, alpha1 * b) + beta * c, where b is broadcast along its dimensions of
+// length 1, like OpTensor() does.
+template <class T>
+void cpu_op_tensor(miopenTensorOp_t op,
+                   float alpha0,
+                   const tensor<T>& a_super,
+                   const miopen::TensorDescriptor& a_desc,
+                   std::size_t a_offset,
+                   float alpha1,
+                   const tensor<T>& b_super,
+                   const miopen::TensorDescriptor& b_desc,
+                   std::size_t b_offset,
+                   float beta,
+                   tensor<T>& c_super,
+                   const miopen::TensorDescriptor& c_desc,
+                   std::size_t c_offset)
+{
+    const auto& lens = c_desc.GetLengths();
+    auto b_strides   = b_desc.GetStrides();
+    for(std::size_t d = 0; d < lens.size(); ++d)
+        if(b_desc.GetLengths()[d] != lens[d])
+            b_strides[d] = 0;
+
+    const auto apply = [&](auto f) {
+        cpu_for_each_run<3>(
+            lens,
+            {{a_desc.GetStrides(), b_strides, c_desc.GetStrides()}},
+            {{a_offset, b_offset, c_offset}},
+            {{a_super.data.size(), b_super.data.size(), c_super.data.size()}},
+            [&](const auto& offsets, std::size_t count, const auto& strides) {
+                cpu_tensor_run(count,
+                               strides,
+                               [&](const T& a, const T& b, T& c) {
+                                   c = f(T(a * alpha0), T(b * alpha1)) + beta * c;
+                               },
+                               a_super.data.data() + offsets[0],
+                               b_super.data.data() + offsets[1],
+                               c_super.data.data() + offsets[2]);
+            });
+    };
+
+    switch(op)
+    {
+    case miopenTensorOpAdd: apply([](T a, T b) -> T { return a + b; }); break;
+    case miopenTensorOpMul: apply([](T a, T b) -> T { return a * b; }); break;
+    case miopenTensorOpMin: apply([](T a, T b) -> T { return a < b ? a : b; }); break;
+    case miopenTensorOpMax: apply([](T a, T b) -> T { return a > b ? a : b; }); break;
+    }
+}
+
+#endif
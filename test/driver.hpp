@@ -30,10 +30,12 @@
 #include "serialize.hpp"
 #include "tensor_holder.hpp"
 #include "test.hpp"
+#include "verification_cache.hpp"
 #include "verify.hpp"
 
 #include <functional>
 #include <deque>
+#include <sstream>
 #include <half.hpp>
 #include <type_traits>
 #include <boost/filesystem.hpp>
@@ -97,6 +99,30 @@ auto cpu_async(V& v, Ts&&... xs) -> std::future<decltype(v.cpu(xs...))>
     return std::async(std::launch::deferred, [&] { return v.cpu(xs...); });
 }
 
+// Cached results are stored serialized, compressed and checksummed.
+template <class T>
+void save_cached_result(const std::string& name, const T& x)
+{
+    std::ostringstream os;
+    serialize(os, x);
+    const auto s = os.str();
+    // Serialized tensors are mostly 4-byte aligned floats, which compress better per byte plane.
+    const std::size_t element_size = s.size() % 4 == 0 ? 4 : 1;
+    miopen::SaveVerificationCache(name, s.data(), element_size, s.size() / element_size);
+}
+
+template <class T>
+bool load_cached_result(const std::string& name, T& x)
+{
+    miopen::VerificationCacheReader reader{name};
+    std::string s;
+    if(!reader.ReadBytes(s))
+        return false;
+    std::istringstream is{s};
+    serialize(is, x);
+    return !is.fail();
+}
+
 MIOPEN_DECLARE_ENV_VAR(MIOPEN_VERIFY_CACHE_PATH)
 
 struct test_driver
@@ -158,7 +184,7 @@ struct test_driver
     std::string program_name;
     std::deque<argument> arguments;
     std::unordered_map<std::string, std::size_t> argument_index;
-    int cache_version      = 1;
+    int cache_version      = 2;
     std::string cache_path = compute_cache_path();
     miopenDataType_t type  = miopenFloat;
     bool full_set          = false;
@@ -660,17 +686,27 @@ struct test_driver
         if(boost::filesystem::exists(f) and not retry)
         {
             miss = false;
-            return detach_async([=] {
-                result_type result;
-                load(f.string(), result);
+            auto loaded = detach_async([=] {
+                std::pair<bool, result_type> result;
+                result.first = load_cached_result(f.string(), result.second);
                 return result;
             });
+            // A corrupt entry is recomputed on the calling thread, as v may not be const.
+            return then(std::move(loaded), [=, &v, &xs...](auto result) {
+                if(result.first)
+                    return std::move(result.second);
+                std::cerr << "Warning: corrupt verification cache entry " << f.string()
+                          << ", recomputing" << std::endl;
+                result.second = v.cpu(xs...);
+                save_cached_result(f.string(), result.second);
+                return std::move(result.second);
+            });
         }
         else
         {
             miss = true;
             return then(cpu_async(v, xs...), [=](auto data) {
-                save(f.string(), data);
+                save_cached_result(f.string(), data);
                 return data;
             });
         }
@@ -772,13 +808,22 @@ struct test_driver
 
     template <class V, class... Ts>
     auto verify(V&& v, Ts&&... xs) -> decltype(std::make_pair(v.cpu(xs...), v.gpu(xs...)))
+    {
+        return verify_with_tolerance(tolerance, v, xs...);
+    }
+
+    // Same as verify() with a tolerance tighter than the --tolerance default, for operations
+    // whose host reference models the rounding of the device.
+    template <class V, class... Ts>
+    auto verify_with_tolerance(double tol, V&& v, Ts&&... xs)
+        -> decltype(std::make_pair(v.cpu(xs...), v.gpu(xs...)))
     {
         return verify_impl(
             [&](std::vector<double>& error, auto&& cpu, auto&& gpu) {
                 CHECK(miopen::range_distance(cpu) == miopen::range_distance(gpu));
 
                 using value_type = miopen::range_value<decltype(gpu)>;
-                double threshold = std::numeric_limits<value_type>::epsilon() * tolerance;
+                double threshold = std::numeric_limits<value_type>::epsilon() * tol;
                 error            = {miopen::rms_range(cpu, gpu)};
                 return error.front() <= threshold;
             },
@@ -36,8 +36,7 @@
 #include <miopen/dropout.hpp>
 #include <miopen/tensor.hpp>
 #include <utility>
-#include <miopen/precalc_xorwow_skipahead_matrices.hpp>
-#include <miopen/precalc_xorwow_skipahead_sequence_matrices.hpp>
+#include <miopen/xorwow_host_engine.hpp>
 
 #include "driver.hpp"
 #include "get_handle.hpp"
@@ -219,18 +218,21 @@ void InitKernelStateEmulator(std::vector<prngStates>& states,
                              const miopen::DropoutDescriptor& dropoutDesc)
 {
     size_t states_num = dropoutDesc.stateSizeInBytes / sizeof(prngStates);
-    size_t wk_grp_num = std::min(size_t(MAX_PRNG_STATE / 256), (states_num + 255) / 256);
-    size_t glb_sz     = wk_grp_num * 256;
-
-    for(size_t j = 0; j < (states_num + glb_sz - 1) / glb_sz; j++)
+    miopen::GetXorwowStateEngine().Generate(dropoutDesc.seed, states.data(), states_num);
+
+    // Spot-check the engine against the per-state skipahead emulation
+    for(size_t gid : {size_t(0),
+                      size_t(1),
+                      miopen::XorwowStateEngine::block_size + 1,
+                      states_num / 2,
+                      states_num - 1})
     {
-        for(size_t i = 0; i < glb_sz; i++)
-        {
-            size_t gid                = i + j * glb_sz;
-            unsigned long long seq    = gid;
-            unsigned long long offset = 0;
-            xorwow_lite_init_emu(&states[gid], dropoutDesc.seed, seq, offset);
-        }
+        if(gid >= states_num)
+            continue;
+        prngStates ref;
+        xorwow_lite_init_emu(&ref, dropoutDesc.seed, gid, 0);
+        EXPECT(std::equal(&ref.x, &ref.x + XORWOW_DIM, &states[gid].x));
+        EXPECT(ref.d == states[gid].d);
     }
 }
 
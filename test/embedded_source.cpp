@@ -0,0 +1,104 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2019 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/embedded_source.hpp>
+#include <miopen/lz4_block.hpp>
+#include <string>
+#include "test.hpp"
+
+std::string MakeText()
+{
+    std::string text;
+    for(int i = 0; i < 2000; ++i)
+        text += "__kernel void k" + std::to_string(i % 37) + "(global float* x) { x[" +
+                std::to_string(i) + "] = 0; }\n";
+    // Long literal run and long overlapping match.
+    for(int i = 0; i < 600; ++i)
+        text += static_cast<char>('a' + (i * 7919) % 26);
+    text += std::string(1000, 'z');
+    return text;
+}
+
+bool RoundTrips(const std::string& data)
+{
+    const auto compressed = miopen::Lz4Compress(data.data(), data.size());
+    std::string result(data.size(), '\0');
+    return miopen::Lz4Decompress(reinterpret_cast<const unsigned char*>(compressed.data()),
+                                 compressed.size(),
+                                 &result[0],
+                                 result.size()) &&
+           result == data;
+}
+
+void check_round_trip()
+{
+    EXPECT(RoundTrips(""));
+    EXPECT(RoundTrips("a"));
+    EXPECT(RoundTrips("abcdabcdabcd"));
+    EXPECT(RoundTrips(std::string(100, '\0')));
+    const auto text = MakeText();
+    EXPECT(RoundTrips(text));
+    EXPECT(miopen::Lz4Compress(text.data(), text.size()).size() < text.size() / 4);
+}
+
+void check_malformed()
+{
+    const auto text       = MakeText();
+    const auto compressed = miopen::Lz4Compress(text.data(), text.size());
+    const auto src        = reinterpret_cast<const unsigned char*>(compressed.data());
+    std::string result(text.size() + 1, '\0');
+
+    // Wrong size of the output.
+    EXPECT(!miopen::Lz4Decompress(src, compressed.size(), &result[0], text.size() - 1));
+    EXPECT(!miopen::Lz4Decompress(src, compressed.size(), &result[0], text.size() + 1));
+    // Truncated input.
+    EXPECT(!miopen::Lz4Decompress(src, compressed.size() / 2, &result[0], text.size()));
+    // Offset before the start of the output.
+    const unsigned char bad_offset[] = {0x10, 'a', 0x02, 0x00, 0x00};
+    EXPECT(!miopen::Lz4Decompress(bad_offset, sizeof(bad_offset), &result[0], 6));
+}
+
+void check_embedded_source()
+{
+    const auto text       = MakeText();
+    const auto compressed = miopen::Lz4Compress(text.data(), text.size());
+    const auto data       = reinterpret_cast<const unsigned char*>(compressed.data());
+
+    const miopen::EmbeddedSource packed{data, text.size(), compressed.size()};
+    EXPECT(miopen::LoadEmbeddedSource(packed) == text);
+    EXPECT(miopen::LoadEmbeddedSource(packed) == text);
+
+    const miopen::EmbeddedSource raw{
+        reinterpret_cast<const unsigned char*>(text.data()), text.size(), 0};
+    EXPECT(miopen::LoadEmbeddedSource(raw) == text);
+}
+
+int main()
+{
+    check_round_trip();
+    check_malformed();
+    check_embedded_source();
+}
@@ -0,0 +1,148 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2019 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include "test.hpp"
+#include "get_handle.hpp"
+
+#include <miopen/convolution.hpp>
+#include <miopen/find_db.hpp>
+#include <miopen/problem_buckets.hpp>
+#include <miopen/problem_description.hpp>
+#include <miopen/temp_file.hpp>
+
+#include <cstdlib>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace miopen {
+
+static ProblemDescription MakeProblem(int batch)
+{
+    const ConvolutionDescriptor conv{
+        2, miopenConvolution, miopenPaddingDefault, {1, 1}, {1, 1}, {1, 1}};
+    const TensorDescriptor x{miopenFloat, std::vector<int>{batch, 16, 14, 14}};
+    const TensorDescriptor w{miopenFloat, std::vector<int>{32, 16, 3, 3}};
+    return {x, w, conv.GetForwardOutputTensor(x, w), conv, 1};
+}
+
+static std::string GetNetworkConfig(const ProblemDescription& problem)
+{
+    std::string network_config;
+    problem.mloBuildConf_Key(network_config);
+    return network_config;
+}
+
+// Runs Find of the problem, which measures a direct, a GEMM and an FFT item.
+static void Find(const ProblemDescription& problem, float time, std::size_t workspace)
+{
+    FindDbRecord::TryLoad(get_handle(), problem, [&](DbRecord& record) {
+        record.SetValues("miopenConvolutionFwdAlgoDirect",
+                         FindDbData{"ConvOclDirectFwd",
+                                    time,
+                                    workspace,
+                                    {"miopenConvolutionFwdAlgoDirect", GetNetworkConfig(problem)}});
+        record.SetValues(
+            "miopenConvolutionFwdAlgoGEMM",
+            FindDbData{"gemm",
+                       time / 2,
+                       2 * workspace,
+                       FindDbKCacheKey::MakeUnused("miopenConvolutionFwdAlgoGEMM")});
+        record.SetValues(
+            "miopenConvolutionFwdAlgoFFT",
+            FindDbData{"fft", time * 2, workspace, {"miopenConvolutionFwdAlgoFFT", "fft"}});
+    });
+}
+
+static std::map<std::string, FindDbData> Lookup(const ProblemDescription& problem,
+                                                bool& from_bucket)
+{
+    const FindDbRecord record{get_handle(), problem};
+    from_bucket = record.IsFromBucket();
+    if(record.empty())
+        return {};
+    return {record.begin(), record.end()};
+}
+
+static void CheckBuckets()
+{
+    const auto batch4 = MakeProblem(4);
+    const auto batch3 = MakeProblem(3);
+    const auto batch2 = MakeProblem(2);
+    bool from_bucket  = false;
+
+    // Batches 3 and 4 share the bucket 4, which is keyed apart from the problem of batch 4.
+    EXPECT(GetBucketRepresentative(batch3).batch_sz == 4);
+    EXPECT(DbRecord{ProblemBucket{GetBucketRepresentative(batch4)}}.GetKey() !=
+           DbRecord{batch4}.GetKey());
+
+    EXPECT(Lookup(batch3, from_bucket).empty());
+    Find(batch4, 1.0f, 100);
+
+    // The bucket of batch 4 is rekeyed to the network config of batch 3, without GEMM and FFT.
+    auto items = Lookup(batch3, from_bucket);
+    EXPECT(from_bucket);
+    EXPECT(items.size() == 1);
+    EXPECT(items.count("miopenConvolutionFwdAlgoGEMM") == 0);
+    EXPECT(items.count("miopenConvolutionFwdAlgoFFT") == 0);
+    const auto& direct = items.at("miopenConvolutionFwdAlgoDirect");
+    EXPECT(direct.solver_id == "ConvOclDirectFwd");
+    EXPECT(direct.time == 1.0f);
+    EXPECT(direct.kcache_key.network_config == GetNetworkConfig(batch3));
+
+    // Batch 2 has a bucket of its own.
+    EXPECT(Lookup(batch2, from_bucket).empty());
+
+    // Find of batch 3 measures it and replaces the bucket, but not the record of batch 4.
+    Find(batch3, 2.0f, 50);
+    items = Lookup(batch3, from_bucket);
+    EXPECT(!from_bucket);
+    EXPECT(items.size() == 3);
+    EXPECT(items.at("miopenConvolutionFwdAlgoDirect").workspace == 50);
+
+    items = Lookup(batch4, from_bucket);
+    EXPECT(!from_bucket);
+    EXPECT(items.size() == 3);
+    EXPECT(items.at("miopenConvolutionFwdAlgoDirect").time == 1.0f);
+    EXPECT(items.at("miopenConvolutionFwdAlgoDirect").workspace == 100);
+    EXPECT(items.at("miopenConvolutionFwdAlgoDirect").kcache_key.network_config ==
+           GetNetworkConfig(batch4));
+    EXPECT(items.at("miopenConvolutionFwdAlgoGEMM").workspace == 200);
+}
+
+} // namespace miopen
+
+int main()
+{
+    // Read once, on the first lookup.
+    setenv("MIOPEN_FIND_DB_BATCH_BUCKETS", "1,2,4,8", 1); // NOLINT
+    EXPECT(miopen::IsProblemBucketingEnabled());
+
+    const miopen::TempFile temp_file{"miopen.test.find_db_buckets"};
+    miopen::FindDbRecord::path_override() = temp_file.Path();
+    miopen::CheckBuckets();
+    miopen::FindDbRecord::path_override() = boost::none;
+}
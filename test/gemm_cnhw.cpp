@@ -0,0 +1,131 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2019 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/config.h>
+#include <miopen/convolution.hpp>
+#include <miopen/handle.hpp>
+#include <miopen/tensor.hpp>
+#include <cstddef>
+#include <iostream>
+#include <random>
+#include <vector>
+#include "get_handle.hpp"
+#include "test.hpp"
+#include "verify.hpp"
+
+// ConvolutionForwardGemm() with CNHW x and y gives the results of the NCHW path.
+
+std::vector<float> ToCNHW(const std::vector<float>& src, int n, int c, int hw)
+{
+    std::vector<float> dst(src.size());
+    for(int in = 0; in < n; ++in)
+        for(int ic = 0; ic < c; ++ic)
+            for(int i = 0; i < hw; ++i)
+                dst[(ic * n + in) * hw + i] = src[(in * c + ic) * hw + i];
+    return dst;
+}
+
+std::vector<float> FromCNHW(const std::vector<float>& src, int n, int c, int hw)
+{
+    std::vector<float> dst(src.size());
+    for(int in = 0; in < n; ++in)
+        for(int ic = 0; ic < c; ++ic)
+            for(int i = 0; i < hw; ++i)
+                dst[(in * c + ic) * hw + i] = src[(ic * n + in) * hw + i];
+    return dst;
+}
+
+void check_layouts(int n, int c, int h, int w, int k, int stride)
+{
+    auto&& handle = get_handle();
+    const miopen::ConvolutionDescriptor conv{
+        2, miopenConvolution, miopenPaddingDefault, {0, 0}, {stride, stride}};
+    const miopen::TensorDescriptor xDesc{miopenFloat, std::vector<int>{n, c, h, w}};
+    const miopen::TensorDescriptor wDesc{miopenFloat, std::vector<int>{k, c, 1, 1}};
+    const auto yDesc = conv.GetForwardOutputTensor(xDesc, wDesc);
+    EXPECT(conv.IsGemmTransposeFwd(xDesc, wDesc));
+
+    const auto out_hw = static_cast<int>(yDesc.GetLengths()[2] * yDesc.GetLengths()[3]);
+    std::mt19937 gen(n * 1000 + c * 10 + stride);
+    std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+    std::vector<float> x(xDesc.GetElementSize());
+    std::vector<float> wei(wDesc.GetElementSize());
+    for(auto& v : x)
+        v = dist(gen);
+    for(auto& v : wei)
+        v = dist(gen);
+
+    const auto workspace_size = conv.ForwardGetValidWorkSpaceSizeGemm(handle, wDesc, xDesc, yDesc);
+    auto workspace_dev        = handle.Create(workspace_size);
+    auto w_dev                = handle.Write(wei);
+
+    const auto run = [&](miopen::ConvLayout x_layout, miopen::ConvLayout y_layout) {
+        auto x_dev =
+            handle.Write(x_layout == miopen::ConvLayout::CNHW ? ToCNHW(x, n, c, h * w) : x);
+        auto y_dev = handle.Write(std::vector<float>(yDesc.GetElementSize(), 0.0f));
+        conv.ConvolutionForwardGemm(handle,
+                                    xDesc,
+                                    x_dev.get(),
+                                    wDesc,
+                                    w_dev.get(),
+                                    yDesc,
+                                    y_dev.get(),
+                                    workspace_dev.get(),
+                                    workspace_size,
+                                    x_layout,
+                                    y_layout);
+        const auto y = handle.Read<float>(y_dev, yDesc.GetElementSize());
+        return y_layout == miopen::ConvLayout::CNHW ? FromCNHW(y, n, k, out_hw) : y;
+    };
+
+    const auto nchw = run(miopen::ConvLayout::NCHW, miopen::ConvLayout::NCHW);
+    for(const auto x_layout : {miopen::ConvLayout::NCHW, miopen::ConvLayout::CNHW})
+    {
+        for(const auto y_layout : {miopen::ConvLayout::NCHW, miopen::ConvLayout::CNHW})
+        {
+            const auto error = miopen::rms_range(nchw, run(x_layout, y_layout));
+            if(!(error < 1e-6))
+            {
+                std::cout << "n=" << n << " c=" << c << " hw=" << h << 'x' << w << " k=" << k
+                          << " stride=" << stride << " x=" << x_layout << " y=" << y_layout
+                          << ": error " << error << std::endl;
+            }
+            EXPECT(error < 1e-6);
+        }
+    }
+}
+
+int main()
+{
+#if MIOPEN_USE_GEMM
+    check_layouts(4, 16, 14, 14, 8, 1);
+    // A CNHW input of a strided layer is subsampled by transposing it as a single image of
+    // n * c channels.
+    check_layouts(4, 16, 14, 14, 8, 2);
+    check_layouts(3, 5, 7, 9, 6, 2);
+    check_layouts(1, 32, 7, 7, 16, 1);
+#endif
+}
@@ -0,0 +1,112 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2019 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/find_db.hpp>
+#include <miopen/immediate_mode_cache.hpp>
+#include <miopen/temp_file.hpp>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <thread>
+#include "get_handle.hpp"
+#include "test.hpp"
+
+std::shared_ptr<const miopen::ImmediateSolutions> MakeSolutions(std::size_t count)
+{
+    auto solutions = std::make_shared<miopen::ImmediateSolutions>();
+    for(std::size_t i = 0; i < count; ++i)
+        solutions->solutions.push_back(
+            {static_cast<float>(i), i * 16, i + 1, miopenConvolutionAlgoDirect});
+    return solutions;
+}
+
+void check_cache()
+{
+    miopen::ImmediateModeCache cache;
+    EXPECT(cache.Find("a", "v1") == nullptr);
+
+    const auto solutions = MakeSolutions(3);
+    cache.Insert("a", "v1", solutions);
+    EXPECT(cache.Find("a", "v1") == solutions);
+    EXPECT(cache.Find("b", "v1") == nullptr);
+    // Entries computed from another version of the find-db are not returned.
+    EXPECT(cache.Find("a", "v2") == nullptr);
+
+    cache.Insert("a", "v2", MakeSolutions(1));
+    EXPECT(cache.Find("a", "v1") == nullptr);
+    EXPECT(cache.Find("a", "v2")->solutions.size() == 1);
+
+    for(std::size_t i = 0; i < miopen::ImmediateModeCache::max_entries; ++i)
+        cache.Insert(std::to_string(i), "v2", solutions);
+    EXPECT(cache.Find("a", "v2") == nullptr);
+    EXPECT(cache.Find(std::to_string(miopen::ImmediateModeCache::max_entries - 1), "v2") ==
+           solutions);
+
+    cache.Clear();
+    EXPECT(cache.Find("0", "v2") == nullptr);
+}
+
+void check_find_db_version()
+{
+    auto&& handle = get_handle();
+    const miopen::TempFile temp_file{"miopen.test.immediate_mode_cache"};
+    miopen::FindDbRecord::path_override() = temp_file.Path();
+
+    const auto empty = miopen::FindDbRecord::GetVersion(handle);
+    EXPECT(empty == miopen::FindDbRecord::GetVersion(handle));
+    {
+        std::ofstream file{temp_file.Path()};
+        file << "1-1-1-1x1-1-1x1-1x1-0x0-1x1-1x1-1-NCHW-FP32-F=miopenConvolutionFwdAlgoGEMM:"
+                "gemm,0.1,0,miopenConvolutionFwdAlgoGEMM,<unused>\n";
+    }
+    std::this_thread::sleep_for(miopen::FindDbRecord::version_poll_interval);
+    const auto written = miopen::FindDbRecord::GetVersion(handle);
+    EXPECT(written != empty);
+
+    // A rewrite of the same size, likely within the same second.
+    {
+        std::ofstream file{temp_file.Path()};
+        file << "1-1-1-1x1-1-1x1-1x1-0x0-1x1-1x1-1-NCHW-FP32-F=miopenConvolutionFwdAlgoGEMM:"
+                "gemm,0.2,0,miopenConvolutionFwdAlgoGEMM,<unused>\n";
+    }
+    // Writes of other processes are seen after the poll interval.
+    std::this_thread::sleep_for(miopen::FindDbRecord::version_poll_interval);
+    const auto rewritten = miopen::FindDbRecord::GetVersion(handle);
+    EXPECT(rewritten != written);
+
+    miopen::FindDbRecord::enabled = false;
+    EXPECT(miopen::FindDbRecord::GetVersion(handle) != rewritten);
+    miopen::FindDbRecord::enabled = true;
+    EXPECT(miopen::FindDbRecord::GetVersion(handle) == rewritten);
+
+    miopen::FindDbRecord::path_override() = boost::none;
+}
+
+int main()
+{
+    check_cache();
+    check_find_db_version();
+}
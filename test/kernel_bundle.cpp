@@ -0,0 +1,153 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2019 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/kernel_bundle.hpp>
+#include <sstream>
+#include <string>
+#include "test.hpp"
+
+miopen::KernelBundle MakeBundle()
+{
+    miopen::KernelBundle bundle;
+    bundle.device = "gfx906";
+    bundle.AddProgram("MIOpenConv1x1S.cl", " -DMLO_N_INPUTS=64", false, std::string("\0ELF\1", 5));
+    bundle.AddProgram("__kernel void miog_betac(){}", " -cl-std=CL2.0", true, "binary");
+    bundle.AddKernel({"miopenConvolutionFwdAlgoDirect",
+                      "64x56x56x1x1x64x56x56x16xNCHWxFP32x1",
+                      0,
+                      "MIOpenConv1x1S.cl",
+                      " -DMLO_N_INPUTS=64",
+                      false,
+                      "MIOpenConv1x1",
+                      {256, 1, 1},
+                      {50176, 16, 1}});
+    bundle.AddKernel({"miopenConvolutionFwdAlgoGEMM",
+                      "0_1_64_64_64_64_64_64",
+                      1,
+                      "__kernel void miog_betac(){}",
+                      " -cl-std=CL2.0",
+                      true,
+                      "miog_betac",
+                      {256},
+                      {1024}});
+    return bundle;
+}
+
+std::string WriteBundle(const miopen::KernelBundle& bundle)
+{
+    std::ostringstream ss;
+    bundle.Write(ss);
+    return ss.str();
+}
+
+miopen::KernelBundle ReadBundle(const std::string& s)
+{
+    std::istringstream ss(s);
+    return miopen::KernelBundle::Read(ss);
+}
+
+void check_round_trip()
+{
+    const auto bundle = MakeBundle();
+    const auto read   = ReadBundle(WriteBundle(bundle));
+    EXPECT(read.device == bundle.device);
+    EXPECT(read.programs == bundle.programs);
+    EXPECT(read.kernels.size() == 2);
+    EXPECT(read.kernels[0] == bundle.kernels[0]);
+    EXPECT(read.kernels[1] == bundle.kernels[1]);
+
+    const auto binary = read.FindProgram("MIOpenConv1x1S.cl", " -DMLO_N_INPUTS=64", false);
+    EXPECT(binary != nullptr);
+    EXPECT(*binary == std::string("\0ELF\1", 5));
+    EXPECT(read.FindProgram("MIOpenConv1x1S.cl", " -DMLO_N_INPUTS=64", true) == nullptr);
+    EXPECT(read.FindProgram("MIOpenConv1x1S.cl", " -DMLO_N_INPUTS=32", false) == nullptr);
+}
+
+void check_corruption()
+{
+    const auto s = WriteBundle(MakeBundle());
+    EXPECT(throws([&] { ReadBundle(""); }));
+    EXPECT(throws([&] { ReadBundle("MIOPENKX" + s.substr(8)); }));
+    EXPECT(throws([&] { ReadBundle(s.substr(0, s.size() - 1)); }));
+
+    auto flipped = s;
+    flipped[s.size() / 2] ^= 1;
+    EXPECT(throws([&] { ReadBundle(flipped); }));
+}
+
+void check_kernel_slots()
+{
+    auto bundle = MakeBundle();
+    auto kernel = bundle.kernels[0];
+    bundle.AddKernel(kernel);
+    EXPECT(bundle.kernels.size() == 2);
+
+    // The kernel cache keeps the last kernel added to a slot.
+    kernel.vgd = {25088, 16, 1};
+    bundle.AddKernel(kernel);
+    EXPECT(bundle.kernels.size() == 2);
+    EXPECT(bundle.kernels[0] == kernel);
+
+    kernel.cache_index = 1;
+    bundle.AddKernel(kernel);
+    EXPECT(bundle.kernels.size() == 3);
+}
+
+void check_recording()
+{
+    EXPECT(throws([] { miopen::StopKernelBundleRecording(); }));
+    miopen::RecordBundleProgram("gfx906", "ignored.cl", "", false, "binary");
+
+    miopen::StartKernelBundleRecording();
+    EXPECT(miopen::IsRecordingKernelBundle());
+    const auto bundle = MakeBundle();
+    for(const auto& program : bundle.programs)
+        miopen::RecordBundleProgram(bundle.device,
+                                    std::get<0>(program.first),
+                                    std::get<1>(program.first),
+                                    std::get<2>(program.first),
+                                    program.second);
+    for(const auto& kernel : bundle.kernels)
+        miopen::RecordBundleKernel(kernel);
+    const auto recorded = miopen::StopKernelBundleRecording();
+    EXPECT(!miopen::IsRecordingKernelBundle());
+    EXPECT(recorded.device == bundle.device);
+    EXPECT(recorded.programs == bundle.programs);
+    EXPECT(recorded.kernels.size() == bundle.kernels.size());
+
+    miopen::StartKernelBundleRecording();
+    miopen::RecordBundleProgram("gfx906", "a.cl", "", false, "binary");
+    miopen::RecordBundleProgram("gfx908", "a.cl", "", false, "binary");
+    EXPECT(throws([] { miopen::StopKernelBundleRecording(); }));
+}
+
+int main()
+{
+    check_round_trip();
+    check_corruption();
+    check_kernel_slots();
+    check_recording();
+}
@@ -0,0 +1,112 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2019 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/layout_planner.hpp>
+#include <vector>
+#include "network_data.hpp"
+#include "test.hpp"
+
+miopen::LayoutPlanLayer MakeLayer(int n, int c, int hw, int k, int filter, int pad, int stride)
+{
+    return {miopen::ConvolutionDescriptor{2,
+                                          miopenConvolution,
+                                          miopenPaddingDefault,
+                                          {pad, pad},
+                                          {stride, stride}},
+            miopen::TensorDescriptor{miopenFloat, std::vector<int>{n, c, hw, hw}},
+            miopen::TensorDescriptor{miopenFloat, std::vector<int>{k, c, filter, filter}}};
+}
+
+void check_plan_consistency(const std::vector<miopen::LayoutPlanLayer>& layers,
+                            const miopen::LayoutPlan& plan)
+{
+    EXPECT(plan.steps.size() == layers.size());
+    std::size_t transposes = 0;
+    for(std::size_t i = 0; i < layers.size(); ++i)
+    {
+        const auto& step = plan.steps[i];
+        const auto prev  = i == 0 ? miopen::ConvLayout::NCHW : plan.steps[i - 1].output;
+        EXPECT(step.input == prev);
+        if(!layers[i].conv.IsGemmTransposeFwd(layers[i].xDesc, layers[i].wDesc))
+        {
+            EXPECT(step.input == miopen::ConvLayout::NCHW);
+            EXPECT(step.output == miopen::ConvLayout::NCHW);
+            EXPECT(step.transposes == 0);
+        }
+        transposes += step.transposes;
+    }
+    EXPECT(plan.steps.empty() || plan.steps.back().output == miopen::ConvLayout::NCHW);
+    EXPECT(transposes == plan.transposes);
+    EXPECT(plan.transposes <= plan.baseline_transposes);
+}
+
+void check_resnet50()
+{
+    std::vector<miopen::LayoutPlanLayer> layers;
+    for(const auto& l : get_resnet50_chain())
+        layers.push_back(MakeLayer(32, l[0], l[1], l[3], l[4], l[5], l[6]));
+
+    const auto plan = miopen::PlanConvLayouts(layers);
+    check_plan_consistency(layers, plan);
+
+    // Transpose path: conv3_1a, conv4_1a, conv5_1a (1x1, stride 2) and the 1x1 convolutions of
+    // conv4_x and conv5_x (1x1, 14x14 or smaller), 19 layers with two transposes each.
+    EXPECT(plan.baseline_transposes == 38);
+    // Blocks conv4_1..conv4_6 and conv5_1..conv5_3 are chained by 8 pairs of 1x1 layers. All of
+    // them save two transposes but conv4_6c -> conv5_1a, which still subsamples its input.
+    EXPECT(plan.transposes == 38 - 15);
+}
+
+void check_chain()
+{
+    // 1x1 stride 1 -> 1x1 stride 2 -> 3x3 -> 1x1 stride 1
+    const std::vector<miopen::LayoutPlanLayer> layers = {MakeLayer(8, 64, 14, 64, 1, 0, 1),
+                                                         MakeLayer(8, 64, 14, 32, 1, 0, 2),
+                                                         MakeLayer(8, 32, 7, 32, 3, 1, 1),
+                                                         MakeLayer(8, 32, 7, 16, 1, 0, 1)};
+    const auto plan = miopen::PlanConvLayouts(layers);
+    check_plan_consistency(layers, plan);
+    EXPECT(plan.steps[0].output == miopen::ConvLayout::CNHW);
+    EXPECT(plan.steps[0].transposes == 1);
+    EXPECT(plan.steps[1].input == miopen::ConvLayout::CNHW);
+    EXPECT(plan.steps[1].transposes == 2);
+    EXPECT(plan.steps[3].input == miopen::ConvLayout::NCHW);
+    EXPECT(plan.steps[3].transposes == 2);
+    EXPECT(plan.transposes == 5);
+    EXPECT(plan.baseline_transposes == 6);
+
+    EXPECT(miopen::PlanConvLayouts({}).steps.empty());
+    // The second layer does not take the output of the first one.
+    EXPECT(throws([&] {
+        miopen::PlanConvLayouts({layers[0], layers[2]});
+    }));
+}
+
+int main()
+{
+    check_chain();
+    check_resnet50();
+}
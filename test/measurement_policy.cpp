@@ -0,0 +1,133 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2019 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/measurement_policy.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <vector>
+#include "test.hpp"
+
+using miopen::solver::MeasurementPolicy;
+using miopen::solver::MeasurementResult;
+
+// Replays the given times, then repeats the last one.
+struct SyntheticTimer
+{
+    std::vector<float> times;
+    std::size_t runs    = 0;
+    std::size_t fail_at = std::numeric_limits<std::size_t>::max();
+
+    int operator()(float& elapsed)
+    {
+        if(runs == fail_at)
+            return -1;
+        elapsed = times[std::min(runs, times.size() - 1)];
+        ++runs;
+        return 0;
+    }
+};
+
+template <class Timer>
+MeasurementResult Measure(const MeasurementPolicy& policy,
+                          Timer& timer,
+                          float best_time = std::numeric_limits<float>::max())
+{
+    return policy.Measure([&](float& elapsed) { return timer(elapsed); }, best_time);
+}
+
+void check_estimators()
+{
+    MeasurementPolicy policy;
+    const std::vector<float> samples = {1.0f, 1.1f, 0.9f, 1.05f, 0.95f, 9.0f};
+
+    policy.estimator = MeasurementPolicy::Estimator::Median;
+    const auto median = policy.Estimate(samples);
+    EXPECT_EQUAL(median.outliers, 1u);
+    EXPECT_EQUAL(median.samples, 5u);
+    EXPECT_EQUAL(median.time, 1.0f);
+    EXPECT(median.variance > 0.0f && median.variance < 0.01f);
+
+    policy.estimator = MeasurementPolicy::Estimator::TrimmedMean;
+    const auto trimmed = policy.Estimate(samples);
+    EXPECT(std::fabs(trimmed.time - 1.0f) < 1e-5f);
+}
+
+void check_warmup_and_early_stop()
+{
+    MeasurementPolicy policy;
+    policy.warmup_runs = 2;
+    policy.min_runs    = 3;
+    policy.max_runs    = 10;
+
+    // Cold first runs are not counted, and stable samples stop at min_runs.
+    SyntheticTimer stable{{5.0f, 3.0f, 1.0f}};
+    const auto r = Measure(policy, stable);
+    EXPECT_EQUAL(r.ret, 0);
+    EXPECT_EQUAL(r.time, 1.0f);
+    EXPECT_EQUAL(r.samples, 3u);
+    EXPECT_EQUAL(stable.runs, 5u);
+
+    // Noisy samples are taken up to max_runs.
+    SyntheticTimer noisy{{1.0f, 1.0f, 2.0f, 1.0f, 2.0f, 1.0f, 2.0f, 1.0f, 2.0f, 1.0f, 2.0f, 1.0f}};
+    const auto n = Measure(policy, noisy);
+    EXPECT_EQUAL(noisy.runs, 12u);
+    EXPECT_EQUAL(n.samples + n.outliers, 10u);
+}
+
+void check_probe_and_rejection()
+{
+    MeasurementPolicy policy;
+
+    // Too slow after the first probe.
+    SyntheticTimer slow{{2.0f}};
+    const auto r = Measure(policy, slow, 1.0f);
+    EXPECT(r.probe_only);
+    EXPECT_EQUAL(slow.runs, 1u);
+
+    // Promising probe, but clearly slower than the best once measured properly.
+    SyntheticTimer worse{{1.0f, 1.5f, 1.5f, 1.5f, 1.5f}};
+    const auto w = Measure(policy, worse, 1.05f);
+    EXPECT(!w.probe_only);
+    EXPECT_EQUAL(w.time, 1.5f);
+    EXPECT_EQUAL(worse.runs, 4u);
+
+    // A lucky probe does not win over a config which is faster on average.
+    SyntheticTimer lucky{{0.5f, 1.2f, 1.2f, 1.2f}};
+    EXPECT(Measure(policy, lucky, 1.0f).time > 1.0f);
+
+    SyntheticTimer failing{{1.0f}};
+    failing.fail_at = 2;
+    EXPECT_EQUAL(Measure(policy, failing).ret, -1);
+}
+
+int main()
+{
+    check_estimators();
+    check_warmup_and_early_stop();
+    check_probe_and_rejection();
+}
@@ -0,0 +1,96 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2019 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/miopengemm_db.hpp>
+#include <miopen/temp_file.hpp>
+#include <sstream>
+#include <string>
+#include "test.hpp"
+
+miopen::MiopengemmKernels MakeKernels()
+{
+    miopen::MiopengemmKernels kernels;
+    kernels.kernels.push_back({"miog_betac", "__kernel void miog_betac(){}\n", 256, 1024});
+    kernels.kernels.push_back(
+        {"miog_alphaab",
+         "/* 100% a:b=c; */\n__kernel void miog_alphaab(const unsigned a_offset,\r\n)\n{}",
+         64,
+         4096});
+    return kernels;
+}
+
+bool operator==(const miopen::MiopengemmKernel& a, const miopen::MiopengemmKernel& b)
+{
+    return a.name == b.name && a.source == b.source && a.local_work_size == b.local_work_size &&
+           a.global_work_size == b.global_work_size;
+}
+
+void check_serialization()
+{
+    const auto kernels = MakeKernels();
+    std::ostringstream ss;
+    kernels.Serialize(ss);
+    const auto s = ss.str();
+    // Kernel sources shall not break the db line format.
+    EXPECT(s.find_first_of("\n\r=;:") == std::string::npos);
+
+    miopen::MiopengemmKernels read;
+    EXPECT(read.Deserialize(s));
+    EXPECT(read.kernels.size() == 2);
+    EXPECT(read.kernels[0] == kernels.kernels[0]);
+    EXPECT(read.kernels[1] == kernels.kernels[1]);
+
+    EXPECT(!read.Deserialize(""));
+    EXPECT(!read.Deserialize("0"));
+    EXPECT(!read.Deserialize("2,miog_betac,256,1024,src"));
+    EXPECT(!read.Deserialize("1,miog_betac,x,1024,src"));
+    EXPECT(!read.Deserialize("1,miog_betac,256,1024,bad%2"));
+    EXPECT(!read.Deserialize("1,miog_betac,256,1024,bad%zz"));
+    EXPECT(read.kernels.size() == 2);
+}
+
+void check_db()
+{
+    const miopen::TempFile temp_file{"miopen.test.miopengemm_db"};
+    const auto key = miopen::MiopengemmDbKey{"0_1_64_64_64_64_64_64", false};
+    EXPECT(!miopen::MiopengemmDb::Load(temp_file, key));
+
+    miopen::MiopengemmDb::Store(temp_file, key, MakeKernels());
+    const auto loaded = miopen::MiopengemmDb::Load(temp_file, key);
+    EXPECT(loaded);
+    EXPECT(loaded->kernels.size() == 2);
+    EXPECT(loaded->kernels[1] == MakeKernels().kernels[1]);
+
+    // Kernels searched with enforced determinism are kept apart.
+    const auto deterministic = miopen::MiopengemmDbKey{key.network_config, true};
+    EXPECT(!miopen::MiopengemmDb::Load(temp_file, deterministic));
+}
+
+int main()
+{
+    check_serialization();
+    check_db();
+}
@@ -540,4 +540,30 @@ inline std::vector<std::vector<int>> get_tensor_offsets()
 
 inline std::vector<int> get_tensor_offset() { return {0, 1, 2, 3, 4, 5}; }
 
+// Convolutions of the main path of ResNet-50 from conv2_1 on, in execution order, as
+// { c, h, w, k, filter, pad, stride }. The output of a convolution is the input of the next one.
+// Stages are downsampled by the first 1x1 convolution, as in the original network.
+inline std::vector<std::vector<int>> get_resnet50_chain()
+{
+    std::vector<std::vector<int>> layers;
+    int c  = 64;
+    int hw = 56;
+    // { blocks, width, stride of the first block }
+    for(const auto& stage :
+        std::vector<std::vector<int>>{{3, 64, 1}, {4, 128, 2}, {6, 256, 2}, {3, 512, 2}})
+    {
+        for(int b = 0; b < stage[0]; b++)
+        {
+            const int width  = stage[1];
+            const int stride = b == 0 ? stage[2] : 1;
+            layers.push_back({c, hw, hw, width, 1, 0, stride});
+            hw /= stride;
+            layers.push_back({width, hw, hw, width, 3, 1, 1});
+            layers.push_back({width, hw, hw, 4 * width, 1, 0, 1});
+            c = 4 * width;
+        }
+    }
+    return layers;
+}
+
 #endif
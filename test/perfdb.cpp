@@ -36,7 +36,9 @@
 #include <boost/filesystem/path.hpp>
 #include <boost/optional.hpp>
 
+#include <algorithm>
 #include <array>
+#include <chrono>
 #include <cstdio>
 #include <cstdlib>
 #include <fstream>
@@ -292,6 +294,33 @@ class DbStoreTest : public DbTest
     }
 };
 
+class DbIncompleteLineTest : public DbTest
+{
+    public:
+    void Run() const
+    {
+        std::cout << "Testing db for skipping a record being appended..." << std::endl;
+
+        ResetDb();
+        RawWrite(temp_file, key(), common_data());
+        const TestData appended_key(10, 20);
+        std::ofstream(temp_file, std::ios::app) << appended_key.x << ',' << appended_key.y
+                                                << "=0:3,";
+
+        Db db(temp_file);
+        ValidateSingleEntry(key(), common_data(), db);
+        EXPECT(!db.FindRecord(appended_key));
+
+        const TestData stored_key(30, 40);
+        DbRecord record(stored_key);
+        EXPECT(record.SetValues(id0(), value0()));
+        EXPECT(record.SetValues(id1(), value1()));
+        EXPECT(db.StoreRecord(record));
+        ValidateSingleEntry(stored_key, common_data(), db);
+        ValidateSingleEntry(key(), common_data(), db);
+    }
+};
+
 class DbUpdateTest : public DbTest
 {
     public:
@@ -953,6 +982,96 @@ class DbMultiProcessReadTest : public DbTest
     static std::string LockFilePath(const std::string& db_path) { return db_path + ".test.lock"; }
 };
 
+class DbMultiProcessSnapshotTest : public DbTest
+{
+    public:
+    static constexpr const char* reader_arg = "mp-test-child-read-latency";
+    static constexpr unsigned int writers_count = 4;
+    static constexpr unsigned int readers_count = 4;
+
+    void Run() const
+    {
+        std::cout << "Testing db read latency during multiprocess writes..." << std::endl;
+
+        ResetDb();
+        const std::string p = temp_file;
+        const auto c        = [&p]() { return Db(p); };
+
+        std::cout << "Initializing test data..." << std::endl;
+        DBMultiThreadedTestWork::Initialize();
+        DBMultiThreadedTestWork::FillForReading(c);
+
+        std::vector<FILE*> children;
+        std::cout << "Launching test processes..." << std::endl;
+        {
+            // Stands for a tuning process keeping the db locked for a long time.
+            // Writers wait for it, readers shall not.
+            auto& db_lock = LockFile::Get(LockFilePath(p).c_str());
+            std::unique_lock<LockFile> lock(db_lock);
+
+            for(auto id = 0u; id < writers_count + readers_count; id++)
+            {
+                auto command = exe_path().string() + " --" + DbMultiProcessTest::id_arg + " " +
+                               std::to_string(id) + " --" + DbMultiProcessTest::path_arg + " " + p;
+                command += " --" + std::string(id < writers_count ? DbMultiProcessTest::write_arg
+                                                                  : reader_arg);
+                children.push_back(popen(command.c_str(), "w"));
+            }
+
+            std::this_thread::sleep_for(LockHoldTime());
+        }
+
+        std::cout << "Waiting for test processes..." << std::endl;
+        for(auto child : children)
+        {
+            auto status          = pclose(child);
+            const auto exit_code = WEXITSTATUS(status);
+
+            EXPECT_EQUAL(exit_code, 0);
+        }
+
+        std::cout << "Validating results..." << std::endl;
+        DBMultiThreadedTestWork::ValidateCommonPart(c);
+        std::cout << "Validation passed..." << std::endl;
+    }
+
+    // Reads the common part over and over while the writers run,
+    // and checks the tail latency of the reads.
+    static void ReadWorkItem(unsigned int id, const std::string& db_path)
+    {
+        using Clock   = std::chrono::steady_clock;
+        using Seconds = std::chrono::duration<double>;
+
+        const auto& cp = DBMultiThreadedTestWork::common_part();
+        std::vector<double> latencies;
+        const auto start = Clock::now();
+
+        for(auto i = 0u; Clock::now() - start < 2 * LockHoldTime(); i++)
+        {
+            const auto n    = i % DBMultiThreadedTestWork::common_part_size;
+            const auto key  = n / DBMultiThreadedTestWork::ids_per_key;
+            const auto idx  = n % DBMultiThreadedTestWork::ids_per_key;
+            TestData read(TestData::NoInit{});
+
+            const auto read_start = Clock::now();
+            EXPECT(Db(db_path).Load(std::to_string(key), std::to_string(idx), read));
+            latencies.push_back(Seconds(Clock::now() - read_start).count());
+            EXPECT_EQUAL(read, cp[n]);
+        }
+
+        std::sort(latencies.begin(), latencies.end());
+        const auto max = latencies.back();
+        std::cout << "Reader " << id << ": " << latencies.size()
+                  << " reads, p50: " << latencies[latencies.size() / 2]
+                  << " s, p99: " << latencies[latencies.size() * 99 / 100] << " s, max: " << max
+                  << " s" << std::endl;
+        EXPECT(max < Seconds(LockHoldTime()).count() / 2);
+    }
+
+    private:
+    static std::chrono::seconds LockHoldTime() { return std::chrono::seconds{2}; }
+};
+
 class DbMultiFileTest : public DbTest
 {
     protected:
@@ -1242,6 +1361,8 @@ struct PerfDbDriver : test_driver
         add(logs_root, DbMultiThreadedTest::logs_path_arg);
         add(test_write, DbMultiProcessTest::write_arg, flag());
 
+        add(test_read_latency, DbMultiProcessSnapshotTest::reader_arg, flag());
+
         add(mt_child_id, DbMultiProcessTest::id_arg);
         add(mt_child_db_path, DbMultiProcessTest::path_arg);
     }
@@ -1266,12 +1387,16 @@ struct PerfDbDriver : test_driver
 
         if(mt_child_id >= 0)
         {
-            DbMultiProcessTest::WorkItem(mt_child_id, mt_child_db_path, test_write);
+            if(test_read_latency)
+                DbMultiProcessSnapshotTest::ReadWorkItem(mt_child_id, mt_child_db_path);
+            else
+                DbMultiProcessTest::WorkItem(mt_child_id, mt_child_db_path, test_write);
             return;
         }
 
         DbFindTest().Run();
         DbStoreTest().Run();
+        DbIncompleteLineTest().Run();
         DbUpdateTest().Run();
         DbRemoveTest().Run();
         DbReadTest().Run();
@@ -1283,6 +1408,7 @@ struct PerfDbDriver : test_driver
         DbMultiProcessReadTest().Run();
         DbMultiThreadedTest().Run();
         DbMultiProcessTest().Run();
+        DbMultiProcessSnapshotTest().Run();
 
         DbMultiFileReadTest<true>().Run();
         DbMultiFileReadTest<false>().Run();
@@ -1293,7 +1419,8 @@ struct PerfDbDriver : test_driver
     }
 
     private:
-    bool test_write = false;
+    bool test_write        = false;
+    bool test_read_latency = false;
     std::string logs_root;
 
     int mt_child_id = -1;
@@ -0,0 +1,171 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2019 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/batch_norm_solver.hpp>
+#include <miopen/pooling_solver.hpp>
+#include <miopen/softmax_solver.hpp>
+#include <cstddef>
+#include <sstream>
+#include <string>
+#include "test.hpp"
+
+// The default config shall be valid and reachable by the search.
+template <class PerformanceConfig, class Context>
+void check_default_config(const Context& context)
+{
+    PerformanceConfig heuristic;
+    heuristic.EuristicInit(context);
+    EXPECT(heuristic.IsValid(context));
+
+    bool found = false;
+    int valid  = 0;
+    PerformanceConfig config(true);
+    do
+    {
+        found = found || config == heuristic;
+        if(config.IsValid(context))
+            ++valid;
+    } while(config.SetNextValue());
+    EXPECT(found);
+    EXPECT(valid > 1 || heuristic == PerformanceConfig(true));
+}
+
+template <class Context>
+std::string Key(const Context& context)
+{
+    std::ostringstream ss;
+    ss << context;
+    return ss.str();
+}
+
+void check_batch_norm()
+{
+    for(const bool forward : {true, false})
+    {
+        for(const int n : {1, 16, 64, 128, 256})
+        {
+            for(const int hw : {1, 3, 7, 14, 28, 33, 56, 112, 224})
+            {
+                miopen::BatchNormContext context;
+                context.forward = forward;
+                context.n       = n;
+                context.c       = 64;
+                context.h       = hw;
+                context.w       = hw;
+                check_default_config<miopen::solver::PerformanceConfigBnSpatial>(context);
+
+                // Without gcn_reduce2() the work-groups shall be powers of 2.
+                context.gcn_reduce = false;
+                miopen::solver::PerformanceConfigBnSpatial config(true);
+                do
+                {
+                    if(config.IsValid(context))
+                        EXPECT((config.wg_size & (config.wg_size - 1)) == 0);
+                } while(config.SetNextValue());
+            }
+        }
+    }
+
+    miopen::BatchNormContext context;
+    context.n                     = 64;
+    context.c                     = 256;
+    context.h                     = 14;
+    context.w                     = 14;
+    context.saved_mean_variance   = true;
+    context.running_mean_variance = true;
+    EXPECT_EQUAL(Key(context), "BN-64-256-14x14-FP32-FP32-1-F");
+}
+
+void check_softmax()
+{
+    const std::size_t batch = 32;
+    for(const bool forward : {true, false})
+    {
+        for(const auto mode : {MIOPEN_SOFTMAX_MODE_INSTANCE, MIOPEN_SOFTMAX_MODE_CHANNEL})
+        {
+            for(const int c : {1, 3, 10, 31, 100, 129, 255, 256, 1000, 4096})
+            {
+                miopen::SoftmaxContext context;
+                context.forward = forward;
+                context.mode    = mode;
+                context.n       = batch;
+                context.c       = c;
+                context.h       = 1;
+                context.w       = 1;
+                check_default_config<miopen::solver::PerformanceConfigSoftmax>(context);
+
+                // The default launch is the one used before softmax had solvers.
+                const auto solution = miopen::solver::SoftmaxFwd{}.GetSolution(
+                    context, miopen::solver::SoftmaxFwd{}.GetPerformanceConfig(context));
+                EXPECT_EQUAL(solution.num_batch * solution.batch_size, 256);
+                EXPECT(solution.batch_size * solution.u_batch_size >= c ||
+                       solution.num_batch == 1);
+                if(solution.num_batch == 1)
+                    EXPECT_EQUAL(solution.workgroups, batch);
+                else
+                    EXPECT_EQUAL(solution.workgroups,
+                                 (batch + solution.num_batch - 1) / solution.num_batch);
+            }
+        }
+    }
+
+    miopen::SoftmaxContext context;
+    context.n    = 128;
+    context.c    = 1000;
+    context.h    = 1;
+    context.w    = 1;
+    context.mode = MIOPEN_SOFTMAX_MODE_INSTANCE;
+    EXPECT_EQUAL(Key(context), "SM-128-1000-1x1-FP32-ACCURATE-INSTANCE-F");
+}
+
+void check_pooling()
+{
+    for(const int stride : {1, 2, 3})
+    {
+        for(const int out : {1, 2, 7, 14, 56, 112})
+        {
+            miopen::PoolingContext context;
+            context.n        = 16;
+            context.c        = 64;
+            context.out_h    = out;
+            context.out_w    = out;
+            context.in_h     = out * stride;
+            context.in_w     = out * stride;
+            context.win_h    = 3;
+            context.win_w    = 3;
+            context.stride_h = stride;
+            context.stride_w = stride;
+            check_default_config<miopen::solver::PerformanceConfigPoolingFwd>(context);
+        }
+    }
+}
+
+int main()
+{
+    check_batch_norm();
+    check_softmax();
+    check_pooling();
+}
@@ -0,0 +1,60 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2019 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/problem_buckets.hpp>
+#include <vector>
+#include "test.hpp"
+
+void check_parse()
+{
+    EXPECT(miopen::ParseBucketBounds("1,2,4,8") == (std::vector<int>{1, 2, 4, 8}));
+    EXPECT(miopen::ParseBucketBounds("16") == std::vector<int>{16});
+    EXPECT(miopen::ParseBucketBounds("").empty());
+    EXPECT(miopen::ParseBucketBounds("1,x,4").empty());
+    EXPECT(miopen::ParseBucketBounds("1,2a").empty());
+    EXPECT(miopen::ParseBucketBounds("1,,4").empty());
+    EXPECT(miopen::ParseBucketBounds("0,4").empty());
+    EXPECT(miopen::ParseBucketBounds("4,2").empty());
+    EXPECT(miopen::ParseBucketBounds("2,2").empty());
+}
+
+void check_bound()
+{
+    const std::vector<int> bounds{1, 2, 4, 8, 32};
+    EXPECT(miopen::GetBucketBound(bounds, 1) == 1);
+    EXPECT(miopen::GetBucketBound(bounds, 3) == 4);
+    EXPECT(miopen::GetBucketBound(bounds, 8) == 8);
+    EXPECT(miopen::GetBucketBound(bounds, 9) == 32);
+    // Sizes above all bounds are not bucketed.
+    EXPECT(miopen::GetBucketBound(bounds, 33) == 33);
+    EXPECT(miopen::GetBucketBound({}, 7) == 7);
+}
+
+int main()
+{
+    check_parse();
+    check_bound();
+}
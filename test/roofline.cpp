@@ -0,0 +1,119 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2019 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/convolution.hpp>
+#include <miopen/perf_field.hpp>
+#include <miopen/problem_description.hpp>
+#include <miopen/roofline.hpp>
+#include <miopen/tensor.hpp>
+#include <cmath>
+#include <sstream>
+#include "test.hpp"
+
+bool Near(double a, double b) { return std::abs(a - b) <= 1e-4 * std::abs(b); }
+
+void check_convolution_cost()
+{
+    const miopen::TensorDescriptor x{miopenFloat, {16, 192, 28, 28}};
+    const miopen::TensorDescriptor w{miopenFloat, {32, 192, 5, 5}};
+    const miopen::ConvolutionDescriptor conv{
+        2, miopenConvolution, miopenPaddingDefault, {1, 1}, {1, 1}, {1, 1}};
+    const auto y = conv.GetForwardOutputTensor(x, w);
+
+    const double flops   = 2.0 * 16 * 32 * 192 * 5 * 5 * 26 * 26;
+    const double x_bytes = 16.0 * 192 * 28 * 28 * 4;
+    const double w_bytes = 32.0 * 192 * 5 * 5 * 4;
+    const double y_bytes = 16.0 * 32 * 26 * 26 * 4;
+
+    const auto fwd = miopen::GetConvolutionCost(miopen::ProblemDescription{x, w, y, conv, 1});
+    EXPECT(Near(fwd.flops, flops));
+    EXPECT(Near(fwd.bytes_read, x_bytes + w_bytes));
+    EXPECT(Near(fwd.bytes_written, y_bytes));
+
+    const auto bwd = miopen::GetConvolutionCost(miopen::ProblemDescription{x, w, y, conv, 0});
+    EXPECT(Near(bwd.flops, flops));
+    EXPECT(Near(bwd.bytes_read, y_bytes + w_bytes));
+    EXPECT(Near(bwd.bytes_written, x_bytes));
+
+    auto wrw_problem = miopen::ProblemDescription{x, w, y, conv, 0};
+    wrw_problem.direction.SetBackwardWrW();
+    const auto wrw = miopen::GetConvolutionCost(wrw_problem);
+    EXPECT(Near(wrw.flops, flops));
+    EXPECT(Near(wrw.bytes_read, x_bytes + y_bytes));
+    EXPECT(Near(wrw.bytes_written, w_bytes));
+}
+
+void check_metrics()
+{
+    EXPECT(Near(miopen::GetPeakTflops(64, 1500, miopenFloat), 12.288));
+    EXPECT(Near(miopen::GetPeakTflops(64, 1500, miopenHalf), 24.576));
+
+    miopen::OperationCost cost;
+    cost.flops         = 2e9;
+    cost.bytes_read    = 3e6;
+    cost.bytes_written = 1e6;
+    const auto metrics = miopen::GetRooflineMetrics(cost, 0.5f, 8);
+    EXPECT(metrics.IsValid());
+    EXPECT(Near(metrics.tflops, 4));
+    EXPECT(Near(metrics.gbps, 8));
+    EXPECT(Near(metrics.peak_percent, 50));
+
+    EXPECT(!miopen::GetRooflineMetrics(cost, 0, 8).IsValid());
+    EXPECT(miopen::GetRooflineMetrics(cost, 0.5f, 0).peak_percent < 0);
+}
+
+void check_find_db_data()
+{
+    const std::string legacy = "ConvOclDirectFwd,0.5,0,miopenConvolutionFwdAlgoDirect,1x1";
+    miopen::FindDbData data;
+    EXPECT(data.Deserialize(legacy));
+    EXPECT(data.solver_id == "ConvOclDirectFwd");
+    EXPECT(!data.roofline.IsValid());
+    std::ostringstream legacy_ss;
+    data.Serialize(legacy_ss);
+    EXPECT(legacy_ss.str() == legacy);
+
+    data.roofline.tflops       = 4;
+    data.roofline.gbps         = 8;
+    data.roofline.peak_percent = 50;
+    std::ostringstream ss;
+    data.Serialize(ss);
+    EXPECT(ss.str() == legacy + ",4,8,50");
+
+    miopen::FindDbData read;
+    EXPECT(read.Deserialize(ss.str()));
+    EXPECT(read.kcache_key.network_config == "1x1");
+    EXPECT(read.roofline.tflops == 4);
+    EXPECT(read.roofline.gbps == 8);
+    EXPECT(read.roofline.peak_percent == 50);
+}
+
+int main()
+{
+    check_convolution_cost();
+    check_metrics();
+    check_find_db_data();
+}
@@ -0,0 +1,104 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2019 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/solver_policy.hpp>
+#include <sstream>
+#include <string>
+#include "test.hpp"
+
+const std::string key_1x1 = "576-4-4-1x1-192-4-4-8-0x0-1x1-1x1-0-NCHW-FP32-F";
+const std::string key_3x3 = "64-56-56-3x3-64-56-56-16-1x1-1x1-1x1-0-NCHW-FP16-B";
+
+miopen::SolverPolicyFile MakePolicyFile(const std::string& text)
+{
+    std::istringstream stream(text);
+    return {stream, "test"};
+}
+
+void check_patterns()
+{
+    EXPECT(miopen::MatchKeyPattern("*", ""));
+    EXPECT(miopen::MatchKeyPattern("*", key_1x1));
+    EXPECT(miopen::MatchKeyPattern(key_1x1, key_1x1));
+    EXPECT(miopen::MatchKeyPattern("*-1x1-*-F", key_1x1));
+    EXPECT(miopen::MatchKeyPattern("576-?-?-1x1-*", key_1x1));
+    EXPECT(miopen::MatchKeyPattern("*FP32*", key_1x1));
+    EXPECT(!miopen::MatchKeyPattern("*-1x1-*-B", key_1x1));
+    EXPECT(!miopen::MatchKeyPattern("576", key_1x1));
+    EXPECT(!miopen::MatchKeyPattern("*-3x3-*", key_1x1));
+    EXPECT(!miopen::MatchKeyPattern("", key_1x1));
+}
+
+void check_rules()
+{
+    const auto file = MakePolicyFile("# Comment\n"
+                                     "\n"
+                                     "*-1x1-*-F  solver  ConvAsm1x1U\n"
+                                     "*-1x1-*-F  solver  ConvOclDirectFwd1x1\n"
+                                     "*-1x1-*-F  config  ConvAsm1x1U  1,16,1,64,2,2,1,4\n"
+                                     "*-1x1-*-F  config  ConvAsm1x1U  2,16,1,64,2,2,1,4\n"
+                                     "*-FP16-*   disable ConvBinWinograd3x3U\n"
+                                     "*-FP16-*   workspace 1048576\n"
+                                     "*          workspace 0\n");
+    EXPECT(!file.IsEmpty());
+
+    const auto p1x1 = file.Match(key_1x1);
+    EXPECT(p1x1.IsAllowed("ConvAsm1x1U"));
+    EXPECT(p1x1.IsAllowed("ConvOclDirectFwd1x1"));
+    EXPECT(!p1x1.IsAllowed("ConvOclDirectFwd"));
+    EXPECT(!p1x1.IsAllowed("gemm"));
+    EXPECT(p1x1.FindConfig("ConvAsm1x1U") != nullptr);
+    EXPECT(*p1x1.FindConfig("ConvAsm1x1U") == "1,16,1,64,2,2,1,4");
+    EXPECT(p1x1.FindConfig("ConvOclDirectFwd1x1") == nullptr);
+    EXPECT(p1x1.FitsWorkspace(0));
+    EXPECT(!p1x1.FitsWorkspace(1));
+
+    const auto p3x3 = file.Match(key_3x3);
+    EXPECT(!p3x3.IsAllowed("ConvBinWinograd3x3U"));
+    EXPECT(p3x3.IsAllowed("ConvOclDirectFwd"));
+    EXPECT(p3x3.IsAllowed("gemm"));
+    EXPECT(p3x3.FitsWorkspace(1048576));
+    EXPECT(!p3x3.FitsWorkspace(1048577));
+}
+
+void check_invalid_rules()
+{
+    const auto file = MakePolicyFile("*  solver\n"
+                                     "*  config ConvAsm1x1U\n"
+                                     "*  workspace 1M\n"
+                                     "*  workspace 99999999999999999999999\n"
+                                     "*  unknown ConvAsm1x1U\n");
+    EXPECT(file.IsEmpty());
+    EXPECT(file.Match(key_1x1).IsEmpty());
+    EXPECT(miopen::SolverPolicyFile{}.Match(key_1x1).IsEmpty());
+}
+
+int main()
+{
+    check_patterns();
+    check_rules();
+    check_invalid_rules();
+}
@@ -40,6 +40,7 @@
 #include "get_handle.hpp"
 #include "tensor_holder.hpp"
 #include "verify.hpp"
+#include "cpu_tensor_ops.hpp"
 
 template <class T>
 struct verify_tensor_copy
@@ -65,38 +66,11 @@ struct verify_tensor_copy
         dstOffset = offsets[1];
     }
 
-    void tensor_copy_for_loop(tensor<T>& dstSuperCpu,
-                              int src_offset_index,
-                              int dst_offset_index,
-                              int dim) const
-    {
-        auto src_stride = srcDesc.GetStrides()[dim];
-        auto dst_stride = dstDesc.GetStrides()[dim];
-
-        for(int idx = 0; idx < srcDesc.GetLengths()[dim]; idx++)
-        {
-            std::size_t src_super_index =
-                ((dim == 0) ? srcOffset : 0) + src_offset_index + src_stride * idx;
-            std::size_t dst_super_index =
-                ((dim == 0) ? dstOffset : 0) + dst_offset_index + dst_stride * idx;
-
-            if(dim < (srcDesc.GetLengths().size() - 1))
-            {
-                tensor_copy_for_loop(dstSuperCpu, src_super_index, dst_super_index, dim + 1);
-            }
-            if(dst_super_index < dstSuperCpu.desc.GetElementSpace() &&
-               src_super_index < srcSuper.desc.GetElementSpace())
-            {
-                dstSuperCpu[dst_super_index] = srcSuper[src_super_index];
-            }
-        }
-    }
-
     tensor<T> cpu() const
     {
         tensor<T> dstSuperCpu = dstSuper;
 
-        tensor_copy_for_loop(dstSuperCpu, 0, 0, 0);
+        cpu_copy_tensor(srcSuper, srcDesc, srcOffset, dstSuperCpu, dstDesc, dstOffset);
 
         return dstSuperCpu;
     }
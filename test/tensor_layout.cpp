@@ -0,0 +1,150 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2019 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/convolution.hpp>
+#include <miopen/problem_description.hpp>
+#include <miopen/tensor.hpp>
+#include <sstream>
+#include <vector>
+#include "serialize.hpp"
+#include "cpu_conv.hpp"
+#include "test.hpp"
+
+miopen::TensorDescriptor MakeNHWC(int n, int c, int h, int w)
+{
+    return {miopenFloat, std::vector<int>{n, c, h, w}, std::vector<int>{c * h * w, 1, w * c, c}};
+}
+
+std::string Key(const miopen::ProblemDescription& problem)
+{
+    std::ostringstream ss;
+    problem.Serialize(ss);
+    return ss.str();
+}
+
+void check_layout_detection()
+{
+    const miopen::TensorDescriptor nchw{miopenFloat, std::vector<int>{2, 3, 4, 5}};
+    EXPECT(nchw.GetLayout("NCHW") == "NCHW");
+    EXPECT(nchw.IsDefaultLayout());
+    EXPECT(!nchw.FitsLayout("NCHW", "NHWC"));
+
+    const auto nhwc = MakeNHWC(2, 3, 4, 5);
+    EXPECT(nhwc.GetLayout("NCHW") == "NHWC");
+    EXPECT(nhwc.FitsLayout("NCHW", "NHWC"));
+    EXPECT(!nhwc.FitsLayout("NCHW", "NCHW"));
+    EXPECT(!nhwc.IsDefaultLayout());
+
+    // Dimensions of length 1 fit anywhere, so both layouts describe these tensors.
+    const miopen::TensorDescriptor one_channel{miopenFloat, std::vector<int>{2, 1, 4, 5}};
+    EXPECT(one_channel.GetLayout("NCHW") == "NCHW");
+    EXPECT(one_channel.FitsLayout("NCHW", "NHWC"));
+    EXPECT(MakeNHWC(2, 3, 1, 1).GetLayout("NCHW") == "NCHW");
+    EXPECT(MakeNHWC(2, 3, 1, 1).IsDefaultLayout());
+
+    const miopen::TensorDescriptor ndhwc{
+        miopenFloat, std::vector<int>{2, 3, 4, 5, 6}, std::vector<int>{360, 1, 90, 18, 3}};
+    EXPECT(ndhwc.GetLayout("NCDHW") == "NDHWC");
+    EXPECT(!ndhwc.IsDefaultLayout());
+
+    // Strided channels-last: a view of the first 3 channels of an 8-channel tensor.
+    const miopen::TensorDescriptor view{
+        miopenFloat, std::vector<int>{2, 3, 4, 5}, std::vector<int>{160, 1, 40, 8}};
+    EXPECT(view.GetLayout("NCHW") == "NHWC");
+    EXPECT(!view.IsPacked());
+
+    EXPECT(throws([&] { nchw.GetLayout("NCDHW"); }));
+}
+
+void check_problem_key()
+{
+    const miopen::ConvolutionDescriptor conv{
+        2, miopenConvolution, miopenPaddingDefault, {0, 0}, {1, 1}};
+    const miopen::TensorDescriptor x{miopenFloat, std::vector<int>{8, 16, 7, 7}};
+    const miopen::TensorDescriptor w{miopenFloat, std::vector<int>{32, 16, 1, 1}};
+    const miopen::TensorDescriptor y{miopenFloat, std::vector<int>{8, 32, 7, 7}};
+    const miopen::ProblemDescription nchw{x, w, y, conv, 1};
+    EXPECT(nchw.IsLayoutDefault());
+    EXPECT(!nchw.IsLayoutNHWC());
+
+    const auto x_nhwc = MakeNHWC(8, 16, 7, 7);
+    const miopen::TensorDescriptor w_nhwc{
+        miopenFloat, std::vector<int>{32, 16, 1, 1}, std::vector<int>{16, 1, 16, 16}};
+    const auto y_nhwc = MakeNHWC(8, 32, 7, 7);
+    const miopen::ProblemDescription nhwc{x_nhwc, w_nhwc, y_nhwc, conv, 1};
+    EXPECT(!nhwc.IsLayoutDefault());
+    EXPECT(nhwc.IsLayoutNHWC());
+    EXPECT(Key(nhwc) != Key(nchw));
+    // Packed 1x1 weights are laid out the same way in both orders.
+    const miopen::ProblemDescription nhwc_packed_w{x_nhwc, w, y_nhwc, conv, 1};
+    EXPECT(nhwc_packed_w.IsLayoutNHWC());
+    EXPECT(Key(nhwc_packed_w) == Key(nhwc));
+    EXPECT(conv.IsGemmNHWCFwd(x_nhwc, w_nhwc, y_nhwc));
+    EXPECT(!conv.IsGemmNHWCFwd(x, w, y));
+
+    // Mixed layouts get their own records as well.
+    const miopen::ProblemDescription mixed{x_nhwc, w_nhwc, y, conv, 1};
+    EXPECT(!mixed.IsLayoutDefault());
+    EXPECT(!mixed.IsLayoutNHWC());
+    EXPECT(Key(mixed) != Key(nhwc));
+    EXPECT(!conv.IsGemmNHWCFwd(x_nhwc, w_nhwc, y));
+}
+
+void check_host_reference()
+{
+    const std::vector<int> pads{0, 0}, strides{1, 1}, dilations{1, 1};
+    tensor<float> in{std::vector<int>{3, 5, 4, 6}, std::vector<int>{120, 1, 30, 5}};
+    tensor<float> wei{std::vector<int>{7, 5, 1, 1}, std::vector<int>{5, 1, 5, 5}};
+    tensor<float> out{std::vector<int>{3, 7, 4, 6}, std::vector<int>{168, 1, 42, 7}};
+    tensor<float> in_nchw{3, 5, 4, 6};
+    tensor<float> wei_nchw{7, 5, 1, 1};
+    tensor<float> out_nchw{3, 7, 4, 6};
+    const auto in_gen  = [](auto n, auto c, auto h, auto w) {
+        return float((n + 2 * c + 3 * h + w) % 7);
+    };
+    const auto wei_gen = [](auto k, auto c, auto, auto) { return float((k * 5 + c) % 4) - 1.5f; };
+    // generate() fills the data in order, so set the elements through their strides.
+    in.for_each([&](auto n, auto c, auto h, auto w) { in(n, c, h, w) = in_gen(n, c, h, w); });
+    wei.for_each([&](auto k, auto c, auto y, auto x) { wei(k, c, y, x) = wei_gen(k, c, y, x); });
+    in_nchw.generate(in_gen);
+    wei_nchw.generate(wei_gen);
+
+    // The reference indexes the tensors through their strides.
+    cpu_convolution_forward(2, in, wei, out, pads, strides, dilations, 1);
+    cpu_convolution_forward(2, in_nchw, wei_nchw, out_nchw, pads, strides, dilations, 1);
+    bool same = true;
+    out.for_each([&](auto n, auto k, auto h, auto w) {
+        same = same && out(n, k, h, w) == out_nchw(n, k, h, w);
+    });
+    EXPECT(same);
+}
+
+int main()
+{
+    check_layout_detection();
+    check_problem_key();
+    check_host_reference();
+}
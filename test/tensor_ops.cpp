@@ -39,6 +39,7 @@
 #include "get_handle.hpp"
 #include "tensor_holder.hpp"
 #include "verify.hpp"
+#include "cpu_tensor_ops.hpp"
 
 #define MIO_OPS_DEBUG 0
 
@@ -86,97 +87,24 @@ struct verify_tensor_ops
     // c = pc(dims);
     //}
 
-    static T add_elem(T aelem, T belem) { return aelem + belem; }
-    static T mul_elem(T aelem, T belem) { return aelem * belem; }
-    static T max_elem(T aelem, T belem) { return ((aelem > belem) ? aelem : belem); }
-    static T min_elem(T aelem, T belem) { return ((aelem < belem) ? aelem : belem); }
-
-    static void tensor_for_loop(const tensor<T>& aten,
-                                const tensor<T>& bten,
-                                tensor<T>& cten,
-                                const std::vector<size_t>& a_dims,
-                                const std::vector<size_t>& b_dims,
-                                float palpha0,
-                                float palpha1,
-                                float pbeta,
-                                int recurr_aoffset,
-                                int recurr_boffset,
-                                int recurr_coffset,
-                                int dim,
-                                int AtenOffset,
-                                int BtenOffset,
-                                int CtenOffset)
-    {
-
-        int astride = aten.desc.GetStrides()[dim];
-        int bstride = bten.desc.GetStrides()[dim];
-        int cstride = cten.desc.GetStrides()[dim];
-
-        // printf("cstride: %d\n", cstride);
-
-        for(int idx = 0; idx < a_dims[dim]; idx++)
-        {
-            size_t aindex = recurr_aoffset + astride * idx;
-            size_t cindex = recurr_coffset + cstride * idx;
-            size_t bindex =
-                (b_dims[dim] == a_dims[dim]) ? recurr_boffset + bstride * idx : recurr_boffset;
-
-            // if((bindex < bten.desc.GetElementSize()) && (dim == a_dims.size() - 1))
-            if(dim == (a_dims.size() - 1))
-            {
-#if(MIO_OPS_DEBUG)
-                printf("c[%lu](%f) = a[%lu](%f) + b[%lu](%f)\n",
-                       cindex + CtenOffset,
-                       cten[cindex + CtenOffset],
-                       aindex + AtenOffset,
-                       aten[aindex + AtenOffset],
-                       bindex + Boffset,
-                       bten[bindex + Boffset]);
-#endif
-                cten[cindex + CtenOffset] =
-                    // add_elem(aten[aindex + AtenOffset] * palpha0, bten[bindex + BtenOffset] *
-                    // palpha1) +
-                    // max_elem(aten[aindex + AtenOffset] * palpha0, bten[bindex + BtenOffset] *
-                    // palpha1) +
-                    // min_elem(aten[aindex + AtenOffset] * palpha0, bten[bindex + BtenOffset] *
-                    // palpha1) +
-                    mul_elem(T(aten[aindex + AtenOffset] * palpha0),
-                             T(bten[bindex + BtenOffset] * palpha1)) +
-                    pbeta * cten[cindex + CtenOffset];
-            }
-            if(dim < (a_dims.size() - 1))
-            {
-
-                tensor_for_loop(aten,
-                                bten,
-                                cten,
-                                a_dims,
-                                b_dims,
-                                palpha0,
-                                palpha1,
-                                pbeta,
-                                aindex,
-                                bindex,
-                                cindex,
-                                dim + 1,
-                                AtenOffset,
-                                BtenOffset,
-                                CtenOffset);
-            }
-        }
-    }
-
     tensor<T> cpu() const
     {
         auto r = c;
         std::fill(r.begin(), r.end(), 1);
-        auto clens    = r.desc.GetLengths();
-        auto blens    = b.desc.GetLengths();
-        auto bstrides = b.desc.GetStrides();
-        auto cstrides = r.desc.GetStrides();
 
-        tensor_for_loop(
-            a, b, r, clens, blens, alpha0, alpha1, beta, 0, 0, 0, 0, Aoffset, Boffset, Coffset);
+        cpu_op_tensor(miopenTensorOpMul,
+                      alpha0,
+                      a,
+                      a.desc,
+                      Aoffset,
+                      alpha1,
+                      b,
+                      b.desc,
+                      Boffset,
+                      beta,
+                      r,
+                      r.desc,
+                      Coffset);
 
 #if(MIO_OPS_DEBUG)
         for(int i = 0; i < r.desc.GetElementSize(); i++)
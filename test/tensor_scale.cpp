@@ -41,14 +41,7 @@
 #include "tensor_holder.hpp"
 #include "verify.hpp"
 #include "tensor_util.hpp"
-
-template <typename T>
-struct scale_data_t
-{
-    const T alpha;
-
-    void operator()(T& r_data) const { r_data *= alpha; }
-};
+#include "cpu_tensor_ops.hpp"
 
 template <class T>
 struct verify_tensor_scale
@@ -73,9 +66,7 @@ struct verify_tensor_scale
     {
         tensor<T> superCpu = super;
 
-        const scale_data_t<T> data_operator = {alpha};
-
-        operate_over_subtensor(data_operator, superCpu, subDesc, offset);
+        cpu_scale_tensor(superCpu, subDesc, offset, alpha);
 
         return superCpu;
     }
@@ -40,14 +40,7 @@
 #include "tensor_holder.hpp"
 #include "verify.hpp"
 #include "tensor_util.hpp"
-
-template <typename T>
-struct set_data_t
-{
-    const T alpha;
-
-    void operator()(T& r_data) const { r_data = alpha; }
-};
+#include "cpu_tensor_ops.hpp"
 
 template <class T>
 struct verify_tensor_set
@@ -72,9 +65,7 @@ struct verify_tensor_set
     {
         tensor<T> superCpu = super;
 
-        const set_data_t<T> data_operator = {alpha};
-
-        operate_over_subtensor(data_operator, superCpu, subDesc, offset);
+        cpu_set_tensor(superCpu, subDesc, offset, alpha);
 
         return superCpu;
     }
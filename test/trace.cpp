@@ -0,0 +1,74 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2019 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/temp_file.hpp>
+#include <miopen/trace.hpp>
+#include <cstdlib>
+#include <sstream>
+#include <string>
+#include <thread>
+#include "test.hpp"
+
+bool contains(const std::string& str, const std::string& substr)
+{
+    return str.find(substr) != std::string::npos;
+}
+
+void check_spans()
+{
+    {
+        MIOPEN_TRACE_SCOPE("test", "outer");
+        {
+            MIOPEN_TRACE_SCOPE("test", std::string("inner \"") + "quoted\"");
+        }
+    }
+    std::thread([] { MIOPEN_TRACE_SCOPE("test", "worker"); }).join();
+
+    std::ostringstream ss;
+    miopen::WriteTrace(ss);
+    const auto trace = ss.str();
+
+    CHECK(contains(trace, R"({"name":"outer","cat":"test","ph":"X")"));
+    CHECK(contains(trace, R"({"name":"inner \"quoted\"","cat":"test","ph":"X")"));
+    CHECK(contains(trace, R"({"name":"worker","cat":"test","ph":"X")"));
+    CHECK(contains(trace, R"("tid":1})"));
+    CHECK(contains(trace, R"("dropped_spans":0)"));
+}
+
+// The trace is written when the trace registry is destroyed at exit. The file is constructed
+// before the registry, so it is destroyed, and its directory removed, after the trace is written.
+const miopen::TempFile& TraceFile()
+{
+    static const miopen::TempFile file{"miopen-trace.json"};
+    return file;
+}
+
+int main()
+{
+    setenv("MIOPEN_TRACE_FILE", TraceFile().Path().c_str(), 1); // NOLINT
+    CHECK(miopen::IsTracing());
+    check_spans();
+}
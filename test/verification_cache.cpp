@@ -0,0 +1,159 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2019 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include "verification_cache.hpp"
+#include "test.hpp"
+#include "verify.hpp"
+
+#include <miopen/temp_file.hpp>
+
+#include <cstdint>
+#include <fstream>
+#include <iterator>
+#include <random>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+template <class T>
+void check_round_trip(const std::vector<T>& data, std::size_t block_elements)
+{
+    const miopen::TempFile file{"verification_cache"};
+    EXPECT(miopen::SaveVerificationCache(
+        file.Path(), data.data(), sizeof(T), data.size(), block_elements));
+
+    miopen::VerificationCacheReader reader(file.Path());
+    EXPECT(reader.IsValid());
+    EXPECT_EQUAL(reader.GetElementCount(), data.size());
+    std::vector<T> read;
+    EXPECT(reader.Read(read));
+    EXPECT(read == data);
+
+    // Another element type is rejected.
+    using Other = std::conditional_t<sizeof(T) == 1, std::uint16_t, std::uint8_t>;
+    miopen::VerificationCacheReader other(file.Path());
+    EXPECT(!other.ForEachBlock<Other>([](const Other*, std::size_t, std::size_t) {}));
+}
+
+void check_compression()
+{
+    const miopen::TempFile file{"verification_cache"};
+    std::vector<float> zeros(1 << 16, 0.0f);
+    EXPECT(miopen::SaveVerificationCache(file.Path(), zeros));
+    std::ifstream is(file.Path(), std::ios::binary | std::ios::ate);
+    EXPECT(static_cast<std::size_t>(is.tellg()) < zeros.size() * sizeof(float) / 16);
+}
+
+void check_corruption()
+{
+    const miopen::TempFile file{"verification_cache"};
+    std::vector<float> data(1000);
+    for(std::size_t i = 0; i < data.size(); ++i)
+        data[i] = static_cast<float>(i % 7);
+    EXPECT(
+        miopen::SaveVerificationCache(file.Path(), data.data(), sizeof(float), data.size(), 256));
+    {
+        std::fstream fs(file.Path(),
+                        std::ios::binary | std::ios::in | std::ios::out | std::ios::ate);
+        const auto size = static_cast<std::streamoff>(fs.tellg());
+        fs.seekp(size - 12);
+        fs.put('\x7f');
+    }
+    std::vector<float> read;
+    miopen::VerificationCacheReader reader(file.Path());
+    EXPECT(reader.IsValid());
+    EXPECT(!reader.Read(read));
+
+    // Sizes in the header which the file can not hold are a miss, not an allocation.
+    {
+        std::fstream fs(file.Path(), std::ios::binary | std::ios::in | std::ios::out);
+        miopen::VerificationCacheHeader header{};
+        fs.read(reinterpret_cast<char*>(&header), sizeof(header));
+        header.element_count  = std::uint64_t{1} << 40;
+        header.block_elements = header.element_count;
+        header.block_count    = 1;
+        fs.seekp(0);
+        fs.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    }
+    EXPECT(!miopen::VerificationCacheReader(file.Path()).IsValid());
+    EXPECT(!miopen::VerificationCacheReader(file.Path()).Read(read));
+
+    // Truncated.
+    EXPECT(
+        miopen::SaveVerificationCache(file.Path(), data.data(), sizeof(float), data.size(), 256));
+    std::string bytes;
+    {
+        std::ifstream is(file.Path(), std::ios::binary);
+        bytes.assign(std::istreambuf_iterator<char>(is), std::istreambuf_iterator<char>());
+    }
+    std::ofstream(file.Path(), std::ios::binary) << bytes.substr(0, bytes.size() / 2);
+    std::string read_bytes;
+    EXPECT(!miopen::VerificationCacheReader(file.Path()).IsValid());
+    EXPECT(!miopen::VerificationCacheReader(file.Path()).ReadBytes(read_bytes));
+
+    std::ofstream(file.Path()) << "raw dump of the previous cache format";
+    EXPECT(!miopen::VerificationCacheReader(file.Path()).IsValid());
+}
+
+void check_streaming_rms()
+{
+    const miopen::TempFile file{"verification_cache"};
+    std::mt19937 gen(17);
+    std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+    std::vector<float> ref(5000);
+    std::vector<float> gpu(ref.size());
+    for(std::size_t i = 0; i < ref.size(); ++i)
+    {
+        ref[i] = dist(gen);
+        gpu[i] = ref[i] + dist(gen) * 1e-3f;
+    }
+    EXPECT(miopen::SaveVerificationCache(file.Path(), ref.data(), sizeof(float), ref.size(), 512));
+
+    double error = 0;
+    EXPECT(miopen::CachedRmsRange<float>(file.Path(), gpu, error));
+    EXPECT(std::fabs(error - miopen::rms_range(ref, gpu)) < 1e-12);
+    gpu.pop_back();
+    EXPECT(!miopen::CachedRmsRange<float>(file.Path(), gpu, error));
+}
+
+int main()
+{
+    std::vector<float> floats(3000);
+    for(std::size_t i = 0; i < floats.size(); ++i)
+        floats[i] = i % 3 == 0 ? 0.0f : static_cast<float>(i) * 0.25f;
+    check_round_trip(floats, 1024);
+    check_round_trip(floats, 1 << 18);
+    check_round_trip(std::vector<double>{}, 16);
+
+    std::vector<std::uint8_t> bytes(777);
+    for(std::size_t i = 0; i < bytes.size(); ++i)
+        bytes[i] = static_cast<std::uint8_t>((i / 5) * 31);
+    check_round_trip(bytes, 100);
+
+    check_compression();
+    check_corruption();
+    check_streaming_rms();
+}
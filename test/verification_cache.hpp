@@ -0,0 +1,554 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2019 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#ifndef MIOPEN_GUARD_TEST_VERIFICATION_CACHE_HPP
+#define MIOPEN_GUARD_TEST_VERIFICATION_CACHE_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <string>
+#include <vector>
+
+// Store of the reference results of the driver and the tests.
+//
+// A file holds one array of trivially copyable elements, split into blocks which are
+// compressed and checksummed separately, so a reference can be compared block by block
+// without loading it into memory as a whole:
+//
+//   VerificationCacheHeader
+//   VerificationCacheBlock[block_count]   the manifest: where each block is and its checksum
+//   block data                            each block starts at an 8-byte aligned offset
+//
+// The layout has no pointers or variable-size fields before the data, so the file may
+// equally be mapped into memory. Compression is dependency-free: the bytes of the elements are
+// split into planes (all the first bytes, then all the second bytes...), and each plane is
+// either run-length encoded or packed into 1, 2 or 4 bits per byte when it has few distinct
+// values. That collapses zeros and constants and shrinks the sign/exponent bytes of floating
+// point data. A block is stored raw when it does not get smaller.
+
+namespace miopen {
+
+struct VerificationCacheHeader
+{
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t element_size;
+    std::uint64_t element_count;
+    std::uint64_t block_elements;
+    std::uint64_t block_count;
+};
+
+struct VerificationCacheBlock
+{
+    std::uint64_t offset;
+    std::uint64_t stored_size;
+    std::uint64_t raw_size;
+    std::uint64_t checksum; // Of the raw bytes.
+    std::uint32_t codec;
+    std::uint32_t reserved;
+};
+
+enum : std::uint32_t
+{
+    verification_cache_version      = 1,
+    verification_cache_codec_raw    = 0,
+    verification_cache_codec_planes = 1,
+    // The most a block grows when decompressed: a run of 130 bytes is stored in 2.
+    verification_cache_max_expansion = 65,
+};
+
+static constexpr const char verification_cache_magic[8] = {'M', 'I', 'O', 'P', 'E', 'N', 'V', 'C'};
+
+// FNV-1a.
+inline std::uint64_t VerificationCacheChecksum(const unsigned char* data, std::size_t size)
+{
+    std::uint64_t hash = 14695981039346656037ULL;
+    for(std::size_t i = 0; i < size; ++i)
+    {
+        hash ^= data[i];
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+// Run-length encoding: a control byte c < 128 is followed by c + 1 literal bytes,
+// c >= 128 is followed by one byte repeated c - 125 times (3..130).
+inline void VerificationCacheRleEncode(const unsigned char* data,
+                                       std::size_t size,
+                                       std::vector<unsigned char>& out)
+{
+    std::size_t i = 0;
+    while(i < size)
+    {
+        std::size_t run = 1;
+        while(i + run < size && run < 130 && data[i + run] == data[i])
+            ++run;
+        if(run >= 3)
+        {
+            out.push_back(static_cast<unsigned char>(run + 125));
+            out.push_back(data[i]);
+            i += run;
+            continue;
+        }
+        // Literals up to the next run of 3.
+        std::size_t literal = 0;
+        while(i + literal < size && literal < 128)
+        {
+            if(i + literal + 2 < size && data[i + literal] == data[i + literal + 1] &&
+               data[i + literal] == data[i + literal + 2])
+                break;
+            ++literal;
+        }
+        out.push_back(static_cast<unsigned char>(literal - 1));
+        out.insert(out.end(), data + i, data + i + literal);
+        i += literal;
+    }
+}
+
+inline bool VerificationCacheRleDecode(const unsigned char* data,
+                                       std::size_t size,
+                                       unsigned char* out,
+                                       std::size_t out_size)
+{
+    std::size_t i = 0;
+    std::size_t o = 0;
+    while(i < size)
+    {
+        const unsigned int c = data[i++];
+        if(c < 128)
+        {
+            const std::size_t literal = c + 1;
+            if(i + literal > size || o + literal > out_size)
+                return false;
+            std::memcpy(out + o, data + i, literal);
+            i += literal;
+            o += literal;
+        }
+        else
+        {
+            const std::size_t run = c - 125;
+            if(i >= size || o + run > out_size)
+                return false;
+            std::memset(out + o, data[i++], run);
+            o += run;
+        }
+    }
+    return o == out_size;
+}
+
+// Each plane starts with its encoding: 0 for run-length encoding, or 1, 2 or 4 for
+// a dictionary of up to 2^bits byte values followed by the packed indices.
+inline void VerificationCacheCompressPlane(const unsigned char* plane,
+                                           std::size_t count,
+                                           std::vector<unsigned char>& out)
+{
+    std::vector<unsigned char> rle;
+    VerificationCacheRleEncode(plane, count, rle);
+
+    bool used[256] = {};
+    for(std::size_t i = 0; i < count; ++i)
+        used[plane[i]] = true;
+    unsigned char dictionary[256];
+    unsigned char index[256] = {};
+    std::size_t values = 0;
+    for(unsigned int v = 0; v < 256; ++v)
+    {
+        if(used[v])
+        {
+            index[v]             = static_cast<unsigned char>(values);
+            dictionary[values++] = static_cast<unsigned char>(v);
+        }
+    }
+    const unsigned int bits = values <= 2 ? 1 : values <= 4 ? 2 : 4;
+    const auto packed_size  = (count * bits + 7) / 8;
+
+    if(values > 16 || rle.size() <= 2 + values + packed_size)
+    {
+        out.push_back(0);
+        out.insert(out.end(), rle.begin(), rle.end());
+        return;
+    }
+    out.push_back(static_cast<unsigned char>(bits));
+    out.push_back(static_cast<unsigned char>(values - 1));
+    out.insert(out.end(), dictionary, dictionary + values);
+    const auto packed = out.size();
+    out.resize(packed + packed_size, 0);
+    for(std::size_t i = 0; i < count; ++i)
+    {
+        const auto bit = i * bits;
+        out[packed + bit / 8] |= static_cast<unsigned char>(index[plane[i]] << (bit % 8));
+    }
+}
+
+// Decodes a plane starting at data[i], advances i past it.
+inline bool VerificationCacheDecompressPlane(const unsigned char* data,
+                                             std::size_t size,
+                                             std::size_t& i,
+                                             unsigned char* plane,
+                                             std::size_t count)
+{
+    if(i >= size)
+        return false;
+    const unsigned int bits = data[i++];
+    if(bits == 0)
+    {
+        // The run-length encoded plane ends where it covers count bytes.
+        std::size_t o = 0;
+        while(o < count)
+        {
+            if(i >= size)
+                return false;
+            const unsigned int c = data[i];
+            const std::size_t n  = c < 128 ? c + 1 : c - 125;
+            const std::size_t in = c < 128 ? n + 1 : 2;
+            if(i + in > size || o + n > count ||
+               !VerificationCacheRleDecode(data + i, in, plane + o, n))
+                return false;
+            i += in;
+            o += n;
+        }
+        return true;
+    }
+    if(bits != 1 && bits != 2 && bits != 4)
+        return false;
+    if(i >= size)
+        return false;
+    const std::size_t values      = data[i++] + 1;
+    const std::size_t packed_size = (count * bits + 7) / 8;
+    if(values > (std::size_t{1} << bits) || i + values + packed_size > size)
+        return false;
+    const unsigned char* dictionary = data + i;
+    const unsigned char* packed     = dictionary + values;
+    const unsigned int mask         = (1U << bits) - 1;
+    for(std::size_t e = 0; e < count; ++e)
+    {
+        const auto bit = e * bits;
+        const auto idx = (packed[bit / 8] >> (bit % 8)) & mask;
+        if(idx >= values)
+            return false;
+        plane[e] = dictionary[idx];
+    }
+    i += values + packed_size;
+    return true;
+}
+
+inline void VerificationCacheCompress(const unsigned char* data,
+                                      std::size_t size,
+                                      std::size_t element_size,
+                                      std::vector<unsigned char>& out)
+{
+    const std::size_t count = size / element_size;
+    std::vector<unsigned char> plane(count);
+    for(std::size_t b = 0; b < element_size; ++b)
+    {
+        for(std::size_t i = 0; i < count; ++i)
+            plane[i] = data[i * element_size + b];
+        VerificationCacheCompressPlane(plane.data(), count, out);
+    }
+}
+
+inline bool VerificationCacheDecompress(const unsigned char* data,
+                                        std::size_t size,
+                                        std::size_t element_size,
+                                        unsigned char* out,
+                                        std::size_t out_size)
+{
+    const std::size_t count = out_size / element_size;
+    std::vector<unsigned char> planes(out_size);
+    std::size_t i = 0;
+    for(std::size_t b = 0; b < element_size; ++b)
+    {
+        if(!VerificationCacheDecompressPlane(data, size, i, &planes[b * count], count))
+            return false;
+    }
+    if(i != size)
+        return false;
+    for(std::size_t b = 0; b < element_size; ++b)
+        for(std::size_t e = 0; e < count; ++e)
+            out[e * element_size + b] = planes[b * count + e];
+    return true;
+}
+
+/// Writes the elements into the file, replacing it atomically.
+inline bool SaveVerificationCache(const std::string& path,
+                                  const void* data,
+                                  std::size_t element_size,
+                                  std::size_t element_count,
+                                  std::size_t block_elements = std::size_t{1} << 18)
+{
+    const auto bytes       = static_cast<const unsigned char*>(data);
+    const auto block_count = (element_count + block_elements - 1) / block_elements;
+
+    VerificationCacheHeader header{};
+    std::memcpy(header.magic, verification_cache_magic, sizeof(header.magic));
+    header.version        = verification_cache_version;
+    header.element_size   = static_cast<std::uint32_t>(element_size);
+    header.element_count  = element_count;
+    header.block_elements = block_elements;
+    header.block_count    = block_count;
+
+    std::vector<VerificationCacheBlock> blocks(block_count);
+    std::uint64_t offset = sizeof(header) + sizeof(VerificationCacheBlock) * block_count;
+
+    const auto temp_path = path + ".tmp";
+    {
+        std::ofstream file(temp_path, std::ios::binary);
+        if(!file)
+            return false;
+        // The manifest is written last, when the offsets are known.
+        file.seekp(offset);
+
+        std::vector<unsigned char> compressed;
+        for(std::size_t b = 0; b < block_count; ++b)
+        {
+            const auto first = b * block_elements;
+            const auto count = std::min<std::size_t>(block_elements, element_count - first);
+            const auto raw   = bytes + first * element_size;
+            const auto size  = count * element_size;
+
+            compressed.clear();
+            VerificationCacheCompress(raw, size, element_size, compressed);
+            const bool use_raw = compressed.size() >= size;
+
+            auto& block       = blocks[b];
+            block.offset      = offset;
+            block.raw_size    = size;
+            block.stored_size = use_raw ? size : compressed.size();
+            block.checksum    = VerificationCacheChecksum(raw, size);
+            block.codec =
+                use_raw ? verification_cache_codec_raw : verification_cache_codec_planes;
+            file.write(use_raw ? reinterpret_cast<const char*>(raw)
+                               : reinterpret_cast<const char*>(compressed.data()),
+                       block.stored_size);
+
+            const auto padding = (8 - block.stored_size % 8) % 8;
+            const char zeros[8] = {};
+            file.write(zeros, padding);
+            offset += block.stored_size + padding;
+        }
+
+        file.seekp(0);
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        file.write(reinterpret_cast<const char*>(blocks.data()),
+                   sizeof(VerificationCacheBlock) * block_count);
+        if(!file)
+            return false;
+    }
+    if(std::rename(temp_path.c_str(), path.c_str()) != 0)
+    {
+        std::remove(temp_path.c_str());
+        return false;
+    }
+    return true;
+}
+
+template <class T>
+bool SaveVerificationCache(const std::string& path, const std::vector<T>& data)
+{
+    return SaveVerificationCache(path, data.data(), sizeof(T), data.size());
+}
+
+/// Reads a file written by SaveVerificationCache() one block at a time.
+class VerificationCacheReader
+{
+    public:
+    explicit VerificationCacheReader(const std::string& path) : file(path, std::ios::binary)
+    {
+        if(!file.seekg(0, std::ios::end))
+            return;
+        const auto file_size = static_cast<std::uint64_t>(file.tellg());
+        if(!file.seekg(0) || !file.read(reinterpret_cast<char*>(&header), sizeof(header)))
+            return;
+        if(std::memcmp(header.magic, verification_cache_magic, sizeof(header.magic)) != 0 ||
+           header.version != verification_cache_version || header.element_size == 0 ||
+           header.block_elements == 0 ||
+           header.element_count > std::numeric_limits<std::uint64_t>::max() /
+                                      header.element_size / verification_cache_max_expansion ||
+           header.block_count !=
+               (header.element_count + header.block_elements - 1) / header.block_elements)
+            return;
+        // Everything allocated from the sizes in the file is bounded by the size of the file,
+        // so a truncated or corrupt file is a miss rather than a huge allocation.
+        if(header.block_count > (file_size - sizeof(header)) / sizeof(VerificationCacheBlock))
+            return;
+        const auto data_offset =
+            sizeof(header) + sizeof(VerificationCacheBlock) * header.block_count;
+        blocks.resize(header.block_count);
+        if(!file.read(reinterpret_cast<char*>(blocks.data()),
+                      sizeof(VerificationCacheBlock) * blocks.size()))
+            return;
+        for(std::size_t b = 0; b < blocks.size(); ++b)
+        {
+            const auto& block = blocks[b];
+            const auto first  = b * header.block_elements;
+            const auto count =
+                std::min<std::uint64_t>(header.block_elements, header.element_count - first);
+            if(block.offset < data_offset || block.offset > file_size ||
+               block.stored_size > file_size - block.offset ||
+               block.raw_size != count * header.element_size ||
+               block.raw_size > block.stored_size * verification_cache_max_expansion)
+                return;
+        }
+        valid = true;
+    }
+
+    bool IsValid() const { return valid; }
+    std::size_t GetElementSize() const { return header.element_size; }
+    std::size_t GetElementCount() const { return header.element_count; }
+
+    /// Calls f(const T* data, std::size_t first, std::size_t count) for every block in order.
+    /// Only one block is in memory at a time. Returns false if the file is not of T,
+    /// is truncated or a block does not match its checksum.
+    template <class T, class F>
+    bool ForEachBlock(F f)
+    {
+        if(!valid || header.element_size != sizeof(T))
+            return false;
+        std::vector<T> elements;
+        return ForEachRawBlock([&](const unsigned char* raw, std::size_t first, std::size_t count) {
+            elements.resize(count);
+            std::memcpy(elements.data(), raw, count * sizeof(T));
+            f(elements.data(), first, count);
+        });
+    }
+
+    template <class T>
+    bool Read(std::vector<T>& data)
+    {
+        if(!valid || header.element_size != sizeof(T))
+            return false;
+        data.resize(GetElementCount());
+        return ForEachBlock<T>([&](const T* block, std::size_t first, std::size_t count) {
+            std::copy(block, block + count, data.begin() + first);
+        });
+    }
+
+    /// Reads the stored elements as bytes, whatever their size.
+    bool ReadBytes(std::string& data)
+    {
+        if(!valid)
+            return false;
+        data.resize(GetElementCount() * GetElementSize());
+        const auto element_size = GetElementSize();
+        return ForEachRawBlock([&](const unsigned char* raw, std::size_t first, std::size_t count) {
+            std::memcpy(&data[first * element_size], raw, count * element_size);
+        });
+    }
+
+    private:
+    template <class F>
+    bool ForEachRawBlock(F f)
+    {
+        if(!valid)
+            return false;
+        std::vector<unsigned char> stored;
+        std::vector<unsigned char> raw;
+        for(std::size_t b = 0; b < blocks.size(); ++b)
+        {
+            const auto& block = blocks[b];
+            const auto first  = b * header.block_elements;
+            const auto count =
+                std::min<std::size_t>(header.block_elements, header.element_count - first);
+            if(block.raw_size != count * header.element_size)
+                return false;
+
+            stored.resize(block.stored_size);
+            raw.resize(block.raw_size);
+            file.seekg(block.offset);
+            if(!file.read(reinterpret_cast<char*>(stored.data()), stored.size()))
+                return false;
+
+            if(block.codec == verification_cache_codec_raw)
+            {
+                if(block.stored_size != block.raw_size)
+                    return false;
+                std::memcpy(raw.data(), stored.data(), stored.size());
+            }
+            else if(block.codec != verification_cache_codec_planes ||
+                    !VerificationCacheDecompress(stored.data(),
+                                                 stored.size(),
+                                                 header.element_size,
+                                                 raw.data(),
+                                                 block.raw_size))
+            {
+                return false;
+            }
+
+            if(VerificationCacheChecksum(raw.data(), block.raw_size) != block.checksum)
+                return false;
+            f(raw.data(), first, count);
+        }
+        return true;
+    }
+
+    private:
+    std::ifstream file;
+    VerificationCacheHeader header{};
+    std::vector<VerificationCacheBlock> blocks;
+    bool valid = false;
+};
+
+/// Same as rms_range(reference, r) from verify.hpp with the reference read from the cache
+/// block by block. Returns false if the reference is missing, corrupt or of another size.
+template <class T, class R>
+bool CachedRmsRange(const std::string& path, const R& r, double& error)
+{
+    VerificationCacheReader reader(path);
+    const auto n = static_cast<std::size_t>(std::distance(r.begin(), r.end()));
+    if(!reader.IsValid() || reader.GetElementCount() != n)
+        return false;
+
+    double square_difference = 0;
+    double mag1              = 0;
+    auto it                  = r.begin();
+    if(!reader.ForEachBlock<T>([&](const T* block, std::size_t, std::size_t count) {
+           for(std::size_t i = 0; i < count; ++i, ++it)
+           {
+               const auto x = static_cast<double>(block[i]);
+               const auto y = static_cast<double>(*it);
+               square_difference += (x - y) * (x - y);
+               mag1 = std::max(mag1, std::fabs(x));
+           }
+       }))
+        return false;
+
+    double mag2 = 0;
+    for(auto&& y : r)
+        mag2 = std::max(mag2, std::fabs(static_cast<double>(y)));
+    const auto mag = std::max({mag1, mag2, std::numeric_limits<double>::min()});
+    error          = std::sqrt(square_difference) / (std::sqrt(n) * mag);
+    return true;
+}
+
+} // namespace miopen
+
+#endif
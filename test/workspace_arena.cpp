@@ -0,0 +1,108 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2019 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/handle.hpp>
+#include <miopen/make_unique.hpp>
+#include <miopen/miopen.h>
+#include <miopen/workspace_arena.hpp>
+#include "get_handle.hpp"
+#include "test.hpp"
+
+void check_growth()
+{
+    miopen::Handle handle{};
+    miopen::WorkspaceArena arena;
+
+    const auto first = arena.Get(handle, 100);
+    EXPECT(first != nullptr);
+    EXPECT(arena.GetCapacity() == 100);
+    // A smaller request reuses the buffer.
+    EXPECT(arena.Get(handle, 50) == first);
+    EXPECT(arena.GetAllocationCount() == 1);
+
+    // The buffer grows at least twice.
+    arena.Get(handle, 150);
+    EXPECT(arena.GetCapacity() == 200);
+    arena.Get(handle, 1000);
+    EXPECT(arena.GetCapacity() == 1000);
+    EXPECT(arena.GetAllocationCount() == 3);
+
+    // The growth keeps within the budget, but a request above the budget is served.
+    handle.workspace_budget = 1500;
+    arena.Get(handle, 1100);
+    EXPECT(arena.GetCapacity() == 1500);
+    arena.Get(handle, 1600);
+    EXPECT(arena.GetCapacity() == 1600);
+    EXPECT(arena.GetHighWaterMark() == 1600);
+    EXPECT(arena.GetAllocationCount() == 5);
+}
+
+void check_use()
+{
+    auto&& handle       = get_handle();
+    auto queried        = false;
+    const auto get_size = [&] {
+        queried = true;
+        return std::size_t{64};
+    };
+
+    // Disabled by default.
+    void* workspace  = nullptr;
+    std::size_t size = 0;
+    miopen::UseWorkspaceArena(handle, workspace, size, get_size);
+    EXPECT(workspace == nullptr);
+    EXPECT(!queried);
+
+    EXPECT(miopenEnableWorkspaceArena(&handle, true) == miopenStatusSuccess);
+    miopen::UseWorkspaceArena(handle, workspace, size, get_size);
+    EXPECT(workspace != nullptr);
+    EXPECT(queried);
+    EXPECT(size == 64);
+
+    // The caller's workspace is used as is.
+    auto buffer          = handle.Create(16);
+    void* own            = reinterpret_cast<void*>(buffer.get()); // NOLINT
+    std::size_t own_size = 16;
+    miopen::UseWorkspaceArena(handle, own, own_size, get_size);
+    EXPECT(own == reinterpret_cast<void*>(buffer.get())); // NOLINT
+    EXPECT(own_size == 16);
+
+    std::size_t capacity = 0, high_water_mark = 0, allocations = 0;
+    EXPECT(miopenGetWorkspaceArenaStats(&handle, &capacity, &high_water_mark, &allocations) ==
+           miopenStatusSuccess);
+    EXPECT(capacity == 64);
+    EXPECT(high_water_mark == 64);
+    EXPECT(allocations == 1);
+
+    EXPECT(miopenEnableWorkspaceArena(&handle, false) == miopenStatusSuccess);
+    EXPECT(handle.workspace_arena == nullptr);
+}
+
+int main()
+{
+    check_growth();
+    check_use();
+}
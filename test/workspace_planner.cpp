@@ -0,0 +1,147 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2019 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/errors.hpp>
+#include <miopen/workspace_planner.hpp>
+#include <limits>
+#include <random>
+#include <vector>
+#include "test.hpp"
+
+using Layers = std::vector<std::vector<miopenConvSolution_t>>;
+
+miopenConvSolution_t MakeSolution(float time, std::size_t workspace)
+{
+    miopenConvSolution_t solution{};
+    solution.time           = time;
+    solution.workspace_size = workspace;
+    return solution;
+}
+
+/// Minimal total time over all combinations that fit into the budget, or -1.
+float BruteForce(const Layers& layers, std::size_t budget)
+{
+    auto best = -1.0f;
+    std::vector<std::size_t> choice(layers.size(), 0);
+    while(true)
+    {
+        std::size_t workspace = 0;
+        auto time             = 0.0f;
+        for(std::size_t i = 0; i < layers.size(); ++i)
+        {
+            workspace += layers[i][choice[i]].workspace_size;
+            time += layers[i][choice[i]].time;
+        }
+        if(workspace <= budget && (best < 0 || time < best))
+            best = time;
+
+        std::size_t i = 0;
+        for(; i < layers.size(); ++i)
+        {
+            if(++choice[i] < layers[i].size())
+                break;
+            choice[i] = 0;
+        }
+        if(i == layers.size())
+            return best;
+    }
+}
+
+void CheckPlan(const Layers& layers, std::size_t budget)
+{
+    const auto expected = BruteForce(layers, budget);
+    if(expected < 0)
+    {
+        EXPECT(throws([&] { miopen::PlanWorkspace(layers, budget); }));
+        return;
+    }
+    const auto plan = miopen::PlanWorkspace(layers, budget);
+    EXPECT(plan.choices.size() == layers.size());
+    std::size_t workspace = 0;
+    auto time             = 0.0f;
+    for(std::size_t i = 0; i < layers.size(); ++i)
+    {
+        workspace += layers[i][plan.choices[i]].workspace_size;
+        time += layers[i][plan.choices[i]].time;
+    }
+    EXPECT(workspace == plan.workspace);
+    EXPECT(workspace <= budget);
+    EXPECT(std::abs(time - plan.time) < 1e-3f);
+    EXPECT(std::abs(time - expected) < 1e-3f);
+
+    const auto more = BruteForce(layers, budget + 1024 * 1024);
+    EXPECT(std::abs(plan.time_per_mb - (expected - more)) < 1e-3f);
+}
+
+void check_simple()
+{
+    const std::size_t mb = 1024 * 1024;
+    // Two layers with a fast solution that needs workspace and a slow one that does not.
+    const Layers layers = {{MakeSolution(1.0f, 3 * mb), MakeSolution(4.0f, 0)},
+                           {MakeSolution(2.0f, 2 * mb), MakeSolution(3.0f, 0)}};
+
+    const auto unlimited = miopen::PlanWorkspace(layers, std::numeric_limits<std::size_t>::max());
+    EXPECT(unlimited.choices == std::vector<std::size_t>({0, 0}));
+    EXPECT(unlimited.time_per_mb == 0.0f);
+
+    // The budget goes to the layer that gains most from it.
+    const auto plan = miopen::PlanWorkspace(layers, 4 * mb);
+    EXPECT(plan.choices == std::vector<std::size_t>({0, 1}));
+    EXPECT(plan.time == 4.0f);
+    EXPECT(plan.time_per_mb == 1.0f);
+
+    const auto none = miopen::PlanWorkspace(layers, 0);
+    EXPECT(none.choices == std::vector<std::size_t>({1, 1}));
+    EXPECT(none.workspace == 0);
+
+    EXPECT(throws([&] { miopen::PlanWorkspace({{}}, 0); }));
+    EXPECT(throws([&] { miopen::PlanWorkspace({{MakeSolution(1.0f, 1)}}, 0); }));
+    EXPECT(miopen::PlanWorkspace({}, 0).choices.empty());
+}
+
+void check_random()
+{
+    std::mt19937 gen(42); // NOLINT
+    std::uniform_int_distribution<std::size_t> layer_count(1, 5);
+    std::uniform_int_distribution<std::size_t> solution_count(1, 4);
+    std::uniform_int_distribution<std::size_t> workspace(0, 4 * 1024 * 1024);
+    std::uniform_int_distribution<int> time(1, 100);
+
+    for(auto n = 0; n < 200; ++n)
+    {
+        Layers layers(layer_count(gen));
+        for(auto& layer : layers)
+            for(auto s = solution_count(gen); s > 0; --s)
+                layer.push_back(MakeSolution(time(gen) * 0.125f, s == 1 ? 0 : workspace(gen)));
+        CheckPlan(layers, workspace(gen) * 2);
+    }
+}
+
+int main()
+{
+    check_simple();
+    check_random();
+}